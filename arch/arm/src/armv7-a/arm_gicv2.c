@@ -126,6 +126,9 @@ void arm_gic0_initialize(void)
 
   DEBUGVERIFY(irq_attach(GIC_IRQ_SGI1, arm_start_handler, NULL));
   DEBUGVERIFY(irq_attach(GIC_IRQ_SGI2, arm_pause_handler, NULL));
+#ifdef CONFIG_SMP_RESCHED_IPI
+  DEBUGVERIFY(irq_attach(GIC_IRQ_SGI3, arm_resched_handler, NULL));
+#endif
 #endif
 
   arm_gic_dump("Exit arm_gic0_initialize", true, 0);
@@ -1763,7 +1763,7 @@ static bool up_rxflowcontrol(struct uart_dev_s *dev,
            * prevent more data from coming in.
            *
            * This function is only called when UART recv buffer is full,
-           * that is: "dev->recv.head + 1 == dev->recv.tail".
+           * that is: "uart_buffer_space(&dev->recv) == 0".
            *
            * Logic in "uart_read" will automatically toggle Rx interrupts
            * when buffer is read empty and thus we do not have to re-
@@ -1042,8 +1042,7 @@ static int  up_hs_attach(struct uart_dev_s *dev)
 {
   struct up_dev_s *priv = (struct up_dev_s *)dev->priv;
 
-  dev->recv.tail = 0;
-  dev->recv.head = 0;
+  uart_buffer_reset(&dev->recv);
   hs_dmaact = HS_DMAACT_STOP1;
 
   up_hs_dmasetup();
@@ -1108,9 +1107,16 @@ static void uart_dma_callback(DMA_HANDLE hdma, void *arg, int result)
 static void  up_hs_dmasetup()
 {
   irqstate_t flags;
+  char *data;
+  int tail;
 
   flags = enter_critical_section();
 
+  /* Get the offset of the tail of the RX data in the buffer */
+
+  (void)uart_buffer_claim(&g_uart1port.recv, &data);
+  tail = data - g_uart1port.recv.buffer;
+
   switch (hs_dmaact)
     {
       case HS_DMAACT_ACT1:
@@ -1118,8 +1124,7 @@ static void  up_hs_dmasetup()
         break;
 
       case HS_DMAACT_STOP1:
-        if (g_uart1port.recv.tail > 0 &&
-            g_uart1port.recv.tail < CONFIG_UART1_RXBUFSIZE / 2)
+        if (tail > 0 && tail < CONFIG_UART1_RXBUFSIZE / 2)
           {
             break;
           }
@@ -1137,7 +1142,7 @@ static void  up_hs_dmasetup()
         break;
 
       case HS_DMAACT_STOP2:
-        if (g_uart1port.recv.tail > CONFIG_UART1_RXBUFSIZE / 2)
+        if (tail > CONFIG_UART1_RXBUFSIZE / 2)
           {
             break;
           }
@@ -1173,21 +1178,7 @@ static int up_hs_receive(struct uart_dev_s *dev, char *buf, int buflen)
   len = MIN(dmalen, buflen);
 
   flags = enter_critical_section();
-  if (len + dev->recv.tail > dev->recv.size)
-    {
-      int len2;
-
-      len2 = dev->recv.size - dev->recv.tail;
-      memcpy(buf, dev->recv.buffer + dev->recv.tail, len2);
-      memcpy(buf + len2, dev->recv.buffer, len - len2);
-      dev->recv.tail = len - len2;
-    }
-  else
-    {
-      memcpy(buf, dev->recv.buffer + dev->recv.tail, len);
-      dev->recv.tail += len;
-    }
-
+  (void)uart_buffer_get(&dev->recv, buf, len);
   up_hs_dmasetup();
   leave_critical_section(flags);
   return len;
@@ -1447,7 +1438,9 @@ void up_console_disable(int disable)
 
 void hsuart_wdtimer(void)
 {
+  char *data;
   int newhead = 0;
+  int head;
 
   if (!hs_recstart)
     {
@@ -1470,19 +1463,23 @@ void hsuart_wdtimer(void)
         break;
     };
 
-  if (g_uart1port.recv.head != newhead)
-    {
-      if (newhead == CONFIG_UART1_RXBUFSIZE)
-        {
-          newhead = 0;
-        }
+  /* Get the offset of the head of the RX data in the buffer and commit
+   * everything that the DMA wrote since.
+   */
 
-      if (g_uart1port.recv.tail == CONFIG_UART1_RXBUFSIZE)
-        {
-          g_uart1port.recv.tail = 0;
-        }
+  (void)uart_buffer_reserve(&g_uart1port.recv, &data);
+  head = data - g_uart1port.recv.buffer;
 
-      g_uart1port.recv.head = newhead;
+  if (newhead == CONFIG_UART1_RXBUFSIZE)
+    {
+      newhead = 0;
+    }
+
+  if (head != newhead)
+    {
+      uart_buffer_commit(&g_uart1port.recv,
+                         (newhead - head + CONFIG_UART1_RXBUFSIZE) %
+                         CONFIG_UART1_RXBUFSIZE);
       uart_datareceived(&g_uart1port);
     }
 }
@@ -1493,21 +1490,7 @@ void hsuart_wdtimer(void)
 
 int up_hsuart_get_rbufsize(struct uart_dev_s *dev)
 {
-  irqstate_t flags;
-  int ret;
-
-  flags = enter_critical_section();
-  if (dev->recv.tail <= dev->recv.head)
-    {
-      ret = dev->recv.head - dev->recv.tail;
-    }
-  else
-    {
-      ret = dev->recv.size - dev->recv.tail + dev->recv.head;
-    }
-
-  leave_critical_section(flags);
-  return ret;
+  return uart_buffer_used(&dev->recv);
 }
 
 #endif /* CONFIG_HSUART */
@@ -1947,7 +1947,7 @@ static bool stm32f0serial_rxflowcontrol(FAR struct uart_dev_s *dev,
            * prevent more data from coming in.
            *
            * This function is only called when USART recv buffer is full,
-           * that is: "dev->recv.head + 1 == dev->recv.tail".
+           * that is: "uart_buffer_space(&dev->recv) == 0".
            *
            * Logic in "uart_read" will automatically toggle Rx interrupts
            * when buffer is read empty and thus we do not have to re-
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * arch/sim/src/up_hosttime.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <time.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_hosttime
+ *
+ * Description:
+ *   Return the current value of the host monotonic clock in nanoseconds.
+ *   This is a high resolution time source for measurements; it is not
+ *   related to the simulated system time.
+ *
+ ****************************************************************************/
+
+uint64_t up_hosttime(void)
+{
+  struct timespec tp;
+
+  clock_gettime(CLOCK_MONOTONIC, &tp);
+  return (uint64_t)tp.tv_sec * 1000000000ull + (uint64_t)tp.tv_nsec;
+}
+
+/****************************************************************************
+ * Name: up_perf_gettime
+ *
+ * Description:
+ *   Return the current value of the performance counter.  The simulation
+ *   uses the low 32 bits of the host monotonic clock in nanoseconds.
+ *
+ ****************************************************************************/
+
+uint32_t up_perf_gettime(void)
+{
+  return (uint32_t)up_hosttime();
+}
+
+/****************************************************************************
+ * Name: up_perf_getfreq
+ *
+ * Description:
+ *   Return the frequency of the performance counter in Hz.
+ *
+ ****************************************************************************/
+
+uint32_t up_perf_getfreq(void)
+{
+  return 1000000000;
+}
@@ -230,6 +230,10 @@ volatile spinlock_t g_cpu_paused[CONFIG_SMP_NCPUS] SP_SECTION;
 int  up_setjmp(xcpt_reg_t *jb);
 void up_longjmp(xcpt_reg_t *jb, int val) noreturn_function;
 
+/* up_hosttime.c **********************************************************/
+
+uint64_t up_hosttime(void);
+
 /* up_simsmp.c ************************************************************/
 
 #ifdef CONFIG_SMP
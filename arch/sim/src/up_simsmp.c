@@ -102,6 +102,9 @@ volatile spinlock_t g_cpu_paused[CONFIG_SMP_NCPUS];
 
 void os_start(void) __attribute__ ((noreturn));
 void up_cpu_paused(int cpu);
+#ifdef CONFIG_SMP_RESCHED_IPI
+void sched_process_resched(void);
+#endif
 void sim_smp_hook(void);
 
 /****************************************************************************
@@ -136,10 +139,13 @@ static void *sim_cpu0_trampoline(void *arg)
       return NULL;
     }
 
-  /* Make sure the SIGUSR1 is not masked */
+  /* Make sure the SIGUSR1 (and SIGUSR2) are not masked */
 
   sigemptyset(&set);
   sigaddset(&set, SIGUSR1);
+#ifdef CONFIG_SMP_RESCHED_IPI
+  sigaddset(&set, SIGUSR2);
+#endif
 
   ret = pthread_sigmask(SIG_UNBLOCK, &set, NULL);
   if (ret < 0)
@@ -190,10 +196,13 @@ static void *sim_idle_trampoline(void *arg)
       return NULL;
     }
 
-  /* Make sure the SIGUSR1 is not masked */
+  /* Make sure the SIGUSR1 (and SIGUSR2) are not masked */
 
   sigemptyset(&set);
   sigaddset(&set, SIGUSR1);
+#ifdef CONFIG_SMP_RESCHED_IPI
+  sigaddset(&set, SIGUSR2);
+#endif
 
   ret = pthread_sigmask(SIG_UNBLOCK, &set, NULL);
   if (ret < 0)
@@ -239,6 +248,28 @@ static void sim_handle_signal(int signo, siginfo_t *info, void *context)
   (void)up_cpu_paused(cpu);
 }
 
+/****************************************************************************
+ * Name: sim_handle_resched
+ *
+ * Description:
+ *   This is the SIGUSR2 signal handler.  It implements the reschedule IPI
+ *   sent by up_cpu_resched() on the thread of execution the simulated CPU.
+ *
+ * Input Parameters:
+ *   arg - Standard sigaction arguments
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_RESCHED_IPI
+static void sim_handle_resched(int signo, siginfo_t *info, void *context)
+{
+  sched_process_resched();
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -285,10 +316,25 @@ int sim_cpu0_initialize(void)
       return -errno;
     }
 
-  /* Make sure the SIGUSR1 is not masked */
+#ifdef CONFIG_SMP_RESCHED_IPI
+  /* Register the reschedule IPI handler */
+
+  act.sa_sigaction = sim_handle_resched;
+
+  ret = sigaction(SIGUSR2, &act, NULL);
+  if (ret < 0)
+    {
+      return -errno;
+    }
+#endif
+
+  /* Make sure the SIGUSR1 (and SIGUSR2) are not masked */
 
   sigemptyset(&set);
   sigaddset(&set, SIGUSR1);
+#ifdef CONFIG_SMP_RESCHED_IPI
+  sigaddset(&set, SIGUSR2);
+#endif
 
   ret = sigprocmask(SIG_UNBLOCK, &set, NULL);
   if (ret < 0)
@@ -501,3 +547,29 @@ int up_cpu_resume(int cpu)
   g_cpu_wait[cpu] = SP_UNLOCKED;
   return 0;
 }
+
+/****************************************************************************
+ * Name: up_cpu_resched
+ *
+ * Description:
+ *   Send a reschedule inter-processor interrupt to the specified CPU.  The
+ *   interrupt handler on that CPU must call sched_process_resched().
+ *   Unlike up_cpu_pause(), this function does not wait for the other CPU
+ *   to respond.  The target may be the current CPU.
+ *
+ * Input Parameters:
+ *   cpu - The index of the CPU to be signaled.
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_RESCHED_IPI
+int up_cpu_resched(int cpu)
+{
+  /* Signal the CPU thread */
+
+  return -pthread_kill(g_sim_cputhread[cpu], SIGUSR2);
+}
+#endif
@@ -166,15 +166,11 @@ static uart_dev_t g_scc_port =
   { 0 },                       /* recvsem */
   {
     { 0 },                     /* xmit.sem */
-    0,                         /* xmit.head */
-    0,                         /* xmit.tail */
     CONFIG_Z180_SCC_TXBUFSIZE, /* xmit.size */
     g_scc_txbuffer,            /* xmit.buffer */
   },
   {
     { 0 },                     /* recv.sem */
-    0,                         /* recv.head */
-    0,                         /* recv.tail */
     CONFIG_Z180_SCC_RXBUFSIZE, /* recv.size */
     g_scc_rxbuffer,            /* recv.buffer */
   },
@@ -212,15 +208,11 @@ static uart_dev_t g_escca_port =
   { 0 },                       /* recvsem */
   {
     { 0 },                     /* xmit.sem */
-    0,                         /* xmit.head */
-    0,                         /* xmit.tail */
     CONFIG_Z180_ESCCA_TXBUFSIZE, /* xmit.size */
     g_escca_txbuffer,          /* xmit.buffer */
   },
   {
     { 0 },                     /* recv.sem */
-    0,                         /* recv.head */
-    0,                         /* recv.tail */
     CONFIG_Z180_ESCCA_RXBUFSIZE, /* recv.size */
     g_escca_rxbuffer,          /* recv.buffer */
   },
@@ -258,15 +250,11 @@ static uart_dev_t g_escca_port =
   { 0 },                       /* recvsem */
   {
     { 0 },                     /* xmit.sem */
-    0,                         /* xmit.head */
-    0,                         /* xmit.tail */
     CONFIG_Z180_ESCCA_TXBUFSIZE, /* xmit.size */
     g_escca_txbuffer,          /* xmit.buffer */
   },
   {
     { 0 },                     /* recv.sem */
-    0,                         /* recv.head */
-    0,                         /* recv.tail */
     CONFIG_Z180_ESCCA_RXBUFSIZE, /* recv.size */
     g_escca_rxbuffer,          /* recv.buffer */
   },
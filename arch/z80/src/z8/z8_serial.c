@@ -166,15 +166,11 @@ static uart_dev_t g_uart0port =
   { 0 },                    /* recvsem */
   {
     { 0 },                  /* xmit.sem */
-    0,                      /* xmit.head */
-    0,                      /* xmit.tail */
     CONFIG_UART0_TXBUFSIZE, /* xmit.size */
     g_uart0txbuffer,        /* xmit.buffer */
   },
   {
     { 0 },                  /* recv.sem */
-    0,                      /* recv.head */
-    0,                      /* recv.tail */
     CONFIG_UART0_RXBUFSIZE, /* recv.size */
     g_uart0rxbuffer,        /* recv.buffer */
   },
@@ -211,15 +207,11 @@ static uart_dev_t g_uart1port =
   { 0 },                    /* recvsem */
   {
     { 0 },                  /* xmit.sem */
-    0,                      /* xmit.head */
-    0,                      /* xmit.tail */
     CONFIG_UART1_TXBUFSIZE, /* xmit.size */
     g_uart1txbuffer,        /* xmit.buffer */
   },
   {
     { 0 },                  /* recv.sem */
-    0,                      /* recv.head */
-    0,                      /* recv.tail */
     CONFIG_UART1_RXBUFSIZE, /* recv.size */
     g_uart0rxbuffer,        /* recv.buffer */
   },
@@ -0,0 +1,1110 @@
+/****************************************************************************
+ * configs/sim/src/sim_mmbench.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/gran.h>
+#include <nuttx/mm/iob.h>
+
+#include "up_internal.h"
+
+#ifdef CONFIG_SIM_MMBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_SIM_MMBENCH_HEAPSIZE
+#  define CONFIG_SIM_MMBENCH_HEAPSIZE 262144
+#endif
+
+#ifndef CONFIG_SIM_MMBENCH_NSLOTS
+#  define CONFIG_SIM_MMBENCH_NSLOTS 512
+#endif
+
+#ifndef CONFIG_SIM_MMBENCH_NOPS
+#  define CONFIG_SIM_MMBENCH_NOPS 100000
+#endif
+
+#ifndef CONFIG_SIM_MMBENCH_SAMPLE
+#  define CONFIG_SIM_MMBENCH_SAMPLE 64
+#endif
+
+#ifndef CONFIG_SIM_MMBENCH_LOG2GRAN
+#  define CONFIG_SIM_MMBENCH_LOG2GRAN 6
+#endif
+
+#ifndef CONFIG_PTHREAD_STACK_DEFAULT
+#  define CONFIG_PTHREAD_STACK_DEFAULT 2048
+#endif
+
+/* The TCB churn trace allocates three chunks per task:  The TCB, the
+ * stack and the task group.
+ */
+
+#define MMBENCH_TCB_NCHUNKS  3
+#define MMBENCH_TCB_SIZE     sizeof(struct pthread_tcb_s)
+#define MMBENCH_GROUP_SIZE   256
+
+/* The number of tasks is limited so that all of them fit in about half of
+ * the heap.
+ */
+
+#define MMBENCH_TASK_SIZE \
+  (MMBENCH_TCB_SIZE + CONFIG_PTHREAD_STACK_DEFAULT + MMBENCH_GROUP_SIZE)
+#define MMBENCH_TASK_FIT \
+  (CONFIG_SIM_MMBENCH_HEAPSIZE / (2 * MMBENCH_TASK_SIZE))
+#define MMBENCH_TASK_SLOTS \
+  (CONFIG_SIM_MMBENCH_NSLOTS / MMBENCH_TCB_NCHUNKS)
+
+#define MMBENCH_NTASKS \
+  (MMBENCH_TASK_FIT < 1 ? 1 : \
+   MMBENCH_TASK_FIT < MMBENCH_TASK_SLOTS ? MMBENCH_TASK_FIT : \
+   MMBENCH_TASK_SLOTS)
+
+/* Operation types */
+
+#define MMBENCH_OP_ALLOC     0
+#define MMBENCH_OP_MEMALIGN  1
+#define MMBENCH_OP_REALLOC   2
+#define MMBENCH_OP_FREE      3
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One allocation request of a trace */
+
+struct mmbench_op_s
+{
+  uint8_t  type;       /* MMBENCH_OP_* */
+  uint16_t slot;       /* Index of the live allocation */
+  size_t   align;      /* Alignment (MMBENCH_OP_MEMALIGN only) */
+  size_t   size;       /* Requested size */
+};
+
+/* One live allocation */
+
+struct mmbench_slot_s
+{
+  FAR void *mem;       /* The allocated memory (NULL if the slot is free) */
+  size_t    size;      /* The requested size */
+};
+
+/* The state of a trace replay */
+
+struct mmbench_state_s
+{
+  uint32_t  seed;      /* State of the pseudo-random number generator */
+  uint32_t  nops;      /* Number of operations generated so far */
+  uint32_t  maxops;    /* Number of operations to generate */
+  uint16_t  head;      /* FIFO head (packet) or first slot (TCB trace) */
+  uint16_t  count;     /* FIFO count (packet) or chunks left (TCB trace) */
+  bool      exiting;   /* The task is exiting (TCB trace) */
+  FAR FILE *stream;    /* Trace file (file trace) */
+};
+
+/* A trace generator returns the next operation or false at the end of the
+ * trace.
+ */
+
+struct mmbench_trace_s
+{
+  FAR const char *name;
+  CODE bool (*next)(FAR struct mmbench_state_s *state,
+                    FAR struct mmbench_op_s *op);
+};
+
+/* An allocator under test.  realloc and memalign may be NULL if they are
+ * not supported; frag returns the fragmentation of the free memory in
+ * percent (or -1 if that is meaningless for the allocator).
+ */
+
+struct mmbench_alloc_s
+{
+  FAR const char *name;
+  CODE int (*init)(void);
+  CODE void (*uninit)(void);
+  CODE FAR void *(*alloc)(size_t size);
+  CODE FAR void *(*memalign)(size_t align, size_t size);
+  CODE FAR void *(*realloc)(FAR void *mem, size_t size);
+  CODE void (*free)(FAR void *mem, size_t size);
+  CODE int (*frag)(void);
+};
+
+/* The results of one trace replay */
+
+struct mmbench_result_s
+{
+  uint32_t nops;       /* Number of timed operations */
+  uint32_t nfail;      /* Number of failed allocations */
+  uint64_t total;      /* Total time of all operations (ns) */
+  uint64_t worst;      /* Longest single operation (ns) */
+  size_t   inuse;      /* Currently requested bytes */
+  size_t   peak;       /* Peak of requested bytes */
+  int      frag;       /* Peak fragmentation (percent) */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static bool mmbench_random(FAR struct mmbench_state_s *state,
+                           FAR struct mmbench_op_s *op);
+static bool mmbench_packet(FAR struct mmbench_state_s *state,
+                           FAR struct mmbench_op_s *op);
+static bool mmbench_tcb(FAR struct mmbench_state_s *state,
+                        FAR struct mmbench_op_s *op);
+static bool mmbench_file(FAR struct mmbench_state_s *state,
+                         FAR struct mmbench_op_s *op);
+
+static int mmbench_heap_init(void);
+static FAR void *mmbench_heap_alloc(size_t size);
+static FAR void *mmbench_heap_memalign(size_t align, size_t size);
+static FAR void *mmbench_heap_realloc(FAR void *mem, size_t size);
+static void mmbench_heap_free(FAR void *mem, size_t size);
+static int mmbench_heap_frag(void);
+
+#ifdef CONFIG_SIM_MMBENCH_GRAN
+static int mmbench_gran_init(void);
+static void mmbench_gran_uninit(void);
+static FAR void *mmbench_gran_alloc(size_t size);
+static void mmbench_gran_free(FAR void *mem, size_t size);
+static int mmbench_gran_frag(void);
+#endif
+
+#ifdef CONFIG_SIM_MMBENCH_IOB
+static FAR void *mmbench_iob_alloc(size_t size);
+static void mmbench_iob_free(FAR void *mem, size_t size);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct mmbench_trace_s g_mmbench_traces[] =
+{
+  { "random", mmbench_random },
+  { "packet", mmbench_packet },
+  { "tcb",    mmbench_tcb    },
+};
+
+#define MMBENCH_NTRACES \
+  (sizeof(g_mmbench_traces) / sizeof(struct mmbench_trace_s))
+
+static const struct mmbench_trace_s g_mmbench_filetrace =
+{
+  "file", mmbench_file
+};
+
+static const struct mmbench_alloc_s g_mmbench_allocs[] =
+{
+  {
+    "mm_heap", mmbench_heap_init, NULL, mmbench_heap_alloc,
+    mmbench_heap_memalign, mmbench_heap_realloc, mmbench_heap_free,
+    mmbench_heap_frag
+  },
+#ifdef CONFIG_SIM_MMBENCH_GRAN
+  {
+    "mm_gran", mmbench_gran_init, mmbench_gran_uninit, mmbench_gran_alloc,
+    NULL, NULL, mmbench_gran_free, mmbench_gran_frag
+  },
+#endif
+#ifdef CONFIG_SIM_MMBENCH_IOB
+  {
+    "iob", NULL, NULL, mmbench_iob_alloc, NULL, NULL, mmbench_iob_free,
+    NULL
+  },
+#endif
+};
+
+#define MMBENCH_NALLOCS \
+  (sizeof(g_mmbench_allocs) / sizeof(struct mmbench_alloc_s))
+
+/* The live allocations of the trace being replayed */
+
+static struct mmbench_slot_s g_mmbench_slots[CONFIG_SIM_MMBENCH_NSLOTS];
+
+/* The private heap that is managed by the allocator under test */
+
+static uint64_t g_mmbench_heapmem[CONFIG_SIM_MMBENCH_HEAPSIZE / 8];
+static struct mm_heap_s g_mmbench_heap;
+
+#ifdef CONFIG_SIM_MMBENCH_GRAN
+static GRAN_HANDLE g_mmbench_gran;
+#endif
+
+/* The overhead of one pair of time measurements */
+
+static uint64_t g_mmbench_overhead;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmbench_rand
+ *
+ * Description:
+ *   A small, deterministic pseudo-random number generator (xorshift32) so
+ *   that each trace is identical for every allocator and on every host.
+ *
+ ****************************************************************************/
+
+static uint32_t mmbench_rand(FAR struct mmbench_state_s *state)
+{
+  uint32_t x = state->seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  state->seed = x;
+  return x;
+}
+
+/****************************************************************************
+ * Name: mmbench_random
+ *
+ * Description:
+ *   Random sizes and lifetimes.  Mostly small requests with an occasional
+ *   large one, some aligned allocations and some reallocations.
+ *
+ ****************************************************************************/
+
+static bool mmbench_random(FAR struct mmbench_state_s *state,
+                           FAR struct mmbench_op_s *op)
+{
+  uint32_t r;
+
+  if (state->nops++ >= state->maxops)
+    {
+      return false;
+    }
+
+  op->slot = mmbench_rand(state) % CONFIG_SIM_MMBENCH_NSLOTS;
+  r        = mmbench_rand(state);
+
+  if ((r & 3) == 0)
+    {
+      op->size = (mmbench_rand(state) % 4096) + 1;
+    }
+  else
+    {
+      op->size = (mmbench_rand(state) % 256) + 1;
+    }
+
+  if (g_mmbench_slots[op->slot].mem != NULL)
+    {
+      op->type = ((r >> 2) & 3) == 0 ? MMBENCH_OP_REALLOC : MMBENCH_OP_FREE;
+    }
+  else if (((r >> 2) & 31) == 0)
+    {
+      op->type  = MMBENCH_OP_MEMALIGN;
+      op->align = (size_t)16 << ((r >> 7) & 3);
+    }
+  else
+    {
+      op->type = MMBENCH_OP_ALLOC;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mmbench_packet
+ *
+ * Description:
+ *   Network packet churn.  Packets are allocated with a typical Ethernet
+ *   size mix and are freed in FIFO order, as by a driver and a protocol
+ *   stack that consumes them.
+ *
+ ****************************************************************************/
+
+static bool mmbench_packet(FAR struct mmbench_state_s *state,
+                           FAR struct mmbench_op_s *op)
+{
+  uint32_t r;
+
+  if (state->nops++ >= state->maxops)
+    {
+      return false;
+    }
+
+  r = mmbench_rand(state);
+
+  if (state->count >= CONFIG_SIM_MMBENCH_NSLOTS ||
+      (state->count > 0 && (r & 1) != 0))
+    {
+      /* Free the oldest packet */
+
+      op->type = MMBENCH_OP_FREE;
+      op->slot = (state->head + CONFIG_SIM_MMBENCH_NSLOTS - state->count) %
+                 CONFIG_SIM_MMBENCH_NSLOTS;
+      op->size = 0;
+      state->count--;
+      return true;
+    }
+
+  /* Allocate a new packet:  40% small (ACKs, ARP), 20% 576 byte, 30% full
+   * size frames and 10% anything in between.
+   */
+
+  r = (r >> 1) % 10;
+  if (r < 4)
+    {
+      op->size = 60 + mmbench_rand(state) % 40;
+    }
+  else if (r < 6)
+    {
+      op->size = 576;
+    }
+  else if (r < 9)
+    {
+      op->size = 1514;
+    }
+  else
+    {
+      op->size = 100 + mmbench_rand(state) % 1400;
+    }
+
+  op->type    = MMBENCH_OP_ALLOC;
+  op->slot    = state->head;
+  state->head = (state->head + 1) % CONFIG_SIM_MMBENCH_NSLOTS;
+  state->count++;
+  return true;
+}
+
+/****************************************************************************
+ * Name: mmbench_tcb
+ *
+ * Description:
+ *   Task creation and exit churn.  Each task allocates a TCB, a stack and
+ *   a task group; a random task exits and frees all three.
+ *
+ ****************************************************************************/
+
+static bool mmbench_tcb(FAR struct mmbench_state_s *state,
+                        FAR struct mmbench_op_s *op)
+{
+  unsigned int task;
+  unsigned int chunk;
+
+  if (state->nops++ >= state->maxops)
+    {
+      return false;
+    }
+
+  /* Select a random task if the creation or exit of the previous one is
+   * complete.  The task exits if it exists, otherwise it is created.
+   */
+
+  if (state->count == 0)
+    {
+      task           = mmbench_rand(state) % MMBENCH_NTASKS;
+      state->head    = task * MMBENCH_TCB_NCHUNKS;
+      state->count   = MMBENCH_TCB_NCHUNKS;
+      state->exiting = (g_mmbench_slots[state->head].mem != NULL);
+    }
+
+  chunk    = MMBENCH_TCB_NCHUNKS - state->count;
+  op->slot = state->head + chunk;
+  state->count--;
+
+  if (state->exiting)
+    {
+      op->type = MMBENCH_OP_FREE;
+      op->size = 0;
+      return true;
+    }
+
+  switch (chunk)
+    {
+      case 0:
+        op->size = MMBENCH_TCB_SIZE;
+        break;
+
+      case 1:
+        op->size = CONFIG_PTHREAD_STACK_DEFAULT;
+        break;
+
+      default:
+        op->size = MMBENCH_GROUP_SIZE;
+        break;
+    }
+
+  op->type = MMBENCH_OP_ALLOC;
+  return true;
+}
+
+/****************************************************************************
+ * Name: mmbench_file
+ *
+ * Description:
+ *   Replay a trace file.  Each line holds one operation:
+ *
+ *     a <slot> <size>          - Allocate
+ *     m <slot> <align> <size>  - Allocate aligned memory
+ *     r <slot> <size>          - Reallocate
+ *     f <slot>                 - Free
+ *
+ *   Lines that cannot be parsed are ignored.
+ *
+ ****************************************************************************/
+
+static bool mmbench_file(FAR struct mmbench_state_s *state,
+                         FAR struct mmbench_op_s *op)
+{
+  char line[64];
+  unsigned long slot;
+  unsigned long arg1;
+  unsigned long arg2;
+  int nargs;
+
+  while (state->nops < state->maxops &&
+         fgets(line, sizeof(line), state->stream) != NULL)
+    {
+      nargs = sscanf(&line[1], "%lu %lu %lu", &slot, &arg1, &arg2);
+      if (nargs < 1 || slot >= CONFIG_SIM_MMBENCH_NSLOTS)
+        {
+          continue;
+        }
+
+      op->slot = slot;
+      op->size = arg1;
+
+      switch (line[0])
+        {
+          case 'a':
+            op->type = MMBENCH_OP_ALLOC;
+            break;
+
+          case 'm':
+            op->type  = MMBENCH_OP_MEMALIGN;
+            op->align = arg1;
+            op->size  = arg2;
+            if (nargs < 3)
+              {
+                continue;
+              }
+            break;
+
+          case 'r':
+            op->type = MMBENCH_OP_REALLOC;
+            break;
+
+          case 'f':
+            op->type = MMBENCH_OP_FREE;
+            nargs    = 2;
+            break;
+
+          default:
+            continue;
+        }
+
+      if (nargs < 2)
+        {
+          continue;
+        }
+
+      state->nops++;
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: mmbench_heap_*
+ *
+ * Description:
+ *   The mm_heap allocator, managing a private heap instance.
+ *
+ ****************************************************************************/
+
+static int mmbench_heap_init(void)
+{
+  mm_initialize(&g_mmbench_heap, g_mmbench_heapmem,
+                sizeof(g_mmbench_heapmem));
+  return OK;
+}
+
+static FAR void *mmbench_heap_alloc(size_t size)
+{
+  return mm_malloc(&g_mmbench_heap, size);
+}
+
+static FAR void *mmbench_heap_memalign(size_t align, size_t size)
+{
+  return mm_memalign(&g_mmbench_heap, align, size);
+}
+
+static FAR void *mmbench_heap_realloc(FAR void *mem, size_t size)
+{
+  return mm_realloc(&g_mmbench_heap, mem, size);
+}
+
+static void mmbench_heap_free(FAR void *mem, size_t size)
+{
+  mm_free(&g_mmbench_heap, mem);
+}
+
+static int mmbench_heap_frag(void)
+{
+  struct mallinfo info;
+
+  mm_mallinfo(&g_mmbench_heap, &info);
+  if (info.fordblks <= 0)
+    {
+      return 0;
+    }
+
+  return 100 - (int)(((uint64_t)info.mxordblk * 100) / info.fordblks);
+}
+
+/****************************************************************************
+ * Name: mmbench_gran_*
+ *
+ * Description:
+ *   The granule allocator, managing the same memory as the private heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_MMBENCH_GRAN
+static int mmbench_gran_init(void)
+{
+  g_mmbench_gran = gran_initialize(g_mmbench_heapmem,
+                                   sizeof(g_mmbench_heapmem),
+                                   CONFIG_SIM_MMBENCH_LOG2GRAN, 0);
+  return g_mmbench_gran != NULL ? OK : -ENOMEM;
+}
+
+static void mmbench_gran_uninit(void)
+{
+  gran_release(g_mmbench_gran);
+}
+
+static FAR void *mmbench_gran_alloc(size_t size)
+{
+  return gran_alloc(g_mmbench_gran, size);
+}
+
+static void mmbench_gran_free(FAR void *mem, size_t size)
+{
+  gran_free(g_mmbench_gran, mem, size);
+}
+
+static int mmbench_gran_frag(void)
+{
+  struct graninfo_s info;
+
+  gran_info(g_mmbench_gran, &info);
+  if (info.nfree == 0)
+    {
+      return 0;
+    }
+
+  return 100 - (int)(((uint32_t)info.mxfree * 100) / info.nfree);
+}
+#endif
+
+/****************************************************************************
+ * Name: mmbench_iob_*
+ *
+ * Description:
+ *   The I/O buffer pool.  A request is satisfied with a list of as many
+ *   I/O buffers as are needed to hold the requested size.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_MMBENCH_IOB
+static FAR void *mmbench_iob_alloc(size_t size)
+{
+  return iob_tryalloc_batch((size + CONFIG_IOB_BUFSIZE - 1) /
+                            CONFIG_IOB_BUFSIZE, false);
+}
+
+static void mmbench_iob_free(FAR void *mem, size_t size)
+{
+  iob_free_batch((FAR struct iob_s *)mem);
+}
+#endif
+
+/****************************************************************************
+ * Name: mmbench_timed_*
+ *
+ * Description:
+ *   Perform one allocator operation and account for its duration.
+ *
+ ****************************************************************************/
+
+static void mmbench_account(FAR struct mmbench_result_s *result,
+                            uint64_t start)
+{
+  uint64_t elapsed = up_hosttime() - start;
+
+  elapsed = elapsed > g_mmbench_overhead ? elapsed - g_mmbench_overhead : 0;
+
+  result->nops++;
+  result->total += elapsed;
+  if (elapsed > result->worst)
+    {
+      result->worst = elapsed;
+    }
+}
+
+static void mmbench_timed_alloc(FAR const struct mmbench_alloc_s *alloc,
+                                FAR struct mmbench_result_s *result,
+                                FAR struct mmbench_slot_s *slot,
+                                size_t align, size_t size)
+{
+  uint64_t start;
+
+  start = up_hosttime();
+  if (align > 0 && alloc->memalign != NULL)
+    {
+      slot->mem = alloc->memalign(align, size);
+    }
+  else
+    {
+      slot->mem = alloc->alloc(size);
+    }
+
+  mmbench_account(result, start);
+
+  if (slot->mem == NULL)
+    {
+      result->nfail++;
+      return;
+    }
+
+  slot->size     = size;
+  result->inuse += size;
+  if (result->inuse > result->peak)
+    {
+      result->peak = result->inuse;
+    }
+}
+
+static void mmbench_timed_free(FAR const struct mmbench_alloc_s *alloc,
+                               FAR struct mmbench_result_s *result,
+                               FAR struct mmbench_slot_s *slot)
+{
+  uint64_t start;
+
+  start = up_hosttime();
+  alloc->free(slot->mem, slot->size);
+  mmbench_account(result, start);
+
+  result->inuse -= slot->size;
+  slot->mem      = NULL;
+}
+
+static void mmbench_timed_realloc(FAR const struct mmbench_alloc_s *alloc,
+                                  FAR struct mmbench_result_s *result,
+                                  FAR struct mmbench_slot_s *slot,
+                                  size_t size)
+{
+  FAR void *newmem;
+  uint64_t start;
+
+  start  = up_hosttime();
+  newmem = alloc->realloc(slot->mem, size);
+  mmbench_account(result, start);
+
+  if (newmem == NULL)
+    {
+      result->nfail++;
+      return;
+    }
+
+  result->inuse += size - slot->size;
+  if (result->inuse > result->peak)
+    {
+      result->peak = result->inuse;
+    }
+
+  slot->mem  = newmem;
+  slot->size = size;
+}
+
+/****************************************************************************
+ * Name: mmbench_replay
+ *
+ * Description:
+ *   Replay one trace against one allocator.
+ *
+ ****************************************************************************/
+
+static int mmbench_replay(FAR const struct mmbench_trace_s *trace,
+                          FAR const struct mmbench_alloc_s *alloc,
+                          FAR struct mmbench_state_s *state,
+                          FAR struct mmbench_result_s *result)
+{
+  FAR struct mmbench_slot_s *slot;
+  struct mmbench_op_s op;
+  int frag;
+  int ret;
+  int i;
+
+  memset(result, 0, sizeof(struct mmbench_result_s));
+  memset(g_mmbench_slots, 0, sizeof(g_mmbench_slots));
+
+  if (alloc->init != NULL)
+    {
+      ret = alloc->init();
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  while (trace->next(state, &op))
+    {
+      slot = &g_mmbench_slots[op.slot];
+
+      switch (op.type)
+        {
+          case MMBENCH_OP_ALLOC:
+          case MMBENCH_OP_MEMALIGN:
+            if (slot->mem != NULL)
+              {
+                mmbench_timed_free(alloc, result, slot);
+              }
+
+            if (op.size > 0)
+              {
+                mmbench_timed_alloc(alloc, result, slot,
+                                    op.type == MMBENCH_OP_MEMALIGN ?
+                                    op.align : 0, op.size);
+              }
+            break;
+
+          case MMBENCH_OP_REALLOC:
+            if (slot->mem != NULL && op.size > 0 && alloc->realloc != NULL)
+              {
+                mmbench_timed_realloc(alloc, result, slot, op.size);
+                break;
+              }
+
+            /* Without realloc support, a reallocation is a free followed
+             * by an allocation.
+             */
+
+            if (slot->mem != NULL)
+              {
+                mmbench_timed_free(alloc, result, slot);
+              }
+
+            if (op.size > 0)
+              {
+                mmbench_timed_alloc(alloc, result, slot, 0, op.size);
+              }
+            break;
+
+          case MMBENCH_OP_FREE:
+          default:
+            if (slot->mem != NULL)
+              {
+                mmbench_timed_free(alloc, result, slot);
+              }
+            break;
+        }
+
+      /* Sample the fragmentation of the free memory */
+
+      if (alloc->frag != NULL &&
+          (state->nops % CONFIG_SIM_MMBENCH_SAMPLE) == 0)
+        {
+          frag = alloc->frag();
+          if (frag > result->frag)
+            {
+              result->frag = frag;
+            }
+        }
+    }
+
+  if (alloc->frag == NULL)
+    {
+      result->frag = -1;
+    }
+
+  /* Free whatever is still allocated (untimed) */
+
+  for (i = 0; i < CONFIG_SIM_MMBENCH_NSLOTS; i++)
+    {
+      if (g_mmbench_slots[i].mem != NULL)
+        {
+          alloc->free(g_mmbench_slots[i].mem, g_mmbench_slots[i].size);
+          g_mmbench_slots[i].mem = NULL;
+        }
+    }
+
+  if (alloc->uninit != NULL)
+    {
+      alloc->uninit();
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mmbench_calibrate
+ *
+ * Description:
+ *   Measure the overhead of reading the host clock twice so that it can be
+ *   subtracted from each measurement.
+ *
+ ****************************************************************************/
+
+static void mmbench_calibrate(void)
+{
+  uint64_t start;
+  uint64_t elapsed;
+  int i;
+
+  g_mmbench_overhead = UINT64_MAX;
+  for (i = 0; i < 1000; i++)
+    {
+      start   = up_hosttime();
+      elapsed = up_hosttime() - start;
+      if (elapsed < g_mmbench_overhead)
+        {
+          g_mmbench_overhead = elapsed;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mmbench_report
+ ****************************************************************************/
+
+static void mmbench_report(FAR const struct mmbench_trace_s *trace,
+                           FAR const struct mmbench_alloc_s *alloc,
+                           FAR const struct mmbench_result_s *result)
+{
+  unsigned long opspersec = 0;
+  unsigned long average   = 0;
+
+  if (result->total > 0)
+    {
+      opspersec = (unsigned long)
+        (((uint64_t)result->nops * 1000000000ull) / result->total);
+    }
+
+  if (result->nops > 0)
+    {
+      average = (unsigned long)(result->total / result->nops);
+    }
+
+  printf("%-7s %-8s %8lu %7lu %10lu %8lu %8lu ",
+         trace->name, alloc->name, (unsigned long)result->nops,
+         (unsigned long)result->nfail, opspersec, average,
+         (unsigned long)result->worst);
+
+  if (result->frag < 0)
+    {
+      printf("%5s", "n/a");
+    }
+  else
+    {
+      printf("%5d", result->frag);
+    }
+
+  printf(" %8lu\n", (unsigned long)result->peak);
+}
+
+/****************************************************************************
+ * Name: mmbench_showusage
+ ****************************************************************************/
+
+static void mmbench_showusage(FAR const char *progname)
+{
+  fprintf(stderr, "USAGE: %s [-n <nops>] [-s <seed>] [-t <trace>] "
+          "[-a <allocator>] [-f <file>]\n", progname);
+  fprintf(stderr, "  -n  Number of operations per trace (default %d)\n",
+          CONFIG_SIM_MMBENCH_NOPS);
+  fprintf(stderr, "  -s  Seed of the generated traces (default 1)\n");
+  fprintf(stderr, "  -t  random, packet or tcb (default all)\n");
+  fprintf(stderr, "  -a  mm_heap, mm_gran or iob (default all)\n");
+  fprintf(stderr, "  -f  Replay the trace in <file> instead\n");
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmbench_main
+ *
+ * Description:
+ *   Replay each allocation trace against each allocator and report the
+ *   throughput (operations per second), the average and worst-case
+ *   latency of a single operation (in host nanoseconds), the peak
+ *   fragmentation of the free memory (100% minus the largest free block
+ *   as a percentage of all free memory) and the peak of requested bytes.
+ *
+ ****************************************************************************/
+
+int mmbench_main(int argc, FAR char *argv[])
+{
+  FAR const struct mmbench_trace_s *trace;
+  FAR const struct mmbench_alloc_s *alloc;
+  FAR const char *tracename = NULL;
+  FAR const char *allocname = NULL;
+  FAR const char *filename  = NULL;
+  struct mmbench_state_s state;
+  struct mmbench_result_s result;
+  unsigned long nops = CONFIG_SIM_MMBENCH_NOPS;
+  unsigned long seed = 1;
+  unsigned int ntraces;
+  unsigned int i;
+  unsigned int j;
+  int option;
+  int ret;
+
+  while ((option = getopt(argc, argv, "n:s:t:a:f:h")) != ERROR)
+    {
+      switch (option)
+        {
+          case 'n':
+            nops = strtoul(optarg, NULL, 0);
+            break;
+
+          case 's':
+            seed = strtoul(optarg, NULL, 0);
+            break;
+
+          case 't':
+            tracename = optarg;
+            break;
+
+          case 'a':
+            allocname = optarg;
+            break;
+
+          case 'f':
+            filename = optarg;
+            break;
+
+          case 'h':
+          default:
+            mmbench_showusage(argv[0]);
+            return option == 'h' ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+  mmbench_calibrate();
+
+  printf("heap=%lu slots=%d ops=%lu seed=%lu clock overhead=%lu ns\n\n",
+         (unsigned long)sizeof(g_mmbench_heapmem),
+         CONFIG_SIM_MMBENCH_NSLOTS, nops, seed,
+         (unsigned long)g_mmbench_overhead);
+  printf("%-7s %-8s %8s %7s %10s %8s %8s %5s %8s\n",
+         "trace", "alloc", "ops", "fail", "ops/sec", "avg(ns)", "max(ns)",
+         "frag%", "peak(B)");
+
+  ntraces = filename != NULL ? 1 : MMBENCH_NTRACES;
+  for (i = 0; i < ntraces; i++)
+    {
+      trace = filename != NULL ? &g_mmbench_filetrace : &g_mmbench_traces[i];
+      if (tracename != NULL && strcmp(tracename, trace->name) != 0)
+        {
+          continue;
+        }
+
+      for (j = 0; j < MMBENCH_NALLOCS; j++)
+        {
+          alloc = &g_mmbench_allocs[j];
+          if (allocname != NULL && strcmp(allocname, alloc->name) != 0)
+            {
+              continue;
+            }
+
+          /* Every allocator replays exactly the same trace */
+
+          memset(&state, 0, sizeof(struct mmbench_state_s));
+          state.seed   = seed != 0 ? seed : 1;
+          state.maxops = nops;
+
+          if (filename != NULL)
+            {
+              state.stream = fopen(filename, "r");
+              if (state.stream == NULL)
+                {
+                  fprintf(stderr, "ERROR: Failed to open %s: %d\n",
+                          filename, errno);
+                  return EXIT_FAILURE;
+                }
+            }
+
+          ret = mmbench_replay(trace, alloc, &state, &result);
+
+          if (state.stream != NULL)
+            {
+              fclose(state.stream);
+            }
+
+          if (ret < 0)
+            {
+              fprintf(stderr, "ERROR: %s initialization failed: %d\n",
+                      alloc->name, ret);
+              continue;
+            }
+
+          mmbench_report(trace, alloc, &result);
+        }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+#endif /* CONFIG_SIM_MMBENCH */
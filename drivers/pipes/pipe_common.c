@@ -228,14 +228,16 @@ int pipecommon_open(FAR struct file *filep)
    * is first opened.
    */
 
-  if (dev->d_refs == 0 && dev->d_buffer == NULL)
+  if (dev->d_refs == 0 && dev->d_ring.rb_buffer == NULL)
     {
-      dev->d_buffer = (FAR uint8_t *)kmm_malloc(dev->d_bufsize);
-      if (!dev->d_buffer)
+      FAR uint8_t *buffer = (FAR uint8_t *)kmm_malloc(dev->d_bufsize);
+      if (!buffer)
         {
           (void)sem_post(&dev->d_bfsem);
           return -ENOMEM;
         }
+
+      ringbuf_init(&dev->d_ring, buffer, dev->d_bufsize);
     }
 
   /* Increment the reference count on the pipe instance */
@@ -278,7 +280,7 @@ int pipecommon_open(FAR struct file *filep)
 
   if ((filep->f_oflags & O_RDWR) == O_RDONLY &&  /* Read-only */
       dev->d_nwriters < 1 &&                     /* No writers on the pipe */
-      dev->d_wrndx == dev->d_rdndx)              /* Buffer is empty */
+      ringbuf_used(&dev->d_ring) == 0)           /* Buffer is empty */
     {
       /* NOTE: d_rdsem is normally used when the read logic waits for more
        * data to be written.  But until the first writer has opened the
@@ -384,17 +386,15 @@ int pipecommon_close(FAR struct file *filep)
    * obtained when the pipe is re-opened.
    */
 
-  else if (PIPE_IS_POLICY_0(dev->d_flags) || dev->d_wrndx == dev->d_rdndx)
+  else if (PIPE_IS_POLICY_0(dev->d_flags) || ringbuf_used(&dev->d_ring) == 0)
     {
       /* Policy 0 or the buffer is empty ... deallocate the buffer now. */
 
-      kmm_free(dev->d_buffer);
-      dev->d_buffer = NULL;
+      kmm_free(dev->d_ring.rb_buffer);
 
       /* And reset all counts and indices */
 
-      dev->d_wrndx    = 0;
-      dev->d_rdndx    = 0;
+      memset(&dev->d_ring, 0, sizeof(struct ringbuf_s));
       dev->d_refs     = 0;
       dev->d_nwriters = 0;
       dev->d_nreaders = 0;
@@ -447,7 +447,7 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   /* If the pipe is empty, then wait for something to be written to it */
 
-  while (dev->d_wrndx == dev->d_rdndx)
+  while (ringbuf_used(&dev->d_ring) == 0)
     {
       /* If O_NONBLOCK was set, then return EGAIN */
 
@@ -480,18 +480,13 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   /* Then return whatever is available in the pipe (which is at least one byte) */
 
-  nread = 0;
-  while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
+  if (len > dev->d_bufsize)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
-        {
-          dev->d_rdndx = 0;
-        }
-
-      nread++;
+      len = dev->d_bufsize;
     }
 
+  nread = ringbuf_get(&dev->d_ring, buffer, len);
+
   /* Notify all waiting writers that bytes have been removed from the buffer */
 
   while (sem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0)
@@ -519,7 +514,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
-  int                    nxtwrndx;
+  size_t                 nput;
   int                    sval;
 
   DEBUGASSERT(dev);
@@ -556,26 +551,22 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   last = 0;
   for (; ; )
     {
-      /* Calculate the write index AFTER the next byte is written */
+      /* Copy as many bytes as will fit into the circular buffer */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      nput = len - nwritten;
+      if (nput > dev->d_bufsize)
         {
-          nxtwrndx = 0;
+          nput = dev->d_bufsize;
         }
 
-      /* Would the next write overflow the circular buffer? */
-
-      if (nxtwrndx != dev->d_rdndx)
+      nput = ringbuf_put(&dev->d_ring, buffer, nput);
+      if (nput > 0)
         {
-          /* No... copy the byte */
-
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
+          buffer   += nput;
+          nwritten += nput;
 
           /* Is the write complete? */
 
-          nwritten++;
           if ((size_t)nwritten >= len)
             {
               /* Yes.. Notify all of the waiting readers that more data is available */
@@ -597,7 +588,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
         }
       else
         {
-          /* There is not enough room for the next byte.  Was anything written in this pass? */
+          /* The circular buffer is full.  Was anything written in this pass? */
 
           if (last < nwritten)
             {
@@ -690,20 +681,13 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
        * First, determine how many bytes are in the buffer
        */
 
-      if (dev->d_wrndx >= dev->d_rdndx)
-        {
-          nbytes = dev->d_wrndx - dev->d_rdndx;
-        }
-      else
-        {
-          nbytes = dev->d_bufsize + dev->d_wrndx - dev->d_rdndx;
-        }
+      nbytes = ringbuf_used(&dev->d_ring);
 
       /* Notify the POLLOUT event if the pipe is not full, but only if
        * there is readers. */
 
       eventset = 0;
-      if (nbytes < (dev->d_bufsize - 1))
+      if (nbytes < dev->d_bufsize)
         {
           eventset |= POLLOUT;
         }
@@ -808,19 +792,9 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
           /* Determine the number of bytes written to the buffer.  This is,
            * of course, also the number of bytes that may be read from the
            * buffer.
-           *
-           *   d_rdndx - index to remove next byte from the buffer
-           *   d_wrndx - Index to next location to add a byte to the buffer.
            */
 
-          if (dev->d_wrndx < dev->d_rdndx)
-            {
-              count = (dev->d_bufsize - dev->d_rdndx) + dev->d_wrndx;
-            }
-          else
-            {
-              count = dev->d_wrndx - dev->d_rdndx;
-            }
+          count = ringbuf_used(&dev->d_ring);
 
           *(FAR int *)((uintptr_t)arg) = count;
           ret = 0;
@@ -833,20 +807,9 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         {
           int count;
 
-          /* Determine the number of bytes free in the buffer.
-           *
-           *   d_rdndx - index to remove next byte from the buffer
-           *   d_wrndx - Index to next location to add a byte to the buffer.
-           */
+          /* Determine the number of bytes free in the buffer. */
 
-          if (dev->d_wrndx < dev->d_rdndx)
-            {
-              count = (dev->d_rdndx - dev->d_wrndx) - 1;
-            }
-          else
-            {
-              count = ((dev->d_bufsize - dev->d_wrndx) + dev->d_rdndx) - 1;
-            }
+          count = ringbuf_space(&dev->d_ring);
 
           *(FAR int *)((uintptr_t)arg) = count;
           ret = 0;
@@ -883,9 +846,9 @@ int pipecommon_unlink(FAR struct inode *inode)
     {
       /* No.. free the buffer (if there is one) */
 
-      if (dev->d_buffer)
+      if (dev->d_ring.rb_buffer)
         {
-          kmm_free(dev->d_buffer);
+          kmm_free(dev->d_ring.rb_buffer);
         }
 
       /* And free the device structure. */
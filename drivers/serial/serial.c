@@ -200,31 +200,19 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
 {
   irqstate_t flags;
-  int nexthead;
+  char xmitch = ch;
   int ret;
 
-  /* Increment to see what the next head pointer will be.  We need to use the "next"
-   * head pointer to determine when the circular buffer would overrun
-   */
-
-  nexthead = dev->xmit.head + 1;
-  if (nexthead >= dev->xmit.size)
-    {
-      nexthead = 0;
-    }
-
   /* Loop until we are able to add the character to the TX buffer. */
 
   for (; ; )
     {
       /* Check if the TX buffer is full */
 
-      if (nexthead != dev->xmit.tail)
+      if (uart_buffer_put(&dev->xmit, &xmitch, 1) > 0)
         {
-          /* No.. not full.  Add the character to the TX buffer and return. */
+          /* No.. not full.  The character was added to the TX buffer. */
 
-          dev->xmit.buffer[dev->xmit.head] = ch;
-          dev->xmit.head = nexthead;
           return OK;
         }
 
@@ -251,7 +239,7 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
            * buffer without this test.
            */
 
-          if (nexthead != dev->xmit.tail)
+          if (uart_buffer_space(&dev->xmit) > 0)
             {
               ret = OK;
             }
@@ -377,7 +365,7 @@ static int uart_tcdrain(FAR uart_dev_t *dev)
   /* Get exclusive access to the to dev->tmit.  We cannot permit new data to be
    * written while we are trying to flush the old data.
    *
-   * A signal received while waiting for access to the xmit.head will abort the
+   * A signal received while waiting for access to the xmit buffer will abort the
    * operation with EINTR.
    */
 
@@ -398,8 +386,7 @@ static int uart_tcdrain(FAR uart_dev_t *dev)
 
       if (dev->disconnected)
         {
-          dev->xmit.head = 0;  /* Drop the buffered TX data */
-          dev->xmit.tail = 0;
+          uart_buffer_reset(&dev->xmit);  /* Drop the buffered TX data */
           ret = -ENOTCONN;
         }
       else
@@ -408,7 +395,7 @@ static int uart_tcdrain(FAR uart_dev_t *dev)
           /* Continue waiting while the TX buffer is not empty */
 
           ret = OK;
-          while (ret >= 0 && dev->xmit.head != dev->xmit.tail)
+          while (ret >= 0 && uart_buffer_used(&dev->xmit) > 0)
             {
               /* Inform the interrupt level logic that we are waiting. */
 
@@ -546,10 +533,8 @@ static int uart_open(FAR struct file *filep)
 
       /* Mark the io buffers empty */
 
-      dev->xmit.head = 0;
-      dev->xmit.tail = 0;
-      dev->recv.head = 0;
-      dev->recv.tail = 0;
+      uart_buffer_reset(&dev->xmit);
+      uart_buffer_reset(&dev->recv);
 
       /* Initialize termios state */
 
@@ -677,16 +662,15 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
-  int16_t tail;
   char ch;
   int ret;
 
-  /* Only one user can access rxbuf->tail at a time */
+  /* Only one user can take data from the RX buffer at a time */
 
   ret = uart_takesem(&rxbuf->sem, true);
   if (ret < 0)
     {
-      /* A signal received while waiting for access to the recv.tail will avort
+      /* A signal received while waiting for access to the RX buffer will avort
        * the transfer.  After the transfer has started, we are committed and
        * signals will be ignored.
        */
@@ -718,34 +702,13 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #endif
 
       /* Check if there is more data to return in the circular buffer.
-       * NOTE: Rx interrupt handling logic may asynchronously increment
-       * the head index but must not modify the tail index.  The tail
-       * index is only modified in this function.  Therefore, no
-       * special handshaking is required here.
-       *
-       * The head and tail pointers are 16-bit values.  The only time that
-       * the following could be unsafe is if the CPU made two non-atomic
-       * 8-bit accesses to obtain the 16-bit head index.
+       * NOTE: Rx interrupt handling logic may asynchronously add data to
+       * the RX buffer but never removes any.  Data is only removed in this
+       * function.  Therefore, no special handshaking is required here.
        */
 
-      tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+      if (uart_buffer_get(rxbuf, &ch, 1) > 0)
         {
-          /* Take the next character from the tail of the buffer */
-
-          ch = rxbuf->buffer[tail];
-
-          /* Increment the tail index.  Most operations are done using the
-           * local variable 'tail' so that the final rxbuf->tail update
-           * is atomic.
-           */
-
-          if (++tail >= rxbuf->size)
-            {
-              tail = 0;
-            }
-
-          rxbuf->tail = tail;
 
 #ifdef CONFIG_SERIAL_TERMIOS
           /* Do input processing if any is enabled */
@@ -846,7 +809,7 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
            * interrupts.
            */
 
-          if (rxbuf->head == rxbuf->tail)
+          if (uart_buffer_used(rxbuf) == 0)
             {
               /* Yes.. the buffer is still empty.  Wait for some characters
                * to be received into the buffer with the RX interrupt re-
@@ -859,9 +822,9 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #ifdef CONFIG_SERIAL_DMA
               /* If RX buffer is empty move tail and head to zero position */
 
-              if (rxbuf->head == rxbuf->tail)
+              if (uart_buffer_used(rxbuf) == 0)
                 {
-                  rxbuf->head = rxbuf->tail = 0;
+                  uart_buffer_reset(rxbuf);
                 }
 
               /* Notify DMA that there is free space in the RX buffer */
@@ -945,9 +908,9 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 
   /* If RX buffer is empty move tail and head to zero position */
 
-  if (rxbuf->head == rxbuf->tail)
+  if (uart_buffer_used(rxbuf) == 0)
     {
-      rxbuf->head = rxbuf->tail = 0;
+      uart_buffer_reset(rxbuf);
     }
 
   leave_critical_section(flags);
@@ -965,15 +928,8 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   /* How many bytes are now buffered */
 
-  rxbuf = &dev->recv;
-  if (rxbuf->head >= rxbuf->tail)
-    {
-      nbuffered = rxbuf->head - rxbuf->tail;
-    }
-  else
-    {
-      nbuffered = rxbuf->size - rxbuf->tail + rxbuf->head;
-    }
+  rxbuf     = &dev->recv;
+  nbuffered = uart_buffer_used(rxbuf);
 
   /* Is the level now below the watermark level that we need to report? */
 
@@ -989,7 +945,7 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #else
   /* If the RX  buffer empty */
 
-  if (rxbuf->head == rxbuf->tail)
+  if (uart_buffer_used(rxbuf) == 0)
     {
       /* Deactivate RX flow control. */
 
@@ -1051,12 +1007,12 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
         }
     }
 
-  /* Only one user can access dev->xmit.head at a time */
+  /* Only one user can add data to the TX buffer at a time */
 
   ret = (ssize_t)uart_takesem(&dev->xmit.sem, true);
   if (ret < 0)
     {
-      /* A signal received while waiting for access to the xmit.head will
+      /* A signal received while waiting for access to the xmit buffer will
        * abort the transfer.  After the transfer has started, we are committed
        * and signals will be ignored.
        */
@@ -1182,7 +1138,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
         }
     }
 
-  if (dev->xmit.head != dev->xmit.tail)
+  if (uart_buffer_used(&dev->xmit) > 0)
     {
 #ifdef CONFIG_SERIAL_DMA
       uart_dmatxavail(dev);
@@ -1222,23 +1178,9 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           case FIONREAD:
             {
-              int count;
-              irqstate_t flags = enter_critical_section();
-
               /* Determine the number of bytes available in the RX buffer */
 
-              if (dev->recv.tail <= dev->recv.head)
-                {
-                  count = dev->recv.head - dev->recv.tail;
-                }
-              else
-                {
-                  count = dev->recv.size - (dev->recv.tail - dev->recv.head);
-                }
-
-              leave_critical_section(flags);
-
-              *(FAR int *)((uintptr_t)arg) = count;
+              *(FAR int *)((uintptr_t)arg) = uart_buffer_used(&dev->recv);
               ret = 0;
             }
             break;
@@ -1247,23 +1189,9 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           case FIONWRITE:
             {
-              int count;
-              irqstate_t flags = enter_critical_section();
-
               /* Determine the number of bytes waiting in the TX buffer */
 
-              if (dev->xmit.tail <= dev->xmit.head)
-                {
-                  count = dev->xmit.head - dev->xmit.tail;
-                }
-              else
-                {
-                  count = dev->xmit.size - (dev->xmit.tail - dev->xmit.head);
-                }
-
-              leave_critical_section(flags);
-
-              *(FAR int *)((uintptr_t)arg) = count;
+              *(FAR int *)((uintptr_t)arg) = uart_buffer_used(&dev->xmit);
               ret = 0;
             }
             break;
@@ -1272,23 +1200,9 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           case FIONSPACE:
             {
-              int count;
-              irqstate_t flags = enter_critical_section();
-
               /* Determine the number of bytes free in the TX buffer */
 
-              if (dev->xmit.head < dev->xmit.tail)
-                {
-                  count = dev->xmit.tail - dev->xmit.head - 1;
-                }
-              else
-                {
-                  count = dev->xmit.size - (dev->xmit.head - dev->xmit.tail) - 1;
-                }
-
-              leave_critical_section(flags);
-
-              *(FAR int *)((uintptr_t)arg) = count;
+              *(FAR int *)((uintptr_t)arg) = uart_buffer_space(&dev->xmit);
               ret = 0;
             }
             break;
@@ -1302,14 +1216,12 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
               if (arg == TCIFLUSH || arg == TCIOFLUSH)
                 {
-                  dev->recv.head = 0;
-                  dev->recv.tail = 0;
+                  uart_buffer_reset(&dev->recv);
                 }
 
               if (arg == TCOFLUSH || arg == TCIOFLUSH)
                 {
-                  dev->xmit.head = 0;
-                  dev->xmit.tail = 0;
+                  uart_buffer_reset(&dev->xmit);
                 }
 
               leave_critical_section(flags);
@@ -1384,7 +1296,6 @@ static int uart_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   FAR struct inode *inode = filep->f_inode;
   FAR uart_dev_t   *dev   = inode->i_private;
   pollevent_t       eventset;
-  int               ndx;
   int               ret;
   int               i;
 
@@ -1447,13 +1358,7 @@ static int uart_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
       eventset = 0;
       (void)uart_takesem(&dev->xmit.sem, false);
 
-      ndx = dev->xmit.head + 1;
-      if (ndx >= dev->xmit.size)
-        {
-          ndx = 0;
-        }
-
-      if (ndx != dev->xmit.tail)
+      if (uart_buffer_space(&dev->xmit) > 0)
        {
          eventset |= (fds->events & POLLOUT);
        }
@@ -1468,7 +1373,7 @@ static int uart_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
        */
 
       (void)uart_takesem(&dev->recv.sem, false);
-      if (dev->recv.head != dev->recv.tail)
+      if (uart_buffer_used(&dev->recv) > 0)
        {
          eventset |= (fds->events & POLLIN);
        }
@@ -1534,6 +1439,8 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
 
   sem_init(&dev->xmit.sem, 0, 1);
   sem_init(&dev->recv.sem, 0, 1);
+  uart_buffer_reset(&dev->xmit);
+  uart_buffer_reset(&dev->recv);
   sem_init(&dev->closesem, 0, 1);
   sem_init(&dev->xmitsem,  0, 0);
   sem_init(&dev->recvsem,  0, 0);
@@ -63,27 +63,40 @@
 void uart_xmitchars_dma(FAR uart_dev_t *dev)
 {
   FAR struct uart_dmaxfer_s *xfer = &dev->dmatx;
+  FAR char *data;
+  unsigned int nused;
+  unsigned int length;
 
-  if (dev->xmit.head == dev->xmit.tail)
+  nused = uart_buffer_used(&dev->xmit);
+  if (nused == 0)
     {
       /* No data to transfer. */
 
       return;
     }
 
-  if (dev->xmit.tail < dev->xmit.head)
+  /* The data may wrap around the end of the buffer.  Transfer the contiguous
+   * data at the tail first, then the rest from the start of the buffer.
+   */
+
+  length = uart_buffer_claim(&dev->xmit, &data);
+  if (length > nused)
     {
-      xfer->buffer  = &dev->xmit.buffer[dev->xmit.tail];
-      xfer->length  = dev->xmit.head - dev->xmit.tail;
-      xfer->nbuffer = NULL;
-      xfer->nlength = 0;
+      length = nused;
     }
-  else
+
+  xfer->buffer  = data;
+  xfer->length  = length;
+
+  if (length < nused)
     {
-      xfer->buffer  = &dev->xmit.buffer[dev->xmit.tail];
-      xfer->length  = dev->xmit.size - dev->xmit.tail;
       xfer->nbuffer = dev->xmit.buffer;
-      xfer->nlength = dev->xmit.head;
+      xfer->nlength = nused - length;
+    }
+  else
+    {
+      xfer->nbuffer = NULL;
+      xfer->nlength = 0;
     }
 
   uart_dmasend(dev);
@@ -107,7 +120,7 @@ void uart_xmitchars_done(FAR uart_dev_t *dev)
 
   /* Move tail for nbytes. */
 
-  txbuf->tail  = (txbuf->tail + nbytes) % txbuf->size;
+  uart_buffer_consume(txbuf, nbytes);
   xfer->nbytes = 0;
   xfer->length = xfer->nlength = 0;
 
@@ -137,15 +150,13 @@ void uart_recvchars_dma(FAR uart_dev_t *dev)
   unsigned int nbuffered;
   unsigned int watermark;
 #endif
+  FAR char *data;
+  unsigned int nfree;
+  unsigned int length;
   bool is_full;
-  int nexthead = rxbuf->head + 1;
 
-  if (nexthead >= rxbuf->size)
-    {
-      nexthead = 0;
-    }
-
-  is_full = nexthead == rxbuf->tail;
+  nfree   = uart_buffer_space(rxbuf);
+  is_full = nfree == 0;
 
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   /* Pre-calcuate the watermark level that we will need to test against. */
@@ -157,14 +168,7 @@ void uart_recvchars_dma(FAR uart_dev_t *dev)
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   /* How many bytes are buffered */
 
-  if (rxbuf->head >= rxbuf->tail)
-    {
-      nbuffered = rxbuf->head - rxbuf->tail;
-    }
-  else
-    {
-      nbuffered = rxbuf->size - rxbuf->tail + rxbuf->head;
-    }
+  nbuffered = rxbuf->size - nfree;
 
   /* Is the level now above the watermark level that we need to report? */
 
@@ -208,26 +212,26 @@ void uart_recvchars_dma(FAR uart_dev_t *dev)
       return;
     }
 
-  if (rxbuf->tail <= rxbuf->head)
+  /* The free space may wrap around the end of the buffer.  Receive into the
+   * contiguous space at the head first, then into the start of the buffer.
+   */
+
+  length = uart_buffer_reserve(rxbuf, &data);
+  if (length > nfree)
     {
-      xfer->buffer  = &rxbuf->buffer[rxbuf->head];
-      xfer->nbuffer = rxbuf->buffer;
+      length = nfree;
+    }
 
-      if (rxbuf->tail > 0)
-        {
-          xfer->length  = rxbuf->size - rxbuf->head;
-          xfer->nlength = rxbuf->tail - 1;
-        }
-      else
-        {
-          xfer->length  = rxbuf->size - rxbuf->head - 1;
-          xfer->nlength = 0;
-        }
+  xfer->buffer  = data;
+  xfer->length  = length;
+
+  if (length < nfree)
+    {
+      xfer->nbuffer = rxbuf->buffer;
+      xfer->nlength = nfree - length;
     }
   else
     {
-      xfer->buffer  = &rxbuf->buffer[rxbuf->head];
-      xfer->length  = rxbuf->tail - rxbuf->head - 1;
       xfer->nbuffer = NULL;
       xfer->nlength = 0;
     }
@@ -253,7 +257,7 @@ void uart_recvchars_done(FAR uart_dev_t *dev)
 
   /* Move head for nbytes. */
 
-  rxbuf->head  = (rxbuf->head + nbytes) % rxbuf->size;
+  uart_buffer_commit(rxbuf, nbytes);
   xfer->nbytes = 0;
   xfer->length = xfer->nlength = 0;
 
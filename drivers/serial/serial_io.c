@@ -63,35 +63,44 @@
 
 void uart_xmitchars(FAR uart_dev_t *dev)
 {
+  FAR char *data;
+  unsigned int navail;
+  unsigned int nsent;
   uint16_t nbytes = 0;
 
-  /* Send while we still have data in the TX buffer & room in the fifo */
+  /* Send while we still have data in the TX buffer & room in the fifo.  The
+   * data is sent in place and removed from the buffer one contiguous segment
+   * at a time; a second pass picks up the data that wrapped around.
+   */
 
-  while (dev->xmit.head != dev->xmit.tail && uart_txready(dev))
+  do
     {
-      /* Send the next byte */
-
-      uart_send(dev, dev->xmit.buffer[dev->xmit.tail]);
-      nbytes++;
+      navail = uart_buffer_claim(&dev->xmit, &data);
+      nsent  = 0;
 
-      /* Increment the tail index */
-
-      if (++(dev->xmit.tail) >= dev->xmit.size)
+      while (nsent < navail && uart_txready(dev))
         {
-          dev->xmit.tail = 0;
+          /* Send the next byte */
+
+          uart_send(dev, data[nsent]);
+          nsent++;
         }
+
+      uart_buffer_consume(&dev->xmit, nsent);
+      nbytes += nsent;
     }
+  while (nsent > 0 && nsent == navail);
 
   /* When all of the characters have been sent from the buffer disable the TX
    * interrupt.
    *
-   * Potential bug?  If nbytes == 0 && (dev->xmit.head == dev->xmit.tail) &&
+   * Potential bug?  If nbytes == 0 && the TX buffer is empty &&
    * dev->xmitwaiting == true, then disabling the TX interrupt will leave
    * the uart_write() logic waiting to TX to complete with no TX interrupts.
    * Can that happen?
    */
 
-  if (dev->xmit.head == dev->xmit.tail)
+  if (uart_buffer_used(&dev->xmit) == 0)
     {
       uart_disabletxint(dev);
     }
@@ -124,14 +133,8 @@ void uart_recvchars(FAR uart_dev_t *dev)
   unsigned int watermark;
 #endif
   unsigned int status;
-  int nexthead = rxbuf->head + 1;
   uint16_t nbytes = 0;
 
-  if (nexthead >= rxbuf->size)
-    {
-      nexthead = 0;
-    }
-
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   /* Pre-calcuate the watermark level that we will need to test against. */
 
@@ -144,7 +147,7 @@ void uart_recvchars(FAR uart_dev_t *dev)
 
   while (uart_rxavailable(dev))
     {
-      bool is_full = (nexthead == rxbuf->tail);
+      bool is_full = (uart_buffer_space(rxbuf) == 0);
       char ch;
 
 #ifdef CONFIG_SERIAL_IFLOWCONTROL
@@ -153,14 +156,7 @@ void uart_recvchars(FAR uart_dev_t *dev)
 
       /* How many bytes are buffered */
 
-      if (rxbuf->head >= rxbuf->tail)
-        {
-          nbuffered = rxbuf->head - rxbuf->tail;
-        }
-      else
-        {
-          nbuffered = rxbuf->size - rxbuf->tail + rxbuf->head;
-        }
+      nbuffered = uart_buffer_used(rxbuf);
 
       /* Is the level now above the watermark level that we need to report? */
 
@@ -208,16 +204,8 @@ void uart_recvchars(FAR uart_dev_t *dev)
         {
           /* Add the character to the buffer */
 
-          rxbuf->buffer[rxbuf->head] = ch;
+          (void)uart_buffer_put(rxbuf, &ch, 1);
           nbytes++;
-
-          /* Increment the head index */
-
-          rxbuf->head = nexthead;
-          if (++nexthead >= rxbuf->size)
-            {
-               nexthead = 0;
-            }
         }
     }
 
@@ -46,6 +46,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <fcntl.h>
 #include <string.h>
 #include <poll.h>
@@ -58,6 +59,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/syslog/ramlog.h>
+#include <nuttx/ringbuf.h>
 
 #include <nuttx/irq.h>
 
@@ -72,14 +74,11 @@ struct ramlog_dev_s
 #ifndef CONFIG_RAMLOG_NONBLOCKING
   volatile uint8_t  rl_nwaiters;     /* Number of threads waiting for data */
 #endif
-  volatile uint16_t rl_head;         /* The head index (where data is added) */
-  volatile uint16_t rl_tail;         /* The tail index (where data is removed) */
   sem_t             rl_exclsem;      /* Enforces mutually exclusive access */
 #ifndef CONFIG_RAMLOG_NONBLOCKING
   sem_t             rl_waitsem;      /* Used to wait for data */
 #endif
-  size_t            rl_bufsize;      /* Size of the RAM buffer */
-  FAR char         *rl_buffer;       /* Circular RAM buffer */
+  struct ringbuf_s  rl_ring;         /* Circular RAM buffer */
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -107,7 +106,9 @@ static int ramlog_flush(void);
 static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                               pollevent_t eventset);
 #endif
-static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+static int     ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+static size_t  ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                             FAR const char *buffer, size_t len);
 
 /* Character driver methods */
 
@@ -173,14 +174,11 @@ static struct ramlog_dev_s g_sysdev =
 #ifndef CONFIG_RAMLOG_NONBLOCKING
   0,                             /* rl_nwaiters */
 #endif
-  0,                             /* rl_head */
-  0,                             /* rl_tail */
   SEM_INITIALIZER(1),            /* rl_exclsem */
 #ifndef CONFIG_RAMLOG_NONBLOCKING
   SEM_INITIALIZER(0),            /* rl_waitsem */
 #endif
-  CONFIG_RAMLOG_BUFSIZE,         /* rl_bufsize */
-  g_sysbuffer                    /* rl_buffer */
+  RINGBUF_INITIALIZER(g_sysbuffer, CONFIG_RAMLOG_BUFSIZE) /* rl_ring */
 };
 #endif
 
@@ -238,37 +236,49 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
 
 static int ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
 {
-  irqstate_t flags;
-  size_t nexthead;
+  /* The character is added without locking:  This may be called from
+   * interrupt handlers on any CPU concurrently with ramlog_read().
+   */
 
-  /* Disable interrupts (in case we are NOT called from interrupt handler) */
+  if (ringbuf_mpput(&priv->rl_ring, &ch, 1) == 0)
+    {
+      /* Return an indication that nothing was saved in the buffer. */
 
-  flags = enter_critical_section();
+      return -EBUSY;
+    }
 
-  /* Calculate the write index AFTER the next byte is written */
+  return OK;
+}
 
-  nexthead = priv->rl_head + 1;
-  if (nexthead >= priv->rl_bufsize)
-    {
-      nexthead = 0;
-    }
+/****************************************************************************
+ * Name: ramlog_addbuf
+ *
+ * Description:
+ *   Add a run of characters to the RAM log.  The run is added at once if
+ *   there is space for all of it; otherwise as many characters as fit are
+ *   added.  Returns the number of characters added.
+ *
+ ****************************************************************************/
 
-  /* Would the next write overflow the circular buffer? */
+static size_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                            FAR const char *buffer, size_t len)
+{
+  size_t nadded;
 
-  if (nexthead == priv->rl_tail)
+  if (len <= UINT_MAX && ringbuf_mpput(&priv->rl_ring, buffer, len) == len)
     {
-      /* Yes... Return an indication that nothing was saved in the buffer. */
-
-      leave_critical_section(flags);
-      return -EBUSY;
+      return len;
     }
 
-  /* No... copy the byte and re-enable interrupts */
+  for (nadded = 0; nadded < len; nadded++)
+    {
+      if (ramlog_addchar(priv, buffer[nadded]) < 0)
+        {
+          break;
+        }
+    }
 
-  priv->rl_buffer[priv->rl_head] = ch;
-  priv->rl_head = nexthead;
-  leave_critical_section(flags);
-  return OK;
+  return nadded;
 }
 
 /****************************************************************************
@@ -280,7 +290,7 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
   ssize_t nread;
-  char ch;
+  unsigned int ncopy;
   int ret;
 
   /* Some sanity checking */
@@ -294,7 +304,7 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   DEBUGASSERT(!up_interrupt_context());
 
-  /* Get exclusive access to the rl_tail index */
+  /* Get exclusive access to the tail of the ring buffer */
 
   ret = sem_wait(&priv->rl_exclsem);
   if (ret < 0)
@@ -306,9 +316,9 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   for (nread = 0; (size_t)nread < len; )
     {
-      /* Get the next byte from the buffer */
+      /* Get the next bytes from the buffer */
 
-      if (priv->rl_head == priv->rl_tail)
+      if (ringbuf_used(&priv->rl_ring) == 0)
         {
           /* The circular buffer is empty. */
 
@@ -402,23 +412,12 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
         }
       else
         {
-          /* The circular buffer is not empty, get the next byte from the
-           * tail index.
+          /* The circular buffer is not empty, copy as much as is
+           * available into the user buffer.
            */
 
-          ch = priv->rl_buffer[priv->rl_tail];
-
-          /* Increment the tail index and re-enable interrupts */
-
-          if (++priv->rl_tail >= priv->rl_bufsize)
-            {
-              priv->rl_tail = 0;
-            }
-
-          /* Add the character to the user buffer */
-
-          buffer[nread] = ch;
-          nread++;
+          ncopy = len - nread > UINT_MAX ? UINT_MAX : len - nread;
+          nread += ringbuf_get(&priv->rl_ring, &buffer[nread], ncopy);
         }
     }
 
@@ -453,8 +452,11 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
   ssize_t nwritten;
+  size_t nadded;
+  size_t start;
+#ifdef CONFIG_RAMLOG_CRLF
   char ch;
-  int ret;
+#endif
 
   /* Some sanity checking */
 
@@ -464,55 +466,64 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
   /* Loop until all of the bytes have been written.  This function may be
    * called from an interrupt handler!  Semaphores cannot be used!
    *
-   * The write logic only needs to modify the rl_head index.  Therefore,
-   * there is a difference in the way that rl_head and rl_tail are protected:
-   * rl_tail is protected with a semaphore; rl_tail is protected by disabling
-   * interrupts.
+   * The write logic only modifies the head of the ring buffer and may
+   * run concurrently with other writers and the reader.  Runs of
+   * characters are added in one step; runs end only where a carriage
+   * return has to be dropped or inserted.
    */
 
+  start = 0;
+
+#ifdef CONFIG_RAMLOG_CRLF
   for (nwritten = 0; (size_t)nwritten < len; nwritten++)
     {
       /* Get the next character to output */
 
       ch = buffer[nwritten];
+      if (ch != '\r' && ch != '\n')
+        {
+          continue;
+        }
 
-      /* Ignore carriage returns */
+      /* Output the run of characters before this one */
 
-#ifdef CONFIG_RAMLOG_CRLF
-      if (ch == '\r')
+      nadded = ramlog_addbuf(priv, &buffer[start], nwritten - start);
+      if (nadded < nwritten - start)
         {
-          continue;
+          /* The buffer is full.  Break out of the loop to return the
+           * number of bytes written up to this point.  The data to be
+           * written is dropped on the floor.
+           */
+
+          nwritten = start + nadded;
+          start    = nwritten;
+          break;
         }
 
-      /* Pre-pend a carriage before a linefeed */
+      /* Ignore carriage returns; pre-pend a carriage return before a
+       * linefeed.
+       */
 
+      start = nwritten + 1;
       if (ch == '\n')
         {
-          ret = ramlog_addchar(priv, '\r');
-          if (ret < 0)
+          nadded = ramlog_addbuf(priv, "\r\n", 2);
+          if (nadded < 2)
             {
-              /* The buffer is full and nothing was saved. Break out of the
-               * loop to return the number of bytes written up to this point.
-               * The data to be written is dropped on the floor.
-               */
-
               break;
             }
         }
+    }
+#else
+  nwritten = len;
 #endif
 
-      /* Then output the character */
+  /* Then output the remaining run of characters */
 
-      ret = ramlog_addchar(priv, ch);
-      if (ret < 0)
-        {
-          /* The buffer is full and nothing was saved. Break out of the
-           * loop to return the number of bytes written up to this point.
-           * The data to be written is dropped on the floor.
-           */
-
-          break;
-        }
+  if (start < (size_t)nwritten)
+    {
+      nadded = ramlog_addbuf(priv, &buffer[start], nwritten - start);
+      nwritten = start + nadded;
     }
 
   /* Was anything written? */
@@ -562,7 +573,6 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
   pollevent_t eventset;
-  size_t ndx;
   int ret;
   int i;
 
@@ -615,20 +625,14 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 
       eventset = 0;
 
-      ndx = priv->rl_head + 1;
-      if (ndx >= priv->rl_bufsize)
-        {
-          ndx = 0;
-        }
-
-      if (ndx != priv->rl_tail)
+      if (ringbuf_space(&priv->rl_ring) > 0)
        {
          eventset |= POLLOUT;
        }
 
       /* Check if the receive buffer is empty */
 
-      if (priv->rl_head != priv->rl_tail)
+      if (ringbuf_used(&priv->rl_ring) > 0)
        {
          eventset |= POLLIN;
        }
@@ -705,8 +709,7 @@ int ramlog_register(FAR const char *devpath, FAR char *buffer, size_t buflen)
       sem_setprotocol(&priv->rl_waitsem, SEM_PRIO_NONE);
 #endif
 
-      priv->rl_bufsize = buflen;
-      priv->rl_buffer  = buffer;
+      ringbuf_init(&priv->rl_ring, buffer, buflen);
 
       /* Register the character driver */
 
@@ -193,7 +193,7 @@ int syslog_console_channel(void);
  * Description:
  *   Add one more character to the interrupt buffer.  In the event of
  *   buffer overlowed, the character will be dropped.  The indication
- *   "[truncated]\n" will be appended to the end of the interrupt buffer.
+ *   "[truncated]\n" will be output when the interrupt buffer is flushed.
  *
  * Input Parameters:
  *   ch - The character to add to the interrupt buffer (must be positive).
@@ -39,12 +39,15 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <assert.h>
 #include <errno.h>
 
 #include <nuttx/syslog/syslog.h>
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/ringbuf.h>
 
 #include "syslog.h"
 
@@ -54,107 +57,41 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-/* Extend the size of the interrupt buffer so that a "[truncated]\n"
- * indication can be append to the end.
- *
- * The usable capacity of the interrupt buffer is (CONFIG_SYSLOG_INTBUFSIZE - 1).
+/* This indication is output after the content of the interrupt buffer when
+ * characters had to be dropped because the buffer was full.
  */
 
 #define SYSLOG_BUFOVERRUN_MESSAGE  "[truncated]\n"
-#define SYSLOG_BUFOVERRUN_SIZE     13
-
-#if CONFIG_SYSLOG_INTBUFSIZE > (65535 - SYSLOG_BUFOVERRUN_SIZE)
-#  undef  CONFIG_SYSLOG_INTBUFSIZE
-#  define CONFIG_SYSLOG_INTBUFSIZE (65535 - SYSLOG_BUFOVERRUN_SIZE)
-#  define SYSLOG_INTBUFSIZE        65535
-#else
-#  define SYSLOG_INTBUFSIZE \
-     (CONFIG_SYSLOG_INTBUFSIZE + SYSLOG_BUFOVERRUN_SIZE)
-#endif
-
-#define USABLE_INTBUFSIZE          (CONFIG_SYSLOG_INTBUFSIZE - 1)
-
-/****************************************************************************
- * Private Types
- ****************************************************************************/
-
-/* This structure encapsulates the interrupt buffer state */
+#define SYSLOG_BUFOVERRUN_SIZE     12
 
-struct g_syslog_intbuffer_s
-{
-  volatile uint16_t si_inndx;
-  volatile uint16_t si_outndx;
-  uint8_t si_buffer[SYSLOG_INTBUFSIZE];
-};
-
-/****************************************************************************
- * Private Data
- ****************************************************************************/
+/* The number of characters taken from the interrupt buffer at a time */
 
-static struct g_syslog_intbuffer_s g_syslog_intbuffer;
-static const char g_overrun_msg[SYSLOG_BUFOVERRUN_SIZE] = SYSLOG_BUFOVERRUN_MESSAGE;
+#define SYSLOG_FLUSH_CHUNK         16
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/****************************************************************************
- * Name: syslog_remove_intbuffer
- *
- * Description:
- *   Extract any characters that may have been added to the interrupt buffer
- *   to the SYSLOG device.
- *
- * Input Parameters:
- *   None
- *
- * Returned Value:
- *   On success, the extracted character is returned.  EOF is returned if
- *   the interrupt buffer is empty.
- *
- * Assumptions:
- *   Interrupts may or may not be disabled.
- *
- ****************************************************************************/
-
-int syslog_remove_intbuffer(void)
-{
-  irqstate_t flags;
-  uint32_t outndx;
-  int ret = EOF;
-
-  /* Extraction of the character and adjustment of the circular buffer
-   * indices must be performed in a critical section to protect from
-   * concurrent modification from interrupt handlers.
-   */
-
-  flags = enter_critical_section();
-
-  /* Check if the interrupt buffer? is empty */
-
-  outndx = (uint32_t)g_syslog_intbuffer.si_outndx;
-  if (outndx != (uint32_t)g_syslog_intbuffer.si_inndx)
-    {
-      /* Not empty.. Take the next character from the interrupt buffer */
-
-      ret = g_syslog_intbuffer.si_buffer[outndx];
+/* The interrupt buffer.  Interrupt handlers on any CPU add characters with
+ * ringbuf_mpput() without waiting for the consumer.
+ */
 
-      /* Increment the OUT index, handling wrap-around */
+static uint8_t g_syslog_intstorage[CONFIG_SYSLOG_INTBUFSIZE];
+static struct ringbuf_s g_syslog_intbuffer =
+  RINGBUF_INITIALIZER(g_syslog_intstorage, CONFIG_SYSLOG_INTBUFSIZE);
 
-      if (++outndx >= SYSLOG_INTBUFSIZE)
-        {
-          outndx -= SYSLOG_INTBUFSIZE;
-        }
+/* True if characters were dropped because the interrupt buffer was full */
 
-      g_syslog_intbuffer.si_outndx = (uint16_t)outndx;
-    }
+static volatile bool g_syslog_overrun;
 
-  leave_critical_section(flags);
+#ifdef CONFIG_SMP
+/* Only one CPU at a time may remove characters from the interrupt buffer */
 
-  /* Now we can send the extracted character to the SYSLOG device */
+static volatile spinlock_t g_syslog_intlock SP_SECTION = SP_UNLOCKED;
+#endif
 
-  return ret;
-}
+static const char g_overrun_msg[SYSLOG_BUFOVERRUN_SIZE + 1] =
+  SYSLOG_BUFOVERRUN_MESSAGE;
 
 /****************************************************************************
  * Public Functions
@@ -166,7 +103,7 @@ int syslog_remove_intbuffer(void)
  * Description:
  *   Add one more character to the interrupt buffer.  In the event of
  *   buffer overlowed, the character will be dropped.  The indication
- *   "[truncated]\n" will be appended to the end of the interrupt buffer.
+ *   "[truncated]\n" will be output when the interrupt buffer is flushed.
  *
  * Input Parameters:
  *   ch - The character to add to the interrupt buffer (must be positive).
@@ -178,94 +115,25 @@ int syslog_remove_intbuffer(void)
  * Assumptions:
  *   - Called either from (1) interrupt handling logic with interrupts
  *     disabled or from an IDLE thread with interrupts enabled.
- *   - Requires caution because there may be an interrupted execution of
- *     syslog_flush_intbuffer():  Only the outndx can be modified.
+ *   - There may be an interrupted execution of syslog_flush_intbuffer():
+ *     The interrupt buffer may be used by one consumer and any number of
+ *     producers concurrently.
  *
  ****************************************************************************/
 
 int syslog_add_intbuffer(int ch)
 {
-  irqstate_t flags;
-  uint32_t inndx;
-  uint32_t outndx;
-  uint32_t endndx;
-  unsigned int inuse;
-  int ret;
-  int i;
-
-  /* Disable concurrent modification from interrupt handling logic */
-
-  flags = enter_critical_section();
-
-  /* How much space is left in the intbuffer? */
-
-  inndx  = (uint32_t)g_syslog_intbuffer.si_inndx;
-  outndx = (uint32_t)g_syslog_intbuffer.si_outndx;
-
-  endndx = inndx;
-  if (endndx < outndx)
-    {
-      endndx += SYSLOG_INTBUFSIZE;
-    }
-
-  inuse = (unsigned int)(endndx - outndx);
-
-  /* Is there space for another character (reserving space for the overrun
-   * message)?
-   */
-
-  if (inuse == USABLE_INTBUFSIZE)
-    {
-      /* Copy the truncated message one character at a time, handing index
-       * wrap-around on each character.
-       */
-
-      for (i = 0; i < SYSLOG_BUFOVERRUN_SIZE; i++)
-        {
-          /* Copy one character */
-
-          g_syslog_intbuffer.si_buffer[inndx] = (uint8_t)g_overrun_msg[i];
-
-          /* Increment the IN index, handling wrap-around */
+  uint8_t byte = (uint8_t)ch;
 
-          if (++inndx >= SYSLOG_INTBUFSIZE)
-            {
-              inndx -= SYSLOG_INTBUFSIZE;
-            }
-
-          DEBUGASSERT(inndx != outndx);
-        }
-
-      g_syslog_intbuffer.si_inndx = (uint16_t)inndx;
-      ret = -ENOSPC;
-    }
-  else if (inuse < USABLE_INTBUFSIZE)
-    {
-       /* Copy one character */
-
-       g_syslog_intbuffer.si_buffer[inndx] = (uint8_t)ch;
-
-       /* Increment the IN index, handling wrap-around */
-
-       if (++inndx >= SYSLOG_INTBUFSIZE)
-         {
-           inndx -= SYSLOG_INTBUFSIZE;
-         }
-
-      g_syslog_intbuffer.si_inndx = (uint16_t)inndx;
-      ret = OK;
-    }
-  else
+  if (ringbuf_mpput(&g_syslog_intbuffer, &byte, 1) == 0)
     {
-      /* This character goes to the bit bucket.  We have already copied
-       * the overrun message so there is nothing else to do.
-       */
+      /* This character goes to the bit bucket */
 
-      ret = -ENOSPC;
+      g_syslog_overrun = true;
+      return -ENOSPC;
     }
 
-  leave_critical_section(flags);
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -291,8 +159,11 @@ int syslog_add_intbuffer(int ch)
 int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
                            bool force)
 {
+  uint8_t chunk[SYSLOG_FLUSH_CHUNK];
   syslog_putc_t putfunc;
-  int ch;
+  irqstate_t flags;
+  unsigned int nbytes;
+  unsigned int i;
   int ret = OK;
 
   /* Select which putc function to use for this flush */
@@ -306,20 +177,33 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
   sched_lock();
   do
     {
-      /* Transfer one character to time.  This is inefficient, but is
-       * done in this way to: (1) Deal with concurrent modification of
-       * the interrupt buffer from interrupt activity, (2) Avoid keeper
-       * interrupts disabled for a long time, and (3) to handler
-       * wraparound of the circular buffer indices.
+      /* Take a small chunk of characters at a time so that the interrupt
+       * buffer is freed as soon as possible for interrupt handlers that
+       * continue to add characters.  Interrupts are disabled only to keep
+       * out other consumers.
        */
 
-      ch = syslog_remove_intbuffer();
-      if (ch != EOF)
+      flags  = spin_lock_irqsave(&g_syslog_intlock);
+      nbytes = ringbuf_get(&g_syslog_intbuffer, chunk, sizeof(chunk));
+      spin_unlock_irqrestore(&g_syslog_intlock, flags);
+
+      for (i = 0; i < nbytes && ret >= 0; i++)
+        {
+          ret = putfunc(chunk[i]);
+        }
+    }
+  while (nbytes > 0 && ret >= 0);
+
+  /* Then indicate if characters were lost */
+
+  if (ret >= 0 && g_syslog_overrun)
+    {
+      g_syslog_overrun = false;
+      for (i = 0; i < SYSLOG_BUFOVERRUN_SIZE && ret >= 0; i++)
         {
-          ret = putfunc(ch);
+          ret = putfunc(g_overrun_msg[i]);
         }
     }
-  while (ch != EOF && ret >= 0);
 
   sched_unlock();
   return ret;
@@ -330,24 +330,13 @@ static uint16_t cdcacm_fillrequest(FAR struct cdcacm_dev_s *priv,
    * request.
    */
 
-  while (xmit->head != xmit->tail && nbytes < reqlen)
-    {
-      *reqbuf++ = xmit->buffer[xmit->tail];
-      nbytes++;
-
-      /* Increment the tail pointer */
-
-      if (++(xmit->tail) >= xmit->size)
-        {
-          xmit->tail = 0;
-        }
-    }
+  nbytes = uart_buffer_get(xmit, (FAR char *)reqbuf, reqlen);
 
   /* When all of the characters have been sent from the buffer disable the
    * "TX interrupt".
    */
 
-  if (xmit->head == xmit->tail)
+  if (uart_buffer_used(xmit) == 0)
     {
       uart_disabletxint(serdev);
     }
@@ -405,8 +394,8 @@ static int cdcacm_sndpacket(FAR struct cdcacm_dev_s *priv)
    * until there is no more data to be sent).
    */
 
-  uinfo("head=%d tail=%d nwrq=%d empty=%d\n",
-        priv->serdev.xmit.head, priv->serdev.xmit.tail,
+  uinfo("used=%u nwrq=%d empty=%d\n",
+        uart_buffer_used(&priv->serdev.xmit),
         priv->nwrq, sq_empty(&priv->txfree));
 
   /* Get the maximum number of bytes that will fit into one bulk IN request */
@@ -476,12 +465,10 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
   unsigned int watermark;
 #endif
   uint16_t reqlen;
-  uint16_t currhead;
-  uint16_t nexthead;
   uint16_t nbytes = 0;
 
-  uinfo("head=%d tail=%d nrdq=%d reqlen=%d\n",
-        priv->serdev.recv.head, priv->serdev.recv.tail, priv->nrdq, reqlen);
+  uinfo("used=%u nrdq=%d reqlen=%d\n",
+        uart_buffer_used(&priv->serdev.recv), priv->nrdq, reqlen);
 
   DEBUGASSERT(priv != NULL && rdcontainer != NULL);
 #ifdef CONFIG_CDCACM_IFLOWCONTROL
@@ -499,21 +486,6 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
   serdev = &priv->serdev;
   recv   = &serdev->recv;
 
-  /* Get the next head index. */
-
-  currhead = recv->head;
-
-  /* Pre-calculate the head index and check for wrap around.  We need to do
-   * this so that we can determine if the circular buffer will overrun
-   * BEFORE we overrun the buffer!
-   */
-
-  nexthead = currhead + 1;
-  if (nexthead >= recv->size)
-    {
-      nexthead = 0;
-    }
-
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   /* Pre-calcuate the watermark level that we will need to test against. */
 
@@ -533,7 +505,7 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
    * proper way to throttle a serial device.
    */
 
-  while (nexthead != recv->tail && nbytes < reqlen)
+  while (uart_buffer_space(recv) > 0 && nbytes < reqlen)
     {
 #ifdef CONFIG_SERIAL_IFLOWCONTROL
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
@@ -541,14 +513,7 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
 
       /* How many bytes are buffered */
 
-      if (recv->head >= recv->tail)
-        {
-          nbuffered = recv->head - recv->tail;
-        }
-      else
-        {
-          nbuffered = recv->size - recv->tail + recv->head;
-        }
+      nbuffered = uart_buffer_used(recv);
 
       /* Is the level now above the watermark level that we need to report? */
 
@@ -570,7 +535,7 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
        * processing. This allows proper utilization of hardware flow control.
        */
 
-      if (nexthead == rxbuf->tail);
+      if (uart_buffer_space(recv) == 0)
         {
           if (cdcuart_rxflowcontrol(&priv->serdev, recv->size, true))
             {
@@ -584,26 +549,10 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
 
       /* Copy one byte to the head of the circular RX buffer */
 
-      recv->buffer[currhead] = *reqbuf++;
-
-      /* Update counts and indices */
-
-      currhead = nexthead;
+      (void)uart_buffer_put(recv, (FAR const char *)reqbuf++, 1);
       nbytes++;
-
-      /* Increment the head index and check for wrap around */
-
-      nexthead = currhead + 1;
-      if (nexthead >= recv->size)
-        {
-          nexthead = 0;
-        }
     }
 
-  /* Write back the head pointer. */
-
-  recv->head = currhead;
-
   /* If data was added to the incoming serial buffer, then wake up any
    * threads is waiting for incoming data. If we are running in an interrupt
    * handler, then the serial driver will not run until the interrupt handler
@@ -1604,8 +1553,7 @@ static void cdcacm_unbind(FAR struct usbdevclass_driver_s *driver,
 
       /* Clear out all data in the circular buffer */
 
-      priv->serdev.xmit.head = 0;
-      priv->serdev.xmit.tail = 0;
+      uart_buffer_reset(&priv->serdev.xmit);
     }
 }
 
@@ -2054,8 +2002,7 @@ static void cdcacm_disconnect(FAR struct usbdevclass_driver_s *driver,
 
   /* Clear out all outgoing data in the circular buffer */
 
-  priv->serdev.xmit.head = 0;
-  priv->serdev.xmit.tail = 0;
+  uart_buffer_reset(&priv->serdev.xmit);
   leave_critical_section(flags);
 
   /* Perform the soft connect function so that we will we can be
@@ -2462,23 +2409,9 @@ static int cdcuart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
     case FIONREAD:
       {
-        int count;
-        irqstate_t flags = enter_critical_section();
-
         /* Determine the number of bytes available in the RX buffer. */
 
-        if (serdev->recv.tail <= serdev->recv.head)
-          {
-            count = serdev->recv.head - serdev->recv.tail;
-          }
-        else
-          {
-            count = serdev->recv.size - (serdev->recv.tail - serdev->recv.head);
-          }
-
-        leave_critical_section(flags);
-
-        *(int *)arg = count;
+        *(int *)arg = uart_buffer_used(&serdev->recv);
         ret = 0;
       }
       break;
@@ -2487,23 +2420,9 @@ static int cdcuart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
     case FIONWRITE:
       {
-        int count;
-        irqstate_t flags = enter_critical_section();
-
         /* Determine the number of bytes waiting in the TX buffer. */
 
-        if (serdev->xmit.tail <= serdev->xmit.head)
-          {
-            count = serdev->xmit.head - serdev->xmit.tail;
-          }
-        else
-          {
-            count = serdev->xmit.size - (serdev->xmit.tail - serdev->xmit.head);
-          }
-
-        leave_critical_section(flags);
-
-        *(int *)arg = count;
+        *(int *)arg = uart_buffer_used(&serdev->xmit);
         ret = 0;
       }
       break;
@@ -2512,23 +2431,9 @@ static int cdcuart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
     case FIONSPACE:
       {
-        int count;
-        irqstate_t flags = enter_critical_section();
-
         /* Determine the number of bytes free in the TX buffer */
 
-        if (serdev->xmit.head < serdev->xmit.tail)
-          {
-            count = serdev->xmit.tail - serdev->xmit.head - 1;
-          }
-        else
-          {
-            count = serdev->xmit.size - (serdev->xmit.head - serdev->xmit.tail) - 1;
-          }
-
-        leave_critical_section(flags);
-
-        *(int *)arg = count;
+        *(int *)arg = uart_buffer_space(&serdev->xmit);
         ret = 0;
       }
       break;
@@ -2813,10 +2718,10 @@ static void cdcuart_txint(FAR struct uart_dev_s *dev, bool enable)
    * send the next packet now.
    */
 
-  uinfo("enable=%d head=%d tail=%d\n",
-        enable, priv->serdev.xmit.head, priv->serdev.xmit.tail);
+  uinfo("enable=%d used=%u\n",
+        enable, uart_buffer_used(&priv->serdev.xmit));
 
-  if (enable && priv->serdev.xmit.head != priv->serdev.xmit.tail)
+  if (enable && uart_buffer_used(&priv->serdev.xmit) > 0)
     {
       cdcacm_sndpacket(priv);
     }
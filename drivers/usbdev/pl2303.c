@@ -261,7 +261,7 @@ struct pl2303_dev_s
   uint8_t nrdq;                       /* Number of queue read requests (in epbulkout) */
   bool    rxenabled;                  /* true: UART RX "interrupts" enabled */
   uint8_t linest[7];                  /* Fake line status */
-  int16_t rxhead;                     /* Working head; used when rx int disabled */
+  int16_t rxpending;                  /* Bytes received while rx int disabled */
 
   FAR struct usbdev_ep_s  *epintin;   /* Interrupt IN endpoint structure */
   FAR struct usbdev_ep_s  *epbulkin;  /* Bulk IN endpoint structure */
@@ -542,24 +542,13 @@ static uint16_t usbclass_fillrequest(FAR struct pl2303_dev_s *priv, uint8_t *req
 
   /* Transfer bytes while we have bytes available and there is room in the request */
 
-  while (xmit->head != xmit->tail && nbytes < reqlen)
-    {
-      *reqbuf++ = xmit->buffer[xmit->tail];
-      nbytes++;
-
-      /* Increment the tail pointer */
-
-      if (++(xmit->tail) >= xmit->size)
-        {
-          xmit->tail = 0;
-        }
-    }
+  nbytes = uart_buffer_get(xmit, (FAR char *)reqbuf, reqlen);
 
   /* When all of the characters have been sent from the buffer
    * disable the "TX interrupt".
    */
 
-  if (xmit->head == xmit->tail)
+  if (uart_buffer_used(xmit) == 0)
     {
       uart_disabletxint(serdev);
     }
@@ -617,8 +606,8 @@ static int usbclass_sndpacket(FAR struct pl2303_dev_s *priv)
    * to be sent).
    */
 
-  uinfo("head=%d tail=%d nwrq=%d empty=%d\n",
-        priv->serdev.xmit.head, priv->serdev.xmit.tail,
+  uinfo("used=%u nwrq=%d empty=%d\n",
+        uart_buffer_used(&priv->serdev.xmit),
         priv->nwrq, sq_empty(&priv->reqlist));
 
   /* Get the maximum number of bytes that will fit into one bulk IN request */
@@ -682,73 +671,53 @@ static inline int usbclass_recvpacket(FAR struct pl2303_dev_s *priv,
 {
   FAR uart_dev_t *serdev = &priv->serdev;
   FAR struct uart_buffer_s *recv = &serdev->recv;
-  uint16_t currhead;
-  uint16_t nexthead;
+  FAR char *head;
+  unsigned int offset;
+  unsigned int nfree;
   uint16_t nbytes = 0;
 
-  /* Get the next head index. During the time that RX interrupts are disabled, the
-   * the serial driver will be extracting data from the circular buffer and modifying
-   * recv.tail.  During this time, we should avoid modifying recv.head; Instead we will
-   * use a shadow copy of the index.  When interrupts are restored, the real recv.head
-   * will be updated with this indes.
-   */
-
-  if (priv->rxenabled)
-    {
-      currhead = recv->head;
-    }
-  else
-    {
-      currhead = priv->rxhead;
-    }
-
-  /* Pre-calculate the head index and check for wrap around.  We need to do this
-   * so that we can determine if the circular buffer will overrun BEFORE we
-   * overrun the buffer!
+  /* Find where the new data goes.  During the time that RX interrupts are
+   * disabled, the serial driver will be extracting data from the circular
+   * buffer.  During this time, we should avoid publishing new data; Instead we
+   * add it behind the published data and count it in priv->rxpending.  When
+   * interrupts are restored, the pending data will be committed.
    */
 
-  nexthead = currhead + 1;
-  if (nexthead >= recv->size)
-    {
-      nexthead = 0;
-    }
+  (void)uart_buffer_reserve(recv, &head);
+  offset = head - recv->buffer + priv->rxpending;
+  nfree  = uart_buffer_space(recv) - priv->rxpending;
 
   /* Then copy data into the RX buffer until either: (1) all of the data has been
    * copied, or (2) the RX buffer is full.  NOTE:  If the RX buffer becomes full,
    * then we have overrun the serial driver and data will be lost.
    */
 
-  while (nexthead != recv->tail && nbytes < reqlen)
+  while (nbytes < nfree && nbytes < reqlen)
     {
-      /* Copy one byte to the head of the circular RX buffer */
+      /* Check for wrap around */
 
-      recv->buffer[currhead] = *reqbuf++;
+      if (offset >= recv->size)
+        {
+          offset -= recv->size;
+        }
 
-      /* Update counts and indices */
+      /* Copy one byte to the head of the circular RX buffer */
 
-      currhead = nexthead;
+      recv->buffer[offset++] = *reqbuf++;
       nbytes++;
-
-      /* Increment the head index and check for wrap around */
-
-      nexthead = currhead + 1;
-      if (nexthead >= recv->size)
-        {
-          nexthead = 0;
-        }
     }
 
-  /* Write back the head pointer using the shadow index if RX "interrupts"
-   * are disabled.
+  /* Commit the new data or add it to the pending data if RX "interrupts" are
+   * disabled.
    */
 
   if (priv->rxenabled)
     {
-      recv->head = currhead;
+      uart_buffer_commit(recv, nbytes);
     }
   else
     {
-      priv->rxhead = currhead;
+      priv->rxpending += nbytes;
     }
 
   /* If data was added to the incoming serial buffer, then wake up any
@@ -1591,8 +1560,7 @@ static void usbclass_unbind(FAR struct usbdevclass_driver_s *driver,
 
   /* Clear out all data in the circular buffer */
 
-  priv->serdev.xmit.head = 0;
-  priv->serdev.xmit.tail = 0;
+  uart_buffer_reset(&priv->serdev.xmit);
 }
 
 /****************************************************************************
@@ -1912,9 +1880,8 @@ static void usbclass_disconnect(FAR struct usbdevclass_driver_s *driver,
 
   /* Clear out all outgoing data in the circular buffer */
 
-  priv->serdev.xmit.head = 0;
-  priv->serdev.xmit.tail = 0;
-  priv->rxhead = 0;
+  uart_buffer_reset(&priv->serdev.xmit);
+  priv->rxpending = 0;
   leave_critical_section(flags);
 
   /* Perform the soft connect function so that we will we can be
@@ -2148,15 +2115,16 @@ static void usbser_rxint(FAR struct uart_dev_s *dev, bool enable)
         {
           /* Yes.  During the time that RX interrupts are disabled, the
            * the serial driver will be extracting data from the circular
-           * buffer and modifying recv.tail.  During this time, we
-           * should avoid modifying recv.head; When interrupts are restored,
-           * we can update the head pointer for all of the data that we
-           * put into cicular buffer while "interrupts" were disabled.
+           * buffer.  During this time, we should avoid publishing new data;
+           * When interrupts are restored, we can commit all of the data
+           * that we put into cicular buffer while "interrupts" were
+           * disabled.
            */
 
-          if (priv->rxhead != serdev->recv.head)
+          if (priv->rxpending > 0)
             {
-              serdev->recv.head = priv->rxhead;
+              uart_buffer_commit(&serdev->recv, priv->rxpending);
+              priv->rxpending = 0;
 
               /* Yes... signal the availability of new data */
 
@@ -2177,13 +2145,12 @@ static void usbser_rxint(FAR struct uart_dev_s *dev, bool enable)
     {
       /* Yes.  During the time that RX interrupts are disabled, the
        * the serial driver will be extracting data from the circular
-       * buffer and modifying recv.tail.  During this time, we
-       * should avoid modifying recv.head; When interrupts are disabled,
-       * we use a shadow index and continue adding data to the circular
-       * buffer.
+       * buffer.  During this time, we should avoid publishing new data;
+       * When interrupts are disabled, we count the pending data and
+       * continue adding data to the circular buffer.
        */
 
-      priv->rxhead    = serdev->recv.head;
+      priv->rxpending = 0;
       priv->rxenabled = false;
     }
   leave_critical_section(flags);
@@ -2227,10 +2194,10 @@ static void usbser_txint(FAR struct uart_dev_s *dev, bool enable)
    * send the next packet now.
    */
 
-  uinfo("enable=%d head=%d tail=%d\n",
-        enable, priv->serdev.xmit.head, priv->serdev.xmit.tail);
+  uinfo("enable=%d used=%u\n",
+        enable, uart_buffer_used(&priv->serdev.xmit));
 
-  if (enable && priv->serdev.xmit.head != priv->serdev.xmit.tail)
+  if (enable && uart_buffer_used(&priv->serdev.xmit) > 0)
     {
       usbclass_sndpacket(priv);
     }
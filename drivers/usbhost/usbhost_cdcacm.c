@@ -899,7 +899,6 @@ static void usbhost_txdata_work(FAR void *arg)
   FAR struct uart_buffer_s *txbuf;
   ssize_t nwritten;
   int txndx;
-  int txtail;
   int ret;
 
   priv = (FAR struct usbhost_cdcacm_s *)arg;
@@ -922,34 +921,17 @@ static void usbhost_txdata_work(FAR void *arg)
 
   /* Loop until The UART TX buffer is empty (or we become disconnected) */
 
-  txtail = txbuf->tail;
-  txndx  = 0;
+  txndx = 0;
 
-  while (txtail != txbuf->head && priv->txena && !priv->disconnected)
+  while (uart_buffer_used(txbuf) > 0 && priv->txena && !priv->disconnected)
     {
       /* Copy data from the UART TX buffer until either 1) the UART TX
-       * buffer has been emptied, or 2) the Bulk OUT buffer is full.
+       * buffer has been emptied, or 2) the Bulk OUT buffer is full.  The
+       * copied data is removed so that it cannot be sent again.
        */
 
-      txndx = 0;
-      while (txtail != txbuf->head && txndx < priv->pktsize)
-        {
-          /* Copy the next byte */
-
-          priv->outbuf[txndx] = txbuf->buffer[txtail];
-
-          /* Increment counters and indices */
-
-          txndx++;
-          if (++txtail >= txbuf->size)
-            {
-             txtail = 0;
-            }
-        }
-
-      /* Save the updated tail pointer so that it cannot be sent again */
-
-      txbuf->tail = txtail;
+      txndx = uart_buffer_get(txbuf, (FAR char *)priv->outbuf,
+                              priv->pktsize);
 
       /* Bytes were removed from the TX buffer.  Inform any waiters that
        * there is space available in the TX buffer.
@@ -1037,7 +1019,6 @@ static void usbhost_rxdata_work(FAR void *arg)
   FAR struct uart_buffer_s *rxbuf;
   ssize_t nread;
   int nxfrd;
-  int nexthead;
   int rxndx;
   int ret;
 
@@ -1057,17 +1038,6 @@ static void usbhost_rxdata_work(FAR void *arg)
   rxndx    = priv->rxndx;
   nxfrd    = 0;
 
-  /* Get the index to the value of the UART RX buffer head AFTER the
-   * first character has been stored.  We need to know this in order
-   * to test if the UART RX buffer is full.
-   */
-
-  nexthead = rxbuf->head + 1;
-  if (nexthead >= rxbuf->size)
-    {
-      nexthead = 0;
-    }
-
   /* Loop until either:
    *
    * 1. The UART RX buffer is full
@@ -1083,7 +1053,7 @@ static void usbhost_rxdata_work(FAR void *arg)
     {
       /* Stop now if there is no room for another character in the RX buffer. */
 
-      if (nexthead == rxbuf->tail)
+      if (uart_buffer_space(rxbuf) == 0)
         {
           /* Break out of the loop, rescheduling the work */
 
@@ -1131,23 +1101,14 @@ static void usbhost_rxdata_work(FAR void *arg)
 
       /* Transfer one byte from the RX packet buffer into UART RX buffer */
 
-      rxbuf->buffer[rxbuf->head] = priv->inbuf[rxndx];
+      (void)uart_buffer_put(rxbuf, (FAR const char *)&priv->inbuf[rxndx], 1);
       nxfrd++;
 
-      /* Save the updated indices */
-
-      rxbuf->head = nexthead;
-      priv->rxndx = rxndx;
-
-      /* Update the head point for for the next pass through the loop
-       * handling. If nexthead incremented to rxbuf->tail, then the
-       * RX buffer will and we will exit the loop at the top.
+      /* Save the updated index.  If the RX buffer is now full, we will
+       * exit the loop at the top.
        */
 
-      if (++nexthead >= rxbuf->size)
-        {
-           nexthead = 0;
-        }
+      priv->rxndx = rxndx;
 
       /* Increment the index in the USB IN packet buffer.  If the
        * index becomes equal to the number of bytes in the buffer, then
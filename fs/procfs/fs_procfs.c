@@ -76,8 +76,12 @@
 
 extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
+extern const struct procfs_operations iobinfo_operations;
 extern const struct procfs_operations kmm_operations;
+extern const struct procfs_operations mempool_operations;
+extern const struct procfs_operations migrate_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations spinlock_operations;
 extern const struct procfs_operations uptime_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
@@ -121,10 +125,22 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "cpuload",       &cpuload_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_IOB_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  { "iobinfo",       &iobinfo_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MM_KERNEL_HEAP) && !defined(CONFIG_FS_PROCFS_EXCLUDE_KMM)
   { "kmm",           &kmm_operations,             PROCFS_FILE_TYPE   },
 #endif
 
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL
+  { "mempool",       &mempool_operations,         PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_SMP_LOADBALANCE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MIGRATION)
+  { "migration",     &migrate_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MODULE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -150,6 +166,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "partitions",    &part_procfsoperations,      PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SPINLOCK_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SPINLOCKS)
+  { "spinlocks",     &spinlock_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
   { "uptime",        &uptime_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -66,10 +66,23 @@
  * Pre-processor Definitions
  ****************************************************************************/
 /* Determines the size of an intermediate buffer that must be large enough
- * to handle the longest line generated by this logic.
+ * to handle the longest line generated by this logic.  With precise CPU
+ * time accounting, a line with the idle and interrupt time of each CPU
+ * follows.
  */
 
-#define CPULOAD_LINELEN 16
+#ifdef CONFIG_SMP
+#  define CPULOAD_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define CPULOAD_NCPUS 1
+#endif
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+#  define CPUSTAT_LINELEN 56
+#  define CPULOAD_LINELEN (16 + CPULOAD_NCPUS * CPUSTAT_LINELEN)
+#else
+#  define CPULOAD_LINELEN 16
+#endif
 
 /****************************************************************************
  * Private Types
@@ -226,6 +239,9 @@ static ssize_t cpuload_read(FAR struct file *filep, FAR char *buffer,
       struct cpuload_s cpuload;
       uint32_t intpart;
       uint32_t fracpart;
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+      int cpu;
+#endif
 
       /* Sample the counts for the IDLE thread.  clock_cpuload should only
        * fail if the PID is not valid.  This, however, should never happen
@@ -255,6 +271,28 @@ static ssize_t cpuload_read(FAR struct file *filep, FAR char *buffer,
       linesize = snprintf(attr->line, CPULOAD_LINELEN, "%3d.%01d%%",
                           intpart, fracpart);
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+      /* Then the time that each CPU has spent idle and in interrupt
+       * handlers.
+       */
+
+      for (cpu = 0; cpu < CPULOAD_NCPUS; cpu++)
+        {
+          struct cpustat_s cpustat;
+
+          DEBUGVERIFY(clock_cpustat(cpu, &cpustat));
+
+          linesize += snprintf(&attr->line[linesize],
+                               CPULOAD_LINELEN - linesize,
+                               "\nCPU%d: idle %lu.%06lu irq %lu.%06lu",
+                               cpu,
+                               (unsigned long)(cpustat.idle / USEC_PER_SEC),
+                               (unsigned long)(cpustat.idle % USEC_PER_SEC),
+                               (unsigned long)(cpustat.irq / USEC_PER_SEC),
+                               (unsigned long)(cpustat.irq % USEC_PER_SEC));
+        }
+#endif
+
       /* Save the linesize in case we are re-entered with f_pos > 0 */
 
       attr->linesize = linesize;
@@ -73,6 +73,16 @@
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_MM_ACCOUNTING
+/* This structure holds the histogram of free chunks by size class */
+
+struct kmm_freehist_s
+{
+  size_t nbytes[MM_NNODES];       /* Total size of the free chunks */
+  unsigned int nchunks[MM_NNODES]; /* Number of free chunks */
+};
+#endif
+
 /* This structure describes one open "file" */
 
 struct kmm_file_s
@@ -86,6 +96,13 @@ struct kmm_file_s
  * Private Function Prototypes
  ****************************************************************************/
 
+/* Helpers */
+
+#ifdef CONFIG_MM_ACCOUNTING
+static int     kmm_freechunk(FAR struct mm_allocnode_s *node,
+                 FAR void *arg);
+#endif
+
 /* File system methods */
 
 static int     kmm_open(FAR struct file *filep, FAR const char *relpath,
@@ -128,6 +145,37 @@ const struct procfs_operations kmm_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: kmm_freechunk
+ *
+ * Description:
+ *   mm_foreach() callback that adds each free chunk to the histogram.  The
+ *   size classes are powers of two, like the free lists of the best-fit
+ *   allocator.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_ACCOUNTING
+static int kmm_freechunk(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct kmm_freehist_s *hist = (FAR struct kmm_freehist_s *)arg;
+  size_t ngran;
+  int ndx;
+
+  if ((node->preceding & MM_ALLOC_BIT) == 0)
+    {
+      for (ndx = 0, ngran = node->size >> MM_MIN_SHIFT;
+           ngran > 1 && ndx < MM_NNODES - 1;
+           ndx++, ngran >>= 1);
+
+      hist->nchunks[ndx]++;
+      hist->nbytes[ndx] += node->size;
+    }
+
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Name: kmm_open
  ****************************************************************************/
@@ -203,6 +251,11 @@ static ssize_t kmm_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct kmm_file_s *procfile;
   struct mallinfo mem;
+#ifdef CONFIG_MM_ACCOUNTING
+  struct kmm_freehist_s hist;
+  int ndx;
+#endif
+  size_t remaining;
   size_t linesize;
   size_t copysize;
   size_t totalsize;
@@ -225,11 +278,11 @@ static ssize_t kmm_read(FAR struct file *filep, FAR char *buffer,
   copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
                             &offset);
   totalsize = copysize;
+  remaining = buflen - copysize;
 
-  if (totalsize < buflen)
+  if (remaining > 0)
     {
       buffer += copysize;
-      buflen -= copysize;
 
       /* The second line is the memory data */
 
@@ -243,11 +296,53 @@ static ssize_t kmm_read(FAR struct file *filep, FAR char *buffer,
                             "Mem:   %11d%11d%11d%11d\n",
                             mem.arena, mem.uordblks, mem.fordblks,
                             mem.mxordblk);
-      copysize   = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining,
                                  &offset);
       totalsize += copysize;
+      remaining -= copysize;
     }
 
+#ifdef CONFIG_MM_ACCOUNTING
+  /* Then the histogram of free chunks.  Only non-empty size classes are
+   * shown.
+   */
+
+  if (remaining > 0)
+    {
+      buffer    += copysize;
+
+      linesize   = snprintf(procfile->line, KMM_LINELEN,
+                            "\n    chunk size     nfree      bytes\n");
+      copysize   = procfs_memcpy(procfile->line, linesize, buffer, remaining,
+                                 &offset);
+      totalsize += copysize;
+      remaining -= copysize;
+
+      memset(&hist, 0, sizeof(struct kmm_freehist_s));
+      (void)mm_foreach(&g_kmmheap, kmm_freechunk, &hist);
+
+      for (ndx = 0; ndx < MM_NNODES && remaining > 0; ndx++)
+        {
+          if (hist.nchunks[ndx] == 0)
+            {
+              continue;
+            }
+
+          buffer    += copysize;
+
+          linesize   = snprintf(procfile->line, KMM_LINELEN,
+                                "%13lu+%10u%11lu\n",
+                                (unsigned long)1 << (ndx + MM_MIN_SHIFT),
+                                hist.nchunks[ndx],
+                                (unsigned long)hist.nbytes[ndx]);
+          copysize   = procfs_memcpy(procfile->line, linesize, buffer,
+                                     remaining, &offset);
+          totalsize += copysize;
+          remaining -= copysize;
+        }
+    }
+#endif
+
   /* Update the file offset */
 
   filep->f_pos += totalsize;
@@ -0,0 +1,365 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsmempool.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define MEMPOOL_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct mempool_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[MEMPOOL_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure carries the state of one read() through mempool_foreach() */
+
+struct mempool_read_s
+{
+  FAR struct mempool_file_s *procfile; /* The open file */
+  FAR char *buffer;               /* Next location in the user buffer */
+  size_t buflen;                  /* Remaining space in the user buffer */
+  size_t totalsize;               /* Number of bytes returned so far */
+  off_t offset;                   /* Bytes of output still to be skipped */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Helpers */
+
+static int     mempool_line(FAR const struct mempoolinfo_s *info,
+                 FAR void *arg);
+
+/* File system methods */
+
+static int     mempool_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     mempool_close(FAR struct file *filep);
+static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     mempool_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     mempool_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations mempool_operations =
+{
+  mempool_open,   /* open */
+  mempool_close,  /* close */
+  mempool_read,   /* read */
+  NULL,           /* write */
+  mempool_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  mempool_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_line
+ *
+ * Description:
+ *   mempool_foreach() callback that generates the line for one pool.
+ *
+ ****************************************************************************/
+
+static int mempool_line(FAR const struct mempoolinfo_s *info, FAR void *arg)
+{
+  FAR struct mempool_read_s *state = (FAR struct mempool_read_s *)arg;
+  FAR struct mempool_file_s *procfile = state->procfile;
+  size_t linesize;
+  size_t copysize;
+
+  linesize = snprintf(procfile->line, MEMPOOL_LINELEN,
+                      "%-12s %6lu %6u %6u %6u %6u %10lu %6lu\n",
+                      info->name != NULL ? info->name : "-",
+                      (unsigned long)info->bsize, info->ntotal, info->nfree,
+                      info->npeak, info->nreserve,
+                      (unsigned long)info->nalloc,
+                      (unsigned long)info->nfail);
+  copysize = procfs_memcpy(procfile->line, linesize, state->buffer,
+                           state->buflen, &state->offset);
+
+  state->buffer    += copysize;
+  state->buflen    -= copysize;
+  state->totalsize += copysize;
+
+  /* Stop the traversal when the user buffer is full */
+
+  return state->buflen > 0 ? 0 : 1;
+}
+
+/****************************************************************************
+ * Name: mempool_open
+ ****************************************************************************/
+
+static int mempool_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct mempool_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "mempool" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "mempool") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct mempool_file_s *)
+    kmm_zalloc(sizeof(struct mempool_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_close
+ ****************************************************************************/
+
+static int mempool_close(FAR struct file *filep)
+{
+  FAR struct mempool_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct mempool_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_read
+ ****************************************************************************/
+
+static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct mempool_file_s *procfile;
+  struct mempool_read_s state;
+  size_t linesize;
+  size_t copysize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct mempool_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  state.procfile = procfile;
+  state.offset   = filep->f_pos;
+
+  /* The first line is the headers */
+
+  linesize  = snprintf(procfile->line, MEMPOOL_LINELEN,
+                       "%-12s %6s %6s %6s %6s %6s %10s %6s\n",
+                       "name", "bsize", "total", "free", "peak", "rsrv",
+                       "nalloc", "nfail");
+  copysize  = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                            &state.offset);
+
+  state.buffer    = buffer + copysize;
+  state.buflen    = buflen - copysize;
+  state.totalsize = copysize;
+
+  /* Then one line for each pool */
+
+  if (state.buflen > 0)
+    {
+      (void)mempool_foreach(mempool_line, &state);
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += state.totalsize;
+  return state.totalsize;
+}
+
+/****************************************************************************
+ * Name: mempool_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int mempool_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct mempool_file_s *oldattr;
+  FAR struct mempool_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct mempool_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct mempool_file_s *)
+    kmm_malloc(sizeof(struct mempool_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct mempool_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int mempool_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "mempool" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "mempool") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "mempool" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#endif /* CONFIG_FS_PROCFS && !CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL */
@@ -57,6 +57,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mm.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
 #include <nuttx/fs/dirent.h>
@@ -87,7 +88,11 @@
  * to handle the longest line generated by this logic.
  */
 
-#define STATUS_LINELEN 32
+#ifdef CONFIG_MM_ACCOUNTING
+#  define STATUS_LINELEN 64
+#else
+#  define STATUS_LINELEN 32
+#endif
 
 /****************************************************************************
  * Private Type Definitions
@@ -103,8 +108,14 @@ enum proc_node_e
   PROC_CMDLINE,                       /* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
   PROC_LOADAVG,                       /* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  PROC_STAT,                          /* Task/thread CPU time */
 #endif
   PROC_STACK,                         /* Task stack info */
+#ifdef CONFIG_MM_ACCOUNTING
+  PROC_HEAP,                          /* Task heap usage */
+#endif
   PROC_GROUP,                         /* Group directory */
   PROC_GROUP_STATUS,                  /* Task group status */
   PROC_GROUP_FD                       /* Group file descriptors */
@@ -132,6 +143,23 @@ struct proc_file_s
   char line[STATUS_LINELEN];          /* Pre-allocated buffer for formatted lines */
 };
 
+#ifdef CONFIG_MM_ACCOUNTING
+/* This structure carries the state of one read of the heap file through
+ * mm_foreach().
+ */
+
+struct proc_heap_s
+{
+  FAR struct proc_file_s *procfile;   /* The open file */
+  FAR char *buffer;                   /* Next location in the user buffer */
+  size_t remaining;                   /* Remaining space in the user buffer */
+  size_t totalsize;                   /* Number of bytes returned so far */
+  off_t offset;                       /* Bytes of output still to skip */
+  size_t nbytes;                      /* Total size of the owned chunks */
+  unsigned int nchunks;               /* Number of owned chunks */
+};
+#endif
+
 /* This structure describes one open "directory" */
 
 struct proc_dir_s
@@ -145,10 +173,25 @@ struct proc_dir_s
  * Private Data
  ****************************************************************************/
 
-static FAR const char *g_policy[4] =
+static FAR const char *g_policy[5] =
 {
-  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_OTHER"
+  "SCHED_FIFO", "SCHED_RR", "SCHED_SPORADIC", "SCHED_OTHER", "SCHED_DEADLINE"
+};
+
+#ifdef CONFIG_MM_ACCOUNTING
+/* These are the heaps whose chunks are attributed to tasks */
+
+static FAR struct mm_heap_s * const g_procheaps[] =
+{
+#ifdef CONFIG_BUILD_FLAT
+  &g_mmheap,      /* The single, user heap */
+#endif
+#ifdef CONFIG_MM_KERNEL_HEAP
+  &g_kmmheap,     /* The kernel heap */
+#endif
 };
+#define PROC_NHEAPS (sizeof(g_procheaps)/sizeof(FAR struct mm_heap_s *))
+#endif
 
 /****************************************************************************
  * Private Function Prototypes
@@ -168,9 +211,23 @@ static ssize_t proc_loadavg(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+static ssize_t proc_cputime(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
+#ifdef CONFIG_MM_ACCOUNTING
+static int     proc_heapcount(FAR struct mm_allocnode_s *node,
+                 FAR void *arg);
+static int     proc_heapchunk(FAR struct mm_allocnode_s *node,
+                 FAR void *arg);
+static ssize_t proc_heap(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_groupstatus(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
@@ -250,11 +307,25 @@ static const struct proc_node_s g_loadavg =
 };
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+static const struct proc_node_s g_cputime =
+{
+  "stat",         "stat",    (uint8_t)PROC_STAT,         DTYPE_FILE        /* Task/thread CPU time */
+};
+#endif
+
 static const struct proc_node_s g_stack =
 {
   "stack",        "stack",   (uint8_t)PROC_STACK,        DTYPE_FILE        /* Task stack info */
 };
 
+#ifdef CONFIG_MM_ACCOUNTING
+static const struct proc_node_s g_heap =
+{
+  "heap",         "heap",    (uint8_t)PROC_HEAP,         DTYPE_FILE        /* Task heap usage */
+};
+#endif
+
 static const struct proc_node_s g_group =
 {
   "group",        "group",   (uint8_t)PROC_GROUP,        DTYPE_DIRECTORY   /* Group directory */
@@ -278,8 +349,14 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
   &g_cmdline,      /* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
   &g_loadavg,      /* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  &g_cputime,      /* Task/thread CPU time */
 #endif
   &g_stack,        /* Task stack info */
+#ifdef CONFIG_MM_ACCOUNTING
+  &g_heap,         /* Task heap usage */
+#endif
   &g_group,        /* Group directory */
   &g_groupstatus,  /* Task group status */
   &g_groupfd       /* Group file descriptors */
@@ -294,8 +371,14 @@ static const struct proc_node_s * const g_level0info[] =
   &g_cmdline,      /* Task command line */
 #ifdef CONFIG_SCHED_CPULOAD
   &g_loadavg,      /* Average CPU utilization */
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  &g_cputime,      /* Task/thread CPU time */
 #endif
   &g_stack,        /* Task stack info */
+#ifdef CONFIG_MM_ACCOUNTING
+  &g_heap,         /* Task heap usage */
+#endif
   &g_group,        /* Group directory */
 };
 #define PROC_NLEVEL0NODES (sizeof(g_level0info)/sizeof(FAR const struct proc_node_s * const))
@@ -702,6 +785,34 @@ static ssize_t proc_loadavg(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_cputime
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+static ssize_t proc_cputime(FAR struct proc_file_s *procfile,
+                            FAR struct tcb_s *tcb, FAR char *buffer,
+                            size_t buflen, off_t offset)
+{
+  struct cpuload_s cpuload;
+  size_t linesize;
+  size_t copysize;
+
+  /* Get the total run time of the thread in microseconds */
+
+  cpuload.runtime = 0;
+  (void)clock_cpuload(procfile->pid, &cpuload);
+
+  linesize = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu.%06lu\n",
+                      "RunTime:",
+                      (unsigned long)(cpuload.runtime / USEC_PER_SEC),
+                      (unsigned long)(cpuload.runtime % USEC_PER_SEC));
+  copysize = procfs_memcpy(procfile->line, linesize, buffer, buflen, &offset);
+
+  return copysize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -763,6 +874,135 @@ static ssize_t proc_stack(FAR struct proc_file_s *procfile,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: proc_heapcount
+ *
+ * Description:
+ *   mm_foreach() callback that sums the chunks owned by the task.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_ACCOUNTING
+static int proc_heapcount(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct proc_heap_s *heapinfo = (FAR struct proc_heap_s *)arg;
+
+  if ((node->preceding & MM_ALLOC_BIT) != 0 &&
+      node->pid == heapinfo->procfile->pid)
+    {
+      heapinfo->nchunks++;
+      heapinfo->nbytes += node->size;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: proc_heapchunk
+ *
+ * Description:
+ *   mm_foreach() callback that generates one line for each chunk owned by
+ *   the task.
+ *
+ ****************************************************************************/
+
+static int proc_heapchunk(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct proc_heap_s *heapinfo = (FAR struct proc_heap_s *)arg;
+  FAR struct proc_file_s *procfile = heapinfo->procfile;
+  size_t linesize;
+  size_t copysize;
+
+  if ((node->preceding & MM_ALLOC_BIT) != 0 &&
+      node->pid == procfile->pid)
+    {
+      linesize = snprintf(procfile->line, STATUS_LINELEN,
+                          "%p %8lu %p\n",
+                          (FAR char *)node + SIZEOF_MM_ALLOCNODE,
+                          (unsigned long)node->size, node->caller);
+      copysize = procfs_memcpy(procfile->line, linesize, heapinfo->buffer,
+                               heapinfo->remaining, &heapinfo->offset);
+
+      heapinfo->totalsize += copysize;
+      heapinfo->buffer    += copysize;
+      heapinfo->remaining -= copysize;
+    }
+
+  /* Stop the traversal when the user buffer is full */
+
+  return heapinfo->remaining > 0 ? 0 : 1;
+}
+
+/****************************************************************************
+ * Name: proc_heap
+ *
+ * Description:
+ *   Show the number and total size of the heap chunks allocated by the
+ *   task, followed by the address, chunk size (including the chunk
+ *   header), and caller of each chunk.
+ *
+ ****************************************************************************/
+
+static ssize_t proc_heap(FAR struct proc_file_s *procfile,
+                         FAR struct tcb_s *tcb, FAR char *buffer,
+                         size_t buflen, off_t offset)
+{
+  struct proc_heap_s heapinfo;
+  size_t linesize;
+  size_t copysize;
+  int i;
+
+  memset(&heapinfo, 0, sizeof(struct proc_heap_s));
+  heapinfo.procfile  = procfile;
+  heapinfo.buffer    = buffer;
+  heapinfo.remaining = buflen;
+  heapinfo.offset    = offset;
+
+  /* Count the chunks owned by the task */
+
+  for (i = 0; i < PROC_NHEAPS; i++)
+    {
+      (void)mm_foreach(g_procheaps[i], proc_heapcount, &heapinfo);
+    }
+
+  /* Show the number of chunks */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%u\n",
+                        "Chunks:", heapinfo.nchunks);
+  copysize   = procfs_memcpy(procfile->line, linesize, heapinfo.buffer,
+                             heapinfo.remaining, &heapinfo.offset);
+
+  heapinfo.totalsize += copysize;
+  heapinfo.buffer    += copysize;
+  heapinfo.remaining -= copysize;
+
+  if (heapinfo.totalsize >= buflen)
+    {
+      return heapinfo.totalsize;
+    }
+
+  /* Show the total size of the chunks */
+
+  linesize   = snprintf(procfile->line, STATUS_LINELEN, "%-12s%lu\n",
+                        "Bytes:", (unsigned long)heapinfo.nbytes);
+  copysize   = procfs_memcpy(procfile->line, linesize, heapinfo.buffer,
+                             heapinfo.remaining, &heapinfo.offset);
+
+  heapinfo.totalsize += copysize;
+  heapinfo.buffer    += copysize;
+  heapinfo.remaining -= copysize;
+
+  /* Then show each chunk */
+
+  for (i = 0; i < PROC_NHEAPS && heapinfo.remaining > 0; i++)
+    {
+      (void)mm_foreach(g_procheaps[i], proc_heapchunk, &heapinfo);
+    }
+
+  return heapinfo.totalsize;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_groupstatus
  ****************************************************************************/
@@ -1175,11 +1415,22 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
     case PROC_LOADAVG: /* Average CPU utilization */
       ret = proc_loadavg(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+    case PROC_STAT: /* Task/thread CPU time */
+      ret = proc_cputime(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
 #endif
     case PROC_STACK: /* Task stack info */
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
 
+#ifdef CONFIG_MM_ACCOUNTING
+    case PROC_HEAP: /* Task heap usage */
+      ret = proc_heap(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
+#endif
+
     case PROC_GROUP_STATUS: /* Task group status */
       ret = proc_groupstatus(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
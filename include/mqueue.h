@@ -50,6 +50,12 @@
 
 #define MQ_NONBLOCK O_NONBLOCK
 
+/* Non-standard mq_flags attribute:  Create a message queue that passes buffers
+ * by reference (see mq_sendbuf() and mq_receivebuf()).
+ */
+
+#define MQ_ZEROCOPY (1 << 12)
+
 /********************************************************************************
  * Public Type Declarations
  ********************************************************************************/
@@ -98,6 +104,13 @@ int     mq_setattr(mqd_t mqdes, FAR const struct mq_attr *mq_stat,
                    FAR struct mq_attr *oldstat);
 int     mq_getattr(mqd_t mqdes, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/* Non-standard zero-copy interfaces */
+
+int     mq_sendbuf(mqd_t mqdes, FAR void *buf, size_t buflen, int prio);
+ssize_t mq_receivebuf(mqd_t mqdes, FAR void **buf, FAR int *prio);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
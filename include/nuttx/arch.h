@@ -451,6 +451,11 @@ void up_release_pending(void);
  *      the priority of the current, running task and it now has the
  *      priority.
  *
+ *   The new priority may be the same as the current priority.  The task
+ *   must still be removed from and added back to the ready-to-run list;
+ *   sched_requeue() relies on this to move a task within the ready-to-run
+ *   lists.
+ *
  *   This function is called only from the NuttX scheduling
  *   logic.  Interrupts will always be disabled when this
  *   function is called.
@@ -1889,6 +1894,27 @@ int up_cpu_paused(int cpu);
 int up_cpu_resume(int cpu);
 #endif
 
+/****************************************************************************
+ * Name: up_cpu_resched
+ *
+ * Description:
+ *   Send a reschedule inter-processor interrupt to the specified CPU.  The
+ *   interrupt handler on that CPU must call sched_process_resched().
+ *   Unlike up_cpu_pause(), this function does not wait for the other CPU
+ *   to respond.  The target may be the current CPU.
+ *
+ * Input Parameters:
+ *   cpu - The index of the CPU to be signaled.
+ *
+ * Returned Value:
+ *   Zero on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_RESCHED_IPI
+int up_cpu_resched(int cpu);
+#endif
+
 /****************************************************************************
  * Name: up_romgetc
  *
@@ -1940,6 +1966,23 @@ char up_romgetc(FAR const char *ptr);
 void up_mdelay(unsigned int milliseconds);
 void up_udelay(useconds_t microseconds);
 
+/****************************************************************************
+ * Name: up_perf_gettime and up_perf_getfreq
+ *
+ * Description:
+ *   Some platforms provide a free-running, high resolution counter that can
+ *   be used for performance measurements.  up_perf_gettime() returns the
+ *   current value of the counter; the counter may wrap around so only the
+ *   difference of two values is meaningful.  up_perf_getfreq() returns the
+ *   frequency of the counter in Hz.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_COUNTER
+uint32_t up_perf_gettime(void);
+uint32_t up_perf_getfreq(void);
+#endif
+
 /****************************************************************************
  * These are standard interfaces that are exported by the OS for use by the
  * architecture specific logic
@@ -2031,6 +2074,27 @@ void sched_alarm_expiration(FAR const struct timespec *ts);
 void weak_function sched_process_cpuload(void);
 #endif
 
+/****************************************************************************
+ * Name: sched_process_resched
+ *
+ * Description:
+ *   Called from the architecture-specific handler of the reschedule IPI
+ *   sent by up_cpu_resched().  If a task in the g_readytorun list may run
+ *   on this CPU and has a higher priority than the task running on this
+ *   CPU, then a context switch is performed.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP_RESCHED_IPI
+void sched_process_resched(void);
+#endif
+
 /****************************************************************************
  * Name: irq_dispatch
  *
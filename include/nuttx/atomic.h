@@ -0,0 +1,88 @@
+/****************************************************************************
+ * include/nuttx/atomic.h
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_ATOMIC_H
+#define __INCLUDE_NUTTX_ATOMIC_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdbool.h>
+
+#ifdef CONFIG_ARCH_HAVE_ATOMICS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* These are thin wrappers around the GCC __atomic built-in functions.  The
+ * architecture selects CONFIG_ARCH_HAVE_ATOMICS only if the built-ins
+ * produce lock-free, in-line code for naturally aligned 8-, 16- and 32-bit
+ * objects.  The names are chosen so that they do not collide with the C11
+ * <stdatomic.h> generic functions.
+ *
+ *   atomic_read(p)            - Load *p (no ordering)
+ *   atomic_read_acquire(p)    - Load *p; later accesses are not moved
+ *                               before the load.
+ *   atomic_set(p,v)           - Store v in *p (no ordering)
+ *   atomic_set_release(p,v)   - Store v in *p; earlier accesses are not
+ *                               moved after the store.
+ *   atomic_add_return(p,v)    - Add v to *p and return the new value
+ *   atomic_cmpxchg(p,o,n)     - If *p == o, then store n in *p and return
+ *                               true.  Otherwise, return false.
+ *
+ * atomic_add_return() and atomic_cmpxchg() are full memory barriers.
+ */
+
+#define atomic_read(p)          __atomic_load_n((p), __ATOMIC_RELAXED)
+#define atomic_read_acquire(p)  __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define atomic_set(p,v)         __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define atomic_set_release(p,v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define atomic_add_return(p,v)  __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+
+#define atomic_cmpxchg(p,o,n) \
+  __extension__ \
+  ({ \
+     __typeof__((void)0, *(p)) __old = (o); \
+     __atomic_compare_exchange_n((p), &__old, (n), false, \
+                                 __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST); \
+  })
+
+#endif /* CONFIG_ARCH_HAVE_ATOMICS */
+#endif /* __INCLUDE_NUTTX_ATOMIC_H */
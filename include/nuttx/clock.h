@@ -188,6 +188,19 @@ struct cpuload_s
 {
   volatile uint32_t total;   /* Total number of clock ticks */
   volatile uint32_t active;  /* Number of ticks while this thread was active */
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  uint64_t runtime;          /* Total run time of this thread in microseconds */
+#endif
+};
+#endif
+
+/* This structure is used to report the time spent by a particular CPU */
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+struct cpustat_s
+{
+  uint64_t idle;             /* Run time of the IDLE thread in microseconds */
+  uint64_t irq;              /* Time in interrupt handlers in microseconds */
 };
 #endif
 
@@ -369,6 +382,27 @@ int clock_systimespec(FAR struct timespec *ts);
 int clock_cpuload(int pid, FAR struct cpuload_s *cpuload);
 #endif
 
+/****************************************************************************
+ * Name:  clock_cpustat
+ *
+ * Description:
+ *   Return the time that the selected CPU has spent in its IDLE thread and
+ *   in interrupt handlers.
+ *
+ * Parameters:
+ *   cpu - The index of the CPU of interest.
+ *   cpustat - The location to return the CPU times
+ *
+ * Return Value:
+ *   OK (0) on success; a negated errno value on failure.  The only reason
+ *   that this function can fail is if 'cpu' is not a valid CPU index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+int clock_cpustat(int cpu, FAR struct cpustat_s *cpustat);
+#endif
+
 /****************************************************************************
  * Name:  sched_oneshot_extclk
  *
@@ -45,6 +45,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <errno.h>
 
 #include <nuttx/mm/mm.h>
 #include <nuttx/userspace.h>
@@ -113,6 +114,10 @@ extern "C"
 # define kmm_memalign(a,s)      memalign(a,s)
 # define kmm_free(p)            free(p)
 
+# define kmm_setregionflags(r,f) umm_setregionflags(r,f)
+# define kmm_malloc_region(s,f) umm_malloc_region(s,f)
+# define kmm_mallinfo_region(r,i) umm_mallinfo_region(r,i)
+
 #elif !defined(CONFIG_MM_KERNEL_HEAP)
 /* If this the kernel phase of a kernel build, and there are only user-space
  * allocators, then the following are defined in userspace.h as macros that
@@ -130,6 +135,14 @@ extern "C"
 # define kmm_memalign(a,s)      umm_memalign(a,s)
 # define kmm_free(p)            umm_free(p)
 
+/* Region placement hints are not available through the user-space
+ * interface and are ignored.  Per-region usage cannot be reported.
+ */
+
+# define kmm_setregionflags(r,f)
+# define kmm_malloc_region(s,f) umm_malloc(s)
+# define kmm_mallinfo_region(r,i) (-ENOSYS)
+
 #else
 /* Otherwise, the kernel-space allocators are declared in include/nuttx/mm/mm.h
  * and we can call them directly.
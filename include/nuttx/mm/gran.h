@@ -74,6 +74,16 @@
 typedef FAR void *GRAN_HANDLE;
 #endif
 
+/* This structure describes the state of a granule heap (see gran_info) */
+
+struct graninfo_s
+{
+  uint8_t  log2gran;  /* Log base 2 of the size of one granule */
+  uint16_t ngranules; /* The total number of (aligned) granules in the heap */
+  uint16_t nfree;     /* The number of free granules */
+  uint16_t mxfree;    /* The longest run of free granules */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -118,10 +128,6 @@ extern "C"
  *   The actual memory allocates will be 64 byte (wasting 17 bytes) and
  *   will be aligned at least to (1 << log2align).
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
- *
  * Input Parameters:
  *   heapstart - Start of the granule allocation heap
  *   heapsize  - Size of heap in bytes
@@ -201,11 +207,8 @@ void gran_reserve(GRAN_HANDLE handle, uintptr_t start, size_t size);
  * Name: gran_alloc
  *
  * Description:
- *   Allocate memory from the granule heap.
- *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
+ *   Allocate memory from the granule heap.  The allocation may span any
+ *   number of contiguous granules.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
@@ -244,6 +247,27 @@ void gran_free(FAR void *memory, size_t size);
 void gran_free(GRAN_HANDLE handle, FAR void *memory, size_t size);
 #endif
 
+/****************************************************************************
+ * Name: gran_info
+ *
+ * Description:
+ *   Return information about the granule heap.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by gran_initialize
+ *   info   - Memory location to return the gran allocator info.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_GRAN_SINGLE
+void gran_info(FAR struct graninfo_s *info);
+#else
+void gran_info(GRAN_HANDLE handle, FAR struct graninfo_s *info);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -121,6 +121,26 @@ struct iob_s
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
 };
 
+#ifdef CONFIG_IOB_STATS
+/* I/O buffer usage statistics as returned by iob_getstats() */
+
+struct iob_stats_s
+{
+  uint16_t ntotal;      /* Total number of I/O buffers */
+  uint16_t nfree;       /* Number of I/O buffers in the free list */
+  uint16_t ncached;     /* Number of I/O buffers held in per-CPU caches */
+  uint16_t nwaiting;    /* Number of tasks waiting for an I/O buffer */
+  uint32_t nalloc;      /* Number of I/O buffers taken from the free list */
+  uint32_t ncachehit;   /* Allocations satisfied from a per-CPU cache */
+  uint32_t nfail;       /* Allocations that failed without waiting */
+  uint32_t nthrottle;   /* Throttled allocations refused while unthrottled
+                         * I/O buffers were still available */
+  uint32_t nwait;       /* Allocations that had to wait */
+  uint32_t waitticks;   /* Total time spent waiting (clock ticks) */
+  uint32_t maxwait;     /* Longest single wait (clock ticks) */
+};
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* This container structure supports queuing of I/O buffer chains.  This
  * structure is intended only for internal use by the IOB module.
@@ -183,6 +203,33 @@ FAR struct iob_s *iob_alloc(bool throttled);
 
 FAR struct iob_s *iob_tryalloc(bool throttled);
 
+/****************************************************************************
+ * Name: iob_alloc_batch
+ *
+ * Description:
+ *   Allocate 'nbufs' empty I/O buffers, linked together through io_flink.
+ *   The buffers are taken from the free list all at once under a single
+ *   critical section.  If not enough are free, this function waits until
+ *   they are without holding any of them (unless called from an interrupt
+ *   handler or the IDLE task, in which case NULL is returned and no buffers
+ *   are taken).
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_batch(unsigned int nbufs, bool throttled);
+
+/****************************************************************************
+ * Name: iob_tryalloc_batch
+ *
+ * Description:
+ *   Allocate 'nbufs' empty I/O buffers, linked together through io_flink,
+ *   under a single critical section without waiting.  Either all of the
+ *   buffers are allocated or none are.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_tryalloc_batch(unsigned int nbufs, bool throttled);
+
 /****************************************************************************
  * Name: iob_free
  *
@@ -194,6 +241,18 @@ FAR struct iob_s *iob_tryalloc(bool throttled);
 
 FAR struct iob_s *iob_free(FAR struct iob_s *iob);
 
+/****************************************************************************
+ * Name: iob_free_batch
+ *
+ * Description:
+ *   Return every I/O buffer in a list linked through io_flink (such as a
+ *   buffer chain or a list allocated by iob_alloc_batch()) to the free list
+ *   under a single critical section.
+ *
+ ****************************************************************************/
+
+void iob_free_batch(FAR struct iob_s *iob);
+
 /****************************************************************************
  * Name: iob_free_chain
  *
@@ -401,6 +460,18 @@ FAR struct iob_s *iob_pack(FAR struct iob_s *iob);
 
 int iob_contig(FAR struct iob_s *iob, unsigned int len);
 
+/****************************************************************************
+ * Name: iob_getstats
+ *
+ * Description:
+ *   Return a snapshot of the I/O buffer usage statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_STATS
+void iob_getstats(FAR struct iob_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: iob_dump
  *
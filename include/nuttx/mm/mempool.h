@@ -0,0 +1,235 @@
+/****************************************************************************
+ * include/nuttx/mm/mempool.h
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef _INCLUDE_NUTTX_MM_MEMPOOL_H
+#define _INCLUDE_NUTTX_MM_MEMPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <queue.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Every free block holds a link to the next free block, so no block can be
+ * smaller than a queue entry.
+ */
+
+#define MEMPOOL_MINBSIZE   sizeof(sq_entry_t)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes one pool of fixed-size objects.  The pool may be
+ * provided with statically allocated storage, may obtain its initial blocks
+ * from the kernel heap, and may optionally grow from the kernel heap in
+ * steps of mp_nexpand blocks.  Blocks obtained from the heap are never
+ * returned to it:  Once in the pool, memory is reused only for objects of
+ * the same size.
+ *
+ * The last mp_nreserve free blocks are reserved for use from interrupt
+ * handlers which cannot wait for the pool to grow.
+ *
+ * All fields are private to the mempool logic and should be accessed only
+ * through the mempool interfaces.
+ */
+
+struct mempool_s
+{
+  FAR struct mempool_s *mp_flink; /* Supports a singly linked list of pools */
+  FAR const char *mp_name;        /* Name of the pool (for statistics) */
+  sq_queue_t mp_freelist;         /* List of free blocks */
+  size_t   mp_bsize;              /* Size of one block in bytes */
+  uint16_t mp_nexpand;            /* Number of blocks added on each growth */
+  uint16_t mp_nreserve;           /* Free blocks reserved for interrupts */
+  uint16_t mp_nfree;              /* Number of blocks in mp_freelist */
+  uint16_t mp_ntotal;             /* Total number of blocks in the pool */
+  uint16_t mp_npeak;              /* Maximum number of blocks ever in use */
+  uint32_t mp_nalloc;             /* Number of successful allocations */
+  uint32_t mp_nfail;              /* Number of failed allocations */
+};
+
+/* This structure is used to report the state of a pool */
+
+struct mempoolinfo_s
+{
+  FAR const char *name;           /* Name of the pool */
+  size_t   bsize;                 /* Size of one block in bytes */
+  uint16_t ntotal;                /* Total number of blocks in the pool */
+  uint16_t nfree;                 /* Number of free blocks */
+  uint16_t npeak;                 /* Maximum number of blocks ever in use */
+  uint16_t nreserve;              /* Free blocks reserved for interrupts */
+  uint32_t nalloc;                /* Number of successful allocations */
+  uint32_t nfail;                 /* Number of failed allocations */
+};
+
+/* This is the type of the callback used by mempool_foreach() */
+
+typedef CODE int (*mempool_handler_t)(FAR const struct mempoolinfo_s *info,
+                                      FAR void *arg);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a pool of fixed-size blocks and register it so that it is
+ *   visible to mempool_foreach().
+ *
+ * Input Parameters:
+ *   pool     - The pool to be initialized
+ *   name     - The name of the pool.  The string is not copied.
+ *   bsize    - The size of one block.  This is also the stride between
+ *              blocks in the storage array.  It must be at least
+ *              MEMPOOL_MINBSIZE.
+ *   storage  - Storage for the initial blocks, for example a statically
+ *              allocated array of objects.  If NULL, the initial blocks
+ *              are allocated from the kernel heap.
+ *   ninit    - The number of initial blocks
+ *   nexpand  - The number of blocks to allocate from the kernel heap when
+ *              the pool is exhausted.  Zero means that the pool never
+ *              grows.
+ *   nreserve - The number of free blocks reserved for interrupt handlers
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   if the initial blocks could not be allocated.
+ *
+ ****************************************************************************/
+
+int mempool_initialize(FAR struct mempool_s *pool, FAR const char *name,
+                       size_t bsize, FAR void *storage, uint16_t ninit,
+                       uint16_t nexpand, uint16_t nreserve);
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate one block from the pool.  This function may be called from
+ *   interrupt handlers.  Only interrupt handlers may take the reserved
+ *   blocks; only non-interrupt callers may grow the pool.  The contents
+ *   of the returned block are undefined.
+ *
+ * Input Parameters:
+ *   pool - The pool to allocate from
+ *
+ * Returned Value:
+ *   The allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool);
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the pool it was allocated from.  This function may
+ *   be called from interrupt handlers.
+ *
+ * Input Parameters:
+ *   pool - The pool that the block was allocated from
+ *   blk  - The block to be freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return a snapshot of the state and statistics of a pool.
+ *
+ * Input Parameters:
+ *   pool - The pool to query
+ *   info - The location to return the information
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_info(FAR struct mempool_s *pool,
+                  FAR struct mempoolinfo_s *info);
+
+/****************************************************************************
+ * Name: mempool_foreach
+ *
+ * Description:
+ *   Call the provided handler with a snapshot of each registered pool.  The
+ *   traversal stops if the handler returns a non-zero value.
+ *
+ * Input Parameters:
+ *   handler - The function to call for each pool
+ *   arg     - An opaque argument passed to the handler
+ *
+ * Returned Value:
+ *   Zero if all pools were visited; otherwise the non-zero value returned
+ *   by the handler.
+ *
+ ****************************************************************************/
+
+int mempool_foreach(mempool_handler_t handler, FAR void *arg);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INCLUDE_NUTTX_MM_MEMPOOL_H */
@@ -46,6 +46,14 @@
 #include <stdbool.h>
 #include <semaphore.h>
 
+#ifdef CONFIG_MM_ACCOUNTING
+#  include <unistd.h>
+#endif
+
+#if defined(CONFIG_MM_CPUCACHE) && defined(CONFIG_SMP)
+#  include <nuttx/spinlock.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -122,15 +130,24 @@
  *   allocated.  It can range from 16-bytes to 4Gb.  Larger values of
  *   MM_MAX_SHIFT can cause larger data structure sizes and, perhaps,
  *   minor performance losses.
+ *
+ * With CONFIG_MM_ACCOUNTING, each chunk header carries two additional
+ * pointer-sized owner fields so MM_MIN_CHUNK is doubled.
  */
 
+#ifdef CONFIG_MM_ACCOUNTING
+#  define MM_OWNER_SHIFT  1
+#else
+#  define MM_OWNER_SHIFT  0
+#endif
+
 #if defined(CONFIG_MM_SMALL) && UINTPTR_MAX <= UINT32_MAX
 /* Two byte offsets; Pointers may be 2 or 4 bytes;
  * sizeof(struct mm_freenode_s) is 8 or 12 bytes.
  * REVISIT: We could do better on machines with 16-bit addressing.
  */
 
-#  define MM_MIN_SHIFT    4  /* 16 bytes */
+#  define MM_MIN_SHIFT   (4 + MM_OWNER_SHIFT)  /* 16 or 32 bytes */
 #  define MM_MAX_SHIFT   15  /* 32 Kb */
 
 #elif defined(CONFIG_HAVE_LONG_LONG)
@@ -139,9 +156,9 @@
  */
 
 #  if UINTPTR_MAX <= UINT32_MAX
-#    define MM_MIN_SHIFT  4  /* 16 bytes */
+#    define MM_MIN_SHIFT (4 + MM_OWNER_SHIFT)  /* 16 or 32 bytes */
 #  elif UINTPTR_MAX <= UINT64_MAX
-#    define MM_MIN_SHIFT  5  /* 32 bytes */
+#    define MM_MIN_SHIFT (5 + MM_OWNER_SHIFT)  /* 32 or 64 bytes */
 #  endif
 #  define MM_MAX_SHIFT   22  /*  4 Mb */
 
@@ -150,7 +167,7 @@
  * sizeof(struct mm_freenode_s) is 16 bytes.
  */
 
-#  define MM_MIN_SHIFT    4  /* 16 bytes */
+#  define MM_MIN_SHIFT   (4 + MM_OWNER_SHIFT)  /* 16 or 32 bytes */
 #  define MM_MAX_SHIFT   22  /*  4 Mb */
 #endif
 
@@ -164,6 +181,65 @@
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
 
+/* Free list organization.
+ *
+ * In the default, best-fit organization, all free chunks are retained in a
+ * single, doubly linked list ordered by size.  The MM_NNODES elements of
+ * mm_nodelist[] are zero-sized sentinel nodes within that list that mark
+ * the beginning of each power-of-two size class.
+ *
+ * With CONFIG_MM_TLSF, each power-of-two (first-level) size class is
+ * further divided into MM_SL_COUNT linear (second-level) sub-classes and
+ * each sub-class has its own, independent free list.  A first-level bitmap
+ * and a second-level bitmap for each first-level class indicate which
+ * lists are non-empty so that a suitable free chunk can be located with a
+ * couple of find-first-set operations rather than by a list traversal.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  define MM_SL_SHIFT    CONFIG_MM_TLSF_SLSHIFT
+#  define MM_SL_COUNT    (1 << MM_SL_SHIFT)
+#  define MM_SL_MASK     (MM_SL_COUNT - 1)
+#  define MM_NBINS       (MM_NNODES * MM_SL_COUNT)
+#else
+#  define MM_NBINS       MM_NNODES
+#endif
+
+/* Region placement hints.  Each heap region may be tagged with a set of
+ * these attributes by mm_setregionflags() and allocations may request
+ * regions with particular attributes by mm_malloc_region().
+ *
+ *   MM_REGION_ANY  - No placement preference
+ *   MM_REGION_FAST - Fast (e.g., tightly coupled or on-chip) memory.  Plain
+ *                    allocations avoid fast regions while there is space
+ *                    elsewhere so that they remain available for objects
+ *                    that ask for them.
+ *   MM_REGION_DMA  - Memory that is accessible by DMA
+ *   MM_REGION_SLOW - Slow (e.g., external) memory
+ */
+
+#define MM_REGION_ANY    0x00
+#define MM_REGION_FAST   0x01
+#define MM_REGION_DMA    0x02
+#define MM_REGION_SLOW   0x04
+
+/* Per-CPU small allocation caches.  Cache class n holds free chunks of
+ * exactly MM_CPUCACHE_CHUNKSIZE(n) bytes (including the allocated node
+ * header).
+ */
+
+#ifdef CONFIG_MM_CPUCACHE
+#  ifdef CONFIG_SMP
+#    define MM_CPUCACHE_NCPUS        CONFIG_SMP_NCPUS
+#  else
+#    define MM_CPUCACHE_NCPUS        1
+#  endif
+
+#  define MM_CPUCACHE_CHUNKSIZE(n)   ((size_t)((n) + 1) << MM_MIN_SHIFT)
+#  define MM_CPUCACHE_MAXCHUNK \
+     MM_CPUCACHE_CHUNKSIZE(CONFIG_MM_CPUCACHE_NCLASSES - 1)
+#endif
+
 /* An allocated chunk is distinguished from a free chunk by bit 31 (or 15)
  * of the 'preceding' chunk size.  If set, then this is an allocated chunk.
  */
@@ -176,6 +252,56 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0))
 
+/* Heap accounting.  MM_SETOWNER() tags an allocated chunk with the ID of
+ * the calling task and with the return address of the function in which
+ * it is expanded.  MM_SETCALLER() replaces that return address for the
+ * memory 'm' returned by an allocator.  The public entry points (malloc(),
+ * kmm_malloc(), ...) use it so that the code calling them is recorded
+ * rather than the entry point itself.  MM_CLROWNER() marks an allocated
+ * chunk as not owned by any task (for example, a chunk held in a per-CPU
+ * cache).
+ */
+
+#ifdef CONFIG_MM_ACCOUNTING
+#  define MM_OWNER_NONE ((pid_t)-1)
+
+#  ifdef __GNUC__
+#    define MM_RETURN_ADDRESS() __builtin_return_address(0)
+#  else
+#    define MM_RETURN_ADDRESS() NULL
+#  endif
+
+#  define MM_SETOWNER(n) \
+     do \
+       { \
+         (n)->pid    = getpid(); \
+         (n)->caller = MM_RETURN_ADDRESS(); \
+       } \
+     while (0)
+#  define MM_SETCALLER(m) \
+     do \
+       { \
+         if ((m) != NULL) \
+           { \
+             ((FAR struct mm_allocnode_s *) \
+              ((FAR char *)(m) - SIZEOF_MM_ALLOCNODE))->caller = \
+                MM_RETURN_ADDRESS(); \
+           } \
+       } \
+     while (0)
+#  define MM_CLROWNER(n) \
+     do \
+       { \
+         (n)->pid    = MM_OWNER_NONE; \
+         (n)->caller = NULL; \
+       } \
+     while (0)
+#else
+#  define MM_SETOWNER(n)
+#  define MM_SETCALLER(m)
+#  define MM_CLROWNER(n)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -199,14 +325,26 @@ struct mm_allocnode_s
 {
   mmsize_t size;           /* Size of this chunk */
   mmsize_t preceding;      /* Size of the preceding chunk */
+#ifdef CONFIG_MM_ACCOUNTING
+  FAR void *caller;        /* Return address of the allocation call */
+  pid_t pid;               /* ID of the allocating task */
+#endif
 };
 
-/* What is the size of the allocnode? */
+/* What is the size of the allocnode?  The owner fields are padded to two
+ * pointers.
+ */
+
+#ifdef CONFIG_MM_ACCOUNTING
+#  define SIZEOF_MM_OWNER      (2 * sizeof(FAR void *))
+#else
+#  define SIZEOF_MM_OWNER      0
+#endif
 
 #ifdef CONFIG_MM_SMALL
-# define SIZEOF_MM_ALLOCNODE   4
+# define SIZEOF_MM_ALLOCNODE   (4 + SIZEOF_MM_OWNER)
 #else
-# define SIZEOF_MM_ALLOCNODE   8
+# define SIZEOF_MM_ALLOCNODE   (8 + SIZEOF_MM_OWNER)
 #endif
 
 #define CHECK_ALLOCNODE_SIZE \
@@ -218,6 +356,10 @@ struct mm_freenode_s
 {
   mmsize_t size;                   /* Size of this chunk */
   mmsize_t preceding;              /* Size of the preceding chunk */
+#ifdef CONFIG_MM_ACCOUNTING
+  FAR void *caller;                /* Unused in a free chunk */
+  pid_t pid;
+#endif
   FAR struct mm_freenode_s *flink; /* Supports a doubly linked list */
   FAR struct mm_freenode_s *blink;
 };
@@ -230,6 +372,56 @@ struct mm_freenode_s
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+#ifdef CONFIG_MM_CPUCACHE
+/* A magazine holds free chunks of one cache class for one CPU.  Cached
+ * chunks remain marked as allocated in the heap proper.
+ */
+
+struct mm_magazine_s
+{
+  uint8_t   mg_count;                               /* Number of chunks held */
+  FAR void *mg_chunks[CONFIG_MM_CPUCACHE_DEPTH];    /* Cached chunk payloads */
+};
+
+/* This is the set of magazines for one CPU */
+
+struct mm_cpucache_s
+{
+#ifdef CONFIG_SMP
+  volatile spinlock_t cc_lock;  /* Also taken by mm_cpucache_flush() */
+#endif
+  struct mm_magazine_s cc_magazine[CONFIG_MM_CPUCACHE_NCLASSES];
+};
+#endif
+
+/* This is the set of free lists of one heap region.  Free chunks never
+ * span regions, so each region keeps its own, independent free lists and
+ * an allocation may be directed to a particular region.
+ */
+
+struct mm_freelist_s
+{
+#ifdef CONFIG_MM_TLSF
+  /* Bit n of mm_flbitmap is set if any second-level list of first-level
+   * class n is non-empty.  Bit m of mm_slbitmap[n] is set if the free
+   * list mm_nodelist[n * MM_SL_COUNT + m] is non-empty.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_NNODES];
+
+  /* The head of each segregated free list */
+
+#else
+  /* All free nodes are maintained in a doubly linked list.  This
+   * array provides some hooks into the list at various points to
+   * speed searches for free nodes.
+   */
+
+#endif
+  struct mm_freenode_s mm_nodelist[MM_NBINS];
+};
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -253,14 +445,25 @@ struct mm_heap_s
 
 #if CONFIG_MM_REGIONS > 1
   int mm_nregions;
+
+  /* The MM_REGION_* placement attributes of each region */
+
+  uint8_t mm_regionflags[CONFIG_MM_REGIONS];
 #endif
 
-  /* All free nodes are maintained in a doubly linked list.  This
-   * array provides some hooks into the list at various points to
-   * speed searches for free nodes.
+  /* The free lists of each region */
+
+  struct mm_freelist_s mm_freelist[CONFIG_MM_REGIONS];
+
+#ifdef CONFIG_MM_CPUCACHE
+  /* Per-CPU caches of small free chunks.  Each CPU normally accesses only
+   * its own cache with local interrupts disabled.  In SMP, the per-CPU lock
+   * is also taken so that mm_cpucache_flush() can drain the caches of the
+   * other CPUs; it is uncontended except while flushing.
    */
 
-  struct mm_freenode_s mm_nodelist[MM_NNODES];
+  struct mm_cpucache_s mm_cpucache[MM_CPUCACHE_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -373,6 +576,37 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
 FAR void *kmm_malloc(size_t size);
 #endif
 
+/* Functions contained in mm_malloc.c ***************************************/
+
+FAR void *mm_malloc_region(FAR struct mm_heap_s *heap, size_t size,
+                           uint8_t flags);
+
+/* Functions contained in umm_region.c **************************************/
+
+#if !defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__)
+FAR void *umm_malloc_region(size_t size, uint8_t flags);
+void umm_setregionflags(int region, uint8_t flags);
+#endif
+
+/* Functions contained in kmm_region.c **************************************/
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+FAR void *kmm_malloc_region(size_t size, uint8_t flags);
+void kmm_setregionflags(int region, uint8_t flags);
+#endif
+
+/* Functions contained in mm_region.c ***************************************/
+
+void mm_setregionflags(FAR struct mm_heap_s *heap, int region,
+                       uint8_t flags);
+#if CONFIG_MM_REGIONS > 1
+int mm_findregion(FAR struct mm_heap_s *heap, FAR void *mem);
+#  define MM_FREELIST(h,n) (&(h)->mm_freelist[mm_findregion(h, n)])
+#else
+#  define mm_findregion(h,m) 0
+#  define MM_FREELIST(h,n)   (&(h)->mm_freelist[0])
+#endif
+
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
@@ -494,6 +728,23 @@ int kmm_mallinfo(struct mallinfo *info);
 #endif /* CONFIG_CAN_PASS_STRUCTS */
 #endif /* CONFIG_MM_KERNEL_HEAP */
 
+/* Functions contained in mm_mallinfo.c *************************************/
+
+int mm_mallinfo_region(FAR struct mm_heap_s *heap, int region,
+                       FAR struct mallinfo *info);
+
+/* Functions contained in umm_region.c **************************************/
+
+#if !defined(CONFIG_BUILD_PROTECTED) || !defined(__KERNEL__)
+int umm_mallinfo_region(int region, FAR struct mallinfo *info);
+#endif
+
+/* Functions contained in kmm_region.c **************************************/
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+int kmm_mallinfo_region(int region, FAR struct mallinfo *info);
+#endif
+
 /* Functions contained in mm_shrinkchunk.c **********************************/
 
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
@@ -504,10 +755,35 @@ void mm_shrinkchunk(FAR struct mm_heap_s *heap,
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c *********************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_cpucache.c *************************************/
+
+#ifdef CONFIG_MM_CPUCACHE
+void mm_cpucache_initialize(FAR struct mm_heap_s *heap);
+FAR void *mm_cpucache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_cpucache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+size_t mm_cpucache_size(FAR struct mm_heap_s *heap);
+bool mm_cpucache_flush(FAR struct mm_heap_s *heap);
+#endif
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
 
+/* Functions contained in mm_foreach.c **************************************/
+
+#ifdef CONFIG_MM_ACCOUNTING
+typedef CODE int (*mm_handler_t)(FAR struct mm_allocnode_s *node,
+                                 FAR void *arg);
+
+int mm_foreach(FAR struct mm_heap_s *heap, mm_handler_t handler,
+               FAR void *arg);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -52,14 +52,22 @@
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
 
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
 
+/* A message on a zero-copy message queue carries this buffer descriptor in
+ * place of the payload.
+ */
+
+#ifdef CONFIG_MQ_ZEROCOPY
+struct mq_buffer_s
+{
+  FAR void *buf;              /* The buffer passed by reference */
+  size_t buflen;              /* The length of the buffer in bytes */
+};
+#endif
+
 /* This structure defines a message queue */
 
 struct mq_des; /* forward reference */
@@ -72,11 +80,18 @@ struct mqueue_inode_s
   int16_t nmsgs;              /* Number of message in the queue */
   int16_t nwaitnotfull;       /* Number tasks waiting for not full */
   int16_t nwaitnotempty;      /* Number tasks waiting for not empty */
-#if CONFIG_MQ_MAXMSGSIZE < 256
+#if CONFIG_MQ_MAXMSGSIZE < 256 && !defined(CONFIG_MQ_QUEUEPOOL)
   uint8_t maxmsgsize;         /* Max size of message in message queue */
 #else
   uint16_t maxmsgsize;        /* Max size of message in message queue */
 #endif
+#ifdef CONFIG_MQ_QUEUEPOOL
+  sq_queue_t msgfree;         /* Free messages of the pool of this queue */
+  FAR void *msgpool;          /* Storage of the pool of this queue */
+#endif
+#ifdef CONFIG_MQ_ZEROCOPY
+  bool zerocopy;              /* Messages are struct mq_buffer_s */
+#endif
 #ifndef CONFIG_DISABLE_SIGNALS
   FAR struct mq_des *ntmqdes; /* Notification: Owning mqdes (NULL if none) */
   pid_t ntpid;                /* Notification: Receiving Task's PID */
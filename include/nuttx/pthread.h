@@ -43,7 +43,9 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <pthread.h>
+#include <semaphore.h>
 #include <sched.h>
 
 /****************************************************************************
@@ -106,6 +108,66 @@
   }
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fastpath
+ *
+ * Description:
+ *   Return true if the mutex may be taken and released in user space with
+ *   a single compare-and-exchange on the count of its semaphore.  That is
+ *   the case for a NORMAL mutex that is neither robust nor uses priority
+ *   inheritance:  The kernel must track the holders of those.  The kernel
+ *   does not add such a mutex to the list of mutexes held by the thread
+ *   (see pthread_mutex_take()), so the fast and slow paths may be mixed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+static inline bool pthread_mutex_fastpath(FAR const pthread_mutex_t *mutex)
+{
+#if defined(CONFIG_PTHREAD_MUTEX_ROBUST)
+  /* All mutexes are robust */
+
+  return false;
+#else
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  if (mutex->type != PTHREAD_MUTEX_NORMAL)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_PTHREAD_MUTEX_BOTH
+  if ((mutex->flags & _PTHREAD_MFLAGS_ROBUST) != 0)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  if ((mutex->sem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      return false;
+    }
+#endif
+
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+  /* Hold times are only measured in the kernel */
+
+  if ((mutex->sem.flags & ADAPTIVE_FLAGS_ENABLE) != 0)
+    {
+      return false;
+    }
+#endif
+
+  return true;
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -128,6 +190,33 @@ EXTERN const pthread_attr_t g_default_pthread_attr;
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: pthread_mutex_wait, pthread_mutex_trywait, and pthread_mutex_wake
+ *
+ * Description:
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, pthread_mutex_lock(),
+ *   pthread_mutex_trylock() and pthread_mutex_unlock() are implemented in
+ *   the C library.  They take and release an uncontended mutex without
+ *   entering the kernel and call these kernel entry points only if the
+ *   mutex is contended or if it does not qualify for the fast path (see
+ *   pthread_mutex_fastpath()):
+ *
+ *   pthread_mutex_wait    - Lock the mutex, waiting if necessary
+ *   pthread_mutex_trywait - Lock the mutex only if it is available
+ *   pthread_mutex_wake    - Unlock the mutex, waking up the highest
+ *                           priority waiter (if any)
+ *
+ *   These have the same semantics and return values as the standard
+ *   interfaces.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+int pthread_mutex_wait(FAR pthread_mutex_t *mutex);
+int pthread_mutex_trywait(FAR pthread_mutex_t *mutex);
+int pthread_mutex_wake(FAR pthread_mutex_t *mutex);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,499 @@
+/****************************************************************************
+ * include/nuttx/ringbuf.h
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RINGBUF_H
+#define __INCLUDE_NUTTX_RINGBUF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/atomic.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A ring buffer is a byte FIFO in caller-provided storage.  It supports
+ * one consumer and either one producer (ringbuf_put(), ringbuf_reserve()
+ * and ringbuf_commit()) or any number of producers (ringbuf_mpput()), but
+ * the two kinds of producers must not be mixed on the same ring buffer.
+ * A single producer and the consumer never wait for each other and never
+ * disable interrupts.  Producers of ringbuf_mpput() disable interrupts on
+ * the local CPU only while they copy their data.
+ *
+ * Any buffer size is supported.  The head and tail indices run from zero
+ * to twice the size so that a full buffer can be told from an empty one
+ * without sacrificing a byte of storage.
+ *
+ * Without CONFIG_ARCH_HAVE_ATOMICS, loads and stores of the indices are
+ * done with interrupts disabled and ringbuf_mpput() uses a critical
+ * section.
+ */
+
+/* Statically initialize a ring buffer with the storage 'b' of 's' bytes */
+
+#define RINGBUF_INITIALIZER(b,s) { (FAR uint8_t *)(b), (s), 0, 0, 0 }
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct ringbuf_s
+{
+  FAR uint8_t *rb_buffer;   /* Storage of the ring buffer */
+  unsigned int rb_size;     /* Size of the storage in bytes */
+  unsigned int rb_head;     /* Index where the next byte is added */
+  unsigned int rb_tail;     /* Index where the next byte is removed */
+  unsigned int rb_reserve;  /* Index up to which ringbuf_mpput() claimed
+                             * space */
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* Index loads and stores.  The acquire/release pairs order the accesses
+ * to the storage with the publication of the indices.
+ */
+
+#ifdef CONFIG_ARCH_HAVE_ATOMICS
+#  define ringbuf_load(p)            atomic_read(p)
+#  define ringbuf_load_acquire(p)    atomic_read_acquire(p)
+#  define ringbuf_store_release(p,v) atomic_set_release(p,v)
+#else
+static inline unsigned int ringbuf_load_acquire(FAR const unsigned int *ndx)
+{
+  irqstate_t flags = up_irq_save();
+  unsigned int value = *(FAR volatile const unsigned int *)ndx;
+
+  up_irq_restore(flags);
+#ifdef CONFIG_SMP
+  SP_DMB();
+#endif
+  return value;
+}
+
+static inline void ringbuf_store_release(FAR unsigned int *ndx,
+                                         unsigned int value)
+{
+  irqstate_t flags;
+
+#ifdef CONFIG_SMP
+  SP_DMB();
+#endif
+  flags = up_irq_save();
+  *(FAR volatile unsigned int *)ndx = value;
+  up_irq_restore(flags);
+}
+
+#  define ringbuf_load(p)            ringbuf_load_acquire(p)
+#endif
+
+/****************************************************************************
+ * Name: ringbuf_wrap, ringbuf_offset, ringbuf_count
+ *
+ * Description:
+ *   Index arithmetic:  Wrap an advanced index, convert an index to an
+ *   offset in the storage and return the number of bytes between two
+ *   indices.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_wrap(FAR const struct ringbuf_s *rb,
+                                        unsigned int ndx)
+{
+  return ndx >= 2 * rb->rb_size ? ndx - 2 * rb->rb_size : ndx;
+}
+
+static inline unsigned int ringbuf_offset(FAR const struct ringbuf_s *rb,
+                                          unsigned int ndx)
+{
+  return ndx >= rb->rb_size ? ndx - rb->rb_size : ndx;
+}
+
+static inline unsigned int ringbuf_count(FAR const struct ringbuf_s *rb,
+                                         unsigned int head,
+                                         unsigned int tail)
+{
+  return head >= tail ? head - tail : head + 2 * rb->rb_size - tail;
+}
+
+/****************************************************************************
+ * Name: ringbuf_copyin, ringbuf_copyout
+ *
+ * Description:
+ *   Copy data to or from the storage starting at index 'ndx', handling the
+ *   wrap-around at the end of the storage.
+ *
+ ****************************************************************************/
+
+static inline void ringbuf_copyin(FAR struct ringbuf_s *rb, unsigned int ndx,
+                                  FAR const void *data, unsigned int len)
+{
+  unsigned int offset = ringbuf_offset(rb, ndx);
+  unsigned int first  = rb->rb_size - offset;
+
+  if (first > len)
+    {
+      first = len;
+    }
+
+  memcpy(&rb->rb_buffer[offset], data, first);
+  memcpy(rb->rb_buffer, (FAR const uint8_t *)data + first, len - first);
+}
+
+static inline void ringbuf_copyout(FAR const struct ringbuf_s *rb,
+                                   unsigned int ndx, FAR void *data,
+                                   unsigned int len)
+{
+  unsigned int offset = ringbuf_offset(rb, ndx);
+  unsigned int first  = rb->rb_size - offset;
+
+  if (first > len)
+    {
+      first = len;
+    }
+
+  memcpy(data, &rb->rb_buffer[offset], first);
+  memcpy((FAR uint8_t *)data + first, rb->rb_buffer, len - first);
+}
+
+/****************************************************************************
+ * Name: ringbuf_init
+ *
+ * Description:
+ *   Initialize an empty ring buffer in the storage 'buffer' of 'size'
+ *   bytes.  This must not race with any other access to the ring buffer.
+ *
+ ****************************************************************************/
+
+static inline void ringbuf_init(FAR struct ringbuf_s *rb, FAR void *buffer,
+                                unsigned int size)
+{
+  DEBUGASSERT(size <= UINT_MAX / 2);
+
+  rb->rb_buffer  = (FAR uint8_t *)buffer;
+  rb->rb_size    = size;
+  rb->rb_head    = 0;
+  rb->rb_tail    = 0;
+  rb->rb_reserve = 0;
+}
+
+/****************************************************************************
+ * Name: ringbuf_used, ringbuf_space
+ *
+ * Description:
+ *   Return the number of bytes in the ring buffer and the number of bytes
+ *   that may still be added.  The result may be stale as soon as it is
+ *   returned unless the caller is the only producer (for ringbuf_space())
+ *   or the consumer (for ringbuf_used()).
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_used(FAR const struct ringbuf_s *rb)
+{
+  unsigned int tail = ringbuf_load_acquire(&rb->rb_tail);
+  unsigned int head = ringbuf_load_acquire(&rb->rb_head);
+
+  return ringbuf_count(rb, head, tail);
+}
+
+static inline unsigned int ringbuf_space(FAR const struct ringbuf_s *rb)
+{
+  return rb->rb_size - ringbuf_used(rb);
+}
+
+/****************************************************************************
+ * Name: ringbuf_put
+ *
+ * Description:
+ *   Single producer:  Add up to 'len' bytes to the ring buffer.
+ *
+ * Returned Value:
+ *   The number of bytes added, which is less than 'len' if the ring buffer
+ *   became full.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_put(FAR struct ringbuf_s *rb,
+                                       FAR const void *data,
+                                       unsigned int len)
+{
+  unsigned int head  = ringbuf_load(&rb->rb_head);
+  unsigned int tail  = ringbuf_load_acquire(&rb->rb_tail);
+  unsigned int space = rb->rb_size - ringbuf_count(rb, head, tail);
+
+  if (len > space)
+    {
+      len = space;
+    }
+
+  if (len > 0)
+    {
+      ringbuf_copyin(rb, head, data, len);
+      ringbuf_store_release(&rb->rb_head, ringbuf_wrap(rb, head + len));
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_reserve
+ *
+ * Description:
+ *   Single producer:  Return the contiguous free space at the head of the
+ *   ring buffer so that data can be produced in place.  The data becomes
+ *   visible to the consumer when it is committed with ringbuf_commit().
+ *
+ * Input Parameters:
+ *   rb  - The ring buffer
+ *   buf - The location to return the address of the free space
+ *
+ * Returned Value:
+ *   The number of contiguous bytes at 'buf' that may be written.  This
+ *   may be less than ringbuf_space() when the free space wraps around.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_reserve(FAR struct ringbuf_s *rb,
+                                           FAR uint8_t **buf)
+{
+  unsigned int head   = ringbuf_load(&rb->rb_head);
+  unsigned int tail   = ringbuf_load_acquire(&rb->rb_tail);
+  unsigned int space  = rb->rb_size - ringbuf_count(rb, head, tail);
+  unsigned int offset = ringbuf_offset(rb, head);
+
+  *buf = &rb->rb_buffer[offset];
+  return space < rb->rb_size - offset ? space : rb->rb_size - offset;
+}
+
+/****************************************************************************
+ * Name: ringbuf_commit
+ *
+ * Description:
+ *   Single producer:  Add 'len' bytes written to the space returned by
+ *   ringbuf_reserve() to the ring buffer.
+ *
+ ****************************************************************************/
+
+static inline void ringbuf_commit(FAR struct ringbuf_s *rb, unsigned int len)
+{
+  unsigned int head = ringbuf_load(&rb->rb_head);
+
+  DEBUGASSERT(len <= rb->rb_size -
+              ringbuf_count(rb, head, ringbuf_load(&rb->rb_tail)));
+  ringbuf_store_release(&rb->rb_head, ringbuf_wrap(rb, head + len));
+}
+
+/****************************************************************************
+ * Name: ringbuf_mpput
+ *
+ * Description:
+ *   Multiple producers:  Add all 'len' bytes to the ring buffer or nothing
+ *   at all.  This may be called from interrupt handlers and from any CPU.
+ *   Producers claim space in turn and then publish their data in the same
+ *   order, so the data of one call is never interleaved with that of
+ *   another.
+ *
+ * Returned Value:
+ *   'len' if the data was added; zero if there was not enough space.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_mpput(FAR struct ringbuf_s *rb,
+                                         FAR const void *data,
+                                         unsigned int len)
+{
+  unsigned int start;
+  unsigned int tail;
+  irqstate_t flags;
+
+#ifdef CONFIG_ARCH_HAVE_ATOMICS
+  unsigned int end;
+
+  /* Interrupts are disabled so that the claimed space is always published:
+   * An interrupt handler on this CPU would otherwise wait forever for the
+   * data of the interrupted producer.
+   */
+
+  flags = up_irq_save();
+
+  /* Claim the space */
+
+  do
+    {
+      start = atomic_read(&rb->rb_reserve);
+      tail  = atomic_read_acquire(&rb->rb_tail);
+
+      if (rb->rb_size - ringbuf_count(rb, start, tail) < len)
+        {
+          up_irq_restore(flags);
+          return 0;
+        }
+
+      end = ringbuf_wrap(rb, start + len);
+    }
+  while (!atomic_cmpxchg(&rb->rb_reserve, start, end));
+
+  ringbuf_copyin(rb, start, data, len);
+
+  /* Wait until the producers that claimed space before us have published
+   * their data, then publish ours.
+   */
+
+  while (atomic_read_acquire(&rb->rb_head) != start)
+    {
+    }
+
+  atomic_set_release(&rb->rb_head, end);
+  up_irq_restore(flags);
+#else
+  flags = enter_critical_section();
+
+  start = rb->rb_head;
+  tail  = ringbuf_load_acquire(&rb->rb_tail);
+
+  if (rb->rb_size - ringbuf_count(rb, start, tail) < len)
+    {
+      leave_critical_section(flags);
+      return 0;
+    }
+
+  ringbuf_copyin(rb, start, data, len);
+  ringbuf_store_release(&rb->rb_head, ringbuf_wrap(rb, start + len));
+  leave_critical_section(flags);
+#endif
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_get
+ *
+ * Description:
+ *   Consumer:  Remove up to 'len' bytes from the ring buffer.  If 'data' is
+ *   NULL, the bytes are discarded.
+ *
+ * Returned Value:
+ *   The number of bytes removed, which is less than 'len' if the ring
+ *   buffer became empty.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_get(FAR struct ringbuf_s *rb,
+                                       FAR void *data, unsigned int len)
+{
+  unsigned int tail = ringbuf_load(&rb->rb_tail);
+  unsigned int head = ringbuf_load_acquire(&rb->rb_head);
+  unsigned int used = ringbuf_count(rb, head, tail);
+
+  if (len > used)
+    {
+      len = used;
+    }
+
+  if (len > 0)
+    {
+      if (data != NULL)
+        {
+          ringbuf_copyout(rb, tail, data, len);
+        }
+
+      ringbuf_store_release(&rb->rb_tail, ringbuf_wrap(rb, tail + len));
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_claim
+ *
+ * Description:
+ *   Consumer:  Return the contiguous data at the tail of the ring buffer so
+ *   that it can be consumed in place.  The data stays in the ring buffer
+ *   until it is removed with ringbuf_consume().
+ *
+ * Input Parameters:
+ *   rb  - The ring buffer
+ *   buf - The location to return the address of the data
+ *
+ * Returned Value:
+ *   The number of contiguous bytes at 'buf'.  This may be less than
+ *   ringbuf_used() when the data wraps around.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ringbuf_claim(FAR struct ringbuf_s *rb,
+                                         FAR uint8_t **buf)
+{
+  unsigned int tail   = ringbuf_load(&rb->rb_tail);
+  unsigned int head   = ringbuf_load_acquire(&rb->rb_head);
+  unsigned int used   = ringbuf_count(rb, head, tail);
+  unsigned int offset = ringbuf_offset(rb, tail);
+
+  *buf = &rb->rb_buffer[offset];
+  return used < rb->rb_size - offset ? used : rb->rb_size - offset;
+}
+
+/****************************************************************************
+ * Name: ringbuf_consume
+ *
+ * Description:
+ *   Consumer:  Remove 'len' bytes claimed with ringbuf_claim() from the
+ *   ring buffer.
+ *
+ ****************************************************************************/
+
+static inline void ringbuf_consume(FAR struct ringbuf_s *rb, unsigned int len)
+{
+  unsigned int tail = ringbuf_load(&rb->rb_tail);
+
+  DEBUGASSERT(len <= ringbuf_count(rb, ringbuf_load(&rb->rb_head), tail));
+  ringbuf_store_release(&rb->rb_tail, ringbuf_wrap(rb, tail + len));
+}
+
+#endif /* __INCLUDE_NUTTX_RINGBUF_H */
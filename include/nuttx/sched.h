@@ -143,15 +143,16 @@
 #define TCB_FLAG_NONCANCELABLE     (1 << 2) /* Bit 2: Pthread is non-cancelable */
 #define TCB_FLAG_CANCEL_DEFERRED   (1 << 3) /* Bit 3: Deferred (vs asynch) cancellation type */
 #define TCB_FLAG_CANCEL_PENDING    (1 << 4) /* Bit 4: Pthread cancel is pending */
-#define TCB_FLAG_POLICY_SHIFT      (5) /* Bit 5-6: Scheduling policy */
-#define TCB_FLAG_POLICY_MASK       (3 << TCB_FLAG_POLICY_SHIFT)
+#define TCB_FLAG_POLICY_SHIFT      (5) /* Bit 5-7: Scheduling policy */
+#define TCB_FLAG_POLICY_MASK       (7 << TCB_FLAG_POLICY_SHIFT)
 #  define TCB_FLAG_SCHED_FIFO      (0 << TCB_FLAG_POLICY_SHIFT) /* FIFO scheding policy */
 #  define TCB_FLAG_SCHED_RR        (1 << TCB_FLAG_POLICY_SHIFT) /* Round robin scheding policy */
 #  define TCB_FLAG_SCHED_SPORADIC  (2 << TCB_FLAG_POLICY_SHIFT) /* Sporadic scheding policy */
 #  define TCB_FLAG_SCHED_OTHER     (3 << TCB_FLAG_POLICY_SHIFT) /* Other scheding policy */
-#define TCB_FLAG_CPU_LOCKED        (1 << 7) /* Bit 7: Locked to this CPU */
-#define TCB_FLAG_EXIT_PROCESSING   (1 << 8) /* Bit 8: Exitting */
-                                            /* Bits 9-15: Available */
+#  define TCB_FLAG_SCHED_DEADLINE  (4 << TCB_FLAG_POLICY_SHIFT) /* Deadline scheding policy */
+#define TCB_FLAG_CPU_LOCKED        (1 << 8) /* Bit 8: Locked to this CPU */
+#define TCB_FLAG_EXIT_PROCESSING   (1 << 9) /* Bit 9: Exitting */
+                                            /* Bits 10-15: Available */
 
 /* Values for struct task_group tg_flags */
 
@@ -307,6 +308,27 @@ struct sporadic_s
 
 #endif /* CONFIG_SCHED_SPORADIC */
 
+/* struct deadline_s *************************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/* This structure is an allocated "plug-in" to the main TCB structure.  It is
+ * allocated when the deadline scheduling policy is assigned to a thread.  The
+ * remaining runtime budget of the current job is kept in the TCB timeslice
+ * field.
+ */
+
+struct deadline_s
+{
+  uint32_t  runtime;                /* Execution budget per period              */
+  uint32_t  deadline;               /* Deadline relative to job release         */
+  uint32_t  period;                 /* Activation period                        */
+  uint32_t  bandwidth;              /* runtime/period, see DEADLINE_BW_SHIFT    */
+  systime_t absdeadline;            /* Absolute deadline of the current job     */
+};
+
+#endif /* CONFIG_SCHED_DEADLINE */
+
 /* struct child_status_s *********************************************************/
 /* This structure is used to maintain information about child tasks.  pthreads
  * work differently, they have join information.  This is only for child tasks.
@@ -571,6 +593,7 @@ struct tcb_s
   uint8_t  pend_reprios[CONFIG_SEM_NNESTPRIO];
 #endif
   uint8_t  base_priority;                /* "Normal" priority of the thread     */
+  FAR struct semholder_s *holdsem;       /* List of semaphores held by thread   */
 #endif
 
   uint8_t  task_state;                   /* Current state of the thread         */
@@ -587,15 +610,23 @@ struct tcb_s
   int16_t  cpcount;                      /* Nested cancellation point count     */
 #endif
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
   int32_t  timeslice;                    /* RR timeslice OR Sporadic budget     */
-                                         /* interval remaining                  */
+                                         /* interval remaining OR Deadline      */
+                                         /* runtime remaining                   */
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
   FAR struct sporadic_s *sporadic;       /* Sporadic scheduling parameters      */
 #endif
+#ifdef CONFIG_SCHED_DEADLINE
+  FAR struct deadline_s *deadline;       /* Deadline scheduling parameters      */
+#endif
 
   FAR struct wdog_s *waitdog;            /* All timed waits use this timer      */
+#ifdef CONFIG_WDOG_SLACK
+  uint32_t timerslack;                   /* Slack of waitdog in clock ticks     */
+#endif
 
   /* Stack-Related Fields *******************************************************/
 
@@ -726,6 +757,16 @@ struct pthread_tcb_s
 
 typedef void (*sched_foreach_t)(FAR struct tcb_s *tcb, FAR void *arg);
 
+/* This structure is used to report the task migration counts of a CPU */
+
+#ifdef CONFIG_SMP_LOADBALANCE
+struct cpumigrate_s
+{
+  uint32_t migrations;       /* Tasks started here after running elsewhere */
+  uint32_t balanced;         /* Tasks moved here by the load balancer */
+};
+#endif
+
 #endif /* __ASSEMBLY__ */
 
 /********************************************************************************
@@ -780,6 +821,25 @@ FAR struct streamlist *sched_getstreams(void);
 FAR struct socketlist *sched_getsockets(void);
 #endif /* CONFIG_NSOCKET_DESCRIPTORS */
 
+/********************************************************************************
+ * Name: sched_cpumigrate
+ *
+ * Description:
+ *   Return the task migration counts of a CPU.
+ *
+ * Inputs:
+ *   cpu - The index of the CPU of interest.
+ *   stats - The location to return the counts.
+ *
+ * Return:
+ *   OK (0) on success; -EINVAL if 'cpu' is not a valid CPU index.
+ *
+ ********************************************************************************/
+
+#ifdef CONFIG_SMP_LOADBALANCE
+int sched_cpumigrate(int cpu, FAR struct cpumigrate_s *stats);
+#endif
+
 /********************************************************************************
  * Name: task_starthook
  *
@@ -849,7 +909,8 @@ void task_vforkabort(FAR struct task_tcb_s *child, int errcode);
  ********************************************************************************/
 
 #if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
-    defined(CONFIG_SCHED_INSTRUMENTATION)
+    defined(CONFIG_SCHED_INSTRUMENTATION) || \
+    defined(CONFIG_SCHED_CPULOAD_PRECISE)
 void sched_resume_scheduler(FAR struct tcb_s *tcb);
 #else
 #  define sched_resume_scheduler(tcb)
@@ -871,7 +932,8 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb);
  *
  ********************************************************************************/
 
-#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION)
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION) || \
+    defined(CONFIG_SCHED_CPULOAD_PRECISE)
 void sched_suspend_scheduler(FAR struct tcb_s *tcb);
 #else
 #  define sched_suspend_scheduler(tcb)
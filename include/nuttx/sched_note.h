@@ -106,6 +106,11 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DEADLINE
+  ,
+  NOTE_DEADLINE_RELEASE = 18,
+  NOTE_DEADLINE_OVERRUN = 19
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -119,7 +124,8 @@ struct note_common_s
   uint8_t nc_cpu;              /* CPU thread/task running on */
 #endif
   uint8_t nc_pid[2];           /* ID of the thread/task */
-  uint8_t nc_systime[4];       /* Time when note was buffered */
+  uint8_t nc_systime[4];       /* Time when note was buffered (see
+                                * CONFIG_SCHED_NOTE_HIRES) */
 };
 
 /* This is the specific form of the NOTE_START note */
@@ -234,6 +240,16 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DEADLINE
+/* This is the specific form of the NOTE_DEADLINE_RELEASE/OVERRUN note */
+
+struct note_deadline_s
+{
+  struct note_common_s nde_cmn; /* Common note parameters */
+  uint8_t nde_deadline[4];      /* Absolute deadline of the job */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_DEADLINE */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
@@ -305,11 +321,17 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 #  define sched_note_spinabort(t,s)
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DEADLINE
+void sched_note_deadline(FAR struct tcb_s *tcb, bool overrun);
+#else
+#  define sched_note_deadline(t,o)
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
  * Description:
- *   Remove the next note from the tail of the circular buffer.  The note
+ *   Remove the next note from the tail of a circular buffer.  The note
  *   is also removed from the circular buffer to make room for futher notes.
  *
  * Input Parameters:
@@ -328,18 +350,42 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: sched_note_read
+ *
+ * Description:
+ *   Remove as many whole notes as fit into the user buffer from the
+ *   circular buffers.  The notes of each CPU are returned in the order
+ *   in which they were added; the notes of different CPUs are not merged.
+ *
+ * Input Parameters:
+ *   buffer - Location to return the notes
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   On success, the positive, non-zero number of bytes returned.  Zero is
+ *   returned only if the circular buffers are empty.  A negated errno
+ *   value is returned in the event of any failure.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_BUFFER) && \
+    defined(CONFIG_SCHED_NOTE_GET)
+ssize_t sched_note_read(FAR uint8_t *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: sched_note_size
  *
  * Description:
- *   Return the size of the next note at the tail of the circular buffer.
+ *   Return the size of the next note that sched_note_get() would return.
  *
  * Input Parameters:
  *   None.
  *
  * Returned Value:
- *   Zero is returned if the circular buffer is empty.  Otherwise, the size
- *   of the next note is returned.
+ *   Zero is returned if the circular buffers are empty.  Otherwise, the
+ *   size of the next note is returned.
  *
  ****************************************************************************/
 
@@ -387,6 +433,7 @@ int note_register(void);
 #  define sched_note_spinlocked(t,s)
 #  define sched_note_spinunlock(t,s)
 #  define sched_note_spinabort(t,s)
+#  define sched_note_deadline(t,o)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
@@ -57,6 +57,12 @@
 #define SEM_PRIO_INHERIT          1
 #define SEM_PRIO_PROTECT          2
 
+/* This bit may be OR'ed with the protocol to select adaptive (spin-then-
+ * block) waits on the semaphore.  See CONFIG_SEM_ADAPTIVE.
+ */
+
+#define SEM_ADAPTIVE              (1 << 4)
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -187,6 +193,11 @@ int sem_getprotocol(FAR sem_t *sem, FAR int *protocol);
  *    the sem_init() call so that there will be no priority inheritance
  *    operations on this semaphore.
  *
+ *    If CONFIG_SEM_ADAPTIVE is enabled, SEM_ADAPTIVE may be OR'ed with the
+ *    protocol.  A task that waits for an adaptive semaphore spins for a
+ *    bounded time while the holder is running on another CPU before it
+ *    blocks.
+ *
  * Parameters:
  *    sem      - A pointer to the semaphore whose attributes are to be
  *               modified
@@ -200,6 +211,28 @@ int sem_getprotocol(FAR sem_t *sem, FAR int *protocol);
 
 int sem_setprotocol(FAR sem_t *sem, int protocol);
 
+/****************************************************************************
+ * Name: sem_getstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of a semaphore.  This is a debug
+ *   interface; the snapshot is taken without locking so the fields may not
+ *   be perfectly consistent with each other.
+ *
+ * Parameters:
+ *   sem   - The semaphore to be queried
+ *   stats - The location to return the statistics
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+int sem_getstats(FAR sem_t *sem, FAR struct semstat_s *stats);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
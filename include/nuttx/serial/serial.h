@@ -51,6 +51,7 @@
 #endif
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/ringbuf.h>
 
 /************************************************************************************
  * Pre-processor Definitions
@@ -121,17 +122,16 @@
  ************************************************************************************/
 
 /* This structure defines one serial I/O buffer.  The serial infrastructure will
- * initialize the 'sem' field but all other fields must be initialized by the
- * caller of uart_register().
+ * initialize the 'sem' and 'rb' fields but 'size' and 'buffer' must be
+ * initialized by the caller of uart_register().
  */
 
 struct uart_buffer_s
 {
   sem_t            sem;    /* Used to control exclusive access to the buffer */
-  volatile int16_t head;   /* Index to the head [IN] index in the buffer */
-  volatile int16_t tail;   /* Index to the tail [OUT] index in the buffer */
   int16_t          size;   /* The allocated size of the buffer */
   FAR char        *buffer; /* Pointer to the allocated buffer memory */
+  struct ringbuf_s rb;     /* Head and tail of the data in 'buffer' */
 };
 
 #ifdef CONFIG_SERIAL_DMA
@@ -327,6 +327,77 @@ struct uart_dev_s
 
 typedef struct uart_dev_s uart_dev_t;
 
+/************************************************************************************
+ * Inline Functions
+ ************************************************************************************/
+
+/************************************************************************************
+ * Name: uart_buffer_*
+ *
+ * Description:
+ *   Access a serial I/O buffer.  The xmit buffer is filled by the upper half and
+ *   drained by the lower half; the recv buffer is filled by the lower half and
+ *   drained by the upper half.  With one producer and one consumer, neither side
+ *   needs a critical section to move data.  All 'size' bytes of the buffer are
+ *   usable.
+ *
+ *   uart_buffer_reset() empties the buffer.  It must not race with the producer
+ *   or the consumer.
+ *
+ ************************************************************************************/
+
+static inline void uart_buffer_reset(FAR struct uart_buffer_s *buf)
+{
+  ringbuf_init(&buf->rb, buf->buffer, buf->size);
+}
+
+static inline unsigned int uart_buffer_used(FAR const struct uart_buffer_s *buf)
+{
+  return ringbuf_used(&buf->rb);
+}
+
+static inline unsigned int uart_buffer_space(FAR const struct uart_buffer_s *buf)
+{
+  return ringbuf_space(&buf->rb);
+}
+
+static inline unsigned int uart_buffer_put(FAR struct uart_buffer_s *buf,
+                                           FAR const char *data,
+                                           unsigned int len)
+{
+  return ringbuf_put(&buf->rb, data, len);
+}
+
+static inline unsigned int uart_buffer_reserve(FAR struct uart_buffer_s *buf,
+                                               FAR char **data)
+{
+  return ringbuf_reserve(&buf->rb, (FAR uint8_t **)data);
+}
+
+static inline void uart_buffer_commit(FAR struct uart_buffer_s *buf,
+                                      unsigned int len)
+{
+  ringbuf_commit(&buf->rb, len);
+}
+
+static inline unsigned int uart_buffer_get(FAR struct uart_buffer_s *buf,
+                                           FAR char *data, unsigned int len)
+{
+  return ringbuf_get(&buf->rb, data, len);
+}
+
+static inline unsigned int uart_buffer_claim(FAR struct uart_buffer_s *buf,
+                                             FAR char **data)
+{
+  return ringbuf_claim(&buf->rb, (FAR uint8_t **)data);
+}
+
+static inline void uart_buffer_consume(FAR struct uart_buffer_s *buf,
+                                       unsigned int len)
+{
+  ringbuf_consume(&buf->rb, len);
+}
+
 /************************************************************************************
  * Public Data
  ************************************************************************************/
@@ -44,6 +44,9 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/irq.h>
 
 #ifdef CONFIG_SPINLOCK
 
@@ -112,6 +115,28 @@ struct spinlock_s
 #endif
 };
 
+#ifdef CONFIG_SPINLOCK_STATS
+/* This structure holds the lock statistics of one registered spinlock.
+ * Times are in units of the architecture performance counter (see
+ * up_perf_getfreq()).  The statistics of a lock are only modified by the
+ * CPU that holds the lock so no additional protection is needed.
+ */
+
+struct spinstat_s
+{
+  FAR struct spinstat_s *flink;      /* Supports a singly linked list */
+  FAR volatile spinlock_t *lock;     /* The monitored spinlock */
+  FAR const char *name;              /* Name shown in /proc/spinlocks */
+  uint32_t locktime;                 /* Counter value when the lock was taken */
+  uint32_t nlocks;                   /* Number of times the lock was taken */
+  uint32_t ncontended;               /* Number of times the caller had to spin */
+  uint32_t maxspin;                  /* Longest wait for the lock */
+  uint32_t maxhold;                  /* Longest time that the lock was held */
+  uint64_t spintime;                 /* Accumulated wait time */
+  uint64_t holdtime;                 /* Accumulated hold time */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -363,5 +388,135 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *setlock,
                  FAR volatile spinlock_t *orlock);
 
+/****************************************************************************
+ * Name: spin_lock_irqsave
+ *
+ * Description:
+ *   Disable interrupts on the local CPU, then loop until the spinlock is
+ *   successfully locked.  This is the light-weight alternative to
+ *   enter_critical_section() for data that is private to one subsystem:
+ *   Only the CPUs that access the same data are serialized.
+ *
+ *   The lock is non-reentrant.  The lock must be a leaf lock:  It may be
+ *   taken while in a critical section, but enter_critical_section(),
+ *   up_cpu_pause() or any other operation that may wait for another CPU
+ *   must not be called while the lock is held.
+ *
+ *   If SMP is not enabled, this simply disables local interrupts.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *
+ * Returned Value:
+ *   The previous interrupt state that must be passed to
+ *   spin_unlock_irqrestore().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_irqsave(FAR volatile spinlock_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore
+ *
+ * Description:
+ *   Release a spinlock taken by spin_lock_irqsave() and restore the
+ *   interrupt state of the local CPU.
+ *
+ *   If SMP is not enabled, this simply restores local interrupts.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the spinlock object to unlock.
+ *   flags - The value returned by spin_lock_irqsave()
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_irqrestore(FAR volatile spinlock_t *lock, irqstate_t flags);
+#endif
+
+/****************************************************************************
+ * Name: spin_register
+ *
+ * Description:
+ *   Register a spinlock so that its wait and hold times are measured and
+ *   reported in /proc/spinlocks.  Only locks taken with
+ *   spin_lock_irqsave() or via enter_critical_section() are measured.
+ *
+ * Input Parameters:
+ *   stat - Caller provided storage for the statistics.  This must persist
+ *          for the life of the system.
+ *   lock - The spinlock to be monitored
+ *   name - A name that identifies the lock
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called during initialization before the lock is used.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spin_register(FAR struct spinstat_s *stat,
+                   FAR volatile spinlock_t *lock, FAR const char *name);
+#endif
+
+/****************************************************************************
+ * Name: spin_getstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of a registered spinlock.
+ *
+ * Input Parameters:
+ *   index - The index of the registered lock (in order of registration)
+ *   stat  - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if there is no
+ *   lock with this index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+int spin_getstats(int index, FAR struct spinstat_s *stat);
+#endif
+
+/****************************************************************************
+ * Name: spinstat_wait, spinstat_lock, and spinstat_unlock
+ *
+ * Description:
+ *   Internal hooks used by the spinlock and critical section logic to
+ *   update the statistics of a registered spinlock:
+ *
+ *   spinstat_wait   - The lock was taken after spinning since 'start'
+ *   spinstat_lock   - The lock became held
+ *   spinstat_unlock - The lock is about to be released
+ *
+ *   Nothing is done for locks that are not registered.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spinstat_wait(FAR volatile spinlock_t *lock, uint32_t start,
+                   bool contended);
+void spinstat_lock(FAR volatile spinlock_t *lock);
+void spinstat_unlock(FAR volatile spinlock_t *lock);
+#endif
+
 #endif /* CONFIG_SPINLOCK */
+
+/* Without SMP there is nothing to lock against other than the interrupt
+ * handlers on the same CPU.
+ */
+
+#ifndef CONFIG_SMP
+#  define spin_lock_irqsave(l)        up_irq_save()
+#  define spin_unlock_irqrestore(l,f) up_irq_restore(f)
+#endif
+
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
@@ -68,34 +68,51 @@
 #  error CONFIG_WDOG_INTRESERVE >= CONFIG_PREALLOC_WDOGS
 #endif
 
+#ifndef CONFIG_WDOG_NEXPAND
+#  define CONFIG_WDOG_NEXPAND 4
+#endif
+
+#ifndef CONFIG_WDOG_WHEELBITS
+#  define CONFIG_WDOG_WHEELBITS 6
+#endif
+
 /* Watchdog Definitions *************************************************/
 /* Flag bits for the flags field of struct wdog_s */
 
 #define WDOGF_ACTIVE       (1 << 0) /* Bit 0: 1=Watchdog is actively timing */
-#define WDOGF_ALLOCED      (1 << 1) /* Bit 1: 0=Pre-allocated, 1=Allocated */
-#define WDOGF_STATIC       (1 << 2) /* Bit 2: 0=[Pre-]allocated, 1=Static */
+#define WDOGF_STATIC       (1 << 1) /* Bit 1: 0=Pool, 1=Static */
 
 #define WDOG_SETACTIVE(w)  do { (w)->flags |= WDOGF_ACTIVE; } while (0)
-#define WDOG_SETALLOCED(w) do { (w)->flags |= WDOGF_ALLOCED; } while (0)
 #define WDOG_SETSTATIC(w)  do { (w)->flags |= WDOGF_STATIC; } while (0)
 
 #define WDOG_CLRACTIVE(w)  do { (w)->flags &= ~WDOGF_ACTIVE; } while (0)
-#define WDOG_CLRALLOCED(w) do { (w)->flags &= ~WDOGF_ALLOCED; } while (0)
 #define WDOG_CLRSTATIC(w)  do { (w)->flags &= ~WDOGF_STATIC; } while (0)
 
 #define WDOG_ISACTIVE(w)   (((w)->flags & WDOGF_ACTIVE) != 0)
-#define WDOG_ISALLOCED(w)  (((w)->flags & WDOGF_ALLOCED) != 0)
 #define WDOG_ISSTATIC(w)   (((w)->flags & WDOGF_STATIC) != 0)
 
+#ifdef CONFIG_WDOG_SLACK
+#  define WDOG_CLRSLACK(w) do { (w)->slack = 0; } while (0)
+#else
+#  define WDOG_CLRSLACK(w)
+#endif
+
 /* Initialization of statically allocated timers ****************************/
 
 #define wd_static(w) \
-  do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
+  do \
+    { \
+      (w)->next  = NULL; \
+      (w)->prev  = NULL; \
+      (w)->flags = WDOGF_STATIC; \
+      WDOG_CLRSLACK(w); \
+    } \
+  while (0)
 
 #ifdef CONFIG_PIC
-#  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
-#  define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #endif
 
 /****************************************************************************
@@ -134,21 +151,37 @@ typedef CODE void (*wdentry_t)(int argc, wdparm_t arg1, ...);
 
 struct wdog_s
 {
-  FAR struct wdog_s *next;       /* Support for singly linked lists. */
+  FAR struct wdog_s *next;       /* Support for doubly linked lists. */
+  FAR struct wdog_s *prev;       /* (must be first, see dq_entry_t) */
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
-  int                lag;        /* Timer associated with the delay */
+  uint32_t           expire;     /* Watchdog time when the delay expires */
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_WDOG_SLACK
+  uint32_t           slack;      /* Permitted lateness in clock ticks */
+#endif
 };
 
 /* Watchdog 'handle' */
 
 typedef FAR struct wdog_s *WDOG_ID;
 
+#ifdef CONFIG_WDOG_SLACK
+/* Watchdog expiration statistics returned by wd_getstats() */
+
+struct wdstats_s
+{
+  uint32_t nwakeups;   /* Number of interval timer events that expired
+                        * one or more watchdogs */
+  uint32_t ncoalesced; /* Number of additional distinct expiration times
+                        * that were handled by those same events */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -277,6 +310,54 @@ int wd_cancel(WDOG_ID wdog);
 
 int wd_gettime(WDOG_ID wdog);
 
+/****************************************************************************
+ * Name: wd_setslack
+ *
+ * Description:
+ *   Set the timer slack of a watchdog:  The watchdog function may then be
+ *   called up to 'slack' ticks after the watchdog expires so that its
+ *   expiration can be handled by the same interval timer event as other
+ *   nearby expirations.  The watchdog never expires early.
+ *
+ *   A new watchdog has no slack.  The slack is retained when the watchdog
+ *   is restarted.
+ *
+ * Parameters:
+ *   wdog  - watchdog ID
+ *   slack - The permitted lateness in clock ticks
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success;  A negated errno value is returned to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_SLACK
+int wd_setslack(WDOG_ID wdog, uint32_t slack);
+#else
+#  define wd_setslack(w,s) ((void)(w), (void)(s), OK)
+#endif
+
+/****************************************************************************
+ * Name: wd_getstats
+ *
+ * Description:
+ *   Return the watchdog expiration statistics.  The ratio of 'ncoalesced'
+ *   to 'nwakeups' shows how many timer interrupts were avoided by timer
+ *   slack.
+ *
+ * Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_SLACK
+void wd_getstats(FAR struct wdstats_s *stats);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
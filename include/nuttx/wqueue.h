@@ -272,6 +272,10 @@
 
 #endif /* CONFIG_LIB_USRWORK && !__KERNEL__ */
 
+/* Selects the CPU that queues the work in work_queue_oncpu() */
+
+#define WORK_CPU_CURRENT (-1)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -294,6 +298,9 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   systime_t qtime;       /* Time work queued */
   systime_t delay;       /* Delay until work performed */
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  uint8_t   cpu;         /* CPU of the high priority work queue */
+#endif
 };
 
 /****************************************************************************
@@ -363,6 +370,41 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, systime_t delay);
 
+/****************************************************************************
+ * Name: work_queue_oncpu
+ *
+ * Description:
+ *   Queue work to be performed at a later time on the high priority work
+ *   queue of the selected CPU.  The work will be performed by the worker
+ *   thread of that CPU.  This is otherwise the same as work_queue().
+ *
+ *   Without CONFIG_SCHED_HPWORK_PERCPU, or for work queues other than
+ *   HPWORK, the CPU is ignored and this is the same as work_queue().
+ *
+ * Input parameters:
+ *   qid    - The work queue ID
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            it is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *   cpu    - The CPU whose work queue is used.  WORK_CPU_CURRENT selects
+ *            the CPU that calls work_queue_oncpu().
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+int work_queue_oncpu(int qid, FAR struct work_s *work, worker_t worker,
+                     FAR void *arg, systime_t delay, int cpu);
+#else
+#  define work_queue_oncpu(q,w,k,a,d,c) work_queue(q,w,k,a,d)
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -337,6 +337,30 @@ typedef struct pthread_barrier_s pthread_barrier_t;
 typedef bool pthread_once_t;
 #define __PTHREAD_ONCE_T_DEFINED 1
 
+#ifdef CONFIG_PTHREAD_RWLOCK_ATOMIC
+/* Bits of struct pthread_rwlock_s state.  These are non-standard and
+ * intended only for internal use within the C library.
+ */
+
+#define _PTHREAD_RWLOCK_WRITER  (1 << 30)       /* Writer holds the lock */
+#define _PTHREAD_RWLOCK_WRWAIT  (1 << 29)       /* Writer waits for readers */
+#define _PTHREAD_RWLOCK_READERS ((1 << 29) - 1) /* Number of readers */
+
+struct pthread_rwlock_s
+{
+  volatile int32_t state;  /* Number of readers and _PTHREAD_RWLOCK_* bits */
+  pid_t writer;            /* ID of the writer holding the lock */
+  sem_t wrsem;             /* Held by the writer */
+  sem_t rdsem;             /* Posted by the last reader for a waiting writer */
+};
+
+typedef struct pthread_rwlock_s pthread_rwlock_t;
+
+typedef int pthread_rwlockattr_t;
+
+#define PTHREAD_RWLOCK_INITIALIZER  {0, -1, SEM_INITIALIZER(1), \
+                                     SEM_INITIALIZER(0)}
+#else
 struct pthread_rwlock_s
 {
     pthread_mutex_t lock;
@@ -353,6 +377,7 @@ typedef int pthread_rwlockattr_t;
 #define PTHREAD_RWLOCK_INITIALIZER  {PTHREAD_MUTEX_INITIALIZER, \
                                      PTHREAD_COND_INITIALIZER, \
                                      0, 0, false}
+#endif
 
 #ifdef CONFIG_PTHREAD_CLEANUP
 /* This type describes the pthread cleanup callback (non-standard) */
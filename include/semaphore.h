@@ -42,6 +42,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
 #include <limits.h>
 
@@ -57,6 +58,8 @@
 
 #define PRIOINHERIT_FLAGS_DISABLE (1 << 0)  /* Bit 0: Priority inheritance
                                              * is disabled for this semaphore. */
+#define ADAPTIVE_FLAGS_ENABLE     (1 << 1)  /* Bit 1: Spin before blocking
+                                             * on this semaphore. */
 
 /****************************************************************************
  * Public Type Declarations
@@ -66,39 +69,71 @@
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 struct tcb_s; /* Forward reference */
+struct sem_s; /* Forward reference */
 struct semholder_s
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   struct semholder_s *flink;     /* Implements singly linked list */
 #endif
+  FAR struct semholder_s *tlink; /* List of holders with the same TCB */
+  FAR struct sem_s *sem;         /* The semaphore that is held */
   FAR struct tcb_s *htcb;        /* Holder TCB */
   int16_t counts;                /* Number of counts owned by this holder */
 };
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#  define SEMHOLDER_INITIALIZER {NULL, NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, NULL, NULL, 0}
 #else
-#  define SEMHOLDER_INITIALIZER {NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, NULL, 0}
 #endif
 #endif /* CONFIG_PRIORITY_INHERITANCE */
 
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+/* Statistics of one semaphore.  Times are in units of the architecture
+ * performance counter (see up_perf_getfreq()).
+ */
+
+struct semstat_s
+{
+  uint32_t locktime;             /* Counter value when a count was taken */
+  uint32_t nspins;               /* Number of waits satisfied by spinning */
+  uint32_t nblocks;              /* Number of waits that blocked */
+  uint32_t maxhold;              /* Longest hold time */
+  uint64_t holdtime;             /* Accumulated hold time */
+};
+#endif
+
 /* This is the generic semaphore structure. */
 
 struct sem_s
 {
   volatile int16_t semcount;     /* >0 -> Num counts available */
                                  /* <0 -> Num tasks waiting for semaphore */
+#if defined(CONFIG_PRIORITY_INHERITANCE) || defined(CONFIG_SEM_ADAPTIVE)
+  uint8_t flags;                 /* See *_FLAGS_* definitions */
+#endif
+
   /* If priority inheritance is enabled, then we have to keep track of which
    * tasks hold references to the semaphore.
    */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
-  uint8_t flags;                 /* See PRIOINHERIT_FLAGS_* definitions */
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *hhead; /* List of holders of semaphore counts */
 # else
   struct semholder_s holder[2];  /* Slot for old and new holder */
 # endif
+#endif
+
+  /* An adaptive semaphore must know if the holder is running.  These fields
+   * are last so that they are zeroed by the initializers below.
+   */
+
+#ifdef CONFIG_SEM_ADAPTIVE
+  pid_t hpid;                    /* Most recent holder (0: none) */
+# ifdef CONFIG_SEM_ADAPTIVE_STATS
+  struct semstat_s stats;        /* Statistics, see sem_getstats() */
+# endif
 #endif
 };
 
@@ -116,7 +151,7 @@ typedef struct sem_s sem_t;
 # endif
 #else
 #  define SEM_INITIALIZER(c) \
-    {(c)}                        /* semcount */
+    {(c)}                        /* semcount (remaining fields zeroed) */
 #endif
 
 /****************************************************************************
@@ -94,6 +94,8 @@ struct mallinfo
                  * chunks handed out by malloc. */
   int fordblks; /* This is the total size of memory occupied
                  * by free (not in use) chunks.*/
+  int fsmblks;  /* This is the portion of fordblks that is held in
+                 * per-CPU small allocation caches (CONFIG_MM_CPUCACHE) */
 };
 
 /* Structure type returned by the div() function. */
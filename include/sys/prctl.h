@@ -63,10 +63,31 @@
  *
  *      char myname[CONFIG_TASK_NAME_SIZE];
  *      prctl(PR_GET_NAME, myname, 0);
+ *
+ *  PR_SET_TIMERSLACK
+ *    Set the timer slack for the thread whose ID is in required arg2 (int)
+ *    to the number of nanoseconds in required arg1 (unsigned long).  The
+ *    timeouts of the timed waits of that thread may then expire up to that
+ *    much later than requested so that they can share a timer interrupt
+ *    with other timers.  The value is truncated to whole clock ticks.  New
+ *    tasks and threads inherit the timer slack of their parent.  Requires
+ *    CONFIG_WDOG_SLACK.  As an example:
+ *
+ *      prctl(PR_SET_TIMERSLACK, 50000000, 0);
+ *
+ *  PR_GET_TIMERSLACK
+ *    Return the timer slack in nanoseconds of the thread whose ID is in
+ *    required arg2 (int) in the location pointed to by required arg1
+ *    (unsigned long *).  As an example:
+ *
+ *      unsigned long slack;
+ *      prctl(PR_GET_TIMERSLACK, &slack, 0);
  */
 
-#define PR_SET_NAME 1
-#define PR_GET_NAME 2
+#define PR_SET_NAME       1
+#define PR_GET_NAME       2
+#define PR_SET_TIMERSLACK 3
+#define PR_GET_TIMERSLACK 4
 
 /****************************************************************************
  * Public Type Definitions
@@ -410,9 +410,16 @@
 #  define SYS_pthread_key_delete       (__SYS_pthread+11)
 #  define SYS_pthread_mutex_destroy    (__SYS_pthread+12)
 #  define SYS_pthread_mutex_init       (__SYS_pthread+13)
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#  define SYS_pthread_mutex_wait       (__SYS_pthread+14)
+#  define SYS_pthread_mutex_trywait    (__SYS_pthread+15)
+#  define SYS_pthread_mutex_wake       (__SYS_pthread+16)
+#else
 #  define SYS_pthread_mutex_lock       (__SYS_pthread+14)
 #  define SYS_pthread_mutex_trylock    (__SYS_pthread+15)
 #  define SYS_pthread_mutex_unlock     (__SYS_pthread+16)
+#endif
 
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
 #  define SYS_pthread_mutex_consistent (__SYS_pthread+17)
@@ -468,7 +475,15 @@
 #  define SYS_mq_timedreceive          (__SYS_mqueue+7)
 #  define SYS_mq_timedsend             (__SYS_mqueue+8)
 #  define SYS_mq_unlink                (__SYS_mqueue+9)
-#  define __SYS_environ                (__SYS_mqueue+10)
+#  define __SYS_mqueue_zerocopy        (__SYS_mqueue+10)
+
+#  ifdef CONFIG_MQ_ZEROCOPY
+#    define SYS_mq_receivebuf          (__SYS_mqueue_zerocopy+0)
+#    define SYS_mq_sendbuf             (__SYS_mqueue_zerocopy+1)
+#    define __SYS_environ              (__SYS_mqueue_zerocopy+2)
+#  else
+#    define __SYS_environ              __SYS_mqueue_zerocopy
+#  endif
 #else
 #  define __SYS_environ                __SYS_mqueue
 #endif
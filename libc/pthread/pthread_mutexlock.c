@@ -0,0 +1,91 @@
+/****************************************************************************
+ * libc/pthread/pthread_mutexlock.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/pthread.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_lock
+ *
+ * Description:
+ *   Lock the mutex.  An uncontended mutex that qualifies for the fast path
+ *   (see pthread_mutex_fastpath()) is taken with a single compare-and-
+ *   exchange on the count of its semaphore:  1 (available) -> 0 (locked).
+ *   Otherwise, the kernel takes the mutex, waiting if necessary.
+ *
+ *   The holder is also recorded in the semaphore so that an adaptive mutex
+ *   taken on the fast path still lets waiters on other CPUs spin while the
+ *   holder is running.
+ *
+ * Parameters:
+ *   mutex - A reference to the mutex to be locked.
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.  See pthread_mutex_wait().
+ *
+ ****************************************************************************/
+
+int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
+{
+  if (mutex != NULL && pthread_mutex_fastpath(mutex) &&
+      atomic_cmpxchg(&mutex->sem.semcount, 1, 0))
+    {
+      mutex->pid = (int)getpid();
+#ifdef CONFIG_SEM_ADAPTIVE
+      mutex->sem.hpid = mutex->pid;
+#endif
+      return OK;
+    }
+
+  return pthread_mutex_wait(mutex);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
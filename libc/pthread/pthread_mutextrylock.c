@@ -0,0 +1,93 @@
+/****************************************************************************
+ * libc/pthread/pthread_mutextrylock.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/pthread.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_trylock
+ *
+ * Description:
+ *   Lock the mutex only if it is available.  A mutex that qualifies for the
+ *   fast path (see pthread_mutex_fastpath()) is tried with a single
+ *   compare-and-exchange on the count of its semaphore and the kernel is
+ *   not entered at all.  Any other mutex is tried by the kernel.
+ *
+ * Parameters:
+ *   mutex - A reference to the mutex to be locked.
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.  EBUSY is returned if the
+ *   mutex is already locked.  See pthread_mutex_trywait().
+ *
+ ****************************************************************************/
+
+int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+{
+  if (mutex != NULL && pthread_mutex_fastpath(mutex))
+    {
+      if (!atomic_cmpxchg(&mutex->sem.semcount, 1, 0))
+        {
+          return EBUSY;
+        }
+
+      mutex->pid = (int)getpid();
+#ifdef CONFIG_SEM_ADAPTIVE
+      mutex->sem.hpid = mutex->pid;
+#endif
+      return OK;
+    }
+
+  return pthread_mutex_trywait(mutex);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
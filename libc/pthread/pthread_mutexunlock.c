@@ -0,0 +1,105 @@
+/****************************************************************************
+ * libc/pthread/pthread_mutexunlock.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <pthread.h>
+#include <semaphore.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/pthread.h>
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_unlock
+ *
+ * Description:
+ *   Unlock the mutex.  A mutex that qualifies for the fast path (see
+ *   pthread_mutex_fastpath()) and has no waiters is released with a single
+ *   compare-and-exchange on the count of its semaphore:  0 (locked) -> 1
+ *   (available).  If there are waiters, the kernel releases the mutex and
+ *   wakes up the highest priority waiter.
+ *
+ *   The holder is cleared before the count is updated since another thread
+ *   may take the mutex as soon as it is.  That is only safe because the
+ *   fast path is restricted to non-robust NORMAL mutexes:  For those, the
+ *   holder is not checked on unlock and unlocking a mutex that the caller
+ *   does not hold is undefined.  The holder is restored if the kernel must
+ *   be entered; no other thread can take the mutex in the meantime because
+ *   the count is still negative.
+ *
+ * Parameters:
+ *   mutex - A reference to the mutex to be unlocked.
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.  See pthread_mutex_wake().
+ *
+ ****************************************************************************/
+
+int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+{
+  if (mutex != NULL && pthread_mutex_fastpath(mutex))
+    {
+      pid_t pid = mutex->pid;
+
+      mutex->pid = -1;
+#ifdef CONFIG_SEM_ADAPTIVE
+      mutex->sem.hpid = 0;
+#endif
+
+      if (atomic_cmpxchg(&mutex->sem.semcount, 0, 1))
+        {
+          return OK;
+        }
+
+      mutex->pid = pid;
+#ifdef CONFIG_SEM_ADAPTIVE
+      mutex->sem.hpid = pid;
+#endif
+    }
+
+  return pthread_mutex_wake(mutex);
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
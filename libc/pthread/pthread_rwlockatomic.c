@@ -0,0 +1,194 @@
+/****************************************************************************
+ * libc/pthread/pthread_rwlockatomic.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_PTHREAD_RWLOCK_ATOMIC
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_rwlock_init
+ *
+ * Description:
+ *   Initialize a read/write lock.  Attributes are not supported.
+ *
+ * Parameters:
+ *   rw_lock - The read/write lock to be initialized
+ *   attr    - Must be NULL
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_init(FAR pthread_rwlock_t *rw_lock,
+                        FAR const pthread_rwlockattr_t *attr)
+{
+  if (attr != NULL)
+    {
+      return ENOSYS;
+    }
+
+  rw_lock->state  = 0;
+  rw_lock->writer = -1;
+
+  (void)sem_init(&rw_lock->wrsem, 0, 1);
+  (void)sem_init(&rw_lock->rdsem, 0, 0);
+
+  /* rdsem is used for signaling and must not participate in priority
+   * inheritance.
+   */
+
+  (void)sem_setprotocol(&rw_lock->rdsem, SEM_PRIO_NONE);
+#ifdef CONFIG_PTHREAD_RWLOCK_PRIO_INHERIT
+  (void)sem_setprotocol(&rw_lock->wrsem, SEM_PRIO_INHERIT);
+#else
+  (void)sem_setprotocol(&rw_lock->wrsem, SEM_PRIO_NONE);
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_rwlock_destroy
+ *
+ * Description:
+ *   Destroy a read/write lock that is not held.
+ *
+ * Parameters:
+ *   rw_lock - The read/write lock to be destroyed
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_destroy(FAR pthread_rwlock_t *rw_lock)
+{
+  if (atomic_read(&rw_lock->state) != 0)
+    {
+      return EBUSY;
+    }
+
+  (void)sem_destroy(&rw_lock->rdsem);
+  (void)sem_destroy(&rw_lock->wrsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pthread_rwlock_unlock
+ *
+ * Description:
+ *   Release a read/write lock held for reading or for writing.
+ *
+ *   A reader only decrements the count of readers.  If it was the last
+ *   reader and a writer is waiting for the readers to drain, it also wakes
+ *   up the writer.
+ *
+ * Parameters:
+ *   rw_lock - The read/write lock to be released
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
+{
+  int32_t state = atomic_read(&rw_lock->state);
+
+  /* Is the lock held by a writer?  Readers may still be draining if the
+   * writer is waiting for them, so check if it is the caller.
+   */
+
+  if ((state & _PTHREAD_RWLOCK_WRITER) != 0 &&
+      rw_lock->writer == getpid())
+    {
+      rw_lock->writer = -1;
+      (void)atomic_add_return(&rw_lock->state, -_PTHREAD_RWLOCK_WRITER);
+      (void)sem_post(&rw_lock->wrsem);
+      return OK;
+    }
+
+  if ((state & _PTHREAD_RWLOCK_READERS) == 0)
+    {
+      return EINVAL;
+    }
+
+  /* Release the read lock */
+
+  state = atomic_add_return(&rw_lock->state, -1);
+
+#ifdef CONFIG_PTHREAD_RWLOCK_PREFER_WRITER
+  /* A writer has set _PTHREAD_RWLOCK_WRITER and waits for the readers to
+   * drain.  Only the last reader sees exactly this state.
+   */
+
+  if (state == _PTHREAD_RWLOCK_WRITER)
+    {
+      (void)sem_post(&rw_lock->rdsem);
+    }
+#else
+  /* A writer waits for the readers to drain, but new readers may arrive.
+   * The reader that clears _PTHREAD_RWLOCK_WRWAIT wakes up the writer.
+   */
+
+  if (state == _PTHREAD_RWLOCK_WRWAIT &&
+      atomic_cmpxchg(&rw_lock->state, _PTHREAD_RWLOCK_WRWAIT, 0))
+    {
+      (void)sem_post(&rw_lock->rdsem);
+    }
+#endif
+
+  return OK;
+}
+
+#endif /* CONFIG_PTHREAD_RWLOCK_ATOMIC */
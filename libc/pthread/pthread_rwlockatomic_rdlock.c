@@ -0,0 +1,162 @@
+/****************************************************************************
+ * libc/pthread/pthread_rwlockatomic_rdlock.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/atomic.h>
+
+#ifdef CONFIG_PTHREAD_RWLOCK_ATOMIC
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tryrdlock
+ *
+ * Description:
+ *   Increment the count of readers unless a writer holds (or, with writer
+ *   preference, is acquiring) the lock.
+ *
+ ****************************************************************************/
+
+static int tryrdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  int32_t state;
+
+  for (; ; )
+    {
+      state = atomic_read(&rw_lock->state);
+      if ((state & _PTHREAD_RWLOCK_WRITER) != 0)
+        {
+          return EBUSY;
+        }
+
+      if ((state & _PTHREAD_RWLOCK_READERS) == _PTHREAD_RWLOCK_READERS)
+        {
+          return EAGAIN;
+        }
+
+      /* This fails only if the state was changed by another thread */
+
+      if (atomic_cmpxchg(&rw_lock->state, state, state + 1))
+        {
+          return OK;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_rwlock_rdlock
+ *
+ * Description:
+ *   Locks a read/write lock for reading.  If no writer holds the lock, this
+ *   is a single atomic operation.  Otherwise, the caller waits for the
+ *   writer by taking the writer's semaphore.
+ *
+ * Parameters:
+ *   rw_lock - The read/write lock
+ *   ts      - The absolute time to wait until (timed variant only)
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_tryrdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return tryrdlock(rw_lock);
+}
+
+int pthread_rwlock_timedrdlock(FAR pthread_rwlock_t *rw_lock,
+                               FAR const struct timespec *ts)
+{
+  int err;
+  int ret;
+
+  err = tryrdlock(rw_lock);
+  if (err != EBUSY)
+    {
+      return err;
+    }
+
+  /* A writer holds the lock.  Wait until it releases its semaphore. */
+
+  do
+    {
+      if (ts != NULL)
+        {
+          ret = sem_timedwait(&rw_lock->wrsem, ts);
+        }
+      else
+        {
+          ret = sem_wait(&rw_lock->wrsem);
+        }
+
+      err = ret < 0 ? get_errno() : OK;
+    }
+  while (err == EINTR);
+
+  if (err != OK)
+    {
+      return err;
+    }
+
+  /* No writer can hold the lock while we hold the semaphore */
+
+  err = tryrdlock(rw_lock);
+  (void)sem_post(&rw_lock->wrsem);
+  return err;
+}
+
+int pthread_rwlock_rdlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return pthread_rwlock_timedrdlock(rw_lock, NULL);
+}
+
+#endif /* CONFIG_PTHREAD_RWLOCK_ATOMIC */
@@ -0,0 +1,291 @@
+/****************************************************************************
+ * libc/pthread/pthread_rwlockatomic_wrlock.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_PTHREAD_RWLOCK_ATOMIC
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wrlock_abort
+ *
+ * Description:
+ *   Give up while waiting for the readers to drain:  Withdraw the claim on
+ *   the lock so that new readers are admitted again and release the
+ *   writer's semaphore.
+ *
+ ****************************************************************************/
+
+static void wrlock_abort(FAR void *arg)
+{
+  FAR pthread_rwlock_t *rw_lock = (FAR pthread_rwlock_t *)arg;
+
+#ifdef CONFIG_PTHREAD_RWLOCK_PREFER_WRITER
+  (void)atomic_add_return(&rw_lock->state, -_PTHREAD_RWLOCK_WRITER);
+#else
+  int32_t state;
+
+  do
+    {
+      state = atomic_read(&rw_lock->state);
+    }
+  while ((state & _PTHREAD_RWLOCK_WRWAIT) != 0 &&
+         !atomic_cmpxchg(&rw_lock->state, state,
+                         state & ~_PTHREAD_RWLOCK_WRWAIT));
+#endif
+
+  (void)sem_post(&rw_lock->wrsem);
+}
+
+/****************************************************************************
+ * Name: wrlock_wait
+ *
+ * Description:
+ *   Wait for the last reader to post rdsem.
+ *
+ ****************************************************************************/
+
+static int wrlock_wait(FAR pthread_rwlock_t *rw_lock,
+                       FAR const struct timespec *ts)
+{
+  int ret;
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* rdsem is used for signaling.  If the lock was statically initialized,
+   * priority inheritance has not been disabled yet.
+   */
+
+  if ((rw_lock->rdsem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      (void)sem_setprotocol(&rw_lock->rdsem, SEM_PRIO_NONE);
+    }
+#endif
+
+  if (ts != NULL)
+    {
+      ret = sem_timedwait(&rw_lock->rdsem, ts);
+    }
+  else
+    {
+      ret = sem_wait(&rw_lock->rdsem);
+    }
+
+  return ret < 0 ? get_errno() : OK;
+}
+
+/****************************************************************************
+ * Name: wrlock_drain
+ *
+ * Description:
+ *   Called with the writer's semaphore held.  Claim the lock for writing
+ *   and wait until there are no more readers.
+ *
+ ****************************************************************************/
+
+static int wrlock_drain(FAR pthread_rwlock_t *rw_lock,
+                        FAR const struct timespec *ts)
+{
+  int32_t state;
+  int err = OK;
+
+#ifdef CONFIG_PTHREAD_RWLOCK_PREFER_WRITER
+  /* Setting _PTHREAD_RWLOCK_WRITER keeps new readers out.  The last of the
+   * current readers will post rdsem.  A stale post from an earlier,
+   * aborted wait is possible so the count of readers is checked again
+   * after each wake-up.
+   */
+
+  state = atomic_add_return(&rw_lock->state, _PTHREAD_RWLOCK_WRITER);
+  while ((state & _PTHREAD_RWLOCK_READERS) != 0)
+    {
+      err = wrlock_wait(rw_lock, ts);
+      if (err != OK && err != EINTR)
+        {
+          break;
+        }
+
+      state = atomic_read(&rw_lock->state);
+      err   = OK;
+    }
+
+#else
+  /* New readers are admitted until there are no readers at all */
+
+  for (; ; )
+    {
+      state = atomic_read(&rw_lock->state);
+      if ((state & _PTHREAD_RWLOCK_READERS) == 0)
+        {
+          if (atomic_cmpxchg(&rw_lock->state, state,
+                             _PTHREAD_RWLOCK_WRITER))
+            {
+              break;
+            }
+        }
+      else if ((state & _PTHREAD_RWLOCK_WRWAIT) != 0 ||
+               atomic_cmpxchg(&rw_lock->state, state,
+                              state | _PTHREAD_RWLOCK_WRWAIT))
+        {
+          err = wrlock_wait(rw_lock, ts);
+          if (err != OK && err != EINTR)
+            {
+              break;
+            }
+
+          err = OK;
+        }
+    }
+#endif
+
+  return err;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_rwlock_wrlock
+ *
+ * Description:
+ *   Locks a read/write lock for writing.  Writers are serialized by the
+ *   writer's semaphore, which is held until the lock is released.  If
+ *   CONFIG_PTHREAD_RWLOCK_PRIO_INHERIT is selected, the priority of the
+ *   writer is boosted by the readers and writers waiting for it.
+ *
+ * Parameters:
+ *   rw_lock - The read/write lock
+ *   ts      - The absolute time to wait until (timed variant only)
+ *
+ * Return Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_rwlock_trywrlock(FAR pthread_rwlock_t *rw_lock)
+{
+  if (sem_trywait(&rw_lock->wrsem) < 0)
+    {
+      return EBUSY;
+    }
+
+  if (!atomic_cmpxchg(&rw_lock->state, 0, _PTHREAD_RWLOCK_WRITER))
+    {
+      (void)sem_post(&rw_lock->wrsem);
+      return EBUSY;
+    }
+
+  rw_lock->writer = getpid();
+  return OK;
+}
+
+int pthread_rwlock_timedwrlock(FAR pthread_rwlock_t *rw_lock,
+                               FAR const struct timespec *ts)
+{
+  pid_t mypid = getpid();
+  int err;
+  int ret;
+
+  if (rw_lock->writer == mypid)
+    {
+      return EDEADLK;
+    }
+
+  /* Wait for the current writer, if any */
+
+  do
+    {
+      if (ts != NULL)
+        {
+          ret = sem_timedwait(&rw_lock->wrsem, ts);
+        }
+      else
+        {
+          ret = sem_wait(&rw_lock->wrsem);
+        }
+
+      err = ret < 0 ? get_errno() : OK;
+    }
+  while (err == EINTR);
+
+  if (err != OK)
+    {
+      return err;
+    }
+
+  /* Then wait for the readers.  If the thread is canceled while waiting,
+   * the claim on the lock must be withdrawn.
+   */
+
+#ifdef CONFIG_PTHREAD_CLEANUP
+  pthread_cleanup_push(&wrlock_abort, rw_lock);
+#endif
+  err = wrlock_drain(rw_lock, ts);
+#ifdef CONFIG_PTHREAD_CLEANUP
+  pthread_cleanup_pop(0);
+#endif
+
+  if (err != OK)
+    {
+      wrlock_abort(rw_lock);
+      return err;
+    }
+
+  rw_lock->writer = mypid;
+  return OK;
+}
+
+int pthread_rwlock_wrlock(FAR pthread_rwlock_t *rw_lock)
+{
+  return pthread_rwlock_timedwrlock(rw_lock, NULL);
+}
+
+#endif /* CONFIG_PTHREAD_RWLOCK_ATOMIC */
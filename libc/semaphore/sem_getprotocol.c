@@ -83,5 +83,12 @@ int sem_getprotocol(FAR sem_t *sem, FAR int *protocol)
   *protocol = SEM_PRIO_NONE;
 #endif
 
+#ifdef CONFIG_SEM_ADAPTIVE
+  if ((sem->flags & ADAPTIVE_FLAGS_ENABLE) != 0)
+    {
+      *protocol |= SEM_ADAPTIVE;
+    }
+#endif
+
   return OK;
 }
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <string.h>
 #include <limits.h>
 #include <semaphore.h>
 #include <errno.h>
@@ -87,8 +88,10 @@ int sem_init(FAR sem_t *sem, int pshared, unsigned int value)
 
       /* Initialize to support priority inheritance */
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) || defined(CONFIG_SEM_ADAPTIVE)
       sem->flags            = 0;
+#endif
+#ifdef CONFIG_PRIORITY_INHERITANCE
 #  if CONFIG_SEM_PREALLOCHOLDERS > 0
       sem->hhead            = NULL;
 #  else
@@ -97,6 +100,15 @@ int sem_init(FAR sem_t *sem, int pshared, unsigned int value)
       sem->holder[1].htcb   = NULL;
       sem->holder[1].counts = 0;
 #  endif
+#endif
+
+      /* Initialize to support adaptive waits */
+
+#ifdef CONFIG_SEM_ADAPTIVE
+      sem->hpid             = 0;
+#  ifdef CONFIG_SEM_ADAPTIVE_STATS
+      memset(&sem->stats, 0, sizeof(struct semstat_s));
+#  endif
 #endif
       return OK;
     }
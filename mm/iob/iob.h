@@ -46,6 +46,9 @@
 #include <debug.h>
 
 #include <nuttx/mm/iob.h>
+#ifdef CONFIG_SMP
+#  include <nuttx/spinlock.h>
+#endif
 
 #ifdef CONFIG_MM_IOB
 
@@ -83,6 +86,54 @@
 #endif
 #endif /* CONFIG_DEBUG_FEATURES && CONFIG_IOB_DEBUG */
 
+/* Per-CPU caches */
+
+#ifdef CONFIG_IOB_CPUCACHE
+#  if CONFIG_IOB_CPUCACHE_BATCH > CONFIG_IOB_CPUCACHE_DEPTH
+#    error CONFIG_IOB_CPUCACHE_BATCH must not exceed CONFIG_IOB_CPUCACHE_DEPTH
+#  endif
+
+#  ifdef CONFIG_SMP
+#    define IOB_NCPUS CONFIG_SMP_NCPUS
+#  else
+#    define IOB_NCPUS 1
+#  endif
+#endif
+
+/* Statistics.  The global counters are only modified within the critical
+ * section that protects the free list.
+ */
+
+#ifdef CONFIG_IOB_STATS
+#  define IOB_STATS_ADD(f,n) do { g_iob_stats.f += (n); } while (0)
+#else
+#  define IOB_STATS_ADD(f,n)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_CPUCACHE
+/* The cache of free I/O buffers belonging to one CPU.  Only that CPU adds
+ * or removes buffers in normal operation, with local interrupts disabled.
+ * In SMP configurations the spinlock additionally allows the caches of
+ * other CPUs to be emptied by iob_cpucache_flush().
+ */
+
+struct iob_cpucache_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t ic_lock;           /* Protects the cache from other CPUs */
+#endif
+  uint8_t ic_count;             /* Number of buffers in the cache */
+  FAR struct iob_s *ic_head;    /* List of cached buffers */
+#ifdef CONFIG_IOB_STATS
+  uint32_t ic_nhit;             /* Allocations satisfied from the cache */
+#endif
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -115,10 +166,97 @@ extern sem_t g_throttle_sem;  /* Counts available I/O buffers when throttled */
 extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
 #endif
 
+/* The number of tasks waiting in iob_alloc() for a free I/O buffer */
+
+extern volatile uint16_t g_iob_nwaiters;
+
+/* Wakes up the tasks waiting in iob_alloc_batch() when I/O buffers are
+ * freed, and the number of such tasks.
+ */
+
+extern sem_t g_iob_batchsem;
+extern volatile uint16_t g_iob_nbatchwaiters;
+
+#ifdef CONFIG_IOB_CPUCACHE
+/* The per-CPU caches of free I/O buffers */
+
+extern struct iob_cpucache_s g_iob_cpucache[IOB_NCPUS];
+#endif
+
+#ifdef CONFIG_IOB_STATS
+/* Usage statistics */
+
+extern struct iob_stats_s g_iob_stats;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_tryalloc_list
+ *
+ * Description:
+ *   Take up to 'nbufs' I/O buffers from the free list under a single
+ *   critical section without waiting.  If 'all' is true, either all
+ *   'nbufs' buffers are taken or none are.  The buffers are returned in
+ *   'list', linked through io_flink, but are otherwise uninitialized.  This
+ *   function is intended only for internal use by the IOB module.
+ *
+ * Returned Value:
+ *   The number of buffers taken.
+ *
+ ****************************************************************************/
+
+unsigned int iob_tryalloc_list(FAR struct iob_s **list, unsigned int nbufs,
+                               bool throttled, bool all);
+
+/****************************************************************************
+ * Name: iob_cpucache_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU, refilling the
+ *   cache from the free list if it is empty.  The buffer is uninitialized.
+ *   NULL is returned if no buffer could be obtained that way.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_CPUCACHE
+FAR struct iob_s *iob_cpucache_alloc(bool throttled);
+#endif
+
+/****************************************************************************
+ * Name: iob_cpucache_free
+ *
+ * Description:
+ *   Put a freed I/O buffer in the cache of the current CPU, draining a
+ *   batch of buffers to the free list if the cache is full.  Returns false
+ *   if the buffer was not cached (because a task is waiting for a buffer)
+ *   and must be returned to the free list by the caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_CPUCACHE
+bool iob_cpucache_free(FAR struct iob_s *iob);
+#endif
+
+/****************************************************************************
+ * Name: iob_cpucache_flush
+ *
+ * Description:
+ *   Return the contents of the caches of all CPUs to the free list.  This
+ *   is done before an allocation fails or waits so that buffers are never
+ *   stranded in the caches.
+ *
+ * Returned Value:
+ *   The number of buffers returned to the free list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IOB_CPUCACHE
+unsigned int iob_cpucache_flush(void);
+#endif
+
 /****************************************************************************
  * Name: iob_alloc_qentry
  *
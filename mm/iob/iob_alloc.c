@@ -46,6 +46,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
+#include <nuttx/clock.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -54,6 +55,21 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_reset
+ *
+ * Description:
+ *   Put a newly allocated I/O buffer in a known state.
+ *
+ ****************************************************************************/
+
+static inline void iob_reset(FAR struct iob_s *iob)
+{
+  iob->io_len    = 0;    /* Length of the data in the entry */
+  iob->io_offset = 0;    /* Offset to the beginning of data */
+  iob->io_pktlen = 0;    /* Total length of the packet */
+}
+
 /****************************************************************************
  * Name: iob_alloc_committed
  *
@@ -86,15 +102,45 @@ static FAR struct iob_s *iob_alloc_committed(void)
       /* Put the I/O buffer in a known state */
 
       iob->io_flink  = NULL; /* Not in a chain */
-      iob->io_len    = 0;    /* Length of the data in the entry */
-      iob->io_offset = 0;    /* Offset to the beginning of data */
-      iob->io_pktlen = 0;    /* Total length of the packet */
+      iob_reset(iob);
     }
 
   leave_critical_section(flags);
   return iob;
 }
 
+/****************************************************************************
+ * Name: iob_tryalloc_internal
+ *
+ * Description:
+ *   Try to allocate one I/O buffer, first from the cache of this CPU and
+ *   then from the free list, without waiting.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *iob_tryalloc_internal(bool throttled)
+{
+  FAR struct iob_s *iob = NULL;
+
+#ifdef CONFIG_IOB_CPUCACHE
+  iob = iob_cpucache_alloc(throttled);
+  if (iob == NULL)
+#endif
+    {
+      (void)iob_tryalloc_list(&iob, 1, throttled, true);
+    }
+
+  if (iob != NULL)
+    {
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob_reset(iob);
+    }
+
+  return iob;
+}
+
 /****************************************************************************
  * Name: iob_allocwait
  *
@@ -110,6 +156,11 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
   irqstate_t flags;
   FAR sem_t *sem;
   int ret = OK;
+#ifdef CONFIG_IOB_STATS
+  systime_t start = 0;
+  systime_t elapsed;
+  bool waited = false;
+#endif
 
 #if CONFIG_IOB_THROTTLE > 0
   /* Select the semaphore count to check. */
@@ -131,9 +182,36 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
    * decremented atomically.
    */
 
-  iob = iob_tryalloc(throttled);
+  iob = iob_tryalloc_internal(throttled);
   while (ret == OK && iob == NULL)
     {
+      /* Announce that we are about to wait.  From now on, freed I/O buffers
+       * will not be put in the per-CPU caches.
+       */
+
+      g_iob_nwaiters++;
+
+#ifdef CONFIG_IOB_CPUCACHE
+      /* Reclaim any I/O buffers that are already in the caches before
+       * waiting.
+       */
+
+      if (iob_cpucache_flush() > 0)
+        {
+          g_iob_nwaiters--;
+          iob = iob_tryalloc_internal(throttled);
+          continue;
+        }
+#endif
+
+#ifdef CONFIG_IOB_STATS
+      if (!waited)
+        {
+          start  = clock_systimer();
+          waited = true;
+        }
+#endif
+
       /* If not successful, then the semaphore count was less than or equal
        * to zero (meaning that there are no free buffers).  We need to wait
        * for an I/O buffer to be released and placed in the committed
@@ -141,6 +219,8 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
        */
 
       ret = sem_wait(sem);
+      g_iob_nwaiters--;
+
       if (ret < 0)
         {
           int errcode = get_errno();
@@ -192,11 +272,25 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
                */
 
               sem_post(sem);
-              iob = iob_tryalloc(throttled);
+              iob = iob_tryalloc_internal(throttled);
             }
         }
     }
 
+#ifdef CONFIG_IOB_STATS
+  if (waited)
+    {
+      elapsed = clock_systimer() - start;
+
+      g_iob_stats.nwait++;
+      g_iob_stats.waitticks += elapsed;
+      if (elapsed > g_iob_stats.maxwait)
+        {
+          g_iob_stats.maxwait = elapsed;
+        }
+    }
+#endif
+
   leave_critical_section(flags);
   return iob;
 }
@@ -205,6 +299,126 @@ static FAR struct iob_s *iob_allocwait(bool throttled)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: iob_tryalloc_list
+ *
+ * Description:
+ *   Take up to 'nbufs' I/O buffers from the free list under a single
+ *   critical section without waiting.  If 'all' is true, either all
+ *   'nbufs' buffers are taken or none are.  The buffers are returned in
+ *   'list', linked through io_flink, but are otherwise uninitialized.  This
+ *   function is intended only for internal use by the IOB module.
+ *
+ * Returned Value:
+ *   The number of buffers taken.
+ *
+ ****************************************************************************/
+
+unsigned int iob_tryalloc_list(FAR struct iob_s **list, unsigned int nbufs,
+                               bool throttled, bool all)
+{
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  unsigned int navail;
+  unsigned int ntaken;
+
+  /* We don't know what context we are called from so we use extreme measures
+   * to protect the free list:  We disable interrupts very briefly.
+   */
+
+  flags = enter_critical_section();
+
+  /* How many I/O buffers are available for this allocation? */
+
+  navail = g_iob_sem.semcount > 0 ? g_iob_sem.semcount : 0;
+
+#if CONFIG_IOB_THROTTLE > 0
+  if (throttled)
+    {
+      unsigned int nthrottled;
+
+      /* The throttle semaphore count can be negative */
+
+      nthrottled = g_throttle_sem.semcount > 0 ?
+                   g_throttle_sem.semcount : 0;
+
+      if (nthrottled < navail)
+        {
+          if (nthrottled < nbufs)
+            {
+              /* The throttle refused buffers that were available */
+
+              IOB_STATS_ADD(nthrottle, 1);
+            }
+
+          navail = nthrottled;
+        }
+    }
+#endif
+
+  if (navail > nbufs)
+    {
+      navail = nbufs;
+    }
+  else if (all && navail < nbufs)
+    {
+      navail = 0;
+    }
+
+  /* Take the I/O buffers from the head of the free list */
+
+  for (ntaken = 0; ntaken < navail && g_iob_freelist != NULL; ntaken++)
+    {
+      iob            = g_iob_freelist;
+      g_iob_freelist = iob->io_flink;
+      iob->io_flink  = head;
+      head           = iob;
+    }
+
+  if (all && ntaken < nbufs)
+    {
+      /* This should not happen:  The semaphore count says that the buffers
+       * are there.  Put back what we took.
+       */
+
+      DEBUGASSERT(ntaken == 0);
+      while (head != NULL)
+        {
+          iob            = head;
+          head           = iob->io_flink;
+          iob->io_flink  = g_iob_freelist;
+          g_iob_freelist = iob;
+        }
+
+      ntaken = 0;
+    }
+
+  /* Take semaphore counts.  Note that we cannot do this in in the orthodox
+   * way by calling sem_wait() or sem_trywait() because this function may be
+   * called from an interrupt handler.  Fortunately we know that the buffers
+   * are free so a simple subtraction is all that is needed.
+   */
+
+  g_iob_sem.semcount -= ntaken;
+  DEBUGASSERT(g_iob_sem.semcount >= 0);
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* The throttle semaphore is a little more complicated because it can be
+   * negative!  Decrementing is still safe, however.
+   */
+
+  g_throttle_sem.semcount -= ntaken;
+  DEBUGASSERT(g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE);
+#endif
+
+  IOB_STATS_ADD(nalloc, ntaken);
+  leave_critical_section(flags);
+
+  *list = head;
+  return ntaken;
+}
+
 /****************************************************************************
  * Name: iob_alloc
  *
@@ -243,71 +457,186 @@ FAR struct iob_s *iob_alloc(bool throttled)
 FAR struct iob_s *iob_tryalloc(bool throttled)
 {
   FAR struct iob_s *iob;
+#ifdef CONFIG_IOB_STATS
   irqstate_t flags;
-#if CONFIG_IOB_THROTTLE > 0
-  FAR sem_t *sem;
 #endif
 
-#if CONFIG_IOB_THROTTLE > 0
-  /* Select the semaphore count to check. */
+  iob = iob_tryalloc_internal(throttled);
 
-  sem = (throttled ? &g_throttle_sem : &g_iob_sem);
+#ifdef CONFIG_IOB_CPUCACHE
+  /* Reclaim any I/O buffers held in the per-CPU caches before failing */
+
+  if (iob == NULL && iob_cpucache_flush() > 0)
+    {
+      iob = iob_tryalloc_internal(throttled);
+    }
 #endif
 
-  /* We don't know what context we are called from so we use extreme measures
-   * to protect the free list:  We disable interrupts very briefly.
-   */
+#ifdef CONFIG_IOB_STATS
+  if (iob == NULL)
+    {
+      flags = enter_critical_section();
+      g_iob_stats.nfail++;
+      leave_critical_section(flags);
+    }
+#endif
 
-  flags = enter_critical_section();
+  return iob;
+}
 
-#if CONFIG_IOB_THROTTLE > 0
-  /* If there are free I/O buffers for this allocation */
+/****************************************************************************
+ * Name: iob_tryalloc_batch
+ *
+ * Description:
+ *   Allocate 'nbufs' empty I/O buffers, linked together through io_flink,
+ *   under a single critical section without waiting.  Either all of the
+ *   buffers are allocated or none are.
+ *
+ ****************************************************************************/
 
-  if (sem->semcount > 0)
+FAR struct iob_s *iob_tryalloc_batch(unsigned int nbufs, bool throttled)
+{
+  FAR struct iob_s *list;
+  FAR struct iob_s *iob;
+#ifdef CONFIG_IOB_STATS
+  irqstate_t flags;
 #endif
+
+  if (nbufs == 0)
+    {
+      return NULL;
+    }
+
+  if (iob_tryalloc_list(&list, nbufs, throttled, true) == 0)
     {
-      /* Take the I/O buffer from the head of the free list */
+#ifdef CONFIG_IOB_CPUCACHE
+      /* Reclaim any I/O buffers held in the per-CPU caches and try again */
 
-      iob = g_iob_freelist;
-      if (iob != NULL)
+      if (iob_cpucache_flush() == 0 ||
+          iob_tryalloc_list(&list, nbufs, throttled, true) == 0)
+#endif
         {
-          /* Remove the I/O buffer from the free list and decrement the
-           * counting semaphore(s) that tracks the number of available
-           * IOBs.
-           */
+#ifdef CONFIG_IOB_STATS
+          flags = enter_critical_section();
+          g_iob_stats.nfail++;
+          leave_critical_section(flags);
+#endif
+          return NULL;
+        }
+    }
 
-          g_iob_freelist = iob->io_flink;
+  /* Put the I/O buffers in a known state */
 
-          /* Take a semaphore count.  Note that we cannot do this in
-           * in the orthodox way by calling sem_wait() or sem_trywait()
-           * because this function may be called from an interrupt
-           * handler. Fortunately we know at at least one free buffer
-           * so a simple decrement is all that is needed.
-           */
+  for (iob = list; iob != NULL; iob = iob->io_flink)
+    {
+      iob_reset(iob);
+    }
+
+  return list;
+}
 
-          g_iob_sem.semcount--;
-          DEBUGASSERT(g_iob_sem.semcount >= 0);
+/****************************************************************************
+ * Name: iob_alloc_batch
+ *
+ * Description:
+ *   Allocate 'nbufs' empty I/O buffers, linked together through io_flink.
+ *   The buffers are taken from the free list all at once under a single
+ *   critical section.  If not enough are free, this function waits until
+ *   they are without holding any of them (unless called from an interrupt
+ *   handler or the IDLE task, in which case NULL is returned and no buffers
+ *   are taken).
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_batch(unsigned int nbufs, bool throttled)
+{
+  FAR struct iob_s *list;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  int ret;
+
+  /* Were we called from the interrupt level? */
+
+  if (up_interrupt_context() || sched_idletask())
+    {
+      /* Yes, then try to allocate the I/O buffers without waiting */
+
+      return iob_tryalloc_batch(nbufs, throttled);
+    }
+
+  if (nbufs == 0)
+    {
+      return NULL;
+    }
 
 #if CONFIG_IOB_THROTTLE > 0
-          /* The throttle semaphore is a little more complicated because
-           * it can be negative!  Decrementing is still safe, however.
-           */
+  DEBUGASSERT(nbufs <= (throttled ?
+                        CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE :
+                        CONFIG_IOB_NBUFFERS));
+#else
+  DEBUGASSERT(nbufs <= CONFIG_IOB_NBUFFERS);
+#endif
+
+  /* Take all of the buffers or none of them.  Holding some of the buffers
+   * while waiting for the rest could deadlock two batch allocations that
+   * each hold part of the pool.  Interrupts will be re-enabled while we
+   * are waiting.
+   */
+
+  flags = enter_critical_section();
 
-          g_throttle_sem.semcount--;
-          DEBUGASSERT(g_throttle_sem.semcount >= -CONFIG_IOB_THROTTLE);
+  while (iob_tryalloc_list(&list, nbufs, throttled, true) == 0)
+    {
+#ifdef CONFIG_IOB_CPUCACHE
+      /* Reclaim any I/O buffers held in the per-CPU caches and try again */
+
+      if (iob_cpucache_flush() > 0 &&
+          iob_tryalloc_list(&list, nbufs, throttled, true) > 0)
+        {
+          break;
+        }
 #endif
-          leave_critical_section(flags);
 
-          /* Put the I/O buffer in a known state */
+      /* Not enough I/O buffers are free.  Wait until some are freed.  While
+       * we wait, freed I/O buffers will not be put in the per-CPU caches.
+       */
+
+      g_iob_nwaiters++;
+      g_iob_nbatchwaiters++;
+
+      ret = sem_wait(&g_iob_batchsem);
+      g_iob_nwaiters--;
+
+      if (ret < 0)
+        {
+          int errcode = get_errno();
+
+          /* We were not woken up by iob_free_batch() so we are still
+           * counted as a waiter.
+           */
+
+          g_iob_nbatchwaiters--;
 
-          iob->io_flink  = NULL; /* Not in a chain */
-          iob->io_len    = 0;    /* Length of the data in the entry */
-          iob->io_offset = 0;    /* Offset to the beginning of data */
-          iob->io_pktlen = 0;    /* Total length of the packet */
-          return iob;
+          /* EINTR is not an error!  EINTR simply means that we were
+           * awakened by a signal and we should try again.
+           */
+
+          if (errcode != EINTR)
+            {
+              leave_critical_section(flags);
+              return NULL;
+            }
         }
     }
 
   leave_critical_section(flags);
-  return NULL;
+
+  /* Put the I/O buffers in a known state */
+
+  for (iob = list; iob != NULL; iob = iob->io_flink)
+    {
+      iob_reset(iob);
+    }
+
+  return list;
 }
@@ -0,0 +1,308 @@
+/****************************************************************************
+ * mm/iob/iob_cpucache.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_CPUCACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cpucache_lock
+ *
+ * Description:
+ *   Disable local interrupts and return the cache of the current CPU, now
+ *   locked against iob_cpucache_flush() on other CPUs.
+ *
+ ****************************************************************************/
+
+static inline FAR struct iob_cpucache_s *
+iob_cpucache_lock(FAR irqstate_t *flags)
+{
+  FAR struct iob_cpucache_s *cache;
+
+  *flags = up_irq_save();
+  cache  = &g_iob_cpucache[up_cpu_index()];
+#ifdef CONFIG_SMP
+  spin_lock(&cache->ic_lock);
+#endif
+  return cache;
+}
+
+/****************************************************************************
+ * Name: iob_cpucache_unlock
+ ****************************************************************************/
+
+static inline void iob_cpucache_unlock(FAR struct iob_cpucache_s *cache,
+                                       irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&cache->ic_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_cpucache_alloc
+ *
+ * Description:
+ *   Take an I/O buffer from the cache of the current CPU, refilling the
+ *   cache from the free list if it is empty.  The buffer is uninitialized.
+ *   NULL is returned if no buffer could be obtained that way.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_cpucache_alloc(bool throttled)
+{
+  FAR struct iob_cpucache_s *cache;
+  FAR struct iob_s *list;
+  FAR struct iob_s *tail;
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+  unsigned int nbufs;
+
+#if CONFIG_IOB_THROTTLE > 0
+  /* Cached buffers are already counted as allocated.  Leave them to
+   * unthrottled allocations when the throttle is in effect.  This unlocked
+   * test is only advisory.
+   */
+
+  if (throttled && g_throttle_sem.semcount <= 0)
+    {
+      return NULL;
+    }
+#endif
+
+  /* Fast path:  Take a buffer from the cache of this CPU */
+
+  cache = iob_cpucache_lock(&flags);
+  iob   = cache->ic_head;
+  if (iob != NULL)
+    {
+      cache->ic_head = iob->io_flink;
+      cache->ic_count--;
+#ifdef CONFIG_IOB_STATS
+      cache->ic_nhit++;
+#endif
+    }
+
+  iob_cpucache_unlock(cache, flags);
+
+  if (iob != NULL)
+    {
+      return iob;
+    }
+
+  /* The cache is empty.  Take a batch of buffers from the free list, keep
+   * one for the caller and put the rest in the cache.
+   */
+
+  nbufs = iob_tryalloc_list(&list, CONFIG_IOB_CPUCACHE_BATCH, throttled,
+                            false);
+  if (nbufs == 0)
+    {
+      return NULL;
+    }
+
+  iob  = list;
+  list = iob->io_flink;
+  nbufs--;
+
+  if (nbufs > 0)
+    {
+      tail = list;
+      while (tail->io_flink != NULL)
+        {
+          tail = tail->io_flink;
+        }
+
+      /* We may have been migrated to another CPU or other tasks may have
+       * freed buffers into this cache in the meantime.
+       */
+
+      cache = iob_cpucache_lock(&flags);
+      if (cache->ic_count + nbufs <= CONFIG_IOB_CPUCACHE_DEPTH)
+        {
+          tail->io_flink   = cache->ic_head;
+          cache->ic_head   = list;
+          cache->ic_count += nbufs;
+          list             = NULL;
+        }
+
+      iob_cpucache_unlock(cache, flags);
+
+      if (list != NULL)
+        {
+          iob_free_batch(list);
+        }
+    }
+
+  return iob;
+}
+
+/****************************************************************************
+ * Name: iob_cpucache_free
+ *
+ * Description:
+ *   Put a freed I/O buffer in the cache of the current CPU, draining a
+ *   batch of buffers to the free list if the cache is full.  Returns false
+ *   if the buffer was not cached (because a task is waiting for a buffer)
+ *   and must be returned to the free list by the caller.
+ *
+ ****************************************************************************/
+
+bool iob_cpucache_free(FAR struct iob_s *iob)
+{
+  FAR struct iob_cpucache_s *cache;
+  FAR struct iob_s *drain = NULL;
+  FAR struct iob_s *prev;
+  irqstate_t flags;
+  int i;
+
+  cache = iob_cpucache_lock(&flags);
+
+  /* If a task is waiting for a buffer, then the buffer must go to the
+   * committed list.  g_iob_nwaiters is incremented before the waiter
+   * flushes the caches, and the flush must take this lock, so either the
+   * waiter sees this buffer in the cache or we see the waiter here.
+   */
+
+  if (g_iob_nwaiters > 0)
+    {
+      iob_cpucache_unlock(cache, flags);
+      return false;
+    }
+
+  iob->io_flink  = cache->ic_head;
+  cache->ic_head = iob;
+  cache->ic_count++;
+
+  /* If the cache is now over-full, then detach the oldest buffers at the
+   * end of the list, keeping the most recently freed (and most likely
+   * still in the data cache) buffers.
+   */
+
+  if (cache->ic_count > CONFIG_IOB_CPUCACHE_DEPTH)
+    {
+      prev = cache->ic_head;
+      for (i = 1; i < cache->ic_count - CONFIG_IOB_CPUCACHE_BATCH; i++)
+        {
+          prev = prev->io_flink;
+        }
+
+      drain           = prev->io_flink;
+      prev->io_flink  = NULL;
+      cache->ic_count = cache->ic_count - CONFIG_IOB_CPUCACHE_BATCH;
+    }
+
+  iob_cpucache_unlock(cache, flags);
+
+  if (drain != NULL)
+    {
+      iob_free_batch(drain);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: iob_cpucache_flush
+ *
+ * Description:
+ *   Return the contents of the caches of all CPUs to the free list.  This
+ *   is done before an allocation fails or waits so that buffers are never
+ *   stranded in the caches.
+ *
+ * Returned Value:
+ *   The number of buffers returned to the free list.
+ *
+ ****************************************************************************/
+
+unsigned int iob_cpucache_flush(void)
+{
+  FAR struct iob_cpucache_s *cache;
+  FAR struct iob_s *list;
+  irqstate_t flags;
+  unsigned int nflushed = 0;
+  int cpu;
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      cache = &g_iob_cpucache[cpu];
+
+      flags = up_irq_save();
+#ifdef CONFIG_SMP
+      spin_lock(&cache->ic_lock);
+#endif
+
+      list            = cache->ic_head;
+      nflushed       += cache->ic_count;
+      cache->ic_head  = NULL;
+      cache->ic_count = 0;
+
+#ifdef CONFIG_SMP
+      spin_unlock(&cache->ic_lock);
+#endif
+      up_irq_restore(flags);
+
+      if (list != NULL)
+        {
+          iob_free_batch(list);
+        }
+    }
+
+  return nflushed;
+}
+
+#endif /* CONFIG_IOB_CPUCACHE */
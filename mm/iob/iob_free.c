@@ -65,7 +65,6 @@
 FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 {
   FAR struct iob_s *next = iob->io_flink;
-  irqstate_t flags;
 
   iobinfo("iob=%p io_pktlen=%u io_len=%u next=%p\n",
           iob, iob->io_pktlen, iob->io_len, next);
@@ -101,7 +100,41 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
               next, next->io_pktlen, next->io_len);
     }
 
-  /* Free the I/O buffer by adding it to the head of the free or the
+#ifdef CONFIG_IOB_CPUCACHE
+  /* Try to keep the I/O buffer in the cache of this CPU */
+
+  if (!iob_cpucache_free(iob))
+#endif
+    {
+      /* Return the I/O buffer to the free (or committed) list */
+
+      iob->io_flink = NULL;
+      iob_free_batch(iob);
+    }
+
+  /* And return the I/O buffer after the one that was freed */
+
+  return next;
+}
+
+/****************************************************************************
+ * Name: iob_free_batch
+ *
+ * Description:
+ *   Return every I/O buffer in a list linked through io_flink (such as a
+ *   buffer chain or a list allocated by iob_alloc_batch()) to the free list
+ *   under a single critical section.
+ *
+ ****************************************************************************/
+
+void iob_free_batch(FAR struct iob_s *iob)
+{
+  FAR struct iob_s *next;
+  irqstate_t flags;
+
+  iobinfo("iob=%p\n", iob);
+
+  /* Free the I/O buffers by adding them to the head of the free or the
    * committed list. We don't know what context we are called from so
    * we use extreme measures to protect the free list:  We disable
    * interrupts very briefly.
@@ -109,36 +142,47 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 
   flags = enter_critical_section();
 
-  /* Which list?  If there is a task waiting for an IOB, then put
-   * the IOB on either the free list or on the committed list where
-   * it is reserved for that allocation (and not available to
-   * iob_tryalloc()).
-   */
-
-  if (g_iob_sem.semcount < 0)
-    {
-      iob->io_flink   = g_iob_committed;
-      g_iob_committed = iob;
-    }
-  else
+  for (; iob != NULL; iob = next)
     {
-      iob->io_flink   = g_iob_freelist;
-      g_iob_freelist  = iob;
-    }
+      next = iob->io_flink;
 
-  /* Signal that an IOB is available.  If there is a thread waiting
-   * for an IOB, this will wake up exactly one thread.  The semaphore
-   * count will correctly indicated that the awakened task owns an
-   * IOB and should find it in the committed list.
-   */
+      /* Which list?  If there is a task waiting for an IOB, then put
+       * the IOB on either the free list or on the committed list where
+       * it is reserved for that allocation (and not available to
+       * iob_tryalloc()).
+       */
+
+      if (g_iob_sem.semcount < 0)
+        {
+          iob->io_flink   = g_iob_committed;
+          g_iob_committed = iob;
+        }
+      else
+        {
+          iob->io_flink   = g_iob_freelist;
+          g_iob_freelist  = iob;
+        }
 
-  sem_post(&g_iob_sem);
+      /* Signal that an IOB is available.  If there is a thread waiting
+       * for an IOB, this will wake up exactly one thread.  The semaphore
+       * count will correctly indicated that the awakened task owns an
+       * IOB and should find it in the committed list.
+       */
+
+      sem_post(&g_iob_sem);
 #if CONFIG_IOB_THROTTLE > 0
-  sem_post(&g_throttle_sem);
+      sem_post(&g_throttle_sem);
 #endif
-  leave_critical_section(flags);
+    }
 
-  /* And return the I/O buffer after the one that was freed */
+  /* Wake up every task waiting in iob_alloc_batch() so that each can check
+   * whether enough I/O buffers are free now.
+   */
 
-  return next;
+  for (; g_iob_nbatchwaiters > 0; g_iob_nbatchwaiters--)
+    {
+      sem_post(&g_iob_batchsem);
+    }
+
+  leave_critical_section(flags);
 }
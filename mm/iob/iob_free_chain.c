@@ -59,12 +59,7 @@
 
 void iob_free_chain(FAR struct iob_s *iob)
 {
-  FAR struct iob_s *next;
+  /* Free every IOB in the chain under a single critical section */
 
-  /* Free each IOB in the chain -- one at a time to keep the count straight */
-
-  for (; iob; iob = next)
-    {
-      next = iob_free(iob);
-    }
+  iob_free_batch(iob);
 }
@@ -0,0 +1,98 @@
+/****************************************************************************
+ * mm/iob/iob_getstats.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/iob.h>
+
+#include "iob.h"
+
+#ifdef CONFIG_IOB_STATS
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iob_getstats
+ *
+ * Description:
+ *   Return a snapshot of the I/O buffer usage statistics.
+ *
+ ****************************************************************************/
+
+void iob_getstats(FAR struct iob_stats_s *stats)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+#ifdef CONFIG_IOB_CPUCACHE
+  int cpu;
+#endif
+
+  flags = enter_critical_section();
+
+  *stats          = g_iob_stats;
+  stats->ntotal   = CONFIG_IOB_NBUFFERS;
+  stats->nwaiting = g_iob_nwaiters;
+  stats->nfree    = 0;
+
+  for (iob = g_iob_freelist; iob != NULL; iob = iob->io_flink)
+    {
+      stats->nfree++;
+    }
+
+#ifdef CONFIG_IOB_CPUCACHE
+  /* The per-CPU counts are read without the cache locks; they are only
+   * statistics.
+   */
+
+  for (cpu = 0; cpu < IOB_NCPUS; cpu++)
+    {
+      stats->ncached   += g_iob_cpucache[cpu].ic_count;
+      stats->ncachehit += g_iob_cpucache[cpu].ic_nhit;
+    }
+#endif
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_IOB_STATS */
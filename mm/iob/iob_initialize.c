@@ -42,6 +42,7 @@
 #include <stdbool.h>
 #include <semaphore.h>
 
+#include <nuttx/semaphore.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -97,6 +98,29 @@ sem_t g_throttle_sem;       /* Counts available I/O buffers when throttled */
 sem_t g_qentry_sem;         /* Counts free I/O buffer queue containers */
 #endif
 
+/* The number of tasks waiting in iob_alloc() for a free I/O buffer */
+
+volatile uint16_t g_iob_nwaiters;
+
+/* Wakes up the tasks waiting in iob_alloc_batch() when I/O buffers are
+ * freed, and the number of such tasks.
+ */
+
+sem_t g_iob_batchsem;
+volatile uint16_t g_iob_nbatchwaiters;
+
+#ifdef CONFIG_IOB_CPUCACHE
+/* The per-CPU caches of free I/O buffers */
+
+struct iob_cpucache_s g_iob_cpucache[IOB_NCPUS];
+#endif
+
+#ifdef CONFIG_IOB_STATS
+/* Usage statistics */
+
+struct iob_stats_s g_iob_stats;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -132,7 +156,23 @@ void iob_initialize(void)
 
       g_iob_committed = NULL;
 
+#if defined(CONFIG_IOB_CPUCACHE) && defined(CONFIG_SMP)
+      /* All of the per-CPU caches are initially empty */
+
+      for (i = 0; i < IOB_NCPUS; i++)
+        {
+          spin_initialize(&g_iob_cpucache[i].ic_lock, SP_UNLOCKED);
+        }
+#endif
+
       sem_init(&g_iob_sem, 0, CONFIG_IOB_NBUFFERS);
+
+      /* The batch semaphore is used for signaling and, hence, should not
+       * have priority inheritance enabled.
+       */
+
+      sem_init(&g_iob_batchsem, 0, 0);
+      sem_setprotocol(&g_iob_batchsem, SEM_PRIO_NONE);
 #if CONFIG_IOB_THROTTLE > 0
       sem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
 #endif
@@ -0,0 +1,100 @@
+/****************************************************************************
+ * mm/kmm_heap/kmm_region.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdlib.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: kmm_setregionflags
+ *
+ * Description:
+ *   Set the MM_REGION_* placement attributes of a region of the kernel heap.
+ *
+ ****************************************************************************/
+
+void kmm_setregionflags(int region, uint8_t flags)
+{
+  mm_setregionflags(&g_kmmheap, region, flags);
+}
+
+/****************************************************************************
+ * Name: kmm_malloc_region
+ *
+ * Description:
+ *   Allocate memory from the kernel heap, preferring the regions that have
+ *   all of the MM_REGION_* attributes in 'flags'.
+ *
+ * Parameters:
+ *   size  - Size (in bytes) of the memory region to be allocated.
+ *   flags - The preferred MM_REGION_* attributes
+ *
+ * Return Value:
+ *   The address of the allocated memory (NULL on failure to allocate)
+ *
+ ****************************************************************************/
+
+FAR void *kmm_malloc_region(size_t size, uint8_t flags)
+{
+  return mm_malloc_region(&g_kmmheap, size, flags);
+}
+
+/****************************************************************************
+ * Name: kmm_mallinfo_region
+ *
+ * Description:
+ *   Return a copy of updated current heap information for one region of
+ *   the kernel heap.
+ *
+ ****************************************************************************/
+
+int kmm_mallinfo_region(int region, FAR struct mallinfo *info)
+{
+  return mm_mallinfo_region(&g_kmmheap, region, info);
+}
+
+#endif /* CONFIG_MM_KERNEL_HEAP */
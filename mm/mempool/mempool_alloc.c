@@ -0,0 +1,170 @@
+/****************************************************************************
+ * mm/mempool/mempool_alloc.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_expand
+ *
+ * Description:
+ *   Grow the pool by mp_nexpand blocks allocated from the kernel heap.  This
+ *   must not be called from an interrupt handler.
+ *
+ *   Several callers may find the pool exhausted at the same time.  The free
+ *   count is checked again under the lock so that only the first of them
+ *   grows the pool; the others return their allocation to the heap.
+ *
+ ****************************************************************************/
+
+static void mempool_expand(FAR struct mempool_s *pool)
+{
+  FAR void *base;
+  irqstate_t flags;
+  uint16_t nblocks = pool->mp_nexpand;
+
+  /* Don't let the block count wrap */
+
+  if ((uint32_t)pool->mp_ntotal + nblocks > UINT16_MAX)
+    {
+      return;
+    }
+
+  base = kmm_malloc(pool->mp_bsize * nblocks);
+  if (base == NULL)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+  if (pool->mp_nfree <= pool->mp_nreserve &&
+      (uint32_t)pool->mp_ntotal + nblocks <= UINT16_MAX)
+    {
+      mempool_addblocks(pool, base, nblocks);
+      base = NULL;
+    }
+
+  leave_critical_section(flags);
+
+  if (base != NULL)
+    {
+      kmm_free(base);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate one block from the pool.  This function may be called from
+ *   interrupt handlers.  Only interrupt handlers may take the reserved
+ *   blocks; only non-interrupt callers may grow the pool.  The contents
+ *   of the returned block are undefined.
+ *
+ * Input Parameters:
+ *   pool - The pool to allocate from
+ *
+ * Returned Value:
+ *   The allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool)
+{
+  FAR sq_entry_t *blk = NULL;
+  irqstate_t flags;
+  uint16_t nused;
+  bool inint;
+
+  DEBUGASSERT(pool != NULL);
+
+  inint = up_interrupt_context();
+
+  /* Try to grow the pool before dipping into the interrupt reserve.  The
+   * heap allocation cannot be done inside the critical section.
+   */
+
+  if (!inint && pool->mp_nexpand > 0 &&
+      pool->mp_nfree <= pool->mp_nreserve)
+    {
+      mempool_expand(pool);
+    }
+
+  flags = enter_critical_section();
+  if (pool->mp_nfree > pool->mp_nreserve ||
+      (inint && pool->mp_nfree > 0))
+    {
+      blk = sq_remfirst(&pool->mp_freelist);
+      DEBUGASSERT(blk != NULL);
+
+      pool->mp_nfree--;
+      pool->mp_nalloc++;
+
+      nused = pool->mp_ntotal - pool->mp_nfree;
+      if (nused > pool->mp_npeak)
+        {
+          pool->mp_npeak = nused;
+        }
+    }
+  else
+    {
+      pool->mp_nfail++;
+    }
+
+  leave_critical_section(flags);
+  return blk;
+}
@@ -0,0 +1,128 @@
+/****************************************************************************
+ * mm/mempool/mempool_info.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/mm/mempool.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return a snapshot of the state and statistics of a pool.
+ *
+ * Input Parameters:
+ *   pool - The pool to query
+ *   info - The location to return the information
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_info(FAR struct mempool_s *pool,
+                  FAR struct mempoolinfo_s *info)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && info != NULL);
+
+  flags          = enter_critical_section();
+  info->name     = pool->mp_name;
+  info->bsize    = pool->mp_bsize;
+  info->ntotal   = pool->mp_ntotal;
+  info->nfree    = pool->mp_nfree;
+  info->npeak    = pool->mp_npeak;
+  info->nreserve = pool->mp_nreserve;
+  info->nalloc   = pool->mp_nalloc;
+  info->nfail    = pool->mp_nfail;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_foreach
+ *
+ * Description:
+ *   Call the provided handler with a snapshot of each registered pool.  The
+ *   traversal stops if the handler returns a non-zero value.
+ *
+ * Input Parameters:
+ *   handler - The function to call for each pool
+ *   arg     - An opaque argument passed to the handler
+ *
+ * Returned Value:
+ *   Zero if all pools were visited; otherwise the non-zero value returned
+ *   by the handler.
+ *
+ ****************************************************************************/
+
+int mempool_foreach(mempool_handler_t handler, FAR void *arg)
+{
+  FAR struct mempool_s *pool;
+  struct mempoolinfo_s info;
+  irqstate_t flags;
+  int ret = 0;
+
+  DEBUGASSERT(handler != NULL);
+
+  /* Pools are never unregistered so the links remain valid after the
+   * critical section is left.
+   */
+
+  flags = enter_critical_section();
+  pool  = g_mempools;
+  leave_critical_section(flags);
+
+  for (; pool != NULL && ret == 0; pool = pool->mp_flink)
+    {
+      mempool_info(pool, &info);
+      ret = handler(&info, arg);
+    }
+
+  return ret;
+}
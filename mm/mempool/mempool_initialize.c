@@ -0,0 +1,169 @@
+/****************************************************************************
+ * mm/mempool/mempool_initialize.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+
+#include "mempool.h"
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of all initialized pools */
+
+FAR struct mempool_s *g_mempools;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_addblocks
+ *
+ * Description:
+ *   Carve the memory at 'base' into 'nblocks' blocks and add them to the
+ *   free list of the pool.
+ *
+ ****************************************************************************/
+
+void mempool_addblocks(FAR struct mempool_s *pool, FAR void *base,
+                       uint16_t nblocks)
+{
+  FAR uint8_t *blk = (FAR uint8_t *)base;
+  irqstate_t flags;
+  int i;
+
+  flags = enter_critical_section();
+  for (i = 0; i < nblocks; i++)
+    {
+      sq_addlast((FAR sq_entry_t *)blk, &pool->mp_freelist);
+      blk += pool->mp_bsize;
+    }
+
+  pool->mp_nfree  += nblocks;
+  pool->mp_ntotal += nblocks;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a pool of fixed-size blocks and register it so that it is
+ *   visible to mempool_foreach().
+ *
+ * Input Parameters:
+ *   pool     - The pool to be initialized
+ *   name     - The name of the pool.  The string is not copied.
+ *   bsize    - The size of one block.  This is also the stride between
+ *              blocks in the storage array.  It must be at least
+ *              MEMPOOL_MINBSIZE.
+ *   storage  - Storage for the initial blocks, for example a statically
+ *              allocated array of objects.  If NULL, the initial blocks
+ *              are allocated from the kernel heap.
+ *   ninit    - The number of initial blocks
+ *   nexpand  - The number of blocks to allocate from the kernel heap when
+ *              the pool is exhausted.  Zero means that the pool never
+ *              grows.
+ *   nreserve - The number of free blocks reserved for interrupt handlers
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   if the initial blocks could not be allocated.
+ *
+ ****************************************************************************/
+
+int mempool_initialize(FAR struct mempool_s *pool, FAR const char *name,
+                       size_t bsize, FAR void *storage, uint16_t ninit,
+                       uint16_t nexpand, uint16_t nreserve)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  DEBUGASSERT(pool != NULL && bsize >= MEMPOOL_MINBSIZE);
+
+  sq_init(&pool->mp_freelist);
+  pool->mp_name     = name;
+  pool->mp_bsize    = bsize;
+  pool->mp_nexpand  = nexpand;
+  pool->mp_nreserve = nreserve;
+  pool->mp_nfree    = 0;
+  pool->mp_ntotal   = 0;
+  pool->mp_npeak    = 0;
+  pool->mp_nalloc   = 0;
+  pool->mp_nfail    = 0;
+
+  /* Allocate the initial blocks from the kernel heap if no storage was
+   * provided.
+   */
+
+  if (storage == NULL && ninit > 0)
+    {
+      storage = kmm_malloc(bsize * ninit);
+      if (storage == NULL)
+        {
+          ninit = 0;
+          ret   = -ENOMEM;
+        }
+    }
+
+  if (ninit > 0)
+    {
+      mempool_addblocks(pool, storage, ninit);
+    }
+
+  /* Register the pool.  Even a pool whose initial allocation failed is
+   * registered:  It may still grow later.
+   */
+
+  flags          = enter_critical_section();
+  pool->mp_flink = g_mempools;
+  g_mempools     = pool;
+  leave_critical_section(flags);
+
+  return ret;
+}
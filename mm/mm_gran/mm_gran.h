@@ -41,8 +41,10 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <nuttx/compiler.h>
 
 #include <stdint.h>
+#include <strings.h>
 #include <semaphore.h>
 
 #include <arch/types.h>
@@ -59,6 +61,16 @@
 #define SIZEOF_GRAN_S(n) \
   (sizeof(struct gran_s) + sizeof(uint32_t) * (SIZEOF_GAT(n) - 1))
 
+/* Index of the least significant set bit in a non-zero GAT entry.  The long
+ * variants are used because int may be only 16-bits wide.
+ */
+
+#ifdef CONFIG_HAVE_BUILTIN_CTZ
+#  define GRAN_CTZ(v)  __builtin_ctzl((unsigned long)(v))
+#else
+#  define GRAN_CTZ(v)  (ffsl((long)(v)) - 1)
+#endif
+
 /* Debug */
 
 #ifdef CONFIG_CPP_HAVE_VARARGS
@@ -93,6 +105,9 @@ struct gran_s
 {
   uint8_t    log2gran;  /* Log base 2 of the size of one granule */
   uint16_t   ngranules; /* The total number of (aligned) granules in the heap */
+#ifdef CONFIG_GRAN_NEXTFIT
+  uint16_t   hint;      /* Granule at which the next search begins */
+#endif
 #ifdef CONFIG_GRAN_INTR
   irqstate_t irqstate;  /* For exclusive access to the GAT */
 #else
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <assert.h>
+#include <errno.h>
 
 #include <nuttx/mm/gran.h>
 
@@ -51,6 +52,97 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: gran_search
+ *
+ * Description:
+ *   Search the granule allocation table for a run of free granules.  Whole
+ *   GAT entries are examined at a time:  The first free granule at or after
+ *   the current position is found with a count-trailing-zeros of the
+ *   inverted entry and the end of that free run is found with a
+ *   count-trailing-zeros of the entry itself.  Fully allocated or fully free
+ *   entries are skipped without examining individual bits, so the number of
+ *   steps depends on the number of runs rather than the number of granules.
+ *
+ * Input Parameters:
+ *   priv      - The granule heap state structure.
+ *   granno    - The first granule that may begin the allocation.
+ *   limit     - The allocation must begin before this granule.
+ *   ngranules - The number of contiguous granules needed.
+ *
+ * Returned Value:
+ *   The granule number of the start of the free run on success; a negated
+ *   value if there is no such run.
+ *
+ ****************************************************************************/
+
+static int gran_search(FAR struct gran_s *priv, unsigned int granno,
+                       unsigned int limit, unsigned int ngranules)
+{
+  unsigned int ngat = SIZEOF_GAT(priv->ngranules);
+  unsigned int endno;
+  unsigned int usedno;
+  unsigned int gatidx;
+  uint32_t     bits;
+
+  for (; ; )
+    {
+      /* Find the first free (zero) granule at or after granno.  The unused
+       * bits at the end of the last GAT entry are zero, but any allocation
+       * beginning there fails the size test below.
+       */
+
+      gatidx = granno >> 5;
+      bits   = ~priv->gat[gatidx] & (0xffffffff << (granno & 31));
+
+      while (bits == 0)
+        {
+          if (++gatidx >= ngat)
+            {
+              return -ENOMEM;
+            }
+
+          bits = ~priv->gat[gatidx];
+        }
+
+      granno = (gatidx << 5) + GRAN_CTZ(bits);
+      endno  = granno + ngranules;
+
+      if (granno >= limit || endno > priv->ngranules)
+        {
+          return -ENOMEM;
+        }
+
+      /* Find the first allocated (one) granule after the free granule.  If
+       * there is none before endno, then the allocation fits here.
+       */
+
+      bits = priv->gat[gatidx] & (0xffffffff << (granno & 31));
+
+      while (bits == 0)
+        {
+          if ((++gatidx << 5) >= endno)
+            {
+              return (int)granno;
+            }
+
+          bits = priv->gat[gatidx];
+        }
+
+      usedno = (gatidx << 5) + GRAN_CTZ(bits);
+      if (usedno >= endno)
+        {
+          return (int)granno;
+        }
+
+      /* The free run is too short.  Continue with the allocated granule
+       * that ended it.
+       */
+
+      granno = usedno;
+    }
+}
+
 /****************************************************************************
  * Name: gran_common_alloc
  *
@@ -71,175 +163,58 @@ static inline FAR void *gran_common_alloc(FAR struct gran_s *priv, size_t size)
   unsigned int ngranules;
   size_t       tmpmask;
   uintptr_t    alloc;
-  uint32_t     curr;
-  uint32_t     next;
-  uint32_t     mask;
-  int          granidx;
-  int          gatidx;
-  int          bitidx;
-  int          shift;
+  int          granno;
 
-  DEBUGASSERT(priv && size <= 32 * (1 << priv->log2gran));
+  DEBUGASSERT(priv);
 
   if (priv && size > 0)
     {
-      /* Get exclusive access to the GAT */
-
-      gran_enter_critical(priv);
-
       /* How many contiguous granules we we need to find? */
 
+      if (size > ((size_t)priv->ngranules << priv->log2gran))
+        {
+          return NULL;
+        }
+
       tmpmask   = (1 << priv->log2gran) - 1;
       ngranules = (size + tmpmask) >> priv->log2gran;
 
-      /* Then create mask for that number of granules */
-
-      DEBUGASSERT(ngranules <= 32);
-      mask = 0xffffffff >> (32 - ngranules);
+      /* Get exclusive access to the GAT */
 
-      /* Now search the granule allocation table for that number of contiguous */
+      gran_enter_critical(priv);
 
-      alloc = priv->heapstart;
+#ifdef CONFIG_GRAN_NEXTFIT
+      /* Search from the end of the previous allocation to the end of the
+       * heap and then, if necessary, wrap around to the beginning.
+       */
 
-      for (granidx = 0; granidx < priv->ngranules; granidx += 32)
+      granno = gran_search(priv, priv->hint, priv->ngranules, ngranules);
+      if (granno < 0 && priv->hint > 0)
         {
-          /* Get the GAT index associated with the granule table entry */
-
-          gatidx = granidx >> 5;
-          curr = priv->gat[gatidx];
-
-          /* Handle the case where there are no free granules in the entry */
+          granno = gran_search(priv, 0, priv->hint, ngranules);
+        }
+#else
+      granno = gran_search(priv, 0, priv->ngranules, ngranules);
+#endif
 
-          if (curr == 0xffffffff)
-            {
-              alloc += (32 << priv->log2gran);
-              continue;
-            }
+      if (granno >= 0)
+        {
+          /* Mark these granules allocated */
 
-          /* Get the next entry from the GAT to support a 64 bit shift */
+          alloc = priv->heapstart + ((uintptr_t)granno << priv->log2gran);
+          gran_mark_allocated(priv, alloc, ngranules);
 
-          if (granidx < priv->ngranules)
-            {
-              next = priv->gat[gatidx + 1];
-            }
+#ifdef CONFIG_GRAN_NEXTFIT
+          /* The next search begins just after this allocation */
 
-          /* Use all ones when are at the last entry in the GAT (meaning
-           * nothing can be allocated.
-           */
+          granno += ngranules;
+          priv->hint = granno < priv->ngranules ? granno : 0;
+#endif
 
-          else
-            {
-              next = 0xffffffff;
-            }
+          /* And return the allocation address */
 
-          /* Search through the allocations in the 'curr' GAT entry
-           * to see if we can satisfy the allocation starting in that
-           * entry.
-           *
-           * This loop continues until either all of the bits have been
-           * examined (bitidx >= 32), or until there are insufficient
-           * granules left to satisfy the allocation.
-           */
-
-          for (bitidx = 0;
-               bitidx < 32 && (granidx + bitidx + ngranules) <= priv->ngranules;
-              )
-            {
-              /* Break out if there are no further free bits in 'curr'.
-               * All of the zero bits might have gotten shifted out.
-               */
-
-              if (curr == 0xffffffff)
-                {
-                  break;
-                }
-
-              /* Check for the first zero bit in the lower or upper 16-bits.
-               * From the test above, we know that at least one of the 32-
-               * bits in 'curr' is zero.
-               */
-
-              else if ((curr & 0x0000ffff) == 0x0000ffff)
-                {
-                  /* Not in the lower 16 bits.  The first free bit must be
-                   * in the upper 16 bits.
-                   */
-
-                  shift = 16;
-                }
-
-              /* We know that the first free bit is now within the lower 16
-               * bits of 'curr'.  Is it in the upper or lower byte?
-               */
-
-              else if ((curr & 0x0000ff) == 0x000000ff)
-                {
-                  /* Not in the lower 8 bits.  The first free bit must be in
-                   * the upper 8 bits.
-                   */
-
-                  shift = 8;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower nibble?
-               */
-
-              else if ((curr & 0x00000f) == 0x0000000f)
-                {
-                  /* Not in the lower 4 bits.  The first free bit must be in
-                   * the upper 4 bits.
-                   */
-
-                  shift = 4;
-                }
-
-              /* We know that the first free bit is now within the lower 4 bits
-               * of 'curr'.  Is it in the upper or lower pair?
-               */
-
-              else if ((curr & 0x000003) == 0x00000003)
-                {
-                  /* Not in the lower 2 bits.  The first free bit must be in
-                   * the upper 2 bits.
-                   */
-
-                  shift = 2;
-                }
-
-              /* We know that the first free bit is now within the lower 4 bits
-               * of 'curr'.  Check if we have the allocation at this bit position.
-               */
-
-              else if ((curr & mask) == 0)
-                {
-                  /* Yes.. mark these granules allocated */
-
-                  gran_mark_allocated(priv, alloc, ngranules);
-
-                  /* And return the allocation address */
-
-                  gran_leave_critical(priv);
-                  return (FAR void *)alloc;
-                }
-
-              /* The free allocation does not start at this position */
-
-              else
-                {
-                  shift = 1;
-                }
-
-              /* Set up for the next time through the loop.  Perform a 64
-               * bit shift to move to the next gran position andi ncrement
-               * to the next candidate allocation address.
-               */
-
-              alloc  += (shift << priv->log2gran);
-              curr    = (curr >> shift) | (next << (32 - shift));
-              next  >>= shift;
-              bitidx += shift;
-            }
+          gran_leave_critical(priv);
+          return (FAR void *)alloc;
         }
 
       gran_leave_critical(priv);
@@ -256,11 +231,8 @@ static inline FAR void *gran_common_alloc(FAR struct gran_s *priv, size_t size)
  * Name: gran_alloc
  *
  * Description:
- *   Allocate memory from the granule heap.
- *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
+ *   Allocate memory from the granule heap.  The allocation may span any
+ *   number of contiguous granules.
  *
  * Input Parameters:
  *   handle - The handle previously returned by gran_initialize
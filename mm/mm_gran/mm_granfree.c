@@ -77,7 +77,7 @@ static inline void gran_common_free(FAR struct gran_s *priv,
   unsigned int avail;
   uint32_t     gatmask;
 
-  DEBUGASSERT(priv && memory && size <= 32 * (1 << priv->log2gran));
+  DEBUGASSERT(priv && memory);
 
   /* Get exclusive access to the GAT */
 
@@ -98,39 +98,36 @@ static inline void gran_common_free(FAR struct gran_s *priv,
 
   granmask =  (1 << priv->log2gran) - 1;
   ngranules = (size + granmask) >> priv->log2gran;
+  DEBUGASSERT(granno + ngranules <= priv->ngranules);
 
-  /* Clear bits in the GAT entry or entries */
+  /* Clear bits in each GAT entry spanned by the allocation.  Only the first
+   * and last entries may be partial.
+   */
 
-  avail = 32 - gatbit;
-  if (ngranules > avail)
+  while (ngranules > 0)
     {
-      /* Clear bits in the first GAT entry */
+      avail = 32 - gatbit;
+      if (ngranules >= avail)
+        {
+          /* Clear all bits from gatbit to the end of the entry */
+
+          gatmask    = 0xffffffff << gatbit;
+          ngranules -= avail;
+        }
+      else
+        {
+          /* The allocation ends in this entry */
+
+          gatmask    = 0xffffffff >> (32 - ngranules);
+          gatmask  <<= gatbit;
+          ngranules  = 0;
+        }
 
-      gatmask = (0xffffffff << gatbit);
       DEBUGASSERT((priv->gat[gatidx] & gatmask) == gatmask);
-
       priv->gat[gatidx] &= ~gatmask;
-      ngranules -= avail;
-
-      /* Clear bits in the second GAT entry */
-
-      gatmask = 0xffffffff >> (32 - ngranules);
-      DEBUGASSERT((priv->gat[gatidx+1] & gatmask) == gatmask);
-
-      priv->gat[gatidx+1] &= ~gatmask;
-    }
 
-  /* Handle the case where where all of the granules came from one entry */
-
-  else
-    {
-      /* Clear bits in a single GAT entry */
-
-      gatmask   = 0xffffffff >> (32 - ngranules);
-      gatmask <<= gatbit;
-      DEBUGASSERT((priv->gat[gatidx] & gatmask) == gatmask);
-
-      priv->gat[gatidx] &= ~gatmask;
+      gatidx++;
+      gatbit = 0;
     }
 
   gran_leave_critical(priv);
@@ -0,0 +1,187 @@
+/****************************************************************************
+ * mm/mm_gran/mm_graninfo.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/mm/gran.h>
+
+#include "mm_gran/mm_gran.h"
+
+#ifdef CONFIG_GRAN
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_common_info
+ *
+ * Description:
+ *   Return information about the granule heap.
+ *
+ * Input Parameters:
+ *   priv - The granule heap state structure.
+ *   info - Memory location to return the gran allocator info.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void gran_common_info(FAR struct gran_s *priv,
+                                    FAR struct graninfo_s *info)
+{
+  unsigned int granno;
+  unsigned int nfree;
+  unsigned int mxfree;
+  unsigned int run;
+  unsigned int nbits;
+  uint32_t gatvalue;
+
+  DEBUGASSERT(priv != NULL && info != NULL);
+
+  nfree  = 0;
+  mxfree = 0;
+  run    = 0;
+
+  /* Get exclusive access to the GAT */
+
+  gran_enter_critical(priv);
+
+  /* Visit each GAT entry, counting the free granules and tracking the
+   * longest run of free granules.  Entirely free and entirely allocated
+   * entries are handled a word at a time.
+   */
+
+  for (granno = 0; granno < priv->ngranules; granno += 32)
+    {
+      gatvalue = priv->gat[granno >> 5];
+      nbits    = priv->ngranules - granno;
+      if (nbits >= 32)
+        {
+          nbits = 32;
+        }
+      else
+        {
+          /* Granules beyond the end of the heap are never free */
+
+          gatvalue |= 0xffffffff << nbits;
+        }
+
+      if (gatvalue == 0)
+        {
+          nfree += 32;
+          run   += 32;
+        }
+      else if (gatvalue == 0xffffffff)
+        {
+          run = 0;
+        }
+      else
+        {
+          unsigned int bit;
+
+          for (bit = 0; bit < nbits; bit++, gatvalue >>= 1)
+            {
+              if ((gatvalue & 1) == 0)
+                {
+                  nfree++;
+                  run++;
+                }
+              else
+                {
+                  run = 0;
+                }
+
+              if (run > mxfree)
+                {
+                  mxfree = run;
+                }
+            }
+        }
+
+      if (run > mxfree)
+        {
+          mxfree = run;
+        }
+    }
+
+  info->log2gran  = priv->log2gran;
+  info->ngranules = priv->ngranules;
+
+  gran_leave_critical(priv);
+
+  info->nfree  = nfree;
+  info->mxfree = mxfree;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_info
+ *
+ * Description:
+ *   Return information about the granule heap.
+ *
+ * Input Parameters:
+ *   handle - The handle previously returned by gran_initialize
+ *   info   - Memory location to return the gran allocator info.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_GRAN_SINGLE
+void gran_info(FAR struct graninfo_s *info)
+{
+  gran_common_info(g_graninfo, info);
+}
+#else
+void gran_info(GRAN_HANDLE handle, FAR struct graninfo_s *info)
+{
+  gran_common_info((FAR struct gran_s *)handle, info);
+}
+#endif
+
+#endif /* CONFIG_GRAN */
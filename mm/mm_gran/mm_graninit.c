@@ -94,7 +94,7 @@ gran_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2gran,
   FAR struct gran_s *priv;
   uintptr_t          heapend;
   uintptr_t          alignedstart;
-  unsigned int       mask;
+  uintptr_t          mask;
   unsigned int       alignedsize;
   unsigned int       ngranules;
 
@@ -109,12 +109,12 @@ gran_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2gran,
 
   /* Get the aligned start of the heap */
 
-  mask         = (1 << log2align) - 1;
+  mask         = ((uintptr_t)1 << log2align) - 1;
   alignedstart = ((uintptr_t)heapstart + mask) & ~mask;
 
   /* Determine the number of granules */
 
-  mask         = (1 << log2gran) - 1;
+  mask         = ((uintptr_t)1 << log2gran) - 1;
   heapend      = (uintptr_t)heapstart + heapsize;
   alignedsize  = (heapend - alignedstart) & ~mask;
   ngranules    = alignedsize >> log2gran;
@@ -178,10 +178,6 @@ gran_common_initialize(FAR void *heapstart, size_t heapsize, uint8_t log2gran,
  *   The actual memory allocates will be 64 byte (wasting 17 bytes) and
  *   will be aligned at least to (1 << log2align).
  *
- *   NOTE: The current implementation also restricts the maximum allocation
- *   size to 32 granules.  That restriction could be eliminated with some
- *   additional coding effort.
- *
  * Input Parameters:
  *   heapstart - Start of the granule allocation heap
  *   heapsize  - Size of heap in bytes
@@ -79,45 +79,41 @@ void gran_mark_allocated(FAR struct gran_s *priv, uintptr_t alloc,
   /* Determine the granule number of the allocation */
 
   granno = (alloc - priv->heapstart) >> priv->log2gran;
+  DEBUGASSERT(granno + ngranules <= priv->ngranules);
 
   /* Determine the GAT table index associated with the allocation */
 
   gatidx = granno >> 5;
   gatbit = granno & 31;
 
-  /* Mark bits in the GAT entry or entries */
+  /* Mark bits in each GAT entry spanned by the allocation.  Only the first
+   * and last entries may be partial.
+   */
 
-  avail = 32 - gatbit;
-  if (ngranules > avail)
+  while (ngranules > 0)
     {
-      /* Mark bits in the first GAT entry */
+      avail = 32 - gatbit;
+      if (ngranules >= avail)
+        {
+          /* Mark all bits from gatbit to the end of the entry */
+
+          gatmask    = 0xffffffff << gatbit;
+          ngranules -= avail;
+        }
+      else
+        {
+          /* The allocation ends in this entry */
+
+          gatmask    = 0xffffffff >> (32 - ngranules);
+          gatmask  <<= gatbit;
+          ngranules  = 0;
+        }
 
-      gatmask = 0xffffffff << gatbit;
       DEBUGASSERT((priv->gat[gatidx] & gatmask) == 0);
-
       priv->gat[gatidx] |= gatmask;
-      ngranules -= avail;
-
-      /* Mark bits in the second GAT entry */
-
-      gatmask = 0xffffffff >> (32 - ngranules);
-      DEBUGASSERT((priv->gat[gatidx+1] & gatmask) == 0);
-
-      priv->gat[gatidx+1] |= gatmask;
-    }
-
-  /* Handle the case where where all of the granules come from one entry */
 
-  else
-    {
-      /* Mark bits in a single GAT entry */
-
-      gatmask   = 0xffffffff >> (32 - ngranules);
-      gatmask <<= gatbit;
-      DEBUGASSERT((priv->gat[gatidx] & gatmask) == 0);
-
-      priv->gat[gatidx] |= gatmask;
-      return;
+      gatidx++;
+      gatbit = 0;
     }
 }
 
@@ -79,7 +79,7 @@ static inline void gran_common_reserve(FAR struct gran_s *priv,
   if (size > 0)
     {
       uintptr_t mask = (1 << priv->log2gran) - 1;
-      uintptr_t end  = start + size - 1;
+      uintptr_t end  = start + size;
       unsigned int ngranules;
 
       /* Get the aligned (down) start address and the aligned (up) end
@@ -91,7 +91,7 @@ static inline void gran_common_reserve(FAR struct gran_s *priv,
 
       /* Calculate the new size in granules */
 
-      ngranules = ((end - start) >> priv->log2gran) + 1;
+      ngranules = (end - start) >> priv->log2gran;
 
       /* And reserve the granules */
 
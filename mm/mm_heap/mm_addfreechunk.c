@@ -49,13 +49,14 @@
  * Name: mm_addfreechunk
  *
  * Description:
- *   Add a free chunk to the node next.  It is assumed that the caller holds
- *   the mm semaphore
+ *   Add a free chunk to the free lists of the region that contains it.  It
+ *   is assumed that the caller holds the mm semaphore
  *
  ****************************************************************************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 {
+  FAR struct mm_freelist_s *list = MM_FREELIST(heap, node);
   FAR struct mm_freenode_s *next;
   FAR struct mm_freenode_s *prev;
 
@@ -63,11 +64,23 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
   int ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_TLSF
+  /* Each segregated list is unordered, so just add the node at the head of
+   * the list and mark the list as non-empty.
+   */
+
+  prev = &list->mm_nodelist[ndx];
+  next = prev->flink;
+
+  list->mm_flbitmap                    |= (uint32_t)1 << (ndx >> MM_SL_SHIFT);
+  list->mm_slbitmap[ndx >> MM_SL_SHIFT] |= (uint32_t)1 << (ndx & MM_SL_MASK);
+#else
   /* Now put the new node int the next */
 
-  for (prev = &heap->mm_nodelist[ndx], next = heap->mm_nodelist[ndx].flink;
+  for (prev = &list->mm_nodelist[ndx], next = list->mm_nodelist[ndx].flink;
        next && next->size && next->size < node->size;
        prev = next, next = next->flink);
+#endif
 
   /* Does it go in mid next or at the end? */
 
@@ -0,0 +1,459 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cpucache.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_CPUCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if CONFIG_MM_CPUCACHE_BATCH > CONFIG_MM_CPUCACHE_DEPTH
+#  error CONFIG_MM_CPUCACHE_BATCH must not exceed CONFIG_MM_CPUCACHE_DEPTH
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cpucache_class
+ *
+ * Description:
+ *   Return the cache class for a chunk of the given size (including the
+ *   allocated node header) or -1 if chunks of that size are not cached.
+ *
+ ****************************************************************************/
+
+static inline int mm_cpucache_class(size_t size)
+{
+  if ((size & MM_GRAN_MASK) != 0 || size > MM_CPUCACHE_MAXCHUNK)
+    {
+      return -1;
+    }
+
+  return (int)(size >> MM_MIN_SHIFT) - 1;
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_bypass
+ *
+ * Description:
+ *   The caches are bypassed while the caller holds the heap semaphore.
+ *   This is the case while a cache is being refilled or drained, and also
+ *   when the caller cannot wait for the semaphore (see mm_trysemaphore()).
+ *
+ ****************************************************************************/
+
+static inline bool mm_cpucache_bypass(FAR struct mm_heap_s *heap)
+{
+  return heap->mm_holder == getpid();
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_lock
+ *
+ * Description:
+ *   Disable local interrupts so that the caller can be neither preempted
+ *   nor migrated to another CPU and return the cache of the current CPU.
+ *   In SMP, the cache is also locked against mm_cpucache_flush().
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_cpucache_s *
+mm_cpucache_lock(FAR struct mm_heap_s *heap, FAR irqstate_t *flags)
+{
+  FAR struct mm_cpucache_s *cache;
+
+  *flags = up_irq_save();
+  cache  = &heap->mm_cpucache[up_cpu_index()];
+#ifdef CONFIG_SMP
+  spin_lock(&cache->cc_lock);
+#endif
+  return cache;
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_unlock
+ *
+ * Description:
+ *   Release a cache locked by mm_cpucache_lock().
+ *
+ ****************************************************************************/
+
+static inline void mm_cpucache_unlock(FAR struct mm_cpucache_s *cache,
+                                      irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&cache->cc_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_release
+ *
+ * Description:
+ *   Return chunks to the heap proper under a single acquisition of the
+ *   heap semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_cpucache_release(FAR struct mm_heap_s *heap,
+                                FAR void **chunks, int nchunks)
+{
+  int i;
+
+  mm_takesemaphore(heap);
+  for (i = 0; i < nchunks; i++)
+    {
+      mm_free(heap, chunks[i]);
+    }
+
+  mm_givesemaphore(heap);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cpucache_initialize
+ *
+ * Description:
+ *   Initialize the per-CPU caches of the heap.  All caches are empty.
+ *
+ ****************************************************************************/
+
+void mm_cpucache_initialize(FAR struct mm_heap_s *heap)
+{
+#ifdef CONFIG_SMP
+  int cpu;
+#endif
+
+  memset(heap->mm_cpucache, 0, sizeof(heap->mm_cpucache));
+
+#ifdef CONFIG_SMP
+  for (cpu = 0; cpu < MM_CPUCACHE_NCPUS; cpu++)
+    {
+      spin_initialize(&heap->mm_cpucache[cpu].cc_lock, SP_UNLOCKED);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_alloc
+ *
+ * Description:
+ *   Try to satisfy an allocation from the cache of the current CPU without
+ *   taking the heap semaphore.  If the cache is empty, it is refilled with
+ *   CONFIG_MM_CPUCACHE_BATCH chunks under a single acquisition of the heap
+ *   semaphore.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The chunk size, including the allocated node header
+ *
+ * Returned Value:
+ *   The allocated memory or NULL if the size is not cached or if the heap
+ *   could not provide any chunks of that size.  In the latter case, the
+ *   caller should fall back to the heap proper.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cpucache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_cpucache_s *cache;
+  FAR struct mm_magazine_s *mag;
+  FAR void *batch[CONFIG_MM_CPUCACHE_BATCH];
+  FAR void *ret = NULL;
+  irqstate_t flags;
+  int nchunks;
+  int ndx;
+
+  ndx = mm_cpucache_class(size);
+  if (ndx < 0 || mm_cpucache_bypass(heap))
+    {
+      return NULL;
+    }
+
+  /* Fast path:  Take a chunk from the magazine of this CPU */
+
+  cache = mm_cpucache_lock(heap, &flags);
+  mag   = &cache->cc_magazine[ndx];
+  if (mag->mg_count > 0)
+    {
+      ret = mag->mg_chunks[--mag->mg_count];
+    }
+
+  mm_cpucache_unlock(cache, flags);
+
+  if (ret != NULL)
+    {
+      return ret;
+    }
+
+  /* The magazine is empty.  Get a batch of chunks from the heap.  While we
+   * hold the semaphore, mm_malloc() will not recurse into the cache.
+   */
+
+  mm_takesemaphore(heap);
+  for (nchunks = 0; nchunks < CONFIG_MM_CPUCACHE_BATCH; nchunks++)
+    {
+      batch[nchunks] = mm_malloc(heap, size - SIZEOF_MM_ALLOCNODE);
+      if (batch[nchunks] == NULL)
+        {
+          break;
+        }
+    }
+
+  mm_givesemaphore(heap);
+
+  if (nchunks == 0)
+    {
+      return NULL;
+    }
+
+  /* Keep one chunk for the caller and put the rest in the magazine of
+   * whichever CPU we are now running on.  Only chunks of exactly the class
+   * size may be cached (mm_malloc() may have returned a slightly larger
+   * chunk rather than leave an unusably small free fragment).
+   */
+
+  ret   = batch[--nchunks];
+  cache = mm_cpucache_lock(heap, &flags);
+  mag   = &cache->cc_magazine[ndx];
+
+  while (nchunks > 0 && mag->mg_count < CONFIG_MM_CPUCACHE_DEPTH)
+    {
+      FAR struct mm_allocnode_s *node = (FAR struct mm_allocnode_s *)
+        ((FAR char *)batch[nchunks - 1] - SIZEOF_MM_ALLOCNODE);
+
+      if (node->size != size)
+        {
+          break;
+        }
+
+      MM_CLROWNER(node);
+      mag->mg_chunks[mag->mg_count++] = batch[--nchunks];
+    }
+
+  mm_cpucache_unlock(cache, flags);
+
+  /* Return any chunks that did not fit back to the heap.  This is rare:  It
+   * happens only if another task on this CPU freed into the magazine in the
+   * meantime or if we were migrated to a CPU with a fuller magazine.
+   */
+
+  if (nchunks > 0)
+    {
+      mm_cpucache_release(heap, batch, nchunks);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_free
+ *
+ * Description:
+ *   Try to put a freed chunk in the cache of the current CPU without taking
+ *   the heap semaphore.  If the magazine is full, CONFIG_MM_CPUCACHE_BATCH
+ *   chunks are drained from it and returned to the heap under a single
+ *   acquisition of the heap semaphore.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - The memory to be freed
+ *
+ * Returned Value:
+ *   True if the chunk was taken by the cache; false if the caller must
+ *   return it to the heap proper.
+ *
+ ****************************************************************************/
+
+bool mm_cpucache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cpucache_s *cache;
+  FAR struct mm_magazine_s *mag;
+  FAR void *batch[CONFIG_MM_CPUCACHE_BATCH];
+  irqstate_t flags;
+  int nchunks = 0;
+  int ndx;
+
+  node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  ndx  = mm_cpucache_class(node->size);
+
+  if (ndx < 0 || mm_cpucache_bypass(heap))
+    {
+      return false;
+    }
+
+  cache = mm_cpucache_lock(heap, &flags);
+  mag   = &cache->cc_magazine[ndx];
+
+  /* If the magazine is full, then drain the oldest chunks from it */
+
+  if (mag->mg_count >= CONFIG_MM_CPUCACHE_DEPTH)
+    {
+      nchunks = CONFIG_MM_CPUCACHE_BATCH;
+      memcpy(batch, mag->mg_chunks, nchunks * sizeof(FAR void *));
+      memmove(mag->mg_chunks, &mag->mg_chunks[nchunks],
+              (mag->mg_count - nchunks) * sizeof(FAR void *));
+      mag->mg_count -= nchunks;
+    }
+
+  MM_CLROWNER(node);
+  mag->mg_chunks[mag->mg_count++] = mem;
+  mm_cpucache_unlock(cache, flags);
+
+  if (nchunks > 0)
+    {
+      mm_cpucache_release(heap, batch, nchunks);
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_size
+ *
+ * Description:
+ *   Return the total size of the free chunks held in all of the per-CPU
+ *   caches.  The caches of other CPUs may change while they are being
+ *   examined so the result is only a snapshot.
+ *
+ ****************************************************************************/
+
+size_t mm_cpucache_size(FAR struct mm_heap_s *heap)
+{
+  size_t total = 0;
+  int cpu;
+  int ndx;
+
+  for (cpu = 0; cpu < MM_CPUCACHE_NCPUS; cpu++)
+    {
+      for (ndx = 0; ndx < CONFIG_MM_CPUCACHE_NCLASSES; ndx++)
+        {
+          total += MM_CPUCACHE_CHUNKSIZE(ndx) *
+                   heap->mm_cpucache[cpu].cc_magazine[ndx].mg_count;
+        }
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: mm_cpucache_flush
+ *
+ * Description:
+ *   Return the chunks held in the caches of all CPUs to the heap proper.
+ *   This is done when an allocation fails so that free memory stranded in
+ *   the caches (in particular, in the caches of other CPUs) does not cause
+ *   a spurious out-of-memory failure.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *
+ * Returned Value:
+ *   True if any chunks were returned to the heap so that the failed
+ *   allocation may be retried.
+ *
+ ****************************************************************************/
+
+bool mm_cpucache_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_cpucache_s *cache;
+  FAR struct mm_magazine_s *mag;
+  FAR void *batch[CONFIG_MM_CPUCACHE_DEPTH];
+  irqstate_t flags;
+  bool flushed = false;
+  int nchunks;
+  int cpu;
+  int ndx;
+
+  /* Nothing can be returned while a cache is being refilled or drained */
+
+  if (mm_cpucache_bypass(heap))
+    {
+      return false;
+    }
+
+  for (cpu = 0; cpu < MM_CPUCACHE_NCPUS; cpu++)
+    {
+      cache = &heap->mm_cpucache[cpu];
+
+      for (ndx = 0; ndx < CONFIG_MM_CPUCACHE_NCLASSES; ndx++)
+        {
+          mag   = &cache->cc_magazine[ndx];
+          flags = up_irq_save();
+#ifdef CONFIG_SMP
+          spin_lock(&cache->cc_lock);
+#endif
+          nchunks = mag->mg_count;
+          memcpy(batch, mag->mg_chunks, nchunks * sizeof(FAR void *));
+          mag->mg_count = 0;
+#ifdef CONFIG_SMP
+          spin_unlock(&cache->cc_lock);
+#endif
+          up_irq_restore(flags);
+
+          if (nchunks > 0)
+            {
+              mm_cpucache_release(heap, batch, nchunks);
+              flushed = true;
+            }
+        }
+    }
+
+  return flushed;
+}
+
+#endif /* CONFIG_MM_CPUCACHE */
@@ -72,6 +72,17 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       return;
     }
 
+#ifdef CONFIG_MM_CPUCACHE
+  /* Small chunks are kept in the cache of this CPU, if possible, without
+   * taking the MM semaphore.
+   */
+
+  if (mm_cpucache_free(heap, mem))
+    {
+      return;
+    }
+#endif
+
   /* We need to hold the MM semaphore while we muck with the
    * nodelist.
    */
@@ -97,16 +108,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 
       andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + next->size);
 
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
+      /* Remove the next node from the free list */
 
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
+      mm_delfreechunk(heap, next);
 
       /* Then merge the two chunks */
 
@@ -122,16 +126,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
   prev = (FAR struct mm_freenode_s *)((FAR char *)node - node->preceding);
   if ((prev->preceding & MM_ALLOC_BIT) == 0)
     {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+      /* Remove the previous node from the free list */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+      mm_delfreechunk(heap, prev);
 
       /* Then merge the two chunks */
 
@@ -113,6 +113,7 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_heapstart[IDX]            = (FAR struct mm_allocnode_s *)heapbase;
   heap->mm_heapstart[IDX]->size      = SIZEOF_MM_ALLOCNODE;
   heap->mm_heapstart[IDX]->preceding = MM_ALLOC_BIT;
+  MM_CLROWNER(heap->mm_heapstart[IDX]);
 
   node                        = (FAR struct mm_freenode_s *)(heapbase + SIZEOF_MM_ALLOCNODE);
   node->size                  = heapsize - 2*SIZEOF_MM_ALLOCNODE;
@@ -121,6 +122,7 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_heapend[IDX]              = (FAR struct mm_allocnode_s *)(heapend - SIZEOF_MM_ALLOCNODE);
   heap->mm_heapend[IDX]->size        = SIZEOF_MM_ALLOCNODE;
   heap->mm_heapend[IDX]->preceding   = node->size | MM_ALLOC_BIT;
+  MM_CLROWNER(heap->mm_heapend[IDX]);
 
 #undef IDX
 
@@ -155,7 +157,11 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
                    size_t heapsize)
 {
+  FAR struct mm_freelist_s *list;
+  int region;
+#ifndef CONFIG_MM_TLSF
   int i;
+#endif
 
   minfo("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -177,13 +183,29 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_nregions = 0;
 #endif
 
-  /* Initialize the node array */
+#if CONFIG_MM_REGIONS > 1
+  memset(heap->mm_regionflags, 0, sizeof(heap->mm_regionflags));
+#endif
+
+  /* Initialize the node array of each region */
 
-  memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
-  for (i = 1; i < MM_NNODES; i++)
+  for (region = 0; region < CONFIG_MM_REGIONS; region++)
     {
-      heap->mm_nodelist[i-1].flink = &heap->mm_nodelist[i];
-      heap->mm_nodelist[i].blink   = &heap->mm_nodelist[i-1];
+      list = &heap->mm_freelist[region];
+      memset(list, 0, sizeof(struct mm_freelist_s));
+
+#ifndef CONFIG_MM_TLSF
+      /* Each segregated free list of the TLSF organization is independent
+       * and initially empty.  Otherwise, the sentinel nodes of the region
+       * are chained into a single list.
+       */
+
+      for (i = 1; i < MM_NNODES; i++)
+        {
+          list->mm_nodelist[i-1].flink = &list->mm_nodelist[i];
+          list->mm_nodelist[i].blink   = &list->mm_nodelist[i-1];
+        }
+#endif
     }
 
   /* Initialize the malloc semaphore to one (to support one-at-
@@ -192,6 +214,12 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
 
   mm_seminitialize(heap);
 
+#ifdef CONFIG_MM_CPUCACHE
+  /* Start with empty per-CPU caches */
+
+  mm_cpucache_initialize(heap);
+#endif
+
   /* Add the initial region of memory to the heap */
 
   mm_addregion(heap, heapstart, heapsize);
@@ -40,11 +40,81 @@
 #include <nuttx/config.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
+#include <errno.h>
 #include <debug.h>
 
 #include <nuttx/mm/mm.h>
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mm_mallinfo_s
+{
+  size_t mxordblk;  /* Largest non-inuse chunk */
+  int    ordblks;   /* Number of non-inuse chunks */
+  size_t uordblks;  /* Total allocated space */
+  size_t fordblks;  /* Total non-inuse space */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_mallinfo_walk
+ *
+ * Description:
+ *   Visit each node in one region of the heap and accumulate the heap
+ *   information of the region into 'stats'.
+ *
+ ****************************************************************************/
+
+static void mm_mallinfo_walk(FAR struct mm_heap_s *heap, int region,
+                             FAR struct mm_mallinfo_s *stats)
+{
+  FAR struct mm_allocnode_s *node;
+
+  /* Retake the semaphore for each region to reduce latencies */
+
+  mm_takesemaphore(heap);
+
+  for (node = heap->mm_heapstart[region];
+       node < heap->mm_heapend[region];
+       node = (FAR struct mm_allocnode_s *)((FAR char *)node + node->size))
+    {
+      minfo("region=%d node=%p size=%p preceding=%p (%c)\n",
+            region, node, node->size, (node->preceding & ~MM_ALLOC_BIT),
+            (node->preceding & MM_ALLOC_BIT) ? 'A' : 'F');
+
+      /* Check if the node corresponds to an allocated memory chunk */
+
+      if ((node->preceding & MM_ALLOC_BIT) != 0)
+        {
+          stats->uordblks += node->size;
+        }
+      else
+        {
+          stats->ordblks++;
+          stats->fordblks += node->size;
+          if (node->size > stats->mxordblk)
+            {
+              stats->mxordblk = node->size;
+            }
+        }
+    }
+
+  minfo("region=%d node=%p heapend=%p\n",
+        region, node, heap->mm_heapend[region]);
+  DEBUGASSERT(node == heap->mm_heapend[region]);
+
+  mm_givesemaphore(heap);
+
+  stats->uordblks += SIZEOF_MM_ALLOCNODE; /* account for the tail node */
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,72 +129,87 @@
 
 int mm_mallinfo(FAR struct mm_heap_s *heap, FAR struct mallinfo *info)
 {
-  FAR struct mm_allocnode_s *node;
-  size_t mxordblk = 0;
-  int    ordblks  = 0;  /* Number of non-inuse chunks */
-  size_t uordblks = 0;  /* Total allocated space */
-  size_t fordblks = 0;  /* Total non-inuse space */
+  struct mm_mallinfo_s stats;
+  size_t fsmblks = 0;  /* Non-inuse space held in per-CPU caches */
 #if CONFIG_MM_REGIONS > 1
   int region;
-#else
-# define region 0
 #endif
 
   DEBUGASSERT(info);
 
+  memset(&stats, 0, sizeof(struct mm_mallinfo_s));
+
   /* Visit each region */
 
 #if CONFIG_MM_REGIONS > 1
   for (region = 0; region < heap->mm_nregions; region++)
-#endif
     {
-      /* Visit each node in the region
-       * Retake the semaphore for each region to reduce latencies
-       */
+      mm_mallinfo_walk(heap, region, &stats);
+    }
+#else
+  mm_mallinfo_walk(heap, 0, &stats);
+#endif
 
-      mm_takesemaphore(heap);
+  DEBUGASSERT(stats.uordblks + stats.fordblks == heap->mm_heapsize);
 
-      for (node = heap->mm_heapstart[region];
-           node < heap->mm_heapend[region];
-           node = (FAR struct mm_allocnode_s *)((FAR char *)node + node->size))
-        {
-          minfo("region=%d node=%p size=%p preceding=%p (%c)\n",
-                region, node, node->size, (node->preceding & ~MM_ALLOC_BIT),
-                (node->preceding & MM_ALLOC_BIT) ? 'A' : 'F');
+#ifdef CONFIG_MM_CPUCACHE
+  /* Chunks held in the per-CPU caches appear to be allocated in the heap
+   * proper, but they are really available for allocation.
+   */
 
-          /* Check if the node corresponds to an allocated memory chunk */
+  fsmblks         = mm_cpucache_size(heap);
+  stats.uordblks -= fsmblks;
+  stats.fordblks += fsmblks;
+#endif
 
-          if ((node->preceding & MM_ALLOC_BIT) != 0)
-            {
-              uordblks += node->size;
-            }
-          else
-            {
-              ordblks++;
-              fordblks += node->size;
-              if (node->size > mxordblk)
-                {
-                  mxordblk = node->size;
-                }
-            }
-        }
+  info->arena    = heap->mm_heapsize;
+  info->ordblks  = stats.ordblks;
+  info->mxordblk = stats.mxordblk;
+  info->uordblks = stats.uordblks;
+  info->fordblks = stats.fordblks;
+  info->fsmblks  = fsmblks;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mm_mallinfo_region
+ *
+ * Description:
+ *   Return a copy of updated current heap information for one region of
+ *   the heap.  Chunks held in the per-CPU caches are not attributed to a
+ *   region; they are reported as allocated.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL if there is no such region.
+ *
+ ****************************************************************************/
 
-      minfo("region=%d node=%p heapend=%p\n",
-            region, node, heap->mm_heapend[region]);
-      DEBUGASSERT(node == heap->mm_heapend[region]);
+int mm_mallinfo_region(FAR struct mm_heap_s *heap, int region,
+                       FAR struct mallinfo *info)
+{
+  struct mm_mallinfo_s stats;
 
-      mm_givesemaphore(heap);
+  DEBUGASSERT(info);
 
-      uordblks += SIZEOF_MM_ALLOCNODE; /* account for the tail node */
+#if CONFIG_MM_REGIONS > 1
+  if (region < 0 || region >= heap->mm_nregions)
+#else
+  if (region != 0)
+#endif
+    {
+      return -EINVAL;
     }
-#undef region
 
-  DEBUGASSERT(uordblks + fordblks == heap->mm_heapsize);
-
-  info->arena    = heap->mm_heapsize;
-  info->ordblks  = ordblks;
-  info->mxordblk = mxordblk;
-  info->uordblks = uordblks;
-  info->fordblks = fordblks;
+  memset(&stats, 0, sizeof(struct mm_mallinfo_s));
+  mm_mallinfo_walk(heap, region, &stats);
+
+  info->arena    = (FAR char *)heap->mm_heapend[region] -
+                   (FAR char *)heap->mm_heapstart[region] +
+                   SIZEOF_MM_ALLOCNODE;
+  info->ordblks  = stats.ordblks;
+  info->mxordblk = stats.mxordblk;
+  info->uordblks = stats.uordblks;
+  info->fordblks = stats.fordblks;
+  info->fsmblks  = 0;
   return OK;
 }
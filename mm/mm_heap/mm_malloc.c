@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <strings.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -53,42 +54,107 @@
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_findfreechunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
- *
- *  8-byte alignment of the allocated data is assured.
+ *   Find a free chunk of at least 'size' bytes (including the allocated
+ *   node header) in the free lists of one region.  The chunk is not
+ *   removed from the free list.  It is assumed that the caller holds the
+ *   mm semaphore.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+#ifdef CONFIG_MM_TLSF
+static FAR struct mm_freenode_s *
+mm_findfreechunk(FAR struct mm_freelist_s *list, size_t size)
 {
   FAR struct mm_freenode_s *node;
-  void *ret = NULL;
+  uint32_t bitmap;
   int ndx;
+  int fl;
+  int sl;
 
-  /* Handle bad sizes */
+  /* Round the size up to the next second-level boundary so that any chunk
+   * in the selected list (or in any larger list) is sure to be large
+   * enough.  Lists below MM_SL_COUNT granules each hold chunks of a single
+   * granule count and need no rounding.
+   */
 
-  if (size < 1)
+  ndx = mm_size2ndx(size);
+  fl  = ndx >> MM_SL_SHIFT;
+
+  if (ndx < MM_NBINS - 1)
     {
-      return NULL;
+      if (fl > MM_SL_SHIFT)
+        {
+          size_t round = ((size_t)1 << (fl - MM_SL_SHIFT + MM_MIN_SHIFT)) - 1;
+
+          ndx = mm_size2ndx(size + round);
+          fl  = ndx >> MM_SL_SHIFT;
+        }
+
+      /* Find the first non-empty list at or above the rounded size, first
+       * within the same first-level class and then in the next larger,
+       * non-empty first-level class.
+       */
+
+      sl     = ndx & MM_SL_MASK;
+      bitmap = list->mm_slbitmap[fl] & ((uint32_t)~0 << sl);
+
+      if (bitmap == 0)
+        {
+          bitmap = list->mm_flbitmap & ((uint32_t)~0 << (fl + 1));
+          if (bitmap != 0)
+            {
+              fl     = ffs((int)bitmap) - 1;
+              bitmap = list->mm_slbitmap[fl];
+            }
+        }
+
+      if (bitmap != 0)
+        {
+          sl  = ffs((int)bitmap) - 1;
+          ndx = (fl << MM_SL_SHIFT) + sl;
+
+          if (ndx < MM_NBINS - 1)
+            {
+              /* Every chunk in this list is large enough */
+
+              return list->mm_nodelist[ndx].flink;
+            }
+        }
+      else
+        {
+          /* Nothing suitable in the larger lists.  Before failing, fall
+           * back to a search of the un-rounded list; it may still hold a
+           * chunk that is large enough.
+           */
+
+          ndx = mm_size2ndx(size);
+        }
     }
 
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
+  /* The last list holds all chunks that are too large to be classified and
+   * is not ordered by size.  This list, as well as the list of the fall back
+   * case, must be searched for a chunk that is large enough.
    */
 
-  size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
+  for (node = list->mm_nodelist[ndx].flink;
+       node && node->size < size;
+       node = node->flink);
 
-  mm_takesemaphore(heap);
+  return node;
+}
+#else
+static FAR struct mm_freenode_s *
+mm_findfreechunk(FAR struct mm_freelist_s *list, size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  int ndx;
 
   /* Get the location in the node list to start the search. Special case
    * really big allocations
@@ -107,17 +173,106 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   /* Search for a large enough chunk in the list of nodes. This list is
    * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
+   * other mm_nodelist[] entries.  Since the list is ordered, we know that
+   * the first node found must be best fitting chunk available.
    */
 
-  for (node = heap->mm_nodelist[ndx].flink;
+  for (node = list->mm_nodelist[ndx].flink;
        node && node->size < size;
        node = node->flink);
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
-   */
+  return node;
+}
+#endif
+
+/****************************************************************************
+ * Name: mm_findregionchunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes, preferring the regions with
+ *   the MM_REGION_* attributes in 'flags'.  Allocations with no attributes
+ *   prefer the regions that are not marked MM_REGION_FAST.  Only when no
+ *   preferred region can satisfy the request are the other regions
+ *   considered.  Within each of these two groups, the smallest suitable
+ *   chunk is selected.  It is assumed that the caller holds the mm
+ *   semaphore.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MM_REGIONS > 1
+static FAR struct mm_freenode_s *
+mm_findregionchunk(FAR struct mm_heap_s *heap, size_t size, uint8_t flags)
+{
+  FAR struct mm_freenode_s *found = NULL;
+  FAR struct mm_freenode_s *node;
+  uint8_t rflags;
+  bool preferred;
+  int region;
+  int pass;
+
+  for (pass = 0; pass < 2 && found == NULL; pass++)
+    {
+      for (region = 0; region < heap->mm_nregions; region++)
+        {
+          rflags = heap->mm_regionflags[region];
+          if (flags != MM_REGION_ANY)
+            {
+              preferred = ((rflags & flags) == flags);
+            }
+          else
+            {
+              preferred = ((rflags & MM_REGION_FAST) == 0);
+            }
+
+          /* The preferred regions are searched on the first pass, the
+           * remaining regions on the second.
+           */
+
+          if (preferred != (pass == 0))
+            {
+              continue;
+            }
+
+          node = mm_findfreechunk(&heap->mm_freelist[region], size);
+          if (node != NULL && (found == NULL || node->size < found->size))
+            {
+              found = node;
+            }
+        }
+    }
+
+  return found;
+}
+#else
+#  define mm_findregionchunk(h,s,f) mm_findfreechunk(&(h)->mm_freelist[0], s)
+#endif
+
+/****************************************************************************
+ * Name: mm_allocchunk
+ *
+ * Description:
+ *   Find the smallest chunk that satisfies the request in the preferred
+ *   regions.  Take the memory from that chunk, save the remaining, smaller
+ *   chunk (if any).  'size' includes the allocated node header and is
+ *   already aligned.  The owner of the allocated chunk is not set.
+ *
+ ****************************************************************************/
+
+static FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t size,
+                               uint8_t flags)
+{
+  FAR struct mm_freenode_s *node;
+  void *ret = NULL;
+
+  /* We need to hold the MM semaphore while we muck with the nodelist. */
+
+  mm_takesemaphore(heap);
+
+  /* Search for a large enough free chunk */
+
+  node = mm_findregionchunk(heap, size, flags);
+
+  /* If we found a node, then this is one to use. */
 
   if (node)
     {
@@ -125,16 +280,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -196,3 +344,116 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
   return ret;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR void *ret;
+
+  /* Handle bad sizes */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+
+#ifdef CONFIG_MM_CPUCACHE
+  /* Small allocations are satisfied from the cache of this CPU, if
+   * possible, without taking the MM semaphore.
+   */
+
+  ret = mm_cpucache_alloc(heap, size);
+  if (ret != NULL)
+    {
+      MM_SETOWNER((FAR struct mm_allocnode_s *)
+                  ((FAR char *)ret - SIZEOF_MM_ALLOCNODE));
+      minfo("Allocated %p, size %d (cached)\n", ret, size);
+      return ret;
+    }
+#endif
+
+  ret = mm_allocchunk(heap, size, MM_REGION_ANY);
+
+#ifdef CONFIG_MM_CPUCACHE
+  /* Free memory may be stranded in the per-CPU caches.  Return it to the
+   * heap and try once more before failing.
+   */
+
+  if (ret == NULL && mm_cpucache_flush(heap))
+    {
+      ret = mm_allocchunk(heap, size, MM_REGION_ANY);
+    }
+#endif
+
+  if (ret != NULL)
+    {
+      MM_SETOWNER((FAR struct mm_allocnode_s *)
+                  ((FAR char *)ret - SIZEOF_MM_ALLOCNODE));
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_malloc_region
+ *
+ * Description:
+ *  Like mm_malloc(), but prefer the heap regions that have all of the
+ *  MM_REGION_* attributes in 'flags' (see mm_setregionflags()).  The
+ *  attributes are a hint:  If no such region can satisfy the request, the
+ *  memory is taken from any other region.  The per-CPU caches, which do
+ *  not track regions, are bypassed.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc_region(FAR struct mm_heap_s *heap, size_t size,
+                           uint8_t flags)
+{
+  FAR void *ret;
+
+  /* Handle bad sizes */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+
+  ret = mm_allocchunk(heap, size, flags);
+
+#ifdef CONFIG_MM_CPUCACHE
+  if (ret == NULL && mm_cpucache_flush(heap))
+    {
+      ret = mm_allocchunk(heap, size, flags);
+    }
+#endif
+
+  if (ret != NULL)
+    {
+      MM_SETOWNER((FAR struct mm_allocnode_s *)
+                  ((FAR char *)ret - SIZEOF_MM_ALLOCNODE));
+    }
+
+  return ret;
+}
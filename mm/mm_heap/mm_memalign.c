@@ -201,6 +201,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
       mm_shrinkchunk(heap, node, size + SIZEOF_MM_ALLOCNODE);
     }
 
+  MM_SETOWNER(node);
   mm_givesemaphore(heap);
   return (FAR void *)alignedchunk;
 }
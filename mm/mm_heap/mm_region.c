@@ -0,0 +1,108 @@
+/****************************************************************************
+ * mm/mm_heap/mm_region.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_setregionflags
+ *
+ * Description:
+ *   Set the MM_REGION_* placement attributes of a heap region.  Plain
+ *   allocations avoid regions marked MM_REGION_FAST as long as there is
+ *   memory available elsewhere; allocations made with mm_malloc_region()
+ *   prefer the regions that have all of the requested attributes.
+ *
+ *   The attributes are only hints.  They may be set (or changed) at any
+ *   time after the region has been added to the heap.  With a single
+ *   region, the attributes are ignored.
+ *
+ * Parameters:
+ *   heap   - The selected heap
+ *   region - The index of the region, as for mm_extend()
+ *   flags  - The MM_REGION_* attributes of the region
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_setregionflags(FAR struct mm_heap_s *heap, int region,
+                       uint8_t flags)
+{
+#if CONFIG_MM_REGIONS > 1
+  DEBUGASSERT(heap != NULL && region >= 0 && region < CONFIG_MM_REGIONS);
+  heap->mm_regionflags[region] = flags;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_findregion
+ *
+ * Description:
+ *   Return the index of the heap region that contains the memory 'mem'.
+ *   Memory that lies in no region is attributed to region 0.  It is
+ *   assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+#if CONFIG_MM_REGIONS > 1
+int mm_findregion(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  int region;
+
+  for (region = heap->mm_nregions - 1; region > 0; region--)
+    {
+      if ((FAR char *)mem >= (FAR char *)heap->mm_heapstart[region] &&
+          (FAR char *)mem <  (FAR char *)heap->mm_heapend[region])
+        {
+          break;
+        }
+    }
+
+  return region;
+}
+#endif
@@ -39,6 +39,8 @@
 
 #include <nuttx/config.h>
 
+#include <strings.h>
+
 #include <nuttx/mm/mm.h>
 
 /****************************************************************************
@@ -51,23 +53,63 @@
  * Description:
  *    Convert the size to a nodelist index.
  *
+ *    For the best-fit free list, this is the index of the power-of-two size
+ *    class that contains the size.  With CONFIG_MM_TLSF, it is the index of
+ *    the second-level free list that contains the size:  The first-level
+ *    index (the power-of-two size class) is in the upper bits and the
+ *    second-level index (the linear sub-division of that size class) is in
+ *    the lower MM_SL_SHIFT bits.
+ *
  ****************************************************************************/
 
 int mm_size2ndx(size_t size)
 {
-  int ndx = 0;
+#ifdef CONFIG_MM_TLSF
+  size_t ngran;
+  int fl;
+  int sl;
+#endif
 
   if (size >= MM_MAX_CHUNK)
     {
-       return MM_NNODES-1;
+       return MM_NBINS-1;
     }
 
-  size >>= MM_MIN_SHIFT;
-  while (size > 1)
+  /* mm_memalign() may leave free fragments smaller than MM_MIN_CHUNK.  These
+   * always go into the first list, below all allocatable sizes.
+   */
+
+  if (size < MM_MIN_CHUNK)
     {
-      ndx++;
-      size >>= 1;
+      return 0;
+    }
+
+#ifdef CONFIG_MM_TLSF
+  /* The first-level index is the position of the most significant bit of
+   * the size (in units of MM_MIN_CHUNK).  The second-level index is given
+   * by the next MM_SL_SHIFT bits below that.
+   */
+
+  ngran = size >> MM_MIN_SHIFT;
+  fl    = fls((int)ngran) - 1;
+
+  if (fl >= MM_SL_SHIFT)
+    {
+      sl = (int)(ngran >> (fl - MM_SL_SHIFT)) & MM_SL_MASK;
+    }
+  else if (fl > 0)
+    {
+      sl = (int)(ngran << (MM_SL_SHIFT - fl)) & MM_SL_MASK;
+    }
+  else
+    {
+      /* A single granule.  The first list is reserved for fragments. */
+
+      sl = 1;
     }
 
-  return ndx;
+  return (fl << MM_SL_SHIFT) + sl;
+#else
+  return fls((int)(size >> MM_MIN_SHIFT)) - 1;
+#endif
 }
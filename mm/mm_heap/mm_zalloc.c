@@ -61,6 +61,8 @@ FAR void *mm_zalloc(FAR struct mm_heap_s *heap, size_t size)
   if (alloc)
     {
        memset(alloc, 0, size);
+       MM_SETOWNER((FAR struct mm_allocnode_s *)
+                   ((FAR char *)alloc - SIZEOF_MM_ALLOCNODE));
     }
 
   return alloc;
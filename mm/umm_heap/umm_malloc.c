@@ -95,8 +95,12 @@ FAR void *malloc(size_t size)
     }
   while (mem == NULL);
 
+  MM_SETCALLER(mem);
   return mem;
 #else
-  return mm_malloc(USR_HEAP, size);
+  FAR void *mem = mm_malloc(USR_HEAP, size);
+
+  MM_SETCALLER(mem);
+  return mem;
 #endif
 }
@@ -64,5 +64,8 @@
 
 FAR void *memalign(size_t alignment, size_t size)
 {
-  return mm_memalign(USR_HEAP, alignment, size);
+  FAR void *mem = mm_memalign(USR_HEAP, alignment, size);
+
+  MM_SETCALLER(mem);
+  return mem;
 }
@@ -66,5 +66,8 @@
 
 FAR void *realloc(FAR void *oldmem, size_t size)
 {
-  return mm_realloc(USR_HEAP, oldmem, size);
+  FAR void *mem = mm_realloc(USR_HEAP, oldmem, size);
+
+  MM_SETCALLER(mem);
+  return mem;
 }
@@ -75,11 +75,15 @@ FAR void *zalloc(size_t size)
        memset(alloc, 0, size);
     }
 
+  MM_SETCALLER(alloc);
   return alloc;
 
 #else
   /* Use mm_zalloc() becuase it implements the clear */
 
-  return mm_zalloc(USR_HEAP, size);
+  FAR void *alloc = mm_zalloc(USR_HEAP, size);
+
+  MM_SETCALLER(alloc);
+  return alloc;
 #endif
 }
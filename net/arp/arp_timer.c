@@ -61,6 +61,12 @@
 
 #define ARPTIMER_WDINTERVAL (10*CLK_TCK)
 
+/* ARP aging is not time critical:  The timer may run up to one second late
+ * so that it can share a timer interrupt with other timers.
+ */
+
+#define ARPTIMER_WDSLACK    (CLK_TCK)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -126,6 +132,7 @@ void arp_timer_initialize(void)
   /* Create and start the ARP timer */
 
   g_arptimer = wd_create();
+  (void)wd_setslack(g_arptimer, ARPTIMER_WDSLACK);
   (void)wd_start(g_arptimer, ARPTIMER_WDINTERVAL, arptimer_poll, 0);
 }
 
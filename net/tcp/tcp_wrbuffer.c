@@ -56,6 +56,7 @@
 
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
+#include <nuttx/mm/mempool.h>
 
 #include "tcp/tcp.h"
 
@@ -71,9 +72,9 @@ struct wrbuffer_s
 
   sem_t sem;
 
-  /* This is the list of available write buffers */
+  /* This is the pool of available write buffers */
 
-  sq_queue_t freebuffers;
+  struct mempool_s pool;
 
   /* These are the pre-allocated write buffers */
 
@@ -96,7 +97,7 @@ static struct wrbuffer_s g_wrbuffer;
  * Name: tcp_wrbuffer_initialize
  *
  * Description:
- *   Initialize the list of free write buffers
+ *   Initialize the pool of free write buffers
  *
  * Assumptions:
  *   Called once early initialization.
@@ -105,14 +106,9 @@ static struct wrbuffer_s g_wrbuffer;
 
 void tcp_wrbuffer_initialize(void)
 {
-  int i;
-
-  sq_init(&g_wrbuffer.freebuffers);
-
-  for (i = 0; i < CONFIG_NET_TCP_NWRBCHAINS; i++)
-    {
-      sq_addfirst(&g_wrbuffer.buffers[i].wb_node, &g_wrbuffer.freebuffers);
-    }
+  (void)mempool_initialize(&g_wrbuffer.pool, "tcp_wrbuffer",
+                           sizeof(struct tcp_wrbuffer_s), g_wrbuffer.buffers,
+                           CONFIG_NET_TCP_NWRBCHAINS, 0, 0);
 
   sem_init(&g_wrbuffer.sem, 0, CONFIG_NET_TCP_NWRBCHAINS);
 }
@@ -148,10 +144,10 @@ FAR struct tcp_wrbuffer_s *tcp_wrbuffer_alloc(void)
   DEBUGVERIFY(net_lockedwait(&g_wrbuffer.sem)); /* TODO: Handle EINTR. */
 
   /* Now, we are guaranteed to have a write buffer structure reserved
-   * for us in the free list.
+   * for us in the pool.
    */
 
-  wrb = (FAR struct tcp_wrbuffer_s *)sq_remfirst(&g_wrbuffer.freebuffers);
+  wrb = (FAR struct tcp_wrbuffer_s *)mempool_alloc(&g_wrbuffer.pool);
   DEBUGASSERT(wrb);
   memset(wrb, 0, sizeof(struct tcp_wrbuffer_s));
 
@@ -193,7 +189,7 @@ void tcp_wrbuffer_release(FAR struct tcp_wrbuffer_s *wrb)
 
   /* Then free the write buffer structure */
 
-  sq_addlast(&wrb->wb_node, &g_wrbuffer.freebuffers);
+  mempool_free(&g_wrbuffer.pool, wrb);
   sem_post(&g_wrbuffer.sem);
 }
 
@@ -163,6 +163,12 @@ int os_idle_task(int argc, FAR char *argv[])
         }
 #endif
 
+#ifdef CONFIG_SMP_LOADBALANCE
+      /* Pick up any ready-to-run task that may run on this CPU */
+
+      sched_balance_idle();
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
@@ -528,6 +528,7 @@ void os_start(void)
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+      sched_prioindex_add(&g_idletcb[cpu].cmn, tasklist);
 
       /* Initialize the processor-specific portion of the TCB */
 
@@ -839,6 +840,12 @@ void os_start(void)
         }
 #endif
 
+#ifdef CONFIG_SMP_LOADBALANCE
+      /* Pick up any ready-to-run task that may run on this CPU */
+
+      sched_balance_idle();
+#endif
+
       /* Perform any processor-specific idle state operations */
 
       up_idle();
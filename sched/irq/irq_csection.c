@@ -42,6 +42,7 @@
 #include <sys/types.h>
 
 #include <nuttx/init.h>
+#include <nuttx/arch.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
 #include <arch/irq.h>
@@ -122,6 +123,10 @@ volatile uint8_t g_cpu_nestcount[CONFIG_SMP_NCPUS];
 #ifdef CONFIG_SMP
 static inline bool irq_waitlock(int cpu)
 {
+#ifdef CONFIG_SPINLOCK_STATS
+  uint32_t start = up_perf_gettime();
+  bool contended = false;
+#endif
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = this_task();
 
@@ -153,6 +158,9 @@ static inline bool irq_waitlock(int cpu)
           return false;
         }
 
+#ifdef CONFIG_SPINLOCK_STATS
+      contended = true;
+#endif
       SP_DSB();
     }
 
@@ -164,6 +172,14 @@ static inline bool irq_waitlock(int cpu)
   sched_note_spinlocked(tcb, &g_cpu_irqlock);
 #endif
 
+#ifdef CONFIG_SPINLOCK_STATS
+  /* Account for the time spent waiting.  The hold time is measured from
+   * the point where the first CPU is added to g_cpu_irqset.
+   */
+
+  spinstat_wait(&g_cpu_irqlock, start, contended);
+#endif
+
   SP_DMB();
   return true;
 }
@@ -543,6 +559,18 @@ void leave_critical_section(irqstate_t flags)
               spin_clrbit(&g_cpu_irqset, cpu, &g_cpu_irqsetlock,
                           &g_cpu_irqlock);
 
+#ifdef CONFIG_SMP_RESCHED_IPI
+              /* Re-raise any reschedule IPI that was received and deferred
+               * while this CPU held the lock.
+               */
+
+              if (g_cpu_resched[cpu])
+                {
+                  g_cpu_resched[cpu] = false;
+                  DEBUGVERIFY(up_cpu_resched(cpu));
+                }
+#endif
+
               /* Have all CPUs released the lock? */
             }
         }
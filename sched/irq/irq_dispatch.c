@@ -45,6 +45,7 @@
 #include <nuttx/random.h>
 
 #include "irq/irq.h"
+#include "sched/sched.h"
 
 /****************************************************************************
  * Public Functions
@@ -108,7 +109,17 @@ void irq_dispatch(int irq, FAR void *context)
   add_irq_randomness(irq);
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  /* Charge the time in the interrupt handler to the CPU */
+
+  sched_cpuload_irqenter();
+#endif
+
   /* Then dispatch to the interrupt handler */
 
   vector(irq, context, arg);
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  sched_cpuload_irqleave();
+#endif
 }
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 #include <nuttx/arch.h>
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 
 #include "irq/irq.h"
 
@@ -67,6 +68,16 @@ struct irq_info_s g_irqvector[CONFIG_ARCH_NUSER_INTERRUPTS];
 struct irq_info_s g_irqvector[NR_IRQS];
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+/* Lock statistics of the global critical section */
+
+static struct spinstat_s g_cpu_irqstat;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -92,4 +103,10 @@ void irq_initialize(void)
       g_irqvector[i].arg     = NULL;
 #endif
     }
+
+#ifdef CONFIG_SPINLOCK_STATS
+  /* Measure the wait and hold times of the global critical section */
+
+  spin_register(&g_cpu_irqstat, &g_cpu_irqlock, "irqlock");
+#endif
 }
@@ -77,6 +77,13 @@ int mq_getattr(mqd_t mqdes, struct mq_attr *mq_stat)
       mq_stat->mq_flags   = mqdes->oflags;
       mq_stat->mq_curmsgs = mqdes->msgq->nmsgs;
 
+#ifdef CONFIG_MQ_ZEROCOPY
+      if (mqdes->msgq->zerocopy)
+        {
+          mq_stat->mq_flags |= MQ_ZEROCOPY;
+        }
+#endif
+
       ret = OK;
     }
 
@@ -39,11 +39,10 @@
 
 #include <nuttx/config.h>
 
-#include <queue.h>
+#include <stdint.h>
 
 #include <nuttx/irq.h>
-#include <nuttx/arch.h>
-#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "mqueue/mqueue.h"
 
@@ -55,11 +54,11 @@
  * Name: mq_msgfree
  *
  * Description:
- *   The mq_msgfree function will return a message to the free pool of
- *   messages if it was a pre-allocated message. If the message was
- *   allocated dynamically it will be deallocated.
+ *   The mq_msgfree function will return a message to the pool of
+ *   messages that it was allocated from.
  *
  * Inputs:
+ *   msgq  - The message queue that the message was allocated for
  *   mqmsg - message to free
  *
  * Return Value:
@@ -67,51 +66,27 @@
  *
  ****************************************************************************/
 
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
+void mq_msgfree(FAR struct mqueue_inode_s *msgq,
+                FAR struct mqueue_msg_s *mqmsg)
 {
+#ifdef CONFIG_MQ_QUEUEPOOL
+  uintptr_t offset = (uintptr_t)mqmsg - (uintptr_t)msgq->msgpool;
   irqstate_t flags;
 
-  /* If this is a generally available pre-allocated message,
-   * then just put it back in the free list.
-   */
-
-  if (mqmsg->type == MQ_ALLOC_FIXED)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
-    }
+  /* Was the message allocated from the pool of the message queue? */
 
-  /* If this is a message pre-allocated for interrupts,
-   * then put it back in the correct  free list.
-   */
-
-  else if (mqmsg->type == MQ_ALLOC_IRQ)
+  if (offset < MQ_MSG_SIZE(msgq->maxmsgsize) * (size_t)msgq->maxmsgs)
     {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
       flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
+      sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
       leave_critical_section(flags);
+      return;
     }
+#endif
 
-  /* Otherwise, deallocate it.  Note:  interrupt handlers
-   * will never deallocate messages because they will not
-   * received them.
+  /* Return the message to the pool.  This is safe even if we are called
+   * from an interrupt handler.
    */
 
-  else if (mqmsg->type == MQ_ALLOC_DYN)
-    {
-      sched_kfree(mqmsg);
-    }
-  else
-    {
-      PANIC();
-    }
+  mempool_free(&g_msgpool, mqmsg);
 }
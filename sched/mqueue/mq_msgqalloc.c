@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <mqueue.h>
 #include <assert.h>
 
@@ -64,7 +65,8 @@
  *   mode   - mode_t value is ignored
  *   attr   - The mq_maxmsg attribute is used at the time that the message
  *            queue is created to determine the maximum number of
- *            messages that may be placed in the message queue.
+ *            messages that may be placed in the message queue.  MQ_ZEROCOPY
+ *            in the mq_flags attribute creates a zero-copy message queue.
  *
  * Return Value:
  *   The allocated and initialized message queue structure or NULL in the
@@ -76,13 +78,28 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode,
                                         FAR struct mq_attr *attr)
 {
   FAR struct mqueue_inode_s *msgq;
+#ifdef CONFIG_MQ_ZEROCOPY
+  struct mq_attr zcattr;
+
+  /* The messages of a zero-copy message queue hold only the descriptor of
+   * the buffer that is passed.
+   */
+
+  if (attr && (attr->mq_flags & MQ_ZEROCOPY) != 0)
+    {
+      zcattr.mq_maxmsg  = attr->mq_maxmsg;
+      zcattr.mq_msgsize = sizeof(struct mq_buffer_s);
+      zcattr.mq_flags   = attr->mq_flags;
+      attr              = &zcattr;
+    }
+#endif
 
   /* Check if the caller is attempting to allocate a message for messages
    * larger than the configured maximum message size.
    */
 
-  DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_BYTES);
-  if (attr && attr->mq_msgsize > MQ_MAX_BYTES)
+  DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_QBYTES);
+  if (attr && attr->mq_msgsize > MQ_MAX_QBYTES)
     {
       return NULL;
     }
@@ -100,7 +117,10 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode,
       if (attr)
         {
           msgq->maxmsgs    = (int16_t)attr->mq_maxmsg;
-          msgq->maxmsgsize = (int16_t)attr->mq_msgsize;
+          msgq->maxmsgsize = attr->mq_msgsize;
+#ifdef CONFIG_MQ_ZEROCOPY
+          msgq->zerocopy   = (attr->mq_flags & MQ_ZEROCOPY) != 0;
+#endif
         }
       else
         {
@@ -108,6 +128,34 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode,
           msgq->maxmsgsize = MQ_MAX_BYTES;
         }
 
+#ifdef CONFIG_MQ_QUEUEPOOL
+      /* Allocate one message for each message that the queue may hold, each
+       * just large enough for the messages of this queue.
+       */
+
+      sq_init(&msgq->msgfree);
+      if (msgq->maxmsgs > 0)
+        {
+          size_t msgsize = MQ_MSG_SIZE(msgq->maxmsgsize);
+          FAR uint8_t *mqmsg;
+          int i;
+
+          msgq->msgpool = kmm_malloc(msgsize * msgq->maxmsgs);
+          if (msgq->msgpool == NULL)
+            {
+              kmm_free(msgq);
+              return NULL;
+            }
+
+          for (i = 0, mqmsg = (FAR uint8_t *)msgq->msgpool;
+               i < msgq->maxmsgs;
+               i++, mqmsg += msgsize)
+            {
+              sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
+            }
+        }
+#endif
+
 #ifndef CONFIG_DISABLE_SIGNALS
       msgq->ntpid = INVALID_PROCESS_ID;
 #endif
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
 #include <debug.h>
 #include <nuttx/kmalloc.h>
 #include "mqueue/mqueue.h"
@@ -53,9 +54,9 @@
  * Description:
  *   This function deallocates an initialized message queue structure.
  *   First, it deallocates all of the queued messages in the message
- *   queue.  It is assumed that this message is fully unlinked and
- *   closed so that no thread will attempt access it while it is being
- *   deleted.
+ *   queue (and the buffers of queued zero-copy messages).  It is assumed
+ *   that this message is fully unlinked and closed so that no thread will
+ *   attempt access it while it is being deleted.
  *
  * Inputs:
  *   msgq - Named essage queue to be freed
@@ -69,6 +70,9 @@ void mq_msgqfree(FAR struct mqueue_inode_s *msgq)
 {
   FAR struct mqueue_msg_s *curr;
   FAR struct mqueue_msg_s *next;
+#ifdef CONFIG_MQ_ZEROCOPY
+  struct mq_buffer_s buffer;
+#endif
 
   /* Deallocate any stranded messages in the message queue. */
 
@@ -78,10 +82,35 @@ void mq_msgqfree(FAR struct mqueue_inode_s *msgq)
       /* Deallocate the message structure. */
 
       next = curr->next;
-      mq_msgfree(curr);
+
+#ifdef CONFIG_MQ_ZEROCOPY
+      /* The buffer of an undelivered zero-copy message is still owned by
+       * the message queue.  A message that was sent with mq_send() rather
+       * than with mq_sendbuf() holds no buffer to free.  The descriptor is
+       * copied out because the payload is not guaranteed to be pointer
+       * aligned.
+       */
+
+      if (curr->zerocopy)
+        {
+          memcpy(&buffer, curr->mail, sizeof(struct mq_buffer_s));
+          sched_ufree(buffer.buf);
+        }
+#endif
+
+      mq_msgfree(msgq, curr);
       curr = next;
     }
 
+#ifdef CONFIG_MQ_QUEUEPOOL
+  /* Deallocate the message pool of the message queue */
+
+  if (msgq->msgpool != NULL)
+    {
+      sched_kfree(msgq->msgpool);
+    }
+#endif
+
   /* Then deallocate the message queue itself */
 
   sched_kfree(msgq);
@@ -270,11 +270,11 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 
   /* We are done with the message.  Deallocate it now. */
 
-  mq_msgfree(mqmsg);
+  msgq = mqdes->msgq;
+  mq_msgfree(msgq, mqmsg);
 
   /* Check if any tasks are waiting for the MQ not full event. */
 
-  msgq = mqdes->msgq;
   if (msgq->nwaitnotfull > 0)
     {
       /* Find the highest priority task that is waiting for
@@ -0,0 +1,156 @@
+/****************************************************************************
+ * sched/mqueue/mq_receivebuf.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <mqueue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_receivebuf
+ *
+ * Description:
+ *   Receive a buffer passed by reference with mq_sendbuf() from a zero-copy
+ *   message queue.  The caller becomes the owner of the buffer and must
+ *   free() it when it is no longer needed.
+ *
+ *   A message that was sent to the message queue with mq_send() carries no
+ *   buffer.  It is removed from the message queue and discarded.
+ *
+ *   This is otherwise the same as mq_receive().
+ *
+ * Parameters:
+ *   mqdes - Zero-copy message queue descriptor
+ *   buf   - The location to return the address of the buffer
+ *   prio  - If not NULL, the location to return the priority of the
+ *           message
+ *
+ * Return Value:
+ *   On success, the length of the buffer in bytes is returned.  On
+ *   failure, -1 (ERROR) is returned, with errno set as for mq_receive() or
+ *   to EBADMSG if mqdes is not a zero-copy message queue or if the message
+ *   was not sent with mq_sendbuf().
+ *
+ ****************************************************************************/
+
+ssize_t mq_receivebuf(mqd_t mqdes, FAR void **buf, FAR int *prio)
+{
+  FAR struct mqueue_msg_s *mqmsg;
+  struct mq_buffer_s msg;
+  irqstate_t flags;
+  ssize_t ret = ERROR;
+  bool zerocopy;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  /* mq_receivebuf() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  if (buf == NULL)
+    {
+      set_errno(EINVAL);
+      leave_cancellation_point();
+      return ERROR;
+    }
+
+  if (mq_verifyreceive(mqdes, (FAR char *)&msg, sizeof(msg)) != OK)
+    {
+      leave_cancellation_point();
+      return ERROR;
+    }
+
+  if (!mqdes->msgq->zerocopy)
+    {
+      set_errno(EBADMSG);
+      leave_cancellation_point();
+      return ERROR;
+    }
+
+  /* Get the next message from the message queue, waiting for one if
+   * necessary (see mq_receive()).
+   */
+
+  sched_lock();
+
+  flags = enter_critical_section();
+  mqmsg = mq_waitreceive(mqdes);
+  leave_critical_section(flags);
+
+  if (mqmsg != NULL)
+    {
+      /* Only the kernel message header tells whether the message carries a
+       * buffer.  mq_doreceive() frees the message, so check it first.
+       */
+
+      zerocopy = mqmsg->zerocopy;
+      (void)mq_doreceive(mqdes, mqmsg, (FAR char *)&msg, prio);
+
+      if (zerocopy)
+        {
+          *buf = msg.buf;
+          ret  = (ssize_t)msg.buflen;
+        }
+      else
+        {
+          set_errno(EBADMSG);
+        }
+    }
+
+  sched_unlock();
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_MQ_ZEROCOPY */
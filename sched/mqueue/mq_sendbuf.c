@@ -0,0 +1,161 @@
+/****************************************************************************
+ * sched/mqueue/mq_sendbuf.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <mqueue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/mqueue.h>
+
+#include "mqueue/mqueue.h"
+
+#ifdef CONFIG_MQ_ZEROCOPY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_sendbuf
+ *
+ * Description:
+ *   Pass a buffer by reference to a zero-copy message queue (one created
+ *   with MQ_ZEROCOPY in the mq_flags attribute).  Only the address and the
+ *   length of the buffer are queued.  On success, the ownership of the
+ *   buffer passes to the message queue and then to the receiver, which
+ *   must eventually free() it.  The sender must not access the buffer
+ *   after it was sent.  On failure, the sender still owns the buffer.
+ *
+ *   The message is marked as zero-copy in its header so that the buffer of
+ *   an undelivered message is freed when the message queue is destroyed.
+ *
+ *   This is otherwise the same as mq_send().
+ *
+ * Parameters:
+ *   mqdes  - Zero-copy message queue descriptor
+ *   buf    - The buffer to pass.  It must have been allocated with
+ *            malloc().
+ *   buflen - The length of the buffer in bytes
+ *   prio   - The priority of the message
+ *
+ * Return Value:
+ *   On success, mq_sendbuf() returns 0 (OK); on error, -1 (ERROR) is
+ *   returned, with errno set as for mq_send() or to EBADMSG if mqdes is
+ *   not a zero-copy message queue.
+ *
+ ****************************************************************************/
+
+int mq_sendbuf(mqd_t mqdes, FAR void *buf, size_t buflen, int prio)
+{
+  FAR struct mqueue_inode_s *msgq;
+  FAR struct mqueue_msg_s *mqmsg = NULL;
+  struct mq_buffer_s msg;
+  irqstate_t flags;
+  int ret = ERROR;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  /* mq_sendbuf() is a cancellation point */
+
+  (void)enter_cancellation_point();
+
+  msg.buf    = buf;
+  msg.buflen = buflen;
+
+  if (buf == NULL)
+    {
+      set_errno(EINVAL);
+      leave_cancellation_point();
+      return ERROR;
+    }
+
+  if (mq_verifysend(mqdes, (FAR const char *)&msg, sizeof(msg), prio) != OK)
+    {
+      leave_cancellation_point();
+      return ERROR;
+    }
+
+  if (!mqdes->msgq->zerocopy)
+    {
+      set_errno(EBADMSG);
+      leave_cancellation_point();
+      return ERROR;
+    }
+
+  /* Allocate a message structure, waiting for the message queue to become
+   * non-FULL if necessary.
+   */
+
+  sched_lock();
+  msgq = mqdes->msgq;
+
+  flags = enter_critical_section();
+  if (msgq->nmsgs < msgq->maxmsgs || mq_waitsend(mqdes) == OK)
+    {
+      leave_critical_section(flags);
+      mqmsg = mq_msgalloc(msgq);
+      if (mqmsg == NULL)
+        {
+          set_errno(ENOMEM);
+        }
+    }
+  else
+    {
+      leave_critical_section(flags);
+    }
+
+  if (mqmsg != NULL)
+    {
+      mqmsg->zerocopy = true;
+      ret = mq_dosend(mqdes, mqmsg, (FAR const char *)&msg, sizeof(msg),
+                      prio);
+    }
+
+  sched_unlock();
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_MQ_ZEROCOPY */
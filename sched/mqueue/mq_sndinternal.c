@@ -49,11 +49,11 @@
 #include <debug.h>
 
 #include <nuttx/irq.h>
-#include <nuttx/kmalloc.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/signal.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/mm/mempool.h>
 
 #include "sched/sched.h"
 #ifndef CONFIG_DISABLE_SIGNALS
@@ -122,82 +122,59 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *
  * Description:
  *   The mq_msgalloc function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be allocated from the message pool
+ *   of the message queue, if it has one, or from g_msgpool.
  *
- *   If the list is empty AND the message is NOT being allocated from the
- *   interrupt level, then the message will be allocated.  If a message
- *   cannot be obtained, the operating system is dead and therefore cannot
- *   continue.
+ *   If the unreserved messages are exhausted AND the message is NOT being
+ *   allocated from the interrupt level, then the pool will grow from the
+ *   kernel heap.
  *
- *   If the list is empty AND the message IS being allocated from the
- *   interrupt level.  This function will attempt to get a message from
- *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
- *   handler will be notified.
+ *   If the unreserved messages are exhausted AND the message IS being
+ *   allocated from the interrupt level, then this function will take one
+ *   of the messages reserved for interrupt handlers.
  *
  * Inputs:
- *   None
+ *   msgq - The message queue that the message will be sent to
  *
  * Return Value:
- *   A reference to the allocated msg structure.  On a failure to allocate,
- *   this function PANICs.
+ *   A reference to the allocated msg structure or NULL on a failure to
+ *   allocate.
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *mq_msgalloc(void)
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq)
 {
   FAR struct mqueue_msg_s *mqmsg;
+#ifdef CONFIG_MQ_QUEUEPOOL
   irqstate_t flags;
 
-  /* If we were called from an interrupt handler, then try to get the message
-   * from generally available list of messages. If this fails, then try the
-   * list of messages reserved for interrupt handlers
+  /* The pool of the message queue holds one message for each message that
+   * the queue may hold.  It can only be exhausted if interrupt handlers send
+   * to a full message queue.
    */
 
-  if (up_interrupt_context())
-    {
-      /* Try the general free list */
-
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      if (mqmsg == NULL)
-        {
-          /* Try the free list reserved for interrupt handlers */
-
-          mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
-        }
-    }
-
-  /* We were not called from an interrupt handler. */
+  flags = enter_critical_section();
+  mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msgfree);
+  leave_critical_section(flags);
 
-  else
+  if (mqmsg == NULL && msgq->maxmsgsize <= MQ_MAX_BYTES)
+#endif
     {
-      /* Try to get the message from the generally available free list.
-       * Disable interrupts -- we might be called from an interrupt handler.
+      /* Interrupt handlers may use the messages reserved for them; normal
+       * tasks will grow the pool from the heap instead.
        */
 
-      flags = enter_critical_section();
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
-
-      /* If we cannot a message from the free list, then we will have to
-       * allocate one.
-       */
-
-      if (mqmsg == NULL)
-        {
-          mqmsg = (FAR struct mqueue_msg_s *)
-            kmm_malloc((sizeof (struct mqueue_msg_s)));
+      mqmsg = (FAR struct mqueue_msg_s *)mempool_alloc(&g_msgpool);
+    }
 
-          /* Check if we allocated the message */
+#ifdef CONFIG_MQ_ZEROCOPY
+  /* Only mq_sendbuf() sends messages that carry a buffer */
 
-          if (mqmsg != NULL)
-            {
-              /* Yes... remember that this message was dynamically allocated */
-
-              mqmsg->type = MQ_ALLOC_DYN;
-            }
-        }
+  if (mqmsg != NULL)
+    {
+      mqmsg->zerocopy = false;
     }
+#endif
 
   return mqmsg;
 }
@@ -195,20 +195,6 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio,
       return ERROR;
     }
 
-  /* Pre-allocate a message structure */
-
-  mqmsg = mq_msgalloc();
-  if (mqmsg == NULL)
-    {
-      /* Failed to allocate the message. mq_msgalloc() does not set the
-       * errno value.
-       */
-
-      set_errno(ENOMEM);
-      leave_cancellation_point();
-      return ERROR;
-    }
-
   /* Get a pointer to the message queue */
 
   sched_lock();
@@ -230,6 +216,15 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio,
 
   if (msgq->nmsgs < msgq->maxmsgs || up_interrupt_context())
     {
+      /* Allocate the message.  mq_msgalloc() does not set the errno value */
+
+      mqmsg = mq_msgalloc(msgq);
+      if (mqmsg == NULL)
+        {
+          result = ENOMEM;
+          goto errout_with_lock;
+        }
+
       /* Do the send with no further checks (possibly exceeding maxmsgs)
        * Currently mq_dosend() always returns OK.
        */
@@ -247,7 +242,7 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio,
   if (!abstime || abstime->tv_nsec < 0 || abstime->tv_nsec >= 1000000000)
     {
       result = EINVAL;
-      goto errout_with_mqmsg;
+      goto errout_with_lock;
     }
 
   /* Create a watchdog.  We will not actually need this watchdog
@@ -259,7 +254,7 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio,
   if (!rtcb->waitdog)
     {
       result = EINVAL;
-      goto errout_with_mqmsg;
+      goto errout_with_lock;
     }
 
   /* We are not in an interrupt handler and the message queue is full.
@@ -315,25 +310,33 @@ int mq_timedsend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio,
   /* That is the end of the atomic operations */
 
   leave_critical_section(flags);
+  wd_delete(rtcb->waitdog);
+  rtcb->waitdog = NULL;
 
-  /* If any of the above failed, set the errno.  Otherwise, there should
-   * be space for another message in the message queue.  NOW we can allocate
-   * the message structure.
-   *
-   * Currently mq_dosend() always returns OK.
+  /* There should now be space for another message in the message queue.
+   * NOW we can allocate the message structure.  With CONFIG_MQ_QUEUEPOOL,
+   * that takes one of the messages that were released by the receiver.
    */
 
+  mqmsg = mq_msgalloc(msgq);
+  if (mqmsg == NULL)
+    {
+      /* mq_msgalloc() does not set the errno value */
+
+      result = ENOMEM;
+      goto errout_with_lock;
+    }
+
+  /* Currently mq_dosend() always returns OK. */
+
   ret = mq_dosend(mqdes, mqmsg, msg, msglen, prio);
 
   sched_unlock();
-  wd_delete(rtcb->waitdog);
-  rtcb->waitdog = NULL;
   leave_cancellation_point();
   return ret;
 
-  /* Exit here with (1) the scheduler locked, (2) a message allocated, (3) a
-   * wdog allocated, and (4) interrupts disabled.  The error code is in
-   * 'result'
+  /* Exit here with (1) the scheduler locked, (2) a wdog allocated, and (3)
+   * interrupts disabled.  The error code is in 'result'
    */
 
 errout_in_critical_section:
@@ -341,12 +344,9 @@ errout_in_critical_section:
   wd_delete(rtcb->waitdog);
   rtcb->waitdog = NULL;
 
-  /* Exit here with (1) the scheduler locked and 2) a message allocated.  The
-   * error code is in 'result'
-   */
+  /* Exit here with the scheduler locked.  The error code is in 'result' */
 
-errout_with_mqmsg:
-  mq_msgfree(mqmsg);
+errout_with_lock:
   sched_unlock();
 
   set_errno(result);
@@ -44,6 +44,7 @@
 #include <nuttx/compiler.h>
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <limits.h>
@@ -52,6 +53,7 @@
 #include <signal.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/mm/mempool.h>
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -63,6 +65,24 @@
 #define MQ_MAX_MSGS    16
 #define MQ_PRIO_MAX    _POSIX_MQ_PRIO_MAX
 
+/* The largest message size that a message queue may be created with.  With
+ * per-queue message pools, this is limited only by the type of msglen.
+ */
+
+#ifdef CONFIG_MQ_QUEUEPOOL
+#  define MQ_MAX_QBYTES UINT16_MAX
+#else
+#  define MQ_MAX_QBYTES MQ_MAX_BYTES
+#endif
+
+/* The size of a message with a payload of 'n' bytes in a per-queue message
+ * pool.  Messages are padded so that each message in the pool is aligned.
+ */
+
+#define MQ_MSG_SIZE(n) \
+  ((offsetof(struct mqueue_msg_s, mail) + (n) + sizeof(uintptr_t) - 1) & \
+   ~(sizeof(uintptr_t) - 1))
+
 /* This defines the number of messages descriptors to allocate at each
  * "gulp."
  */
@@ -75,28 +95,32 @@
 
 #define NUM_INTERRUPT_MSGS   8
 
+/* This defines the number of messages to add to the message pool when it
+ * is exhausted.
+ */
+
+#ifndef CONFIG_MQ_NEXPAND
+#  define CONFIG_MQ_NEXPAND  8
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
-enum mqalloc_e
-{
-  MQ_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
-  MQ_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
-};
-
 /* This structure describes one buffered POSIX message. */
 
 struct mqueue_msg_s
 {
   FAR struct mqueue_msg_s *next;  /* Forward link to next message */
-  uint8_t type;                   /* (Used to manage allocations) */
   uint8_t priority;               /* priority of message */
-#if MQ_MAX_BYTES < 256
+#if MQ_MAX_QBYTES < 256
   uint8_t msglen;                 /* Message data length */
 #else
   uint16_t msglen;                /* Message data length */
+#endif
+#ifdef CONFIG_MQ_ZEROCOPY
+  bool zerocopy;                  /* Sent by mq_sendbuf(); mail is a
+                                   * struct mq_buffer_s */
 #endif
   char mail[MQ_MAX_BYTES];        /* Message data */
 };
@@ -113,17 +137,11 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_msgfree is a list of messages that are available for general use.
- * The number of messages in this list is a system configuration item.
- */
-
-EXTERN sq_queue_t  g_msgfree;
-
-/* The g_msgfreeInt is a list of messages that are reserved for use by
- * interrupt handlers.
+/* g_msgpool is the pool of messages.  The last NUM_INTERRUPT_MSGS free
+ * messages are reserved for use by interrupt handlers.
  */
 
-EXTERN sq_queue_t  g_msgfreeirq;
+EXTERN struct mempool_s g_msgpool;
 
 /* The g_desfree data structure is a list of message descriptors available
  * to the operating system for general use. The number of messages in the
@@ -145,7 +163,8 @@ void weak_function mq_initialize(void);
 void mq_desblockalloc(void);
 
 FAR struct mqueue_inode_s *mq_findnamed(FAR const char *mq_name);
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg);
+void mq_msgfree(FAR struct mqueue_inode_s *msgq,
+                FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c ************************************************************/
 
@@ -161,7 +180,7 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 /* mq_sndinternal.c ********************************************************/
 
 int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio);
-FAR struct mqueue_msg_s *mq_msgalloc(void);
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq);
 int mq_waitsend(mqd_t mqdes);
 int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
               FAR const char *msg, size_t msglen, int prio);
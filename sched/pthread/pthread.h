@@ -49,6 +49,7 @@
 #include <sched.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/pthread.h>
 
 /****************************************************************************
  * Public Type Declarations
@@ -257,15 +257,18 @@ int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
       attr = &g_default_pthread_attr;
     }
 
-  /* Allocate a TCB for the new task. */
+  /* Allocate a TCB for the new task, preferably in fast memory. */
 
-  ptcb = (FAR struct pthread_tcb_s *)kmm_zalloc(sizeof(struct pthread_tcb_s));
+  ptcb = (FAR struct pthread_tcb_s *)
+    kmm_malloc_region(sizeof(struct pthread_tcb_s), MM_REGION_FAST);
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
       return ENOMEM;
     }
 
+  memset(ptcb, 0, sizeof(struct pthread_tcb_s));
+
 #ifdef HAVE_TASK_GROUP
   /* Bind the parent's group to the new TCB (we have not yet joined the
    * group).
@@ -478,6 +481,17 @@ int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
         break;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        /* Deadline reservations are not inherited.  The new thread starts
+         * as SCHED_FIFO in the same priority band and must request its own
+         * reservation with sched_setscheduler().
+         */
+
+        ptcb->cmn.flags    |= TCB_FLAG_SCHED_FIFO;
+        break;
+#endif
+
 #if 0 /* Not supported */
       case SCHED_OTHER:
         ptcb->cmn.flags    |= TCB_FLAG_SCHED_OTHER;
@@ -74,6 +74,19 @@ static void pthread_mutex_add(FAR struct pthread_mutex_s *mutex)
 
   DEBUGASSERT(mutex->flink == NULL);
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* A mutex that qualifies for the fast path may be released in the C
+   * library without entering the kernel.  It could never be removed from
+   * the list so it is not tracked.  It is neither robust nor does it use
+   * priority inheritance, so nothing depends on the list for it.
+   */
+
+  if (pthread_mutex_fastpath(mutex))
+    {
+      return;
+    }
+#endif
+
   /* Check if this is a pthread.  The main thread may also lock and unlock
    * mutexes.  The main thread, however, does not participate in the mutex
    * consistency logic.  Presumably, when the main thread exits, all of the
@@ -115,6 +128,15 @@ static void pthread_mutex_remove(FAR struct pthread_mutex_s *mutex)
 {
   FAR struct tcb_s *rtcb = this_task();
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* A mutex that qualifies for the fast path was never added to the list */
+
+  if (pthread_mutex_fastpath(mutex))
+    {
+      return;
+    }
+#endif
+
   /* Check if this is a pthread.  The main thread may also lock and unlock
    * mutexes.  The main thread, however, does not participate in the mutex
    * consistency logic.
@@ -55,7 +55,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_lock
+ * Name: pthread_mutex_lock (pthread_mutex_wait)
  *
  * Description:
  *   The mutex object referenced by mutex is locked by calling
@@ -88,6 +88,10 @@
  *   from the signal handler the thread resumes waiting for the mutex as if
  *   it was not interrupted.
  *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, pthread_mutex_lock() is implemented
+ *   in the C library and this function is pthread_mutex_wait(), the kernel
+ *   path that it calls when the fast path cannot be used.
+ *
  * Parameters:
  *   mutex - A reference to the mutex to be locked.
  *
@@ -104,7 +108,11 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+int pthread_mutex_wait(FAR pthread_mutex_t *mutex)
+#else
 int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
+#endif
 {
   int mypid = (int)getpid();
   int ret = EINVAL;
@@ -54,7 +54,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_trylock
+ * Name: pthread_mutex_trylock (pthread_mutex_trywait)
  *
  * Description:
  *   The function pthread_mutex_trylock() is identical to pthread_mutex_lock()
@@ -66,6 +66,11 @@
  *   the signal handler the thread resumes waiting for the mutex as if it was
  *   not interrupted.
  *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, pthread_mutex_trylock() is
+ *   implemented in the C library and this function is
+ *   pthread_mutex_trywait(), the kernel path that it calls when the fast
+ *   path cannot be used.
+ *
  * Parameters:
  *   mutex - A reference to the mutex to be locked.
  *
@@ -82,7 +87,11 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+int pthread_mutex_trywait(FAR pthread_mutex_t *mutex)
+#else
 int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+#endif
 {
   int status;
   int ret = EINVAL;
@@ -86,7 +86,7 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_unlock
+ * Name: pthread_mutex_unlock (pthread_mutex_wake)
  *
  * Description:
  *   The pthread_mutex_unlock() function releases the mutex object referenced
@@ -102,6 +102,10 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *   the signal handler the thread resumes waiting for the mutex as if it was
  *   not interrupted.
  *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, pthread_mutex_unlock() is
+ *   implemented in the C library and this function is pthread_mutex_wake(),
+ *   the kernel path that it calls when the fast path cannot be used.
+ *
  * Parameters:
  *   None
  *
@@ -112,7 +116,11 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+int pthread_mutex_wake(FAR pthread_mutex_t *mutex)
+#else
 int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+#endif
 {
   int ret = EPERM;
 
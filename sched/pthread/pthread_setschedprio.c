@@ -78,9 +78,9 @@ int pthread_setschedprio(pthread_t thread, int prio)
   struct sched_param param;
   int ret;
 
-#ifdef CONFIG_SCHED_SPORADIC
-  /* Get the current sporadic scheduling parameters.  Those will not be
-   * modified.
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
+  /* Get the current sporadic or deadline scheduling parameters.  Those
+   * will not be modified.
    */
 
   ret = sched_getparam((pid_t)thread, &param);
@@ -99,7 +99,7 @@ int pthread_setschedprio(pthread_t thread, int prio)
       return OK;
     }
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_errno:
 #endif
   ret = get_errno();
@@ -102,6 +102,25 @@
 #  define TLIST_BLOCKED(s)       __TLIST_HEAD(s)
 #endif
 
+/* SCHED_DEADLINE ordering.  Within a priority band, a deadline thread runs
+ * before another deadline thread with a later absolute deadline.  Threads of
+ * other policies keep FIFO order with respect to each other and to deadline
+ * threads.
+ */
+
+#ifdef CONFIG_SCHED_DEADLINE
+#  define sched_isdeadline(t) \
+  (((t)->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+#  define sched_deadline_before(t1,t2) \
+  ((t1)->sched_priority == (t2)->sched_priority && \
+   sched_isdeadline(t1) && sched_isdeadline(t2) && \
+   (ssystime_t)((t1)->deadline->absdeadline - \
+                (t2)->deadline->absdeadline) < 0)
+#else
+#  define sched_isdeadline(t) (false)
+#  define sched_deadline_before(t1,t2) (false)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -121,7 +140,10 @@ struct pidhash_s
 {
   FAR struct tcb_s *tcb;       /* TCB assigned to this PID */
   pid_t pid;                   /* The full PID value */
-#ifdef CONFIG_SCHED_CPULOAD
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  uint64_t ticks;              /* Decaying run time in counter counts */
+  uint64_t runtime;            /* Total run time in counter counts */
+#elif defined(CONFIG_SCHED_CPULOAD)
   uint32_t ticks;              /* Number of ticks on this thread */
 #endif
 };
@@ -289,11 +311,16 @@ extern const struct tasklist_s g_tasklisttable[NUM_TASK_STATES];
 
 #ifdef CONFIG_SCHED_CPULOAD
 /* This is the total number of clock tick counts.  Essentially the
- * 'denominator' for all CPU load calculations.
+ * 'denominator' for all CPU load calculations.  With precise accounting,
+ * this is the total number of performance counter counts.
  */
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+extern volatile uint64_t g_cpuload_total;
+#else
 extern volatile uint32_t g_cpuload_total;
 #endif
+#endif
 
 /* Declared in sched_lock.c *************************************************/
 /* Pre-emption is disabled via the interface sched_lock(). sched_lock()
@@ -360,6 +387,21 @@ extern volatile spinlock_t g_cpu_schedlock SP_SECTION;
 extern volatile spinlock_t g_cpu_locksetlock SP_SECTION;
 extern volatile cpu_set_t g_cpu_lockset SP_SECTION;
 
+#ifdef CONFIG_SMP_RESCHED_IPI
+/* Set when a reschedule IPI is received while the CPU holds the IRQ lock.
+ * The IPI is then re-raised when the CPU leaves the critical section.
+ */
+
+extern volatile bool g_cpu_resched[CONFIG_SMP_NCPUS];
+#endif
+
+#ifdef CONFIG_SMP_LOADBALANCE
+/* Per-CPU task migration counts.  See struct cpumigrate_s. */
+
+extern volatile uint32_t g_cpu_migrations[CONFIG_SMP_NCPUS];
+extern volatile uint32_t g_cpu_balanced[CONFIG_SMP_NCPUS];
+#endif
+
 #endif /* CONFIG_SMP */
 
 /****************************************************************************
@@ -373,10 +415,32 @@ bool sched_removereadytorun(FAR struct tcb_s *rtrtcb);
 bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
 void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
                             uint8_t task_state);
+#ifdef CONFIG_SCHED_PRIOBITMAP
+void sched_remprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+#else
+#  define sched_remprioritized(t,l) dq_rem((FAR dq_entry_t *)(t), (l))
+#endif
 bool sched_mergepending(void);
 void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int  sched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
+void sched_requeue(FAR struct tcb_s *tcb);
+void sched_requeue(FAR struct tcb_s *tcb);
+
+/* Priority index of the ready-to-run and pending task lists */
+
+#ifdef CONFIG_SCHED_PRIOBITMAP
+bool sched_prioindex_find(DSEG dq_queue_t *list, uint8_t priority,
+                          FAR struct tcb_s **prev);
+void sched_prioindex_add(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+void sched_prioindex_rem(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+void sched_prioindex_rebuild(DSEG dq_queue_t *list);
+#else
+#  define sched_prioindex_find(l,p,t) (false)
+#  define sched_prioindex_add(t,l)
+#  define sched_prioindex_rem(t,l)
+#  define sched_prioindex_rebuild(l)
+#endif
 
 /* Priority inheritance support */
 
@@ -418,6 +482,18 @@ uint32_t sched_sporadic_process(FAR struct tcb_s *tcb, uint32_t ticks,
 void sched_sporadic_lowpriority(FAR struct tcb_s *tcb);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+int  sched_deadline_start(FAR struct tcb_s *tcb, uint32_t runtime,
+                          uint32_t deadline, uint32_t period);
+int  sched_deadline_stop(FAR struct tcb_s *tcb);
+void sched_deadline_wakeup(FAR struct tcb_s *tcb);
+void sched_deadline_requeue(FAR struct tcb_s *tcb);
+uint32_t sched_deadline_process(FAR struct tcb_s *tcb, uint32_t ticks,
+                                bool noswitches);
+#else
+#  define sched_deadline_wakeup(t)
+#endif
+
 #ifdef CONFIG_SMP
 int  sched_cpu_select(cpu_set_t affinity);
 int  sched_cpu_pause(FAR struct tcb_s *tcb);
@@ -428,12 +504,36 @@ int  sched_cpu_pause(FAR struct tcb_s *tcb);
 #  define sched_islocked(tcb) ((tcb)->lockcount > 0)
 #endif
 
+/* SMP load balancing */
+
+#ifdef CONFIG_SMP_LOADBALANCE
+int  sched_balance_cpu(FAR struct tcb_s *tcb);
+FAR struct tcb_s *sched_balance_task(int cpu);
+void sched_balance_idle(void);
+#ifndef CONFIG_SCHED_TICKLESS
+void sched_process_balance(void);
+#endif
+#  define sched_count_migration(tcb,c) \
+     do { if ((tcb)->cpu != (c)) g_cpu_migrations[c]++; } while (0)
+#else
+#  define sched_count_migration(tcb,c)
+#endif
+
 /* CPU load measurement support */
 
-#if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_SCHED_CPULOAD_EXTCLK)
+#if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_SCHED_CPULOAD_EXTCLK) && \
+   !defined(CONFIG_SCHED_CPULOAD_PRECISE)
 void weak_function sched_process_cpuload(void);
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+void sched_cpuload_suspend(FAR struct tcb_s *tcb);
+void sched_cpuload_resume(void);
+void sched_cpuload_irqenter(void);
+void sched_cpuload_irqleave(void);
+unsigned int sched_cpuload_process(void);
+#endif
+
 /* TCB operations */
 
 bool sched_verifytcb(FAR struct tcb_s *tcb);
@@ -54,7 +54,9 @@
  * Name: sched_addprioritized
  *
  * Description:
- *  This function adds a TCB to a prioritized TCB list.
+ *  This function adds a TCB to a prioritized TCB list.  TCBs of the same
+ *  priority are kept in FIFO order except that SCHED_DEADLINE threads are
+ *  kept in earliest deadline first order.
  *
  * Inputs:
  *   tcb - Points to the TCB to add to the prioritized list
@@ -87,13 +89,38 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   ASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
-  /* Search the list to find the location to insert the new Tcb.
-   * Each is list is maintained in descending sched_priority order.
+  /* Find the location to insert the new Tcb.  Each is list is maintained
+   * in descending sched_priority order.  If the list has a priority index,
+   * then the TCB goes just after the last TCB of the same or the nearest
+   * higher priority.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
-       next = next->flink);
+  if (sched_prioindex_find(list, sched_priority, &prev))
+    {
+      next = prev ? prev->flink : (FAR struct tcb_s *)list->head;
+    }
+
+  /* Otherwise, search the list */
+
+  else
+    {
+      for (next = (FAR struct tcb_s *)list->head;
+           (next && sched_priority <= next->sched_priority);
+           next = next->flink);
+    }
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Within its priority band, a deadline thread goes before the deadline
+   * threads that have a later absolute deadline.
+   */
+
+  if (sched_isdeadline(tcb))
+    {
+      for (prev = next ? next->blink : (FAR struct tcb_s *)list->tail;
+           (prev && sched_deadline_before(tcb, prev));
+           next = prev, prev = prev->blink);
+    }
+#endif
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
@@ -151,6 +178,9 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+  /* The TCB is now the last TCB of its priority in the list */
+
+  sched_prioindex_add(tcb, list);
   return ret;
 }
 
@@ -90,7 +90,9 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
    * also disabled.
    */
 
-  if (rtcb->lockcount > 0 && rtcb->sched_priority < btcb->sched_priority)
+  if (rtcb->lockcount > 0 &&
+      (rtcb->sched_priority < btcb->sched_priority ||
+       sched_deadline_before(btcb, rtcb)))
     {
       /* Yes.  Preemption would occur!  Add the new ready-to-run task to the
        * g_pendingtasks task list for now.
@@ -187,7 +189,11 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
        * (possibly its IDLE task).
        */
 
+#ifdef CONFIG_SMP_LOADBALANCE
+      cpu = sched_balance_cpu(btcb);
+#else
       cpu = sched_cpu_select(btcb->affinity);
+#endif
     }
 
   /* Get the task currently running on the CPU (maybe the IDLE task) */
@@ -197,9 +203,12 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
   /* Determine the desired new task state.  First, if the new task priority
    * is higher then the priority of the lowest priority, running task, then
    * the new task will be running and a context switch switch will be required.
+   * The same is true for a deadline task with an earlier deadline than the
+   * running deadline task of the same priority.
    */
 
-  if (rtcb->sched_priority < btcb->sched_priority)
+  if (rtcb->sched_priority < btcb->sched_priority ||
+      sched_deadline_before(btcb, rtcb))
     {
       task_state = TSTATE_TASK_RUNNING;
     }
@@ -262,6 +271,24 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
       btcb->task_state = TSTATE_TASK_READYTORUN;
       doswitch         = false;
     }
+#ifdef CONFIG_SMP_RESCHED_IPI
+  else if (cpu != me && (btcb->flags & TCB_FLAG_CPU_LOCKED) == 0)
+    {
+      /* The new task should preempt the task running on another CPU.
+       * Rather than pausing that CPU in order to modify its assigned task
+       * list, add the task to the g_readytorun list and ask the other CPU
+       * to pick it up.  If the task has been started elsewhere by the time
+       * the IPI is handled, then nothing is lost.
+       */
+
+      (void)sched_addprioritized(btcb, (FAR dq_queue_t *)&g_readytorun);
+
+      btcb->task_state = TSTATE_TASK_READYTORUN;
+      doswitch         = false;
+
+      DEBUGVERIFY(up_cpu_resched(cpu));
+    }
+#endif
   else /* (task_state == TSTATE_TASK_ASSIGNED || task_state == TSTATE_TASK_RUNNING) */
     {
       /* If we are modifying some assigned task list other than our own, we
@@ -297,6 +324,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
 
           DEBUGASSERT(task_state == TSTATE_TASK_RUNNING);
 
+          sched_count_migration(btcb, cpu);
           btcb->cpu        = cpu;
           btcb->task_state = TSTATE_TASK_RUNNING;
 
@@ -376,7 +404,7 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
             {
               /* Remove the task from the assigned task list */
 
-              dq_rem((FAR dq_entry_t *)next, tasklist);
+              sched_remprioritized(next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
                * list.  NOTE: That the above operations may cause the
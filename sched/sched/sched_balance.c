@@ -0,0 +1,367 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <sched.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_LOADBALANCE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* An idle CPU that found nothing that it could run in the g_readytorun
+ * list looks again without entering the critical section only if the head
+ * of the list changes or after this many clock ticks.
+ */
+
+#ifdef CONFIG_SMP_LOADBALANCE_INTERVAL
+#  define BALANCE_IDLE_TICKS CONFIG_SMP_LOADBALANCE_INTERVAL
+#else
+#  define BALANCE_IDLE_TICKS MSEC2TICK(10)
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The number of tasks that started running on each CPU after last running
+ * on some other CPU, and the number of tasks that the load balancer moved
+ * to each CPU.
+ */
+
+volatile uint32_t g_cpu_migrations[CONFIG_SMP_NCPUS];
+volatile uint32_t g_cpu_balanced[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifndef CONFIG_SCHED_TICKLESS
+/* Clock ticks since the periodic load balancer last ran */
+
+static unsigned int g_balance_ticks;
+#endif
+
+/* The head of the g_readytorun list and the time when each idle CPU last
+ * found nothing that it could run there.
+ */
+
+static FAR void *g_balance_idlehead[CONFIG_SMP_NCPUS];
+static systime_t g_balance_idletime[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_balance_move
+ *
+ * Description:
+ *   Move a task from the g_readytorun list to the CPU selected by
+ *   sched_balance_cpu().  The task is simply re-queued with
+ *   sched_requeue() which adds it back through sched_addreadytorun().
+ *   That will pause or signal the selected CPU as necessary or perform a
+ *   context switch if the selected CPU is this CPU.
+ *
+ ****************************************************************************/
+
+static void sched_balance_move(FAR struct tcb_s *tcb, int cpu)
+{
+  g_cpu_balanced[cpu]++;
+  sched_requeue(tcb);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_balance_cpu
+ *
+ * Description:
+ *   Select the CPU for a task that is becoming ready-to-run:  Normally the
+ *   CPU running the lowest priority task as selected by sched_cpu_select().
+ *   If the CPU that the task last ran on is as good a choice, then it is
+ *   used instead since the task's working set may still be in its cache.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the task becoming ready-to-run
+ *
+ * Returned Value:
+ *   The index of the selected CPU.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+int sched_balance_cpu(FAR struct tcb_s *tcb)
+{
+  int cpu  = sched_cpu_select(tcb->affinity);
+  int last = tcb->cpu;
+
+  if (last != cpu && CPU_ISSET(last, &tcb->affinity) &&
+      current_task(last)->sched_priority <=
+      current_task(cpu)->sched_priority &&
+      !sched_deadline_before(current_task(last), current_task(cpu)))
+    {
+      cpu = last;
+    }
+
+  return cpu;
+}
+
+/****************************************************************************
+ * Name: sched_balance_task
+ *
+ * Description:
+ *   Select the task from the g_readytorun list that should run next on
+ *   'cpu':  The highest priority task whose affinity mask includes 'cpu'.
+ *   If there are several such tasks with the same priority, the one that
+ *   last ran on 'cpu' is preferred.
+ *
+ * Input Parameters:
+ *   cpu - The CPU that is looking for work
+ *
+ * Returned Value:
+ *   The selected TCB or NULL if there is no task that can run on 'cpu'.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_balance_task(int cpu)
+{
+  FAR struct tcb_s *first = NULL;
+  FAR struct tcb_s *tcb;
+
+  for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+       tcb != NULL && (first == NULL ||
+                       tcb->sched_priority == first->sched_priority);
+       tcb = (FAR struct tcb_s *)tcb->flink)
+    {
+      if (CPU_ISSET(cpu, &tcb->affinity))
+        {
+          if (tcb->cpu == cpu)
+            {
+              return tcb;
+            }
+
+          if (first == NULL)
+            {
+              first = tcb;
+            }
+        }
+    }
+
+  return first;
+}
+
+/****************************************************************************
+ * Name: sched_balance_idle
+ *
+ * Description:
+ *   Called from the IDLE loop of each CPU.  If there is a task in the
+ *   g_readytorun list that may run on this CPU, then start it.
+ *
+ *   The tasks that remain in the g_readytorun list are usually those that
+ *   cannot run on this CPU.  So that the idle CPU does not keep taking the
+ *   critical section away from the busy CPUs, the list is examined again
+ *   only when its head changes or after BALANCE_IDLE_TICKS.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_balance_idle(void)
+{
+  FAR struct tcb_s *tcb;
+  FAR void *head = g_readytorun.head;
+  systime_t now;
+  irqstate_t flags;
+  int cpu;
+
+  /* Avoid the critical section if there is obviously nothing to do */
+
+  if (head == NULL || spin_islocked(&g_cpu_schedlock))
+    {
+      return;
+    }
+
+  /* Or if nothing has changed since we last looked.  The IDLE task cannot
+   * be migrated so this_cpu() is stable here.
+   */
+
+  cpu = this_cpu();
+  now = clock_systimer();
+
+  if (head == g_balance_idlehead[cpu] &&
+      now - g_balance_idletime[cpu] < BALANCE_IDLE_TICKS)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  if (!spin_islocked(&g_cpu_schedlock))
+    {
+      tcb = sched_balance_task(cpu);
+      if (tcb != NULL &&
+          (tcb->sched_priority > this_task()->sched_priority ||
+           sched_deadline_before(tcb, this_task())))
+        {
+          g_balance_idlehead[cpu] = NULL;
+          sched_balance_move(tcb, sched_balance_cpu(tcb));
+        }
+      else
+        {
+          g_balance_idlehead[cpu] = g_readytorun.head;
+          g_balance_idletime[cpu] = now;
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: sched_process_balance
+ *
+ * Description:
+ *   Called on each system timer tick.  Every CONFIG_SMP_LOADBALANCE_INTERVAL
+ *   ticks, move the highest priority task in the g_readytorun list that
+ *   would preempt the lowest priority task running on a CPU in its affinity
+ *   mask to that CPU.  At most one task is moved each time.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt handler.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SCHED_TICKLESS
+void sched_process_balance(void)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int cpu;
+
+  if (++g_balance_ticks < CONFIG_SMP_LOADBALANCE_INTERVAL)
+    {
+      return;
+    }
+
+  g_balance_ticks = 0;
+  if (g_readytorun.head == NULL)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  if (!spin_islocked(&g_cpu_schedlock))
+    {
+      for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+           tcb != NULL;
+           tcb = (FAR struct tcb_s *)tcb->flink)
+        {
+          cpu = sched_balance_cpu(tcb);
+          if (current_task(cpu)->sched_priority < tcb->sched_priority ||
+              sched_deadline_before(tcb, current_task(cpu)))
+            {
+              sched_balance_move(tcb, cpu);
+              break;
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: sched_cpumigrate
+ *
+ * Description:
+ *   Return the task migration counts of a CPU.
+ *
+ * Inputs:
+ *   cpu - The index of the CPU of interest.
+ *   stats - The location to return the counts.
+ *
+ * Return:
+ *   OK (0) on success; -EINVAL if 'cpu' is not a valid CPU index.
+ *
+ ****************************************************************************/
+
+int sched_cpumigrate(int cpu, FAR struct cpumigrate_s *stats)
+{
+  if (cpu < 0 || cpu >= CONFIG_SMP_NCPUS || stats == NULL)
+    {
+      return -EINVAL;
+    }
+
+  stats->migrations = g_cpu_migrations[cpu];
+  stats->balanced   = g_cpu_balanced[cpu];
+  return OK;
+}
+
+#endif /* CONFIG_SMP_LOADBALANCE */
@@ -39,11 +39,14 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <errno.h>
 #include <assert.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 
 #include "sched/sched.h"
 
@@ -53,10 +56,13 @@
  * Pre-processor Definitions
  ****************************************************************************/
 /* Are we using the system timer, or an external clock?  Get the rate
- * of the sampling in ticks per second for the selected timer.
+ * of the sampling in ticks per second for the selected timer.  With
+ * precise accounting, the rate is that of the performance counter.
  */
 
-#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+#if defined(CONFIG_SCHED_CPULOAD_PRECISE)
+#  define CPULOAD_TICKSPERSEC ((uint64_t)up_perf_getfreq())
+#elif defined(CONFIG_SCHED_CPULOAD_EXTCLK)
 #  ifndef CONFIG_SCHED_CPULOAD_TICKSPERSEC
 #    error CONFIG_SCHED_CPULOAD_TICKSPERSEC is not defined
 #  endif
@@ -81,8 +87,37 @@
       CPULOAD_TICKSPERSEC)
 #endif
 
+#ifdef CONFIG_SMP
+#  define CPULOAD_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define CPULOAD_NCPUS 1
+#endif
+
+/* With precise accounting, the counts that elapsed on every CPU are charged
+ * from the system timer at least every CPULOAD_FOLD_COUNTS counts.  That is
+ * half of the wrap period of the 32-bit performance counter, leaving margin
+ * for a late timer.
+ */
+
+#define CPULOAD_FOLD_COUNTS (UINT32_MAX >> 1)
+
 /****************************************************************************
- * Private Data
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+/* This structure holds the precise accounting state of one CPU */
+
+struct cpuload_cpu_s
+{
+  uint32_t stamp;              /* Counter value at the last accounting */
+  uint16_t irqnest;            /* Interrupt handler nesting level */
+  uint64_t irqtime;            /* Counts spent in interrupt handlers */
+};
+#endif
+
+/****************************************************************************
+ * Public Data
  ****************************************************************************/
 
 /* This is the total number of clock tick counts.  Essentially the
@@ -96,14 +131,148 @@
  * incremented for each CPU on each sample interval. So, as an example, if
  * there are four CPUs and is nothing is running but the IDLE threads, then
  * each would have a load of 25% of the total.
+ *
+ * With precise accounting, this is instead the number of performance
+ * counter counts that have elapsed on all CPUs, including the time spent
+ * in interrupt handlers.
  */
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+volatile uint64_t g_cpuload_total;
+#else
 volatile uint32_t g_cpuload_total;
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+/* The precise accounting state of each CPU */
+
+static struct cpuload_cpu_s g_cpuload_cpu[CPULOAD_NCPUS];
+
+/* The counter value when sched_cpuload_process() last charged all CPUs */
+
+static uint32_t g_cpuload_fold;
+
+#ifdef CONFIG_SMP
+/* Interrupt handlers on other CPUs update the accounting data without
+ * taking the critical section.  This lock protects the accounting data.
+ */
+
+static volatile spinlock_t g_cpuload_lock SP_SECTION = SP_UNLOCKED;
+#endif
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+/****************************************************************************
+ * Name: cpuload_charge
+ *
+ * Description:
+ *   Charge the counts that elapsed on a CPU since its last accounting to
+ *   the interrupt time of the CPU, if it is in an interrupt handler, or to
+ *   the thread that is running on it.
+ *
+ *   The performance counters of all CPUs are assumed to be synchronized so
+ *   that the current task of another CPU can be charged, too.
+ *
+ * Inputs:
+ *   cpu - The CPU to be charged.
+ *   tcb - The thread that has been running on the CPU.
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   Called with g_cpuload_lock held and local interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void cpuload_charge(int cpu, FAR struct tcb_s *tcb)
+{
+  FAR struct cpuload_cpu_s *cpuload = &g_cpuload_cpu[cpu];
+  uint32_t now = up_perf_gettime();
+  uint32_t elapsed = now - cpuload->stamp;
+  int hash_index;
+  int i;
+
+  cpuload->stamp = now;
+
+  if (cpuload->irqnest > 0)
+    {
+      cpuload->irqtime += elapsed;
+    }
+  else
+    {
+      hash_index = PIDHASH(tcb->pid);
+      g_pidhash[hash_index].ticks   += elapsed;
+      g_pidhash[hash_index].runtime += elapsed;
+    }
+
+  g_cpuload_total += elapsed;
+
+  /* If the accumulated count exceeds the time constant, then divide the
+   * count of every task and the total by two.  The interrupt time is
+   * included only in the total so the total is not recalculated from the
+   * task counts.
+   */
+
+  if (g_cpuload_total > CPULOAD_TIMECONSTANT)
+    {
+      for (i = 0; i < CONFIG_MAX_TASKS; i++)
+        {
+          g_pidhash[i].ticks >>= 1;
+        }
+
+      g_cpuload_total >>= 1;
+    }
+}
+
+/****************************************************************************
+ * Name: cpuload_update
+ *
+ * Description:
+ *   Bring the accounting data of all CPUs up to date so that the time of
+ *   the threads that are running now is included.
+ *
+ * Assumptions/Limitations:
+ *   Called with g_cpuload_lock held and local interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void cpuload_update(void)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < CPULOAD_NCPUS; cpu++)
+    {
+      cpuload_charge(cpu, current_task(cpu));
+    }
+}
+
+/****************************************************************************
+ * Name: cpuload_usec
+ *
+ * Description:
+ *   Convert a number of performance counter counts to microseconds.
+ *
+ ****************************************************************************/
+
+static uint64_t cpuload_usec(uint64_t counts)
+{
+  uint32_t freq = up_perf_getfreq();
+
+  return (counts / freq) * USEC_PER_SEC +
+         ((counts % freq) * USEC_PER_SEC) / freq;
+}
+
+#else /* CONFIG_SCHED_CPULOAD_PRECISE */
+
 /****************************************************************************
  * Name: sched_cpu_process_cpuload
  *
@@ -145,11 +314,173 @@ static inline void sched_cpu_process_cpuload(int cpu)
 
   g_cpuload_total++;
 }
+#endif /* CONFIG_SCHED_CPULOAD_PRECISE */
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+/****************************************************************************
+ * Name: sched_cpuload_suspend
+ *
+ * Description:
+ *   Called by sched_suspend_scheduler() when a thread is suspended on this
+ *   CPU.  Charge the time since the thread was resumed to the thread.
+ *
+ * Inputs:
+ *   tcb - The TCB of the thread that is being suspended.
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_cpuload_suspend(FAR struct tcb_s *tcb)
+{
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_cpuload_lock);
+  cpuload_charge(this_cpu(), tcb);
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+}
+
+/****************************************************************************
+ * Name: sched_cpuload_resume
+ *
+ * Description:
+ *   Called by sched_resume_scheduler() when a thread is resumed on this
+ *   CPU.  The run time of the thread starts now.  The time since the
+ *   previous thread was suspended is context switch overhead (or the last
+ *   moments of a thread that exited) and is not charged to anyone.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_cpuload_resume(void)
+{
+  FAR struct cpuload_cpu_s *cpuload;
+  irqstate_t flags;
+
+  flags   = spin_lock_irqsave(&g_cpuload_lock);
+  cpuload = &g_cpuload_cpu[this_cpu()];
+
+  /* If the thread is resumed by an interrupt handler, then the time until
+   * the handler returns is still interrupt time.
+   */
+
+  if (cpuload->irqnest == 0)
+    {
+      cpuload->stamp = up_perf_gettime();
+    }
+
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+}
+
+/****************************************************************************
+ * Name: sched_cpuload_irqenter and sched_cpuload_irqleave
+ *
+ * Description:
+ *   Called by irq_dispatch() before and after an interrupt handler runs.
+ *   The time until the outermost handler returns is charged to the CPU
+ *   rather than to the interrupted thread.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions/Limitations:
+ *   Called from interrupt handling logic with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_cpuload_irqenter(void)
+{
+  irqstate_t flags;
+  int cpu;
+
+  flags = spin_lock_irqsave(&g_cpuload_lock);
+  cpu   = this_cpu();
+
+  if (g_cpuload_cpu[cpu].irqnest++ == 0)
+    {
+      cpuload_charge(cpu, current_task(cpu));
+    }
+
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+}
+
+void sched_cpuload_irqleave(void)
+{
+  irqstate_t flags;
+  int cpu;
+
+  flags = spin_lock_irqsave(&g_cpuload_lock);
+  cpu   = this_cpu();
+
+  DEBUGASSERT(g_cpuload_cpu[cpu].irqnest > 0);
+  if (g_cpuload_cpu[cpu].irqnest == 1)
+    {
+      cpuload_charge(cpu, current_task(cpu));
+    }
+
+  g_cpuload_cpu[cpu].irqnest--;
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+}
+
+/****************************************************************************
+ * Name: sched_cpuload_process
+ *
+ * Description:
+ *   Called from the system timer logic.  A CPU may run one thread, or sleep
+ *   in its IDLE thread, for longer than the wrap period of the performance
+ *   counter.  Every CPULOAD_FOLD_COUNTS counts, the time that elapsed on
+ *   each CPU is charged so that no elapsed count is lost to a wrap.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   The number of system ticks until the next charge is due.  In tickless
+ *   mode, the next timer interval must not be longer than this.
+ *
+ * Assumptions/Limitations:
+ *   This function is called from a timer interrupt handler with all
+ *   interrupts disabled.
+ *
+ ****************************************************************************/
+
+unsigned int sched_cpuload_process(void)
+{
+  irqstate_t flags;
+  uint32_t elapsed;
+  uint64_t ticks;
+
+  flags   = spin_lock_irqsave(&g_cpuload_lock);
+  elapsed = up_perf_gettime() - g_cpuload_fold;
+
+  if (elapsed >= CPULOAD_FOLD_COUNTS)
+    {
+      cpuload_update();
+      g_cpuload_fold = g_cpuload_cpu[this_cpu()].stamp;
+      elapsed        = 0;
+    }
+
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+
+  ticks = cpuload_usec(CPULOAD_FOLD_COUNTS - elapsed) / USEC_PER_TICK;
+  return ticks > 0 ? (unsigned int)ticks : 1;
+}
+
+#else /* CONFIG_SCHED_CPULOAD_PRECISE */
+
 /****************************************************************************
  * Name: sched_process_cpuload
  *
@@ -217,6 +548,7 @@ void weak_function sched_process_cpuload(void)
   leave_critical_section(flags);
 #endif
 }
+#endif /* CONFIG_SCHED_CPULOAD_PRECISE */
 
 /****************************************************************************
  * Name:  clock_cpuload
@@ -267,8 +599,35 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
 
   if (g_pidhash[hash_index].tcb && g_pidhash[hash_index].pid == pid)
     {
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+      irqstate_t lflags;
+      uint64_t total;
+      uint64_t active;
+
+      /* Include the time of the threads that are running now */
+
+      lflags = spin_lock_irqsave(&g_cpuload_lock);
+      cpuload_update();
+
+      total  = g_cpuload_total;
+      active = g_pidhash[hash_index].ticks;
+      cpuload->runtime = cpuload_usec(g_pidhash[hash_index].runtime);
+      spin_unlock_irqrestore(&g_cpuload_lock, lflags);
+
+      /* The counts may exceed 32 bits.  Only their ratio is meaningful. */
+
+      while (total > UINT32_MAX)
+        {
+          total  >>= 1;
+          active >>= 1;
+        }
+
+      cpuload->total  = (uint32_t)total;
+      cpuload->active = (uint32_t)active;
+#else
       cpuload->total  = g_cpuload_total;
       cpuload->active = g_pidhash[hash_index].ticks;
+#endif
       ret = OK;
     }
 
@@ -276,4 +635,50 @@ int clock_cpuload(int pid, FAR struct cpuload_s *cpuload)
   return ret;
 }
 
+/****************************************************************************
+ * Name:  clock_cpustat
+ *
+ * Description:
+ *   Return the time that the selected CPU has spent in its IDLE thread and
+ *   in interrupt handlers.
+ *
+ * Parameters:
+ *   cpu - The index of the CPU of interest.
+ *   cpustat - The location to return the CPU times
+ *
+ * Return Value:
+ *   OK (0) on success; a negated errno value on failure.  The only reason
+ *   that this function can fail is if 'cpu' is not a valid CPU index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+int clock_cpustat(int cpu, FAR struct cpustat_s *cpustat)
+{
+  irqstate_t flags;
+  uint64_t idle;
+  uint64_t irq;
+
+  DEBUGASSERT(cpustat);
+
+  if (cpu < 0 || cpu >= CPULOAD_NCPUS)
+    {
+      return -EINVAL;
+    }
+
+  /* The IDLE thread of each CPU has the PID of the CPU index */
+
+  flags = spin_lock_irqsave(&g_cpuload_lock);
+  cpuload_update();
+
+  idle  = g_pidhash[PIDHASH(cpu)].runtime;
+  irq   = g_cpuload_cpu[cpu].irqtime;
+  spin_unlock_irqrestore(&g_cpuload_lock, flags);
+
+  cpustat->idle = cpuload_usec(idle);
+  cpustat->irq  = cpuload_usec(irq);
+  return OK;
+}
+#endif
+
 #endif /* CONFIG_SCHED_CPULOAD */
@@ -63,7 +63,8 @@
  *
  * Description:
  *   Return the index to the CPU with the lowest priority running task,
- *   possbily its IDLE task.
+ *   possbily its IDLE task.  Among deadline tasks of the same priority,
+ *   the one with the latest deadline is the lowest priority task.
  *
  * Inputs:
  *   affinity - The set of CPUs on which the thread is permitted to run.
@@ -78,7 +79,7 @@
 
 int sched_cpu_select(cpu_set_t affinity)
 {
-  uint8_t minprio;
+  FAR struct tcb_s *mintcb;
   int cpu;
   int i;
 
@@ -86,8 +87,8 @@ int sched_cpu_select(cpu_set_t affinity)
    * (possibly its IDLE task).
    */
 
-  minprio = SCHED_PRIORITY_MAX;
-  cpu     = IMPOSSIBLE_CPU;
+  mintcb = NULL;
+  cpu    = IMPOSSIBLE_CPU;
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
@@ -110,10 +111,13 @@ int sched_cpu_select(cpu_set_t affinity)
               DEBUGASSERT(rtcb->sched_priority == 0);
               return i;
             }
-          else if (rtcb->sched_priority < minprio)
+          else if (mintcb == NULL ||
+                   rtcb->sched_priority < mintcb->sched_priority ||
+                   sched_deadline_before(mintcb, rtcb))
             {
               DEBUGASSERT(rtcb->sched_priority > 0);
-              cpu = i;
+              mintcb = rtcb;
+              cpu    = i;
             }
         }
     }
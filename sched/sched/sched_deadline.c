@@ -0,0 +1,414 @@
+/****************************************************************************
+ * sched/sched/sched_deadline.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched_note.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_DEADLINE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) (((a) < (b)) ? (a) : (b))
+#endif
+
+#ifdef CONFIG_SMP
+#  define DEADLINE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define DEADLINE_NCPUS 1
+#endif
+
+/* Bandwidths (runtime/period) are kept as fixed point fractions with
+ * DEADLINE_BW_SHIFT fractional bits.  DEADLINE_BW_LIMIT is the admission
+ * control limit for the sum of the bandwidths of all deadline threads.
+ */
+
+#define DEADLINE_BW_SHIFT  16
+#define DEADLINE_BW_LIMIT \
+  ((((uint32_t)CONFIG_SCHED_DEADLINE_MAXUTIL << DEADLINE_BW_SHIFT) / 100) * \
+   DEADLINE_NCPUS)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The sum of the bandwidths reserved by all deadline threads */
+
+static uint32_t g_deadline_bw;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_release
+ *
+ * Description:
+ *   Start a new job:  The absolute deadline is set one relative deadline
+ *   from now and the full runtime budget is granted.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the deadline thread
+ *   now - The current system time
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void deadline_release(FAR struct tcb_s *tcb, systime_t now)
+{
+  FAR struct deadline_s *dl = tcb->deadline;
+
+  dl->absdeadline = now + dl->deadline;
+  tcb->timeslice  = dl->runtime;
+
+  sched_note_deadline(tcb, false);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_deadline_start
+ *
+ * Description:
+ *   Assign or change the deadline scheduling parameters of a thread.  The
+ *   request is subject to admission control:  It is refused if the total
+ *   bandwidth reserved by all deadline threads would exceed
+ *   CONFIG_SCHED_DEADLINE_MAXUTIL.  On success, a new job is released
+ *   immediately.
+ *
+ * Input Parameters:
+ *   tcb      - The TCB of the thread
+ *   runtime  - The execution budget per period in clock ticks
+ *   deadline - The relative deadline in clock ticks
+ *   period   - The activation period in clock ticks
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure:
+ *
+ *   EINVAL - The parameters do not satisfy 0 < runtime <= deadline <=
+ *            period.
+ *   EBUSY  - Admission control refused the reservation.
+ *   ENOMEM - The deadline data structure could not be allocated.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *
+ ****************************************************************************/
+
+int sched_deadline_start(FAR struct tcb_s *tcb, uint32_t runtime,
+                         uint32_t deadline, uint32_t period)
+{
+  FAR struct deadline_s *dl;
+  uint32_t oldbw;
+  uint32_t newbw;
+
+  DEBUGASSERT(tcb != NULL);
+
+  if (runtime < 1 || runtime > deadline || deadline > period)
+    {
+      return -EINVAL;
+    }
+
+  /* Admission control.  A thread that is already a deadline thread gives
+   * back its current reservation first.
+   */
+
+  dl    = tcb->deadline;
+  oldbw = (dl != NULL) ? dl->bandwidth : 0;
+  newbw = (uint32_t)(((uint64_t)runtime << DEADLINE_BW_SHIFT) / period);
+
+  if (newbw < 1)
+    {
+      newbw = 1;
+    }
+
+  if (g_deadline_bw - oldbw + newbw > DEADLINE_BW_LIMIT)
+    {
+      return -EBUSY;
+    }
+
+  /* Allocate the deadline add-on data structure if this thread does not
+   * already have one.
+   */
+
+  if (dl == NULL)
+    {
+      dl = (FAR struct deadline_s *)kmm_zalloc(sizeof(struct deadline_s));
+      if (dl == NULL)
+        {
+          serr("ERROR: Failed to allocate deadline data structure\n");
+          return -ENOMEM;
+        }
+
+      tcb->deadline = dl;
+    }
+
+  g_deadline_bw = g_deadline_bw - oldbw + newbw;
+
+  dl->runtime   = runtime;
+  dl->deadline  = deadline;
+  dl->period    = period;
+  dl->bandwidth = newbw;
+
+  deadline_release(tcb, clock_systimer());
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sched_deadline_stop
+ *
+ * Description:
+ *   Called to terminate deadline scheduling on a given thread, either
+ *   because it switches to another policy or because it is being deleted.
+ *   Its bandwidth is returned to admission control.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or a negated errno value on failure.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The thread is currently using the deadline scheduling policy.
+ *
+ ****************************************************************************/
+
+int sched_deadline_stop(FAR struct tcb_s *tcb)
+{
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+  DEBUGASSERT(g_deadline_bw >= tcb->deadline->bandwidth);
+
+  g_deadline_bw -= tcb->deadline->bandwidth;
+
+  sched_kfree(tcb->deadline);
+  tcb->deadline = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sched_deadline_wakeup
+ *
+ * Description:
+ *   Called when a deadline thread leaves the blocked state.  This applies
+ *   the constant bandwidth server wake-up rule:  The current job continues
+ *   with its remaining budget and deadline only if doing so would not use
+ *   more than the reserved bandwidth before that deadline.  Otherwise, a
+ *   new job is released.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the thread that is becoming ready-to-run
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *
+ ****************************************************************************/
+
+void sched_deadline_wakeup(FAR struct tcb_s *tcb)
+{
+  FAR struct deadline_s *dl;
+  systime_t now;
+  ssystime_t laxity;
+
+  if (!sched_isdeadline(tcb))
+    {
+      return;
+    }
+
+  dl     = tcb->deadline;
+  DEBUGASSERT(dl != NULL);
+
+  now    = clock_systimer();
+  laxity = (ssystime_t)(dl->absdeadline - now);
+
+  /* Keep the current job if remaining / laxity <= runtime / deadline */
+
+  if (laxity <= 0 || tcb->timeslice <= 0 ||
+      (uint64_t)tcb->timeslice * dl->deadline >
+      (uint64_t)dl->runtime * (uint64_t)laxity)
+    {
+      deadline_release(tcb, now);
+    }
+}
+
+/****************************************************************************
+ * Name: sched_deadline_requeue
+ *
+ * Description:
+ *   Move the running deadline thread behind the ready-to-run deadline
+ *   threads of its priority band that now have an earlier deadline.  This
+ *   is needed after the deadline of the running thread was postponed.
+ *
+ *   In the SMP case, the threads that may take over this CPU are either
+ *   assigned to it, following the running thread, or waiting in the
+ *   g_readytorun list.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the currently executing thread
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - Pre-emption is not locked
+ *
+ ****************************************************************************/
+
+void sched_deadline_requeue(FAR struct tcb_s *tcb)
+{
+  FAR struct tcb_s *next = (FAR struct tcb_s *)tcb->flink;
+
+#ifdef CONFIG_SMP
+  if (next == NULL || !sched_deadline_before(next, tcb))
+    {
+      for (next = (FAR struct tcb_s *)g_readytorun.head;
+           next != NULL && next->sched_priority >= tcb->sched_priority;
+           next = (FAR struct tcb_s *)next->flink)
+        {
+          if (CPU_ISSET(tcb->cpu, &next->affinity) &&
+              sched_deadline_before(next, tcb))
+            {
+              break;
+            }
+        }
+    }
+#endif
+
+  if (next != NULL && sched_deadline_before(next, tcb))
+    {
+      /* Re-insert the TCB in the ready-to-run list in deadline order */
+
+      sched_requeue(tcb);
+    }
+}
+
+/****************************************************************************
+ * Name: sched_deadline_process
+ *
+ * Description:
+ *   Charge the execution time of the currently executing deadline thread
+ *   against its budget.  When the budget is exhausted, the deadline of the
+ *   job is postponed by one period and the budget is replenished (the
+ *   constant bandwidth server rule).  The thread may then no longer have
+ *   the earliest deadline in its band and be preempted.
+ *
+ * Input Parameters:
+ *   tcb        - The TCB of the currently executing task
+ *   ticks      - The number of ticks that have elapsed on the interval
+ *                timer.
+ *   noswitches - True: Can't do context switches now.
+ *
+ * Returned Value:
+ *   The number if ticks remaining until the budget expires.
+ *
+ *   The value one may returned if the budget expired but noswitches is
+ *   true.  The value one is the minimal timer setup and it means that the
+ *   budget will be handled as soon as possible in the normal timer
+ *   expiration context.
+ *
+ * Assumptions:
+ *   - Interrupts are disabled
+ *   - The task associated with TCB uses the deadline scheduling policy
+ *
+ ****************************************************************************/
+
+uint32_t sched_deadline_process(FAR struct tcb_s *tcb, uint32_t ticks,
+                                bool noswitches)
+{
+  FAR struct deadline_s *dl;
+  int32_t decr;
+
+  DEBUGASSERT(tcb != NULL && tcb->deadline != NULL);
+  dl = tcb->deadline;
+
+  /* Charge the elapsed time against the remaining budget */
+
+  decr = MIN(tcb->timeslice, (int32_t)ticks);
+  tcb->timeslice -= decr;
+
+  if (tcb->timeslice <= 0)
+    {
+      if (noswitches)
+        {
+          return 1;
+        }
+
+      /* Overrun:  Postpone the deadline and replenish the budget */
+
+      dl->absdeadline += dl->period;
+      tcb->timeslice   = dl->runtime;
+
+      sched_note_deadline(tcb, true);
+
+      /* If pre-emption is locked, then sched_unlock() will re-queue the
+       * thread when the lock is released.
+       */
+
+      if (!sched_islocked(tcb))
+        {
+          sched_deadline_requeue(tcb);
+        }
+    }
+
+  return tcb->timeslice;
+}
+
+#endif /* CONFIG_SCHED_DEADLINE */
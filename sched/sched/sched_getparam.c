@@ -45,6 +45,46 @@
 #include "clock/clock.h"
 #include "sched/sched.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_getdeadline
+ *
+ * Description:
+ *   Return the SCHED_DEADLINE parameters of a thread, or zero if the thread
+ *   does not use the deadline scheduling policy.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_DEADLINE
+static void sched_getdeadline(FAR struct tcb_s *tcb,
+                              FAR struct sched_param *param)
+{
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      FAR struct deadline_s *dl = tcb->deadline;
+      DEBUGASSERT(dl != NULL);
+
+      clock_ticks2time((ssystime_t)dl->runtime, &param->sched_dl_runtime);
+      clock_ticks2time((ssystime_t)dl->deadline, &param->sched_dl_deadline);
+      clock_ticks2time((ssystime_t)dl->period, &param->sched_dl_period);
+    }
+  else
+    {
+      param->sched_dl_runtime.tv_sec   = 0;
+      param->sched_dl_runtime.tv_nsec  = 0;
+      param->sched_dl_deadline.tv_sec  = 0;
+      param->sched_dl_deadline.tv_nsec = 0;
+      param->sched_dl_period.tv_sec    = 0;
+      param->sched_dl_period.tv_nsec   = 0;
+    }
+}
+#else
+#  define sched_getdeadline(t,p)
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -92,6 +132,7 @@ int sched_getparam (pid_t pid, FAR struct sched_param *param)
       /* Return the priority if the calling task. */
 
       param->sched_priority = (int)rtcb->sched_priority;
+      sched_getdeadline(rtcb, param);
     }
 
   /* Ths pid is not for the calling task, we will have to look it up */
@@ -142,6 +183,8 @@ int sched_getparam (pid_t pid, FAR struct sched_param *param)
               param->sched_ss_init_budget.tv_nsec = 0;
             }
 #endif
+
+          sched_getdeadline(tcb, param);
         }
 
       sched_unlock();
@@ -115,7 +115,8 @@ bool sched_mergepending(void)
        */
 
       for (;
-           (rtcb && ptcb->sched_priority <= rtcb->sched_priority);
+           (rtcb && ptcb->sched_priority <= rtcb->sched_priority &&
+            !sched_deadline_before(ptcb, rtcb));
            rtcb = rtcb->flink);
 
       /* Add the ptcb to the spot found in the list.  Check if the
@@ -152,6 +153,10 @@ bool sched_mergepending(void)
           ptcb->task_state  = TSTATE_TASK_READYTORUN;
         }
 
+      /* ptcb is the last TCB of its priority in the ready-to-run list */
+
+      sched_prioindex_add(ptcb, (FAR dq_queue_t *)&g_readytorun);
+
       /* Set up for the next time through */
 
       rtcb = ptcb;
@@ -161,6 +166,7 @@ bool sched_mergepending(void)
 
   g_pendingtasks.head = NULL;
   g_pendingtasks.tail = NULL;
+  sched_prioindex_rebuild((FAR dq_queue_t *)&g_pendingtasks);
 
   return ret;
 }
@@ -194,7 +200,6 @@ bool sched_mergepending(void)
 {
   FAR struct tcb_s *rtcb;
   FAR struct tcb_s *ptcb;
-  FAR struct tcb_s *tcb;
   bool ret = false;
   int cpu;
   int me;
@@ -230,16 +235,16 @@ bool sched_mergepending(void)
        * end up in the g_readytorun list.
        */
 
-      while (ptcb->sched_priority > rtcb->sched_priority)
+      while (ptcb->sched_priority > rtcb->sched_priority ||
+             sched_deadline_before(ptcb, rtcb))
         {
           /* Remove the task from the pending task list */
 
-          tcb = (FAR struct tcb_s *)dq_remfirst((FAR dq_queue_t *)&g_pendingtasks);
-          DEBUGASSERT(tcb == ptcb);
+          sched_remprioritized(ptcb, (FAR dq_queue_t *)&g_pendingtasks);
 
           /* Add the pending task to the correct ready-to-run list. */
 
-          ret |= sched_addreadytorun(tcb);
+          ret |= sched_addreadytorun(ptcb);
 
           /* This operation could cause the scheduler to become locked.
            * Check if that happened.
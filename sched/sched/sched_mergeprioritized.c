@@ -91,6 +91,7 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
    */
 
   dq_move(list1, &clone);
+  sched_prioindex_rebuild(list1);
 
   /* Get the TCB at the head of list1 */
 
@@ -122,6 +123,7 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       /* Special case.. list2 is empty.  Move list1 to list2. */
 
       dq_move(&clone, list2);
+      sched_prioindex_rebuild(list2);
       return;
     }
 
@@ -146,7 +148,8 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
 
       /* Which TCB has higher priority? */
 
-      else if (tcb1->sched_priority > tcb2->sched_priority)
+      else if (tcb1->sched_priority > tcb2->sched_priority ||
+               sched_deadline_before(tcb1, tcb2))
         {
           /* The TCB from list1 has higher priority than the TCB from list2.
            * Remove the TCB from list1 and insert it before the TCB from
@@ -171,4 +174,10 @@ void sched_mergeprioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
         }
     }
   while (tcb1 != NULL);
+
+  /* The merge has already visited most of list2 so the cost of recreating
+   * its priority index is comparable.
+   */
+
+  sched_prioindex_rebuild(list2);
 }
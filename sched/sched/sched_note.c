@@ -45,7 +45,10 @@
 #include <errno.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/clock.h>
+#include <nuttx/atomic.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
 
@@ -57,15 +60,39 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Each CPU adds notes to its own circular buffer of 32-bit words.  Each
+ * note begins on a word boundary.
+ */
+
+#ifdef CONFIG_SMP
+#  define NOTE_NCPUS    CONFIG_SMP_NCPUS
+#else
+#  define NOTE_NCPUS    1
+#endif
+
+#define NOTE_BUFWORDS   (CONFIG_SCHED_NOTE_BUFSIZE / 4)
+#define NOTE_WORDS(n)   (((uint32_t)(n) + 3) >> 2)
+
+/* The head and tail indices count words from 0 up to NOTE_NDXWRAP - 1,
+ * the largest multiple of the buffer size that fits in 32 bits.  Because
+ * the indices almost never repeat, a reader can tell reliably whether the
+ * tail was moved while it was copying notes.
+ */
+
+#define NOTE_NDXWRAP    ((UINT32_MAX / NOTE_BUFWORDS) * NOTE_BUFWORDS)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
 struct note_info_s
 {
-  volatile unsigned int ni_head;
-  volatile unsigned int ni_tail;
-  uint8_t ni_buffer[CONFIG_SCHED_NOTE_BUFSIZE];
+  uint32_t ni_head;             /* Index where the next note is added */
+  uint32_t ni_tail;             /* Index of the oldest note */
+#if defined(CONFIG_SMP) && !defined(CONFIG_ARCH_HAVE_ATOMICS)
+  volatile spinlock_t ni_lock;  /* Serializes updates of ni_tail */
+#endif
+  uint32_t ni_buffer[NOTE_BUFWORDS];
 };
 
 struct note_startalloc_s
@@ -92,38 +119,182 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen);
  * Private Data
  ****************************************************************************/
 
-static struct note_info_s g_note_info;
+static struct note_info_s g_note_info[NOTE_NCPUS];
+
+#ifdef CONFIG_SCHED_NOTE_GET
+/* The CPU buffer that the next read starts with */
+
+static unsigned int g_note_nextcpu;
+#endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: note_next
+ * Name: note_load, note_store, note_cmpxchg
  *
  * Description:
- *   Return the circular buffer index at offset from the specified index
- *   value, handling wraparound
+ *   Access the indices of a note buffer.  note_load() orders the following
+ *   accesses to the buffer after the load of the index; note_store()
+ *   orders the preceding accesses to the buffer before the store.
+ *   note_cmpxchg() sets the tail index to 'newtail' only if it still holds
+ *   'oldtail'.
  *
- * Input Parameters:
- *   ndx - Old circular buffer index
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_ATOMICS
+#  define note_load(p)    atomic_read_acquire(p)
+#  define note_store(p,v) atomic_set_release(p,v)
+#else
+static inline uint32_t note_load(FAR uint32_t *ndx)
+{
+  uint32_t value = *(FAR volatile uint32_t *)ndx;
+
+#ifdef CONFIG_SMP
+  SP_DMB();
+#endif
+  return value;
+}
+
+static inline void note_store(FAR uint32_t *ndx, uint32_t value)
+{
+#ifdef CONFIG_SMP
+  SP_DMB();
+#endif
+  *(FAR volatile uint32_t *)ndx = value;
+}
+#endif
+
+static inline bool note_cmpxchg(FAR struct note_info_s *info,
+                                uint32_t oldtail, uint32_t newtail)
+{
+#ifdef CONFIG_ARCH_HAVE_ATOMICS
+  return atomic_cmpxchg(&info->ni_tail, oldtail, newtail);
+#else
+  irqstate_t flags;
+  bool ret = false;
+
+  /* The raw test-and-set is used because spin_lock() would itself add a
+   * note when spinlocks are instrumented.
+   */
+
+  flags = up_irq_save();
+#ifdef CONFIG_SMP
+  while (up_testset(&info->ni_lock) == SP_LOCKED)
+    {
+      SP_DSB();
+    }
+
+  SP_DMB();
+#endif
+
+  if (info->ni_tail == oldtail)
+    {
+      info->ni_tail = newtail;
+      ret = true;
+    }
+
+#ifdef CONFIG_SMP
+  SP_DMB();
+  info->ni_lock = SP_UNLOCKED;
+#endif
+  up_irq_restore(flags);
+  return ret;
+#endif
+}
+
+/****************************************************************************
+ * Name: note_advance, note_count, note_offset
  *
- * Returned Value:
- *   New circular buffer index
+ * Description:
+ *   Index arithmetic:  Advance an index by 'nwords', return the number of
+ *   words between two indices and convert an index to a word offset in
+ *   the buffer.
  *
  ****************************************************************************/
 
-static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
+static inline uint32_t note_advance(uint32_t ndx, uint32_t nwords)
+{
+  return ndx < NOTE_NDXWRAP - nwords ? ndx + nwords :
+         ndx + nwords - NOTE_NDXWRAP;
+}
+
+static inline uint32_t note_count(uint32_t head, uint32_t tail)
+{
+  return head >= tail ? head - tail : head + (NOTE_NDXWRAP - tail);
+}
+
+static inline unsigned int note_offset(uint32_t ndx)
 {
-  ndx += offset;
-  if (ndx >= CONFIG_SCHED_NOTE_BUFSIZE)
+  return ndx % NOTE_BUFWORDS;
+}
+
+/****************************************************************************
+ * Name: note_length
+ *
+ * Description:
+ *   Return the length in bytes of the note at index 'ndx'.
+ *
+ ****************************************************************************/
+
+static inline unsigned int note_length(FAR struct note_info_s *info,
+                                       uint32_t ndx)
+{
+  FAR struct note_common_s *note =
+    (FAR struct note_common_s *)&info->ni_buffer[note_offset(ndx)];
+
+  return note->nc_length;
+}
+
+/****************************************************************************
+ * Name: note_copyin, note_copyout
+ *
+ * Description:
+ *   Copy a note to or from the buffer starting at index 'ndx'.  The note
+ *   is copied with at most two memcpy() calls, one on each side of the
+ *   end of the buffer.
+ *
+ ****************************************************************************/
+
+static void note_copyin(FAR struct note_info_s *info, uint32_t ndx,
+                        FAR const uint8_t *note, unsigned int notelen)
+{
+  unsigned int offset = note_offset(ndx);
+  unsigned int nbytes = (NOTE_BUFWORDS - offset) << 2;
+
+  if (nbytes > notelen)
     {
-      ndx -= CONFIG_SCHED_NOTE_BUFSIZE;
+      nbytes = notelen;
     }
 
-  return ndx;
+  memcpy(&info->ni_buffer[offset], note, nbytes);
+  if (nbytes < notelen)
+    {
+      memcpy(info->ni_buffer, note + nbytes, notelen - nbytes);
+    }
 }
 
+#ifdef CONFIG_SCHED_NOTE_GET
+static void note_copyout(FAR struct note_info_s *info, uint32_t ndx,
+                         FAR uint8_t *buffer, unsigned int notelen)
+{
+  unsigned int offset = note_offset(ndx);
+  unsigned int nbytes = (NOTE_BUFWORDS - offset) << 2;
+
+  if (nbytes > notelen)
+    {
+      nbytes = notelen;
+    }
+
+  memcpy(buffer, &info->ni_buffer[offset], nbytes);
+  if (nbytes < notelen)
+    {
+      memcpy(buffer + nbytes, info->ni_buffer, notelen - nbytes);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: note_common
  *
@@ -144,7 +315,11 @@ static inline unsigned int note_next(unsigned int ndx, unsigned int offset)
 static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
                         uint8_t length, uint8_t type)
 {
+#ifdef CONFIG_SCHED_NOTE_HIRES
+  uint32_t systime    = up_perf_gettime();
+#else
   uint32_t systime    = (uint32_t)clock_systimer();
+#endif
 
   /* Save all of the common fields */
 
@@ -157,7 +332,7 @@ static void note_common(FAR struct tcb_s *tcb, FAR struct note_common_s *note,
   note->nc_pid[0]     = (uint8_t)(tcb->pid & 0xff);
   note->nc_pid[1]     = (uint8_t)((tcb->pid >> 8) & 0xff);
 
-  /* Save the LS 32-bits of the system timer in little endian order */
+  /* Save the LS 32-bits of the timestamp in little endian order */
 
   note->nc_systime[0] = (uint8_t)( systime        & 0xff);
   note->nc_systime[1] = (uint8_t)((systime >> 8)  & 0xff);
@@ -199,153 +374,195 @@ void note_spincommon(FAR struct tcb_s *tcb, FAR volatile spinlock_t *spinlock,
 #endif
 
 /****************************************************************************
- * Name: note_length
+ * Name: note_add
  *
  * Description:
- *   Length of data currently in circular buffer.
+ *   Add the variable length note to the head of the circular buffer of
+ *   this CPU.  If the buffer is full, the oldest notes are discarded.
  *
  * Input Parameters:
- *   None
- *
- * Returned Value:
- *   Length of data currently in circular buffer.
- *
- ****************************************************************************/
-
-static unsigned int note_length(void)
-{
-  unsigned int head = g_note_info.ni_head;
-  unsigned int tail = g_note_info.ni_tail;
-
-  if (tail > head)
-    {
-      head += CONFIG_SCHED_NOTE_BUFSIZE;
-    }
-
-  return head - tail;
-}
-
-/****************************************************************************
- * Name: note_remove
- *
- * Description:
- *   Remove the variable length note from the tail of the circular buffer
- *
- * Input Parameters:
- *   None
+ *   note    - The note to add
+ *   notelen - The length of the note in bytes
  *
  * Returned Value:
  *   None
  *
  * Assumptions:
- *   We are within a critical section.
+ *   May be called from any context.  Only the CPU itself adds notes to
+ *   its buffer so disabling local interrupts is sufficient; readers on
+ *   other CPUs are never waited for.
  *
  ****************************************************************************/
 
-static void note_remove(void)
+static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
-  FAR struct note_common_s *note;
-  unsigned int tail;
-  unsigned int length;
+  FAR struct note_info_s *info;
+  irqstate_t flags;
+  uint32_t nwords = NOTE_WORDS(notelen);
+  uint32_t head;
+  uint32_t tail;
+
+  DEBUGASSERT(note != NULL && notelen > 0 && nwords < NOTE_BUFWORDS);
 
-  /* Get the tail index of the circular buffer */
+  flags = up_irq_save();
 
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
+#ifdef CONFIG_SMP
+  /* Ignore notes that are not in the set of monitored CPUs */
 
-  /* Get the length of the note at the tail index */
+  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << this_cpu())) == 0)
+    {
+      /* Not in the set of monitored CPUs.  Do not log the note. */
+
+      up_irq_restore(flags);
+      return;
+    }
+#endif
 
-  note   = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  length = note->nc_length;
-  DEBUGASSERT(length <= note_length());
+  info = &g_note_info[this_cpu()];
+  head = info->ni_head;
 
-  /* Increment the tail index to remove the entire note from the circular
-   * buffer.
+  /* Discard the oldest notes until there is space for the new note.  A
+   * reader may remove notes at the same time; then the exchange fails and
+   * the tail is simply examined again.
    */
 
-  g_note_info.ni_tail = note_next(tail, length);
+  for (; ; )
+    {
+      tail = note_load(&info->ni_tail);
+      if (note_count(head, tail) + nwords <= NOTE_BUFWORDS)
+        {
+          break;
+        }
+
+      (void)note_cmpxchg(info, tail,
+                         note_advance(tail,
+                                      NOTE_WORDS(note_length(info, tail))));
+    }
+
+  /* Copy the note into the buffer and then publish it */
+
+  note_copyin(info, head, note, notelen);
+  note_store(&info->ni_head, note_advance(head, nwords));
+  up_irq_restore(flags);
 }
 
 /****************************************************************************
- * Name: note_add
+ * Name: note_remove
  *
  * Description:
- *   Add the variable length note to the head of the circular buffer
+ *   Remove notes from the circular buffers of the CPUs and copy them to the
+ *   user buffer, starting with the buffer after the one read last.  The
+ *   notes of one CPU are removed with a single update of its tail index.
+ *   If the tail was moved by the CPU while the notes were being copied,
+ *   some of them may have been overwritten and the copy is repeated.
  *
  * Input Parameters:
- *   None
+ *   buffer - Location to return the notes
+ *   buflen - The length of the user provided buffer
+ *   single - True: Remove only one note
  *
  * Returned Value:
- *   None
- *
- * Assumptions:
- *   We are within a critical section.
+ *   The number of bytes returned.  Zero is returned only if all of the
+ *   circular buffers are empty.  -EFBIG is returned if the next note does
+ *   not fit into the user buffer; that note is discarded.
  *
  ****************************************************************************/
 
-static void note_add(FAR const uint8_t *note, uint8_t notelen)
+#ifdef CONFIG_SCHED_NOTE_GET
+static ssize_t note_remove(FAR uint8_t *buffer, size_t buflen, bool single)
 {
-  unsigned int head;
-  unsigned int next;
-
-#ifdef CONFIG_SMP
-  /* Ignore notes that are not in the set of monitored CPUs */
-
-  if ((CONFIG_SCHED_INSTRUMENTATION_CPUSET & (1 << this_cpu())) == 0)
-    {
-      /* Not in the set of monitored CPUs.  Do not log the note. */
-
-      return;
-    }
-#endif
-
-  /* REVISIT: In the single CPU case, the following should be safe because
-   * the logic is always called within a critical section, but in the SMP
-   * case we have protection.  One option would be to precalculate and
-   * advancing the new head entry before writing the data into the buffer.
-   * That will eliminate fatal race conditions (although could result in
-   * single notes being corrupted harmlessly).
-   *
-   * But there is a complexity: Advancing the head pointer where the note
-   * buffer is almost full could advance the head to wrap beyond the tail
-   * leaving the buffer in a bad state.  A solution to this would be to pre-
-   * remove entries at the tail of the buffer as necessary to make certain
-   * that there will be space for the new note at the beginning of the
-   * buffer.  I am less certain that this can be done safely in the SMP
-   * case.
-   */
-
-  /* Get the index to the head of the circular buffer */
-
-  DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
-
-  /* Loop until all bytes have been transferred to the circular buffer */
-
-  while (notelen > 0)
+  FAR struct note_info_s *info;
+  unsigned int start = g_note_nextcpu;
+  unsigned int notelen;
+  unsigned int cpu;
+  unsigned int i;
+  uint32_t nwords;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ndx;
+  size_t nbytes;
+  size_t nread = 0;
+
+  for (i = 0; i < NOTE_NCPUS; i++)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
+      cpu  = (start + i) % NOTE_NCPUS;
+      info = &g_note_info[cpu];
 
-      next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
+      for (; ; )
         {
-          /* Yes, then remove the note at the tail index */
-
-          note_remove();
+          tail    = note_load(&info->ni_tail);
+          head    = note_load(&info->ni_head);
+          ndx     = tail;
+          nbytes  = 0;
+          notelen = 0;
+          nwords  = 0;
+
+          /* Copy whole notes while they fit into the user buffer.  The
+           * checks on the length also stop the copy if the note was just
+           * overwritten.
+           */
+
+          while (ndx != head)
+            {
+              notelen = note_length(info, ndx);
+              nwords  = NOTE_WORDS(notelen);
+              if (notelen == 0 || nwords > note_count(head, ndx) ||
+                  notelen > buflen - nread - nbytes)
+                {
+                  break;
+                }
+
+              note_copyout(info, ndx, buffer + nread + nbytes, notelen);
+              nbytes += notelen;
+              ndx     = note_advance(ndx, nwords);
+
+              if (single)
+                {
+                  break;
+                }
+            }
+
+          if (ndx != tail)
+            {
+              /* Remove the copied notes unless the tail was moved */
+
+              if (note_cmpxchg(info, tail, ndx))
+                {
+                  break;
+                }
+
+              continue;
+            }
+
+          /* Nothing was copied.  If the buffer is not empty, the next note
+           * does not fit.  If nothing has been returned at all, discard it
+           * so that we do not get constipated.
+           */
+
+          if (ndx == head || nread > 0 || notelen == 0 ||
+              nwords > note_count(head, ndx))
+            {
+              break;
+            }
+
+          if (note_cmpxchg(info, tail, note_advance(tail, nwords)))
+            {
+              g_note_nextcpu = cpu;
+              return -EFBIG;
+            }
         }
 
-      /* Save the next byte at the head index */
-
-      g_note_info.ni_buffer[head] = *note++;
-
-      head = next;
-      notelen--;
+      nread += nbytes;
+      if (nread >= buflen || (single && nread > 0))
+        {
+          break;
+        }
     }
 
-  g_note_info.ni_head = head;
+  g_note_nextcpu = (start + i + 1) % NOTE_NCPUS;
+  return nread;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -588,11 +805,35 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 }
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_DEADLINE
+void sched_note_deadline(FAR struct tcb_s *tcb, bool overrun)
+{
+  struct note_deadline_s note;
+  uint32_t deadline = (uint32_t)tcb->deadline->absdeadline;
+
+  /* Format the note */
+
+  note_common(tcb, &note.nde_cmn, sizeof(struct note_deadline_s),
+              overrun ? NOTE_DEADLINE_OVERRUN : NOTE_DEADLINE_RELEASE);
+
+  /* Save the LS 32-bits of the deadline in little endian order */
+
+  note.nde_deadline[0] = (uint8_t)( deadline        & 0xff);
+  note.nde_deadline[1] = (uint8_t)((deadline >> 8)  & 0xff);
+  note.nde_deadline[2] = (uint8_t)((deadline >> 16) & 0xff);
+  note.nde_deadline[3] = (uint8_t)((deadline >> 24) & 0xff);
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, sizeof(struct note_deadline_s));
+}
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
  * Description:
- *   Remove the next note from the tail of the circular buffer.  The note
+ *   Remove the next note from the tail of a circular buffer.  The note
  *   is also removed from the circular buffer to make room for futher notes.
  *
  * Input Parameters:
@@ -601,78 +842,43 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
  *
  * Returned Value:
  *   On success, the positive, non-zero length of the return note is
- *   provided.  Zero is returned only if ther circular buffer is empty.  A
- *   negated errno value is returned in the event of any failure.
+ *   provided.  Zero is returned only if ther circular buffers are empty.
+ *   A negated errno value is returned in the event of any failure.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_get(FAR uint8_t *buffer, size_t buflen)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int remaining;
-  unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
-
   DEBUGASSERT(buffer != NULL);
-  flags = enter_critical_section();
-
-  /* Verify that the circular buffer is not empty */
-
-  circlen = note_length();
-  if (circlen <= 0)
-    {
-      notelen = 0;
-      goto errout_with_csection;
-    }
-
-  /* Get the index to the tail of the circular buffer */
-
-  tail    = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
-  /* Get the length of the note at the tail index */
-
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-  /* Is the user buffer large enough to hold the note? */
-
-  if (buflen < notelen)
-    {
-      /* Remove the large note so that we do not get constipated. */
-
-      note_remove();
-
-      /* and return an error */
-
-      notelen = -EFBIG;
-      goto errout_with_csection;
-    }
-
-  /* Loop until the note has been transferred to the user buffer */
-
-  remaining = (unsigned int)notelen;
-  while (remaining > 0)
-    {
-      /* Copy the next byte at the tail index */
-
-      *buffer++ = g_note_info.ni_buffer[tail];
-
-      /* Adjust indices and counts */
-
-      tail = note_next(tail, 1);
-      remaining--;
-    }
+  return note_remove(buffer, buflen, true);
+}
+#endif
 
-  g_note_info.ni_tail = tail;
+/****************************************************************************
+ * Name: sched_note_read
+ *
+ * Description:
+ *   Remove as many whole notes as fit into the user buffer from the
+ *   circular buffers.  The notes of each CPU are returned in the order
+ *   in which they were added; the notes of different CPUs are not merged.
+ *
+ * Input Parameters:
+ *   buffer - Location to return the notes
+ *   buflen - The length of the user provided buffer.
+ *
+ * Returned Value:
+ *   On success, the positive, non-zero number of bytes returned.  Zero is
+ *   returned only if the circular buffers are empty.  A negated errno
+ *   value is returned in the event of any failure.
+ *
+ ****************************************************************************/
 
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+#ifdef CONFIG_SCHED_NOTE_GET
+ssize_t sched_note_read(FAR uint8_t *buffer, size_t buflen)
+{
+  DEBUGASSERT(buffer != NULL);
+  return note_remove(buffer, buflen, false);
 }
 #endif
 
@@ -680,51 +886,36 @@ errout_with_csection:
  * Name: sched_note_size
  *
  * Description:
- *   Return the size of the next note at the tail of the circular buffer.
+ *   Return the size of the next note that sched_note_get() would return.
  *
  * Input Parameters:
  *   None.
  *
  * Returned Value:
- *   Zero is returned if the circular buffer is empty.  Otherwise, the size
- *   of the next note is returned.
+ *   Zero is returned if the circular buffers are empty.  Otherwise, the
+ *   size of the next note is returned.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_NOTE_GET
 ssize_t sched_note_size(void)
 {
-  FAR struct note_common_s *note;
-  irqstate_t flags;
-  unsigned int tail;
-  ssize_t notelen;
-  size_t circlen;
-
-  flags = enter_critical_section();
+  FAR struct note_info_s *info;
+  unsigned int start = g_note_nextcpu;
+  unsigned int i;
+  uint32_t tail;
 
-  /* Verify that the circular buffer is not empty */
-
-  circlen = note_length();
-  if (circlen <= 0)
+  for (i = 0; i < NOTE_NCPUS; i++)
     {
-      notelen = 0;
-      goto errout_with_csection;
+      info = &g_note_info[(start + i) % NOTE_NCPUS];
+      tail = note_load(&info->ni_tail);
+      if (tail != note_load(&info->ni_head))
+        {
+          return note_length(info, tail);
+        }
     }
 
-  /* Get the index to the tail of the circular buffer */
-
-  tail = g_note_info.ni_tail;
-  DEBUGASSERT(tail < CONFIG_SCHED_NOTE_BUFSIZE);
-
-  /* Get the length of the note at the tail index */
-
-  note    = (FAR struct note_common_s *)&g_note_info.ni_buffer[tail];
-  notelen = note->nc_length;
-  DEBUGASSERT(notelen <= circlen);
-
-errout_with_csection:
-  leave_critical_section(flags);
-  return notelen;
+  return 0;
 }
 #endif
 
@@ -0,0 +1,370 @@
+/****************************************************************************
+ * sched/sched/sched_prioindex.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/compiler.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIOBITMAP
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One bit per priority level */
+
+#define PRIOINDEX_NWORDS   ((SCHED_PRIORITY_MAX + 32) >> 5)
+#define PRIOINDEX_WORD(p)  ((p) >> 5)
+#define PRIOINDEX_BIT(p)   ((uint32_t)1 << ((p) & 31))
+
+/* Index of the least significant set bit in a non-zero bitmap word.  The
+ * long variants are used because int may be only 16-bits wide.
+ */
+
+#ifdef CONFIG_HAVE_BUILTIN_CTZ
+#  define PRIOINDEX_CTZ(v) __builtin_ctzl((unsigned long)(v))
+#else
+#  define PRIOINDEX_CTZ(v) (ffsl((long)(v)) - 1)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The priority index of one prioritized task list.  Tasks of equal priority
+ * are contiguous in the list, so the list is divided into one run of TCBs
+ * for each priority that is present.  The bitmap records which priorities
+ * are present and last[] holds the TCB at the end of the run of each such
+ * priority.  last[] entries are valid only if the priority bit is set.
+ */
+
+struct prioindex_s
+{
+  uint32_t bitmap[PRIOINDEX_NWORDS];              /* Priorities present */
+  FAR struct tcb_s *last[SCHED_PRIORITY_MAX + 1]; /* Last TCB of each run */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Priority indices for the g_readytorun, g_pendingtasks, and (SMP only)
+ * g_assignedtasks[] lists.  The blocked task lists are not indexed.
+ */
+
+static struct prioindex_s g_readytorunidx;
+static struct prioindex_s g_pendingidx;
+#ifdef CONFIG_SMP
+static struct prioindex_s g_assignedidx[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex
+ *
+ * Description:
+ *   Return the priority index associated with a task list.
+ *
+ * Inputs:
+ *   list - Points to the task list
+ *
+ * Return Value:
+ *   The priority index of the list or NULL if the list is not indexed.
+ *
+ ****************************************************************************/
+
+static FAR struct prioindex_s *sched_prioindex(DSEG dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorunidx;
+    }
+
+  if (list == (FAR dq_queue_t *)&g_pendingtasks)
+    {
+      return &g_pendingidx;
+    }
+
+#ifdef CONFIG_SMP
+  if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+      list <  (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedidx[list - (FAR dq_queue_t *)&g_assignedtasks[0]];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_prioindex_find
+ *
+ * Description:
+ *   Find the position in a prioritized list where a TCB of the given
+ *   priority would be inserted:  After the last TCB with the same or
+ *   higher priority.  This is done in constant time by locating the
+ *   nearest priority present in the list that is not lower than
+ *   'priority'.
+ *
+ * Inputs:
+ *   list     - Points to the prioritized list
+ *   priority - The priority of the TCB to be inserted
+ *   prev     - Location to return the TCB after which the new TCB goes.
+ *              NULL is returned if the new TCB goes at the head of the list.
+ *
+ * Return Value:
+ *   true if the list is indexed and 'prev' is valid; false if the caller
+ *   must search the list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+bool sched_prioindex_find(DSEG dq_queue_t *list, uint8_t priority,
+                          FAR struct tcb_s **prev)
+{
+  FAR struct prioindex_s *idx = sched_prioindex(list);
+  uint32_t bits;
+  int ndx;
+
+  if (idx == NULL)
+    {
+      return false;
+    }
+
+  /* Look for the lowest priority present that is >= 'priority' */
+
+  ndx  = PRIOINDEX_WORD(priority);
+  bits = idx->bitmap[ndx] & ~(PRIOINDEX_BIT(priority) - 1);
+
+  for (; ; )
+    {
+      if (bits != 0)
+        {
+          *prev = idx->last[(ndx << 5) + PRIOINDEX_CTZ(bits)];
+          return true;
+        }
+
+      if (++ndx >= PRIOINDEX_NWORDS)
+        {
+          break;
+        }
+
+      bits = idx->bitmap[ndx];
+    }
+
+  /* There are no tasks of the same or higher priority in the list */
+
+  *prev = NULL;
+  return true;
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_add
+ *
+ * Description:
+ *   Update the priority index of a list after a TCB has been linked into
+ *   the list.  The TCB becomes the last of its priority if it is followed
+ *   by a lower priority TCB or by nothing.
+ *
+ * Inputs:
+ *   tcb  - The TCB that was added to the list
+ *   list - Points to the prioritized list
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_add(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+  FAR struct prioindex_s *idx = sched_prioindex(list);
+  FAR struct tcb_s *next;
+  uint8_t priority;
+
+  if (idx != NULL)
+    {
+      priority = tcb->sched_priority;
+      next     = (FAR struct tcb_s *)tcb->flink;
+
+      if (next == NULL || next->sched_priority < priority)
+        {
+          idx->last[priority] = tcb;
+        }
+
+      idx->bitmap[PRIOINDEX_WORD(priority)] |= PRIOINDEX_BIT(priority);
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_rem
+ *
+ * Description:
+ *   Update the priority index of a list before a TCB is unlinked from the
+ *   list.
+ *
+ * Inputs:
+ *   tcb  - The TCB that is about to be removed from the list
+ *   list - Points to the prioritized list
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_rem(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+  FAR struct prioindex_s *idx = sched_prioindex(list);
+  FAR struct tcb_s *prev;
+  uint8_t priority;
+
+  if (idx != NULL)
+    {
+      priority = tcb->sched_priority;
+      DEBUGASSERT((idx->bitmap[PRIOINDEX_WORD(priority)] &
+                   PRIOINDEX_BIT(priority)) != 0);
+
+      if (idx->last[priority] == tcb)
+        {
+          /* The run of this priority now ends with the preceding TCB, if
+           * it has the same priority, or else it is empty.
+           */
+
+          prev = (FAR struct tcb_s *)tcb->blink;
+          if (prev != NULL && prev->sched_priority == priority)
+            {
+              idx->last[priority] = prev;
+            }
+          else
+            {
+              idx->bitmap[PRIOINDEX_WORD(priority)] &=
+                ~PRIOINDEX_BIT(priority);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_prioindex_rebuild
+ *
+ * Description:
+ *   Recreate the priority index of a list from its content.  This is
+ *   used after operations that move many TCBs at once, such as
+ *   sched_mergeprioritized().
+ *
+ * Inputs:
+ *   list - Points to the prioritized list
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_prioindex_rebuild(DSEG dq_queue_t *list)
+{
+  FAR struct prioindex_s *idx = sched_prioindex(list);
+  FAR struct tcb_s *tcb;
+  uint8_t priority;
+
+  if (idx != NULL)
+    {
+      memset(idx->bitmap, 0, sizeof(idx->bitmap));
+
+      for (tcb = (FAR struct tcb_s *)list->head;
+           tcb != NULL;
+           tcb = (FAR struct tcb_s *)tcb->flink)
+        {
+          priority = tcb->sched_priority;
+          idx->last[priority] = tcb;
+          idx->bitmap[PRIOINDEX_WORD(priority)] |= PRIOINDEX_BIT(priority);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_remprioritized
+ *
+ * Description:
+ *   Remove a TCB from a prioritized TCB list, keeping the priority index of
+ *   the list up to date.
+ *
+ * Inputs:
+ *   tcb  - Points to the TCB to remove from the prioritized list
+ *   list - Points to the prioritized list that holds the TCB
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void sched_remprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+  sched_prioindex_rem(tcb, list);
+  dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+#endif /* CONFIG_SCHED_PRIOBITMAP */
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * sched/sched/sched_processresched.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "irq/irq.h"
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_RESCHED_IPI
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Set when a reschedule IPI is received while the CPU holds the IRQ lock */
+
+volatile bool g_cpu_resched[CONFIG_SMP_NCPUS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_process_resched
+ *
+ * Description:
+ *   Called from the architecture-specific handler of the reschedule IPI
+ *   sent by up_cpu_resched().  If a task in the g_readytorun list may run
+ *   on this CPU and has a higher priority than the task running on this
+ *   CPU, then a context switch is performed.
+ *
+ *   Only one task is considered for each IPI.  If the task has since been
+ *   started on another CPU, or if a higher priority task has started on
+ *   this CPU, then nothing is done.
+ *
+ * Inputs:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_process_resched(void)
+{
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int me = this_cpu();
+
+  /* If this CPU already holds the IRQ lock, then the ready-to-run lists
+   * may be in an inconsistent state.  This can only happen on platforms
+   * that cannot mask the IPI within the critical section.  Remember the
+   * request; leave_critical_section() will re-raise it.
+   */
+
+  if (CPU_ISSET(me, &g_cpu_irqset))
+    {
+      g_cpu_resched[me] = true;
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  /* Find the highest priority task in g_readytorun that may run on this
+   * CPU.  The list is prioritized so the search may stop at the first
+   * task that would not preempt the task running on this CPU.  A deadline
+   * task of the same priority preempts if its deadline is earlier.
+   */
+
+  rtcb = this_task();
+  for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+       tcb != NULL && (tcb->sched_priority > rtcb->sched_priority ||
+                       sched_deadline_before(tcb, rtcb));
+       tcb = (FAR struct tcb_s *)tcb->flink)
+    {
+      if (CPU_ISSET(me, &tcb->affinity))
+        {
+          break;
+        }
+    }
+
+  /* Re-queue the task.  sched_requeue() will remove it from g_readytorun
+   * and add it back through sched_addreadytorun() which will select the
+   * CPU running the lowest priority task (normally this CPU) and perform
+   * the context switch.
+   */
+
+  if (tcb != NULL && (tcb->sched_priority > rtcb->sched_priority ||
+                      sched_deadline_before(tcb, rtcb)))
+    {
+      sched_requeue(tcb);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SMP_RESCHED_IPI */
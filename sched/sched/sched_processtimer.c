@@ -69,7 +69,8 @@
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static inline void sched_cpu_scheduler(int cpu)
 {
   FAR struct tcb_s *rtcb = current_task(cpu);
@@ -99,6 +100,17 @@ static inline void sched_cpu_scheduler(int cpu)
       (void)sched_sporadic_process(rtcb, 1, false);
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Check if the currently executing task uses deadline scheduling. */
+
+  if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Yes, charge the tick against the budget of its current job. */
+
+      (void)sched_deadline_process(rtcb, 1, false);
+    }
+#endif
 }
 #endif
 
@@ -117,7 +129,8 @@ static inline void sched_cpu_scheduler(int cpu)
  *
  ****************************************************************************/
 
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
 static inline void sched_process_scheduler(void)
 {
 #ifdef CONFIG_SMP
@@ -200,7 +213,8 @@ void sched_process_timer(void)
       clock_timer();
     }
 
-#if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_SCHED_CPULOAD_EXTCLK)
+#if defined(CONFIG_SCHED_CPULOAD) && !defined(CONFIG_SCHED_CPULOAD_EXTCLK) && \
+   !defined(CONFIG_SCHED_CPULOAD_PRECISE)
   /* Perform CPU load measurements (before any timer-initiated context
    * switches can occur)
    */
@@ -213,6 +227,14 @@ void sched_process_timer(void)
     }
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  /* Charge the elapsed performance counter counts before the counter can
+   * wrap.
+   */
+
+  (void)sched_cpuload_process();
+#endif
+
   /* Process watchdogs */
 
   wd_timer();
@@ -222,4 +244,10 @@ void sched_process_timer(void)
    */
 
   sched_process_scheduler();
+
+#ifdef CONFIG_SMP_LOADBALANCE
+  /* Move waiting tasks to CPUs running lower priority tasks */
+
+  sched_process_balance();
+#endif
 }
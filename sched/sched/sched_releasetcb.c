@@ -79,7 +79,15 @@ static void sched_releasepid(pid_t pid)
    * defunct thread to zero.
    */
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  /* With precise accounting, the total is the elapsed time of the CPUs.
+   * It keeps the time that was consumed by this thread until it decays.
+   */
+
+  g_pidhash[hash_ndx].runtime = 0;
+#else
   g_cpuload_total          -= g_pidhash[hash_ndx].ticks;
+#endif
   g_pidhash[hash_ndx].ticks = 0;
 #endif
 }
@@ -80,11 +80,17 @@ void sched_removeblocked(FAR struct tcb_s *btcb)
    * with this state
    */
 
-  dq_rem((FAR dq_entry_t *)btcb, TLIST_BLOCKED(task_state));
+  sched_remprioritized(btcb, TLIST_BLOCKED(task_state));
 
   /* Make sure the TCB's state corresponds to not being in
    * any list
    */
 
   btcb->task_state = TSTATE_TASK_INVALID;
+
+  /* A deadline thread that wakes up may need a new job (and deadline)
+   * before it is placed in the ready-to-run list.
+   */
+
+  sched_deadline_wakeup(btcb);
 }
@@ -100,7 +100,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
-  dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
+  sched_remprioritized(rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -191,7 +191,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      sched_remprioritized(rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
        * next tcb in the assigned task list (nxttcb) or a TCB in the
@@ -209,36 +209,42 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
            * CPU.
            */
 
+#ifdef CONFIG_SMP_LOADBALANCE
+          rtrtcb = sched_balance_task(cpu);
+#else
           for (rtrtcb = (FAR struct tcb_s *)g_readytorun.head;
                rtrtcb != NULL && !CPU_ISSET(cpu, &rtrtcb->affinity);
                rtrtcb = (FAR struct tcb_s *)rtrtcb->flink);
+#endif
         }
 
       /* Did we find a task in the g_readytorun list?  Which task should
        * we use?  We decide strictly by the priority of the two tasks:
        * Either (1) the task currently at the head of the g_assignedtasks[cpu]
        * list (nexttcb) or (2) the highest priority task from the
-       * g_readytorun list with matching affinity (rtrtcb).
+       * g_readytorun list with matching affinity (rtrtcb).  Between two
+       * deadline tasks of the same priority, the earlier deadline wins.
        */
 
-      if (rtrtcb != NULL && rtrtcb->sched_priority >= nxttcb->sched_priority)
+      if (rtrtcb != NULL &&
+          rtrtcb->sched_priority >= nxttcb->sched_priority &&
+          !sched_deadline_before(nxttcb, rtrtcb))
         {
-          FAR struct tcb_s *tmptcb;
-
-          /* The TCB at the head of the ready to run list has the higher
-           * priority.  Remove that task from the head of the g_readytorun
-           * list and add to the head of the g_assignedtasks[cpu] list.
+          /* The TCB from the ready to run list has the higher priority.
+           * Remove that task from the g_readytorun list and add to the
+           * head of the g_assignedtasks[cpu] list.  NOTE that it need not
+           * be at the head of the g_readytorun list if the tasks ahead of
+           * it cannot run on this CPU.
            */
 
-          tmptcb = (FAR struct tcb_s *)
-            dq_remfirst((FAR dq_queue_t *)&g_readytorun);
-
-          DEBUGASSERT(tmptcb == rtrtcb);
+          sched_remprioritized(rtrtcb, (FAR dq_queue_t *)&g_readytorun);
 
-          dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
+          sched_prioindex_add(rtrtcb, tasklist);
 
-          tmptcb->cpu = cpu;
-          nxttcb = tmptcb;
+          sched_count_migration(rtrtcb, cpu);
+          rtrtcb->cpu = cpu;
+          nxttcb = rtrtcb;
         }
 
       /* Will pre-emption be disabled after the switch?  If the lockcount is
@@ -324,7 +330,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
-      dq_rem((FAR dq_entry_t *)rtcb, tasklist);
+      sched_remprioritized(rtcb, tasklist);
     }
 
   /* Since the TCB is no longer in any list, it is now invalid */
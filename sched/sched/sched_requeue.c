@@ -0,0 +1,90 @@
+/****************************************************************************
+ * sched/sched/sched_requeue.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/arch.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_requeue
+ *
+ * Description:
+ *   Remove a running or ready-to-run task from the ready-to-run lists and
+ *   add it back with its current priority.  The task is placed behind all
+ *   other tasks of its priority that it does not preempt (see
+ *   sched_deadline_before()) and, in SMP configurations, is assigned to
+ *   the CPU that sched_addreadytorun() selects.  A context switch is
+ *   performed if the task running on this CPU changes.
+ *
+ *   This is used when the position of a task in the ready-to-run lists
+ *   must change although its priority does not:  When a higher priority
+ *   task should preempt this CPU, when a task is moved to another CPU, or
+ *   when the deadline of a task changes.
+ *
+ * Inputs:
+ *   tcb - The TCB of the running or ready-to-run task
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sched_requeue(FAR struct tcb_s *tcb)
+{
+  DEBUGASSERT(tcb->task_state >= FIRST_READY_TO_RUN_STATE &&
+              tcb->task_state <= LAST_READY_TO_RUN_STATE);
+
+  /* up_reprioritize_rtr() removes the task from the ready-to-run list, sets
+   * the priority, adds the task back and performs any resulting context
+   * switch.  It does so even if the priority is unchanged.
+   */
+
+  up_reprioritize_rtr(tcb, tcb->sched_priority);
+}
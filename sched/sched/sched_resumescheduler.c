@@ -48,7 +48,8 @@
 #include "sched/sched.h"
 
 #if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
-    defined(CONFIG_SCHED_INSTRUMENTATION)
+    defined(CONFIG_SCHED_INSTRUMENTATION) || \
+    defined(CONFIG_SCHED_CPULOAD_PRECISE)
 
 /****************************************************************************
  * Public Functions
@@ -73,7 +74,7 @@
 void sched_resume_scheduler(FAR struct tcb_s *tcb)
 {
 #if CONFIG_RR_INTERVAL > 0
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
   if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_RR)
 #endif
     {
@@ -95,6 +96,12 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb)
     }
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  /* Start measuring the run time of the task */
+
+  sched_cpuload_resume();
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   /* Inidicate the task has been resumed */
 
@@ -104,4 +111,4 @@ void sched_resume_scheduler(FAR struct tcb_s *tcb)
 }
 
 #endif /* CONFIG_RR_INTERVAL > 0 || CONFIG_SCHED_SPORADIC || \
-        * CONFIG_SCHED_INSTRUMENTATION */
+        * CONFIG_SCHED_INSTRUMENTATION || CONFIG_SCHED_CPULOAD_PRECISE */
@@ -215,6 +215,49 @@ int sched_setparam(pid_t pid, FAR const struct sched_param *param)
     }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Update parameters associated with SCHED_DEADLINE.  If they changed,
+   * that is the same operation as selecting the deadline policy again with
+   * the new parameters, including admission control.  If only the priority
+   * changes, the current reservation is kept.
+   */
+
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      FAR struct deadline_s *dl = tcb->deadline;
+      ssystime_t runtime;
+      ssystime_t deadline;
+      ssystime_t period;
+
+      DEBUGASSERT(dl != NULL);
+
+      (void)clock_time2ticks(&param->sched_dl_runtime, &runtime);
+      (void)clock_time2ticks(&param->sched_dl_deadline, &deadline);
+      (void)clock_time2ticks(&param->sched_dl_period, &period);
+
+      /* Apply the same defaults as sched_setscheduler() */
+
+      if (period <= 0)
+        {
+          period = deadline;
+        }
+
+      if (deadline <= 0)
+        {
+          deadline = period;
+        }
+
+      if (runtime != (ssystime_t)dl->runtime ||
+          deadline != (ssystime_t)dl->deadline ||
+          period != (ssystime_t)dl->period)
+        {
+          ret = sched_setscheduler(tcb->pid, SCHED_DEADLINE, param);
+          sched_unlock();
+          return ret;
+        }
+    }
+#endif
+
   /* Then perform the reprioritization */
 
   ret = sched_reprioritize(tcb, param->sched_priority);
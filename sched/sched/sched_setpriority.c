@@ -164,9 +164,27 @@ static inline void sched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_PRIOBITMAP
+      /* The task remains at the head of its ready-to-run list but the
+       * priority index of that list must follow the change.
+       */
+
+#ifdef CONFIG_SMP
+      FAR dq_queue_t *tasklist = TLIST_HEAD(tcb->task_state, tcb->cpu);
+#else
+      FAR dq_queue_t *tasklist = TLIST_HEAD(tcb->task_state);
+#endif
+
+      sched_prioindex_rem(tcb, tasklist);
+#endif
+
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+
+#ifdef CONFIG_SCHED_PRIOBITMAP
+      sched_prioindex_add(tcb, tasklist);
+#endif
     }
 }
 
@@ -289,7 +307,7 @@ static inline void sched_blocked_setpriority(FAR struct tcb_s *tcb,
     {
       /* Remove the TCB from the prioritized task list */
 
-      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+      sched_remprioritized(tcb, tasklist);
 
       /* Change the task priority */
 
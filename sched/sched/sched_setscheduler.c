@@ -67,7 +67,8 @@
  * Inputs:
  *   pid - the task ID of the task to modify.  If pid is zero, the calling
  *      task is modified.
- *   policy - Scheduling policy requested (either SCHED_FIFO or SCHED_RR)
+ *   policy - Scheduling policy requested (SCHED_FIFO, SCHED_RR,
+ *      SCHED_SPORADIC, or SCHED_DEADLINE)
  *   param - A structure whose member sched_priority is the new priority.
  *      The range of valid priority numbers is from SCHED_PRIORITY_MIN
  *      through SCHED_PRIORITY_MAX.
@@ -77,6 +78,7 @@
  *   (-1) is returned, and errno is set appropriately:
  *
  *   EINVAL The scheduling policy is not one of the recognized policies.
+ *   EBUSY  SCHED_DEADLINE admission control refused the reservation.
  *   ESRCH  The task whose ID is pid could not be found.
  *
  * Assumptions:
@@ -88,8 +90,11 @@ int sched_setscheduler(pid_t pid, int policy,
 {
   FAR struct tcb_s *tcb;
   irqstate_t flags;
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
   int errcode;
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+  uint16_t oldpolicy;
 #endif
   int ret;
 
@@ -101,6 +106,9 @@ int sched_setscheduler(pid_t pid, int policy,
 #endif
 #ifdef CONFIG_SCHED_SPORADIC
       && policy != SCHED_SPORADIC
+#endif
+#ifdef CONFIG_SCHED_DEADLINE
+      && policy != SCHED_DEADLINE
 #endif
      )
     {
@@ -133,6 +141,20 @@ int sched_setscheduler(pid_t pid, int policy,
   /* Further, disable timer interrupts while we set up scheduling policy. */
 
   flags = enter_critical_section();
+
+#ifdef CONFIG_SCHED_DEADLINE
+  /* Release any deadline reservation if the thread leaves SCHED_DEADLINE.
+   * A new reservation for a thread that is already a deadline thread
+   * replaces the old one below.
+   */
+
+  oldpolicy = tcb->flags & TCB_FLAG_POLICY_MASK;
+  if (oldpolicy == TCB_FLAG_SCHED_DEADLINE && policy != SCHED_DEADLINE)
+    {
+      DEBUGVERIFY(sched_deadline_stop(tcb));
+    }
+#endif
+
   tcb->flags &= ~TCB_FLAG_POLICY_MASK;
   switch (policy)
     {
@@ -151,7 +173,8 @@ int sched_setscheduler(pid_t pid, int policy,
           /* Save the FIFO scheduling parameters */
 
           tcb->flags       |= TCB_FLAG_SCHED_FIFO;
-#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
+#if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC) || \
+    defined(CONFIG_SCHED_DEADLINE)
           tcb->timeslice    = 0;
 #endif
         }
@@ -267,6 +290,60 @@ int sched_setscheduler(pid_t pid, int policy,
         break;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+      case SCHED_DEADLINE:
+        {
+          ssystime_t runtime;
+          ssystime_t deadline;
+          ssystime_t period;
+
+          /* Convert timespec values to system clock ticks */
+
+          (void)clock_time2ticks(&param->sched_dl_runtime, &runtime);
+          (void)clock_time2ticks(&param->sched_dl_deadline, &deadline);
+          (void)clock_time2ticks(&param->sched_dl_period, &period);
+
+          /* A zero deadline or period defaults to the next larger
+           * parameter, as with Linux SCHED_DEADLINE.
+           */
+
+          if (period <= 0)
+            {
+              period = deadline;
+            }
+
+          if (deadline <= 0)
+            {
+              deadline = period;
+            }
+
+          if (runtime <= 0 || deadline <= 0)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              /* Admit the new reservation and release the first job */
+
+              ret = sched_deadline_start(tcb, (uint32_t)runtime,
+                                         (uint32_t)deadline,
+                                         (uint32_t)period);
+            }
+
+          if (ret < 0)
+            {
+              /* Keep the current policy */
+
+              tcb->flags |= oldpolicy;
+              errcode     = -ret;
+              goto errout_with_irq;
+            }
+
+          tcb->flags |= TCB_FLAG_SCHED_DEADLINE;
+        }
+        break;
+#endif
+
 #if 0 /* Not supported */
       case SCHED_OTHER:
         tcb->flags    |= TCB_FLAG_SCHED_OTHER;
@@ -282,7 +359,7 @@ int sched_setscheduler(pid_t pid, int policy,
   sched_unlock();
   return (ret >= 0) ? OK : ERROR;
 
-#ifdef CONFIG_SCHED_SPORADIC
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_DEADLINE)
 errout_with_irq:
   set_errno(errcode);
   leave_critical_section(flags);
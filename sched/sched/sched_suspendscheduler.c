@@ -50,7 +50,8 @@
 #include "clock/clock.h"
 #include "sched/sched.h"
 
-#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION)
+#if defined(CONFIG_SCHED_SPORADIC) || defined(CONFIG_SCHED_INSTRUMENTATION) || \
+    defined(CONFIG_SCHED_CPULOAD_PRECISE)
 
 /****************************************************************************
  * Public Functions
@@ -83,6 +84,12 @@ void sched_suspend_scheduler(FAR struct tcb_s *tcb)
     }
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+  /* Charge the time since the task was resumed to the task */
+
+  sched_cpuload_suspend(tcb);
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   /* Inidicate the task has been suspended */
 
@@ -90,4 +97,5 @@ void sched_suspend_scheduler(FAR struct tcb_s *tcb)
 #endif
 }
 
-#endif /* CONFIG_SCHED_SPORADIC || CONFIG_SCHED_INSTRUMENTATION */
+#endif /* CONFIG_SCHED_SPORADIC || CONFIG_SCHED_INSTRUMENTATION ||
+        * CONFIG_SCHED_CPULOAD_PRECISE */
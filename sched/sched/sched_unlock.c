@@ -225,6 +225,20 @@ int sched_unlock(void)
 #endif
             }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+          /* If (1) the task that was running supports deadline scheduling
+           * and (2) its deadline was postponed while pre-emption was
+           * disabled, then another deadline task of the same priority may
+           * now have the earlier deadline.  Re-queue the task now.
+           */
+
+          if ((rtcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE &&
+              rtcb == this_task())
+            {
+              sched_deadline_requeue(rtcb);
+            }
+#endif
         }
 
       leave_critical_section(flags);
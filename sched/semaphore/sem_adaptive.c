@@ -0,0 +1,275 @@
+/****************************************************************************
+ * sched/semaphore/sem_adaptive.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <semaphore.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/clock.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+
+#ifdef CONFIG_SEM_ADAPTIVE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The spin is bounded by time if the architecture can measure it and by the
+ * number of polls otherwise.
+ */
+
+#ifdef CONFIG_ARCH_HAVE_PERF_COUNTER
+#  define SEM_SPINTIME \
+     ((uint32_t)((uint64_t)up_perf_getfreq() * CONFIG_SEM_ADAPTIVE_SPINTIME / \
+                 USEC_PER_SEC))
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_holderrunning
+ *
+ * Description:
+ *   Return true if the most recent holder of the semaphore is running on
+ *   another CPU and, hence, may release the semaphore soon.
+ *
+ *   The holder is looked up by its PID so that a stale holder that has
+ *   exited is simply not found.  The critical section is held while the
+ *   TCB is examined so that the holder cannot exit and its TCB cannot be
+ *   freed or reused in the meantime.
+ *
+ ****************************************************************************/
+
+static bool sem_holderrunning(FAR sem_t *sem)
+{
+  FAR struct tcb_s *htcb;
+  irqstate_t flags;
+  bool running;
+  pid_t hpid = sem->hpid;
+
+  if (hpid <= 0)
+    {
+      return false;
+    }
+
+  flags   = enter_critical_section();
+  htcb    = sched_gettcb(hpid);
+  running = htcb != NULL && htcb->task_state == TSTATE_TASK_RUNNING &&
+            htcb->cpu != this_cpu();
+  leave_critical_section(flags);
+
+  return running;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_spinwait
+ *
+ * Description:
+ *   Called by sem_wait() and friends before the critical section is
+ *   entered.  If the semaphore is adaptive and it is held by a task that is
+ *   running on another CPU, poll the semaphore count for a bounded time
+ *   (CONFIG_SEM_ADAPTIVE_SPINTIME microseconds or, if there is no
+ *   performance counter, CONFIG_SEM_ADAPTIVE_SPINCOUNT polls) waiting for
+ *   it to become available.
+ *   The caller then takes the semaphore in the normal way and blocks only
+ *   if it is still (or again) unavailable.
+ *
+ *   There is no point in spinning if there are already waiters:  The next
+ *   sem_post() will give the count directly to the highest priority
+ *   waiter.  Nor may the caller spin if it holds the critical section
+ *   since the holder would be unable to post the semaphore.
+ *
+ * Parameters:
+ *   sem - The semaphore to wait for
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sem_spinwait(FAR sem_t *sem)
+{
+#ifdef CONFIG_ARCH_HAVE_PERF_COUNTER
+  uint32_t spintime;
+  uint32_t start;
+#else
+  int count;
+#endif
+
+  if (sem == NULL || (sem->flags & ADAPTIVE_FLAGS_ENABLE) == 0 ||
+      sem->semcount != 0 || up_interrupt_context() ||
+      this_task()->irqcount > 0)
+    {
+      return;
+    }
+
+#ifdef CONFIG_ARCH_HAVE_PERF_COUNTER
+  spintime = SEM_SPINTIME;
+  for (start = up_perf_gettime(); up_perf_gettime() - start < spintime; )
+#else
+  for (count = 0; count < CONFIG_SEM_ADAPTIVE_SPINCOUNT; count++)
+#endif
+    {
+      if (sem->semcount > 0)
+        {
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+          atomic_add_return(&sem->stats.nspins, 1);
+#endif
+          return;
+        }
+
+      /* Stop spinning if there are waiters or if the holder has been
+       * suspended or has moved to this CPU.
+       */
+
+      if (sem->semcount < 0 || !sem_holderrunning(sem))
+        {
+          return;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sem_settaken
+ *
+ * Description:
+ *   Remember the task that has taken a count on the semaphore.  Called
+ *   with the critical section held when a count is taken or is given to a
+ *   waiting task by sem_post().  With CONFIG_SEM_ATOMIC_COUNT, it is also
+ *   called without the critical section when an uncontended count is taken
+ *   on a semaphore that does not collect statistics.
+ *
+ * Parameters:
+ *   htcb - The new holder of the semaphore count
+ *   sem  - The semaphore
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sem_settaken(FAR struct tcb_s *htcb, FAR sem_t *sem)
+{
+  sem->hpid = htcb->pid;
+
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+  sem->stats.locktime = up_perf_gettime();
+#endif
+}
+
+/****************************************************************************
+ * Name: sem_setposted
+ *
+ * Description:
+ *   Forget the holder of the semaphore and account for the hold time.
+ *   Called by sem_post() before the count is incremented, with the critical
+ *   section held unless the semaphore does not collect statistics (see
+ *   sem_count_nolock()).
+ *
+ * Parameters:
+ *   sem  - The semaphore
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sem_setposted(FAR sem_t *sem)
+{
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+  if (sem->hpid != 0)
+    {
+      uint32_t elapsed = up_perf_gettime() - sem->stats.locktime;
+
+      sem->stats.holdtime += elapsed;
+      if (elapsed > sem->stats.maxhold)
+        {
+          sem->stats.maxhold = elapsed;
+        }
+    }
+#endif
+
+  sem->hpid = 0;
+}
+
+/****************************************************************************
+ * Name: sem_getstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of a semaphore.
+ *
+ * Parameters:
+ *   sem   - The semaphore to be queried
+ *   stats - The location to return the statistics
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+int sem_getstats(FAR sem_t *sem, FAR struct semstat_s *stats)
+{
+  if (sem == NULL || stats == NULL)
+    {
+      return -EINVAL;
+    }
+
+  memcpy(stats, &sem->stats, sizeof(struct semstat_s));
+  return OK;
+}
+#endif
+
+#endif /* CONFIG_SEM_ADAPTIVE */
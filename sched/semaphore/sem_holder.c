@@ -43,7 +43,10 @@
 #include <sched.h>
 #include <assert.h>
 #include <debug.h>
+
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -60,6 +63,18 @@
 #  define CONFIG_SEM_PREALLOCHOLDERS 0
 #endif
 
+#if CONFIG_SEM_PREALLOCHOLDERS == 0 || !defined(CONFIG_SEM_HOLDERS_GROWBY)
+#  undef  CONFIG_SEM_HOLDERS_GROWBY
+#  define CONFIG_SEM_HOLDERS_GROWBY 0
+#endif
+
+/* Grow the pool of holder structures when fewer than this number remain.
+ * The reserve covers the count taken by the caller of sem_wait() plus a
+ * count handed over to a waiter by sem_post() from an interrupt handler.
+ */
+
+#define SEM_HOLDERS_LOWATER 2
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -76,13 +91,31 @@ typedef int (*holderhandler_t)(FAR struct semholder_s *pholder,
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 static struct semholder_s g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS];
 static FAR struct semholder_s *g_freeholders;
+static int g_nfreeholders;
 #endif
 
+/* True while the pool of holder structures is being extended */
+
+#if CONFIG_SEM_HOLDERS_GROWBY > 0
+static bool g_holdersgrowing;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: sem_allocholder
+ *
+ * Description:
+ *   Allocate a holder structure for the thread 'htcb' and add it both to
+ *   the list of holders of the semaphore and to the list of semaphores
+ *   held by the thread.
+ *
  ****************************************************************************/
 
-static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
+static inline FAR struct semholder_s *sem_allocholder(sem_t *sem,
+                                                      FAR struct tcb_s *htcb)
 {
   FAR struct semholder_s *pholder;
 
@@ -100,23 +133,18 @@ static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
        */
 
       g_freeholders    = pholder->flink;
+      g_nfreeholders--;
       pholder->flink   = sem->hhead;
       sem->hhead       = pholder;
-
-      /* Make sure the initial count is zero */
-
-      pholder->counts  = 0;
     }
 #else
   if (sem->holder[0].htcb == NULL)
     {
       pholder          = &sem->holder[0];
-      pholder->counts  = 0;
     }
   else if (sem->holder[1].htcb == NULL)
     {
       pholder          = &sem->holder[1];
-      pholder->counts  = 0;
     }
 #endif
   else
@@ -126,11 +154,31 @@ static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
     }
 
   DEBUGASSERT(pholder != NULL);
+  if (pholder != NULL)
+    {
+      /* Make sure the initial count is zero and add the holder to the list
+       * of semaphores held by the thread.
+       */
+
+      pholder->counts  = 0;
+      pholder->sem     = sem;
+      pholder->htcb    = htcb;
+      pholder->tlink   = htcb->holdsem;
+      htcb->holdsem    = pholder;
+    }
+
   return pholder;
 }
 
 /****************************************************************************
  * Name: sem_findholder
+ *
+ * Description:
+ *   Find the holder structure of the thread 'htcb' on the semaphore.  Only
+ *   the semaphores held by the thread are searched so the cost is bounded
+ *   by the lock nesting depth of the thread, not by the number of holders
+ *   of the semaphore.
+ *
  ****************************************************************************/
 
 static FAR struct semholder_s *sem_findholder(sem_t *sem,
@@ -138,6 +186,32 @@ static FAR struct semholder_s *sem_findholder(sem_t *sem,
 {
   FAR struct semholder_s *pholder;
 
+  for (pholder = htcb->holdsem; pholder != NULL; pholder = pholder->tlink)
+    {
+      if (pholder->sem == sem)
+        {
+          return pholder;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: sem_findstaleholder
+ *
+ * Description:
+ *   Find the holder structure of the thread 'htcb' by searching the list of
+ *   holders of the semaphore.  This is used only if 'htcb' is a stale
+ *   handle so that its list of held semaphores cannot be trusted.
+ *
+ ****************************************************************************/
+
+static FAR struct semholder_s *sem_findstaleholder(sem_t *sem,
+                                                   FAR struct tcb_s *htcb)
+{
+  FAR struct semholder_s *pholder;
+
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   /* Try to find the holder in the list of holders associated with this
    * semaphore
@@ -185,7 +259,7 @@ sem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
   FAR struct semholder_s *pholder = sem_findholder(sem, htcb);
   if (!pholder)
     {
-      pholder = sem_allocholder(sem);
+      pholder = sem_allocholder(sem, htcb);
     }
 
   return pholder;
@@ -193,17 +267,44 @@ sem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
 
 /****************************************************************************
  * Name: sem_freeholder
+ *
+ * Description:
+ *   Remove the holder structure from the list of semaphores held by the
+ *   thread (unless pholder->htcb has been nullified because the thread is
+ *   stale) and from the list of holders of the semaphore.  Then free it.
+ *
  ****************************************************************************/
 
-static inline void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
+static void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
 {
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *curr;
   FAR struct semholder_s *prev;
-#endif
+
+  /* Remove the holder from the list of semaphores held by the thread */
+
+  if (pholder->htcb != NULL)
+    {
+      for (prev = NULL, curr = pholder->htcb->holdsem;
+           curr && curr != pholder;
+           prev = curr, curr = curr->tlink);
+
+      if (curr != NULL)
+        {
+          if (prev != NULL)
+            {
+              prev->tlink = pholder->tlink;
+            }
+          else
+            {
+              pholder->htcb->holdsem = pholder->tlink;
+            }
+        }
+    }
 
   /* Release the holder and counts */
 
+  pholder->tlink  = NULL;
+  pholder->sem    = NULL;
   pholder->htcb   = NULL;
   pholder->counts = 0;
 
@@ -231,6 +332,7 @@ static inline void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
 
       pholder->flink = g_freeholders;
       g_freeholders  = pholder;
+      g_nfreeholders++;
     }
 #endif
 }
@@ -310,14 +412,12 @@ static int sem_foreachholder(FAR sem_t *sem, holderhandler_t handler,
  * Name: sem_recoverholders
  ****************************************************************************/
 
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-static int sem_recoverholders(FAR struct semholder_s *pholder,
-                              FAR sem_t *sem, FAR void *arg)
+static int sem_recoverholder(FAR struct semholder_s *pholder,
+                             FAR sem_t *sem, FAR void *arg)
 {
   sem_freeholder(sem, pholder);
   return 0;
 }
-#endif
 
 /****************************************************************************
  * Name: sem_boostholderprio
@@ -339,6 +439,7 @@ static int sem_boostholderprio(FAR struct semholder_s *pholder,
     {
       serr("ERROR: TCB 0x%08x is a stale handle, counts lost\n", htcb);
       DEBUGPANIC();
+      pholder->htcb = NULL;
       sem_freeholder(sem, pholder);
     }
 
@@ -500,9 +601,10 @@ static int sem_restoreholderprio(FAR struct tcb_s *htcb,
     {
       serr("ERROR: TCB 0x%08x is a stale handle, counts lost\n", htcb);
       DEBUGPANIC();
-      pholder = sem_findholder(sem, htcb);
+      pholder = sem_findstaleholder(sem, htcb);
       if (pholder != NULL)
         {
+          pholder->htcb = NULL;
           sem_freeholder(sem, pholder);
         }
     }
@@ -833,6 +935,94 @@ static inline void sem_restorebaseprio_task(FAR struct tcb_s *stcb,
   sem_findandfreeholder(sem, rtcb);
 }
 
+/****************************************************************************
+ * Name: sem_growholders
+ *
+ * Description:
+ *   If the pool of free holder structures is nearly exhausted, extend it
+ *   with CONFIG_SEM_HOLDERS_GROWBY structures allocated from the kernel
+ *   heap.  Memory added to the pool is never returned to the heap.
+ *
+ * Parameters:
+ *   sem    - The semaphore that the caller is about to take
+ *   nowait - True if the caller must not block on the heap semaphore
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_SEM_HOLDERS_GROWBY > 0
+static void sem_growholders(FAR sem_t *sem, bool nowait)
+{
+  FAR struct semholder_s *alloc;
+  irqstate_t flags;
+  int i;
+
+  /* Nothing needs to be done if this semaphore does not track holders or if
+   * there are enough free holders.  Nothing can be done in an interrupt
+   * handler.
+   */
+
+  if (sem == NULL || (sem->flags & PRIOINHERIT_FLAGS_DISABLE) != 0 ||
+      g_nfreeholders >= SEM_HOLDERS_LOWATER || up_interrupt_context())
+    {
+      return;
+    }
+
+  /* kmm_malloc() will itself take the heap semaphore.  Do not recurse
+   * and do not let two threads extend the pool at the same time.
+   */
+
+  flags = enter_critical_section();
+  if (g_holdersgrowing)
+    {
+      leave_critical_section(flags);
+      return;
+    }
+
+  g_holdersgrowing = true;
+  leave_critical_section(flags);
+
+  /* If the caller must not block, then take the heap semaphore only if it
+   * is available.  kmm_zalloc() will then not wait for it.
+   */
+
+  if (nowait && kmm_trysemaphore() != 0)
+    {
+      g_holdersgrowing = false;
+      return;
+    }
+
+  alloc = (FAR struct semholder_s *)
+    kmm_zalloc(CONFIG_SEM_HOLDERS_GROWBY * sizeof(struct semholder_s));
+
+  if (nowait)
+    {
+      kmm_givesemaphore();
+    }
+
+  flags = enter_critical_section();
+  if (alloc != NULL)
+    {
+      for (i = 0; i < CONFIG_SEM_HOLDERS_GROWBY; i++)
+        {
+          alloc[i].flink = g_freeholders;
+          g_freeholders  = &alloc[i];
+        }
+
+      g_nfreeholders += CONFIG_SEM_HOLDERS_GROWBY;
+    }
+  else
+    {
+      serr("ERROR: Failed to extend the pool of holders\n");
+    }
+
+  g_holdersgrowing = false;
+  leave_critical_section(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -867,9 +1057,64 @@ void sem_initholders(void)
     }
 
   g_holderalloc[CONFIG_SEM_PREALLOCHOLDERS - 1].flink = NULL;
+  g_nfreeholders = CONFIG_SEM_PREALLOCHOLDERS;
 #endif
 }
 
+/****************************************************************************
+ * Name: sem_reserveholders
+ *
+ * Description:
+ *   Make sure that a holder structure will be available when the caller
+ *   takes the semaphore, extending the pool from the kernel heap if
+ *   necessary.  This cannot be done when a holder is actually needed
+ *   because that happens with interrupts disabled and, possibly, in an
+ *   interrupt handler.
+ *
+ *   This may wait for the heap semaphore so it must be called before the
+ *   critical section is entered and before any timeout is started:  A
+ *   timeout would abort the wait for the heap semaphore.  sem_timedwait()
+ *   and sem_tickwait() therefore reserve holders before they start their
+ *   watchdog.  If the watchdog of the calling thread is already armed when
+ *   sem_wait() is called from them, the heap is not waited for.
+ *
+ * Parameters:
+ *   sem - The semaphore that the caller is about to wait for
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_SEM_HOLDERS_GROWBY > 0
+void sem_reserveholders(FAR sem_t *sem)
+{
+  sem_growholders(sem, this_task()->waitdog != NULL);
+}
+#endif
+
+/****************************************************************************
+ * Name: sem_tryreserveholders
+ *
+ * Description:
+ *   Like sem_reserveholders(), but never waits for the heap semaphore.
+ *   Called from sem_trywait(), which must not block.
+ *
+ * Parameters:
+ *   sem - The semaphore that the caller is about to take
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_SEM_HOLDERS_GROWBY > 0
+void sem_tryreserveholders(FAR sem_t *sem)
+{
+  sem_growholders(sem, true);
+}
+#endif
+
 /****************************************************************************
  * Name: sem_destroyholder
  *
@@ -902,22 +1147,46 @@ void sem_destroyholder(FAR sem_t *sem)
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
   if (sem->hhead != NULL)
+#else
+  if (sem->holder[0].htcb != NULL || sem->holder[1].htcb != NULL)
+#endif
     {
       serr("ERROR: Semaphore destroyed with holders\n");
       DEBUGPANIC();
-      (void)sem_foreachholder(sem, sem_recoverholders, NULL);
+      (void)sem_foreachholder(sem, sem_recoverholder, NULL);
     }
+}
 
-#else
-  if (sem->holder[0].htcb != NULL || sem->holder[1].htcb != NULL)
+/****************************************************************************
+ * Name: sem_recoverholders
+ *
+ * Description:
+ *   Called from sem_recover() when a thread is deleted.  Free the holder
+ *   structures of all semaphores on which the thread still holds counts so
+ *   that the other holders and waiters of those semaphores are no longer
+ *   affected by the dead thread.  The counts themselves are not released:
+ *   the data protected by the semaphore may be in an inconsistent state.
+ *
+ * Parameters:
+ *   htcb - The TCB of the thread being deleted
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void sem_recoverholders(FAR struct tcb_s *htcb)
+{
+  FAR struct semholder_s *pholder;
+
+  while ((pholder = htcb->holdsem) != NULL)
     {
-      serr("ERROR: Semaphore destroyed with holder\n");
-      DEBUGPANIC();
+      swarn("WARNING: Thread %d exited holding a semaphore\n", htcb->pid);
+      sem_freeholder(pholder->sem, pholder);
     }
-
-  sem->holder[0].htcb = NULL;
-  sem->holder[1].htcb = NULL;
-#endif
 }
 
 /****************************************************************************
@@ -1186,15 +1455,7 @@ void sem_enumholders(FAR sem_t *sem)
 int sem_nfreeholders(void)
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  FAR struct semholder_s *pholder;
-  int n;
-
-  for (pholder = g_freeholders, n = 0; pholder; pholder = pholder->flink)
-    {
-      n++;
-    }
-
-  return n;
+  return g_nfreeholders;
 #else
   return 0;
 #endif
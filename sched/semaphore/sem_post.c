@@ -85,18 +85,45 @@ int sem_post(FAR sem_t *sem)
 {
   FAR struct tcb_s *stcb = NULL;
   irqstate_t flags;
+  int16_t count;
   int ret = ERROR;
 
   /* Make sure we were supplied with a valid semaphore. */
 
   if (sem)
     {
-      /* The following operations must be performed with interrupts
-       * disabled because sem_post() may be called from an interrupt
-       * handler.
+#ifdef CONFIG_SEM_ATOMIC_COUNT
+      /* If there are no waiters and no holders to release, just increment
+       * the count.  A task that starts waiting concurrently decrements the
+       * count first, so the increment then fails and the waiter is woken
+       * up below.
        */
 
-      flags = enter_critical_section();
+      if (sem_count_nolock(sem))
+        {
+          sem_setposted(sem);
+          if (sem_count_trygive(sem))
+            {
+              return OK;
+            }
+
+          /* There are waiters.  Wake one up below with interrupts
+           * disabled.
+           */
+
+          flags = enter_critical_section();
+        }
+      else
+#endif
+        {
+          /* The following operations must be performed with interrupts
+           * disabled because sem_post() may be called from an interrupt
+           * handler.
+           */
+
+          flags = enter_critical_section();
+          sem_setposted(sem);
+        }
 
       /* Perform the semaphore unlock operation, releasing this task as a
        * holder then also incrementing the count on the semaphore.
@@ -117,7 +144,7 @@ int sem_post(FAR sem_t *sem)
 
       ASSERT(sem->semcount < SEM_VALUE_MAX);
       sem_releaseholder(sem);
-      sem->semcount++;
+      count = sem_count_give(sem);
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
       /* Don't let any unblocked tasks run until we complete any priority
@@ -134,7 +161,7 @@ int sem_post(FAR sem_t *sem)
        * there must be some task waiting for the semaphore.
        */
 
-      if (sem->semcount <= 0)
+      if (count <= 0)
         {
           /* Check if there are any tasks in the waiting for semaphore
            * task list that are waiting for this semaphore. This is a
@@ -153,6 +180,7 @@ int sem_post(FAR sem_t *sem)
                */
 
               sem_addholder_tcb(stcb, sem);
+              sem_settaken(stcb, sem);
 
               /* It is, let the task take the semaphore */
 
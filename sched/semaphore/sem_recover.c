@@ -58,11 +58,9 @@
  *   case where a task is waiting for semaphore at the time that is was
  *   killed.
  *
- *   REVISIT:  A more complete implementation would release counts on all
- *   semaphores held by the thread.  That would, however, require some
- *   significant extension to the semaphore data structures because given
- *   only the task, there is not mechanism to traverse all of the semaphores
- *   with counts held by the task.
+ *   If priority inheritance is enabled, the holder structures of all
+ *   semaphores on which the thread holds counts are also freed.  The counts
+ *   themselves are not released.
  *
  * Inputs:
  *   tcb - The TCB of the terminated task or thread
@@ -110,7 +108,7 @@ void sem_recover(FAR struct tcb_s *tcb)
        * place.
        */
 
-      sem->semcount++;
+      (void)sem_count_give(sem);
 
       /* Clear the semaphore to assure that it is not reused.  But leave the
        * state as TSTATE_WAIT_SEM.  This is necessary because this is a
@@ -121,5 +119,8 @@ void sem_recover(FAR struct tcb_s *tcb)
       tcb->waitsem = NULL;
     }
 
+  /* Forget the semaphores that are held by the thread */
+
+  sem_recoverholders(tcb);
   leave_critical_section(flags);
 }
@@ -94,6 +94,20 @@ int sem_setprotocol(FAR sem_t *sem, int protocol)
 
   DEBUGASSERT(sem != NULL);
 
+#ifdef CONFIG_SEM_ADAPTIVE
+  /* Enable or disable adaptive waits */
+
+  if ((protocol & SEM_ADAPTIVE) != 0)
+    {
+      sem->flags |= ADAPTIVE_FLAGS_ENABLE;
+      protocol   &= ~SEM_ADAPTIVE;
+    }
+  else
+    {
+      sem->flags &= ~ADAPTIVE_FLAGS_ENABLE;
+    }
+#endif
+
   switch (protocol)
     {
       case SEM_PRIO_NONE:
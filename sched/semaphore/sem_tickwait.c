@@ -91,6 +91,13 @@ int sem_tickwait(FAR sem_t *sem, systime_t start, uint32_t delay)
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false &&
               rtcb->waitdog == NULL);
 
+  /* Make sure that a holder structure will be available if priority
+   * inheritance is enabled for the semaphore.  This must be done before the
+   * watchdog is started.
+   */
+
+  sem_reserveholders(sem);
+
   /* Create a watchdog.  We will not actually need this watchdog
    * unless the semaphore is unavailable, but we will reserve it up
    * front before we enter the following critical section.
@@ -102,6 +109,12 @@ int sem_tickwait(FAR sem_t *sem, systime_t start, uint32_t delay)
       return -ENOMEM;
     }
 
+  /* If this is an adaptive semaphore held by a task running on another
+   * CPU, spin briefly before entering the critical section.
+   */
+
+  sem_spinwait(sem);
+
   /* We will disable interrupts until we have completed the semaphore
    * wait.  We need to do this (as opposed to just disabling pre-emption)
    * because there could be interrupt handlers that are asynchronously
@@ -120,6 +120,13 @@ int sem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
     }
 #endif
 
+  /* Make sure that a holder structure will be available if priority
+   * inheritance is enabled for the semaphore.  This must be done before the
+   * watchdog is started.
+   */
+
+  sem_reserveholders(sem);
+
   /* Create a watchdog.  We will not actually need this watchdog
    * unless the semaphore is unavailable, but we will reserve it up
    * front before we enter the following critical section.
@@ -132,6 +139,12 @@ int sem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
       goto errout;
     }
 
+  /* If this is an adaptive semaphore held by a task running on another
+   * CPU, spin briefly before entering the critical section.
+   */
+
+  sem_spinwait(sem);
+
   /* We will disable interrupts until we have completed the semaphore
    * wait.  We need to do this (as opposed to just disabling pre-emption)
    * because there could be interrupt handlers that are asynchronously
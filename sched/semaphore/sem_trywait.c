@@ -88,6 +88,30 @@ int sem_trywait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
+#ifdef CONFIG_SEM_ATOMIC_COUNT
+      /* A semaphore without holders is tried without entering the critical
+       * section.
+       */
+
+      if (sem_count_nolock(sem))
+        {
+          if (sem_count_trytake(sem))
+            {
+              sem_settaken(rtcb, sem);
+              return OK;
+            }
+
+          set_errno(EAGAIN);
+          return ERROR;
+        }
+#endif
+
+      /* Make sure that a holder structure will be available if priority
+       * inheritance is enabled for the semaphore.  This does not block.
+       */
+
+      sem_tryreserveholders(sem);
+
       /* The following operations must be performed with interrupts disabled
        * because sem_post() may be called from an interrupt handler.
        */
@@ -96,11 +120,12 @@ int sem_trywait(FAR sem_t *sem)
 
       /* If the semaphore is available, give it to the requesting task */
 
-      if (sem->semcount > 0)
+      if (sem_count_trytake(sem))
         {
-          /* It is, let the task take the semaphore */
+          /* It was, the task has taken the semaphore */
 
-          sem->semcount--;
+          sem_addholder(sem);
+          sem_settaken(rtcb, sem);
           rtcb->waitsem = NULL;
           ret = OK;
         }
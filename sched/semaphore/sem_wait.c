@@ -87,6 +87,36 @@ int sem_wait(FAR sem_t *sem)
 
   DEBUGASSERT(sem != NULL && up_interrupt_context() == false);
 
+  /* If this is an adaptive semaphore held by a task running on another
+   * CPU, spin briefly before entering the critical section.
+   */
+
+  sem_spinwait(sem);
+
+#ifdef CONFIG_SEM_ATOMIC_COUNT
+  /* Take an available count on a semaphore without holders without
+   * entering the critical section.  A pending cancellation must be acted
+   * upon below, but a cancellation requested after this check is no
+   * different from one requested after sem_wait() returns.
+   */
+
+  if (sem != NULL && sem_count_nolock(sem) &&
+#ifdef CONFIG_CANCELLATION_POINTS
+      (rtcb->flags & TCB_FLAG_CANCEL_PENDING) == 0 &&
+#endif
+      sem_count_trytake(sem))
+    {
+      sem_settaken(rtcb, sem);
+      return OK;
+    }
+#endif
+
+  /* Make sure that a holder structure will be available if priority
+   * inheritance is enabled for the semaphore.
+   */
+
+  sem_reserveholders(sem);
+
   /* The following operations must be performed with interrupts
    * disabled because sem_post() may be called from an interrupt
    * handler.
@@ -114,14 +144,14 @@ int sem_wait(FAR sem_t *sem)
 
   if (sem != NULL)
     {
-      /* Check if the lock is available */
+      /* Decrement the count and check if the lock was available */
 
-      if (sem->semcount > 0)
+      if (sem_count_take(sem))
         {
-          /* It is, let the task take the semaphore. */
+          /* It was, the task has taken the semaphore. */
 
-          sem->semcount--;
           sem_addholder(sem);
+          sem_settaken(rtcb, sem);
           rtcb->waitsem = NULL;
           ret = OK;
         }
@@ -138,13 +168,13 @@ int sem_wait(FAR sem_t *sem)
 
           ASSERT(rtcb->waitsem == NULL);
 
-          /* Handle the POSIX semaphore (but don't set the owner yet) */
-
-          sem->semcount--;
-
-          /* Save the waited on semaphore in the TCB */
+          /* The count was already decremented above, recording this
+           * thread as a waiter (but don't set the owner yet).  Save the
+           * waited on semaphore in the TCB.
+           */
 
           rtcb->waitsem = sem;
+          sem_countblock(sem);
 
           /* If priority inheritance is enabled, then check the priority of
            * the holder of the semaphore.
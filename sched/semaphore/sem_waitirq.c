@@ -109,7 +109,7 @@ void sem_waitirq(FAR struct tcb_s *wtcb, int errcode)
        * place.
        */
 
-      sem->semcount++;
+      (void)sem_count_give(sem);
 
       /* Indicate that the semaphore wait is over. */
 
@@ -49,6 +49,107 @@
 #include <sched.h>
 #include <queue.h>
 
+#ifdef CONFIG_SEM_ATOMIC_COUNT
+#  include <limits.h>
+#  include <assert.h>
+#endif
+
+#if defined(CONFIG_SEM_ATOMIC_COUNT) || defined(CONFIG_SEM_ADAPTIVE_STATS)
+#  include <nuttx/atomic.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Semaphore count updates.  With CONFIG_SEM_ATOMIC_COUNT, an uncontended
+ * count may be taken or given without entering the critical section (see
+ * sem_count_nolock() and the pthread mutex fast path).  Every other update
+ * of the count must then also be atomic.  Otherwise, the critical section
+ * is sufficient.
+ *
+ *   sem_count_take(s)    - Decrement the count.  Return true if the count
+ *                          was positive, i.e., if the semaphore was taken
+ *                          without waiting.
+ *   sem_count_trytake(s) - Decrement the count only if it is positive.
+ *                          Return true if the count was decremented.
+ *   sem_count_give(s)    - Increment the count and return the new count.
+ *   sem_count_trygive(s) - Increment the count only if it is not negative,
+ *                          i.e., if there are no waiters.  Return true if
+ *                          the count was incremented.
+ *   sem_count_nolock(s)  - Return true if sem_count_trytake() and
+ *                          sem_count_trygive() may be used without entering
+ *                          the critical section.  That is the case if the
+ *                          semaphore does not track its holders and does
+ *                          not collect adaptive statistics.
+ */
+
+#ifdef CONFIG_SEM_ATOMIC_COUNT
+#  define sem_count_take(s)    (atomic_add_return(&(s)->semcount, -1) >= 0)
+#  define sem_count_trytake(s) sem_trytake_atomic(s)
+#  define sem_count_give(s)    atomic_add_return(&(s)->semcount, 1)
+#  define sem_count_trygive(s) sem_trygive_atomic(s)
+#  if defined(CONFIG_PRIORITY_INHERITANCE) && \
+      defined(CONFIG_SEM_ADAPTIVE_STATS)
+#    define sem_count_nolock(s) \
+       (((s)->flags & (PRIOINHERIT_FLAGS_DISABLE | ADAPTIVE_FLAGS_ENABLE)) == \
+        PRIOINHERIT_FLAGS_DISABLE)
+#  elif defined(CONFIG_PRIORITY_INHERITANCE)
+#    define sem_count_nolock(s) \
+       (((s)->flags & PRIOINHERIT_FLAGS_DISABLE) != 0)
+#  elif defined(CONFIG_SEM_ADAPTIVE_STATS)
+#    define sem_count_nolock(s) (((s)->flags & ADAPTIVE_FLAGS_ENABLE) == 0)
+#  else
+#    define sem_count_nolock(s) true
+#  endif
+#else
+#  define sem_count_take(s)    ((s)->semcount-- > 0)
+#  define sem_count_trytake(s) \
+     ((s)->semcount > 0 ? ((s)->semcount--, true) : false)
+#  define sem_count_give(s)    (++(s)->semcount)
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_SEM_ATOMIC_COUNT
+static inline bool sem_trytake_atomic(FAR sem_t *sem)
+{
+  int16_t count = atomic_read(&sem->semcount);
+
+  while (count > 0)
+    {
+      if (atomic_cmpxchg(&sem->semcount, count, count - 1))
+        {
+          return true;
+        }
+
+      count = atomic_read(&sem->semcount);
+    }
+
+  return false;
+}
+
+static inline bool sem_trygive_atomic(FAR sem_t *sem)
+{
+  int16_t count = atomic_read(&sem->semcount);
+
+  while (count >= 0)
+    {
+      ASSERT(count < SEM_VALUE_MAX);
+      if (atomic_cmpxchg(&sem->semcount, count, count + 1))
+        {
+          return true;
+        }
+
+      count = atomic_read(&sem->semcount);
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -87,7 +188,15 @@ void sem_recover(FAR struct tcb_s *tcb);
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 void sem_initholders(void);
+#  if defined(CONFIG_SEM_HOLDERS_GROWBY) && CONFIG_SEM_HOLDERS_GROWBY > 0
+void sem_reserveholders(FAR sem_t *sem);
+void sem_tryreserveholders(FAR sem_t *sem);
+#  else
+#    define sem_reserveholders(sem)
+#    define sem_tryreserveholders(sem)
+#  endif
 void sem_destroyholder(FAR sem_t *sem);
+void sem_recoverholders(FAR struct tcb_s *htcb);
 void sem_addholder(FAR sem_t *sem);
 void sem_addholder_tcb(FAR struct tcb_s *htcb, FAR sem_t *sem);
 void sem_boostpriority(FAR sem_t *sem);
@@ -100,7 +209,10 @@ void sem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
 #  endif
 #else
 #  define sem_initholders()
+#  define sem_reserveholders(sem)
+#  define sem_tryreserveholders(sem)
 #  define sem_destroyholder(sem)
+#  define sem_recoverholders(htcb)
 #  define sem_addholder(sem)
 #  define sem_addholder_tcb(htcb,sem)
 #  define sem_boostpriority(sem)
@@ -109,6 +221,26 @@ void sem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
 #  define sem_canceled(stcb,sem)
 #endif
 
+/* Special logic needed only by adaptive semaphores to spin while the holder
+ * is running on another CPU and to keep track of the holder.
+ */
+
+#ifdef CONFIG_SEM_ADAPTIVE
+void sem_spinwait(FAR sem_t *sem);
+void sem_settaken(FAR struct tcb_s *htcb, FAR sem_t *sem);
+void sem_setposted(FAR sem_t *sem);
+#else
+#  define sem_spinwait(sem)
+#  define sem_settaken(htcb,sem)
+#  define sem_setposted(sem)
+#endif
+
+#ifdef CONFIG_SEM_ADAPTIVE_STATS
+#  define sem_countblock(sem) atomic_add_return(&(sem)->stats.nblocks, 1)
+#else
+#  define sem_countblock(sem)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
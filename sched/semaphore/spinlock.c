@@ -40,9 +40,14 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <sched.h>
+#include <string.h>
+#include <errno.h>
 #include <assert.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/sched_note.h>
 #include <arch/irq.h>
@@ -66,6 +71,51 @@
 
 #undef CONFIG_SPINLOCK_LOCKDOWN /* Feature not yet available */
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+/* The list of spinlocks whose statistics are collected */
+
+static FAR struct spinstat_s *g_spinstats;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spinstat_find
+ *
+ * Description:
+ *   Find the statistics of a registered spinlock.
+ *
+ * Input Parameters:
+ *   lock - The spinlock of interest
+ *
+ * Returned Value:
+ *   The statistics of the lock or NULL if the lock is not registered.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+static FAR struct spinstat_s *spinstat_find(FAR volatile spinlock_t *lock)
+{
+  FAR struct spinstat_s *stat;
+
+  for (stat = g_spinstats; stat != NULL; stat = stat->flink)
+    {
+      if (stat->lock == lock)
+        {
+          break;
+        }
+    }
+
+  return stat;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -402,7 +452,8 @@ void spin_setbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *setlock,
                  FAR volatile spinlock_t *orlock)
 {
-#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+#if defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS) || \
+    defined(CONFIG_SPINLOCK_STATS)
   cpu_set_t prev;
 #endif
 
@@ -412,12 +463,22 @@ void spin_setbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 
   /* Then set the bit and mark the 'orlock' as locked */
 
-#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+#if defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS) || \
+    defined(CONFIG_SPINLOCK_STATS)
   prev    = *set;
 #endif
   *set   |= (1 << cpu);
   *orlock = SP_LOCKED;
 
+#ifdef CONFIG_SPINLOCK_STATS
+  if (prev == 0)
+    {
+      /* Start measuring the time that the lock is held */
+
+      spinstat_lock(orlock);
+    }
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   if (prev == 0)
     {
@@ -453,7 +514,8 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *setlock,
                  FAR volatile spinlock_t *orlock)
 {
-#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+#if defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS) || \
+    defined(CONFIG_SPINLOCK_STATS)
   cpu_set_t prev;
 #endif
 
@@ -465,9 +527,19 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
    * upon the resulting state of the CPU set.
    */
 
-#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+#if defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS) || \
+    defined(CONFIG_SPINLOCK_STATS)
   prev    = *set;
 #endif
+#ifdef CONFIG_SPINLOCK_STATS
+  if (prev != 0 && (prev & ~(1 << cpu)) == 0)
+    {
+      /* The last holder is about to release the lock */
+
+      spinstat_unlock(orlock);
+    }
+#endif
+
   *set   &= ~(1 << cpu);
   *orlock = (*set != 0) ? SP_LOCKED : SP_UNLOCKED;
 
@@ -485,4 +557,261 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
   spin_unlock(setlock);
 }
 
+/****************************************************************************
+ * Name: spin_lock_irqsave
+ *
+ * Description:
+ *   Disable interrupts on the local CPU, then loop until the spinlock is
+ *   successfully locked.  The lock must be a leaf lock; see
+ *   include/nuttx/spinlock.h.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *
+ * Returned Value:
+ *   The previous interrupt state that must be passed to
+ *   spin_unlock_irqrestore().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_irqsave(FAR volatile spinlock_t *lock)
+{
+  irqstate_t flags;
+#ifdef CONFIG_SPINLOCK_STATS
+  uint32_t start = up_perf_gettime();
+  bool contended = false;
+#endif
+
+  /* Disable local interrupts first so that the lock cannot be requested
+   * again by an interrupt handler on this CPU while it is held.
+   */
+
+  flags = up_irq_save();
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are waiting for a spinlock */
+
+  sched_note_spinlock(this_task(), lock);
+#endif
+
+  while (up_testset(lock) == SP_LOCKED)
+    {
+#ifdef CONFIG_SPINLOCK_STATS
+      contended = true;
+#endif
+      SP_DSB();
+    }
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we have the spinlock */
+
+  sched_note_spinlocked(this_task(), lock);
+#endif
+  SP_DMB();
+
+#ifdef CONFIG_SPINLOCK_STATS
+  spinstat_wait(lock, start, contended);
+  spinstat_lock(lock);
+#endif
+
+  return flags;
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore
+ *
+ * Description:
+ *   Release a spinlock taken by spin_lock_irqsave() and restore the
+ *   interrupt state of the local CPU.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the spinlock object to unlock.
+ *   flags - The value returned by spin_lock_irqsave()
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_irqrestore(FAR volatile spinlock_t *lock, irqstate_t flags)
+{
+#ifdef CONFIG_SPINLOCK_STATS
+  spinstat_unlock(lock);
+#endif
+
+  spin_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_register
+ *
+ * Description:
+ *   Register a spinlock so that its wait and hold times are measured and
+ *   reported in /proc/spinlocks.
+ *
+ * Input Parameters:
+ *   stat - Caller provided storage for the statistics.
+ *   lock - The spinlock to be monitored
+ *   name - A name that identifies the lock
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called during initialization before the lock is used.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spin_register(FAR struct spinstat_s *stat,
+                   FAR volatile spinlock_t *lock, FAR const char *name)
+{
+  FAR struct spinstat_s **tail;
+
+  DEBUGASSERT(stat != NULL && lock != NULL && name != NULL);
+
+  memset(stat, 0, sizeof(struct spinstat_s));
+  stat->lock = lock;
+  stat->name = name;
+
+  /* Add the new entry to the end of the list so that the index reported
+   * by spin_getstats() follows the order of registration.
+   */
+
+  for (tail = &g_spinstats; *tail != NULL; tail = &(*tail)->flink);
+  *tail = stat;
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_getstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of a registered spinlock.  The
+ *   snapshot is taken without holding the lock so the fields may not be
+ *   perfectly consistent with each other.
+ *
+ * Input Parameters:
+ *   index - The index of the registered lock (in order of registration)
+ *   stat  - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if there is no
+ *   lock with this index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+int spin_getstats(int index, FAR struct spinstat_s *stat)
+{
+  FAR struct spinstat_s *curr;
+
+  DEBUGASSERT(stat != NULL);
+
+  for (curr = g_spinstats; curr != NULL && index > 0; curr = curr->flink)
+    {
+      index--;
+    }
+
+  if (curr == NULL || index < 0)
+    {
+      return -ENOENT;
+    }
+
+  memcpy(stat, curr, sizeof(struct spinstat_s));
+  stat->flink = NULL;
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: spinstat_wait
+ *
+ * Description:
+ *   Account for the time spent waiting for a spinlock that has just been
+ *   taken.
+ *
+ * Input Parameters:
+ *   lock      - The spinlock that was taken
+ *   start     - The performance counter value when the wait started
+ *   contended - True if the lock was not available on the first attempt
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   Called by the holder of the lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_STATS
+void spinstat_wait(FAR volatile spinlock_t *lock, uint32_t start,
+                   bool contended)
+{
+  FAR struct spinstat_s *stat = spinstat_find(lock);
+  uint32_t elapsed;
+
+  if (stat != NULL && contended)
+    {
+      elapsed         = up_perf_gettime() - start;
+      stat->spintime += elapsed;
+      stat->ncontended++;
+
+      if (elapsed > stat->maxspin)
+        {
+          stat->maxspin = elapsed;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: spinstat_lock
+ *
+ * Description:
+ *   Start measuring the hold time of a spinlock.
+ *
+ ****************************************************************************/
+
+void spinstat_lock(FAR volatile spinlock_t *lock)
+{
+  FAR struct spinstat_s *stat = spinstat_find(lock);
+
+  if (stat != NULL)
+    {
+      stat->locktime = up_perf_gettime();
+      stat->nlocks++;
+    }
+}
+
+/****************************************************************************
+ * Name: spinstat_unlock
+ *
+ * Description:
+ *   Account for the hold time of a spinlock that is about to be released.
+ *
+ ****************************************************************************/
+
+void spinstat_unlock(FAR volatile spinlock_t *lock)
+{
+  FAR struct spinstat_s *stat = spinstat_find(lock);
+  uint32_t elapsed;
+
+  if (stat != NULL)
+    {
+      elapsed         = up_perf_gettime() - stat->locktime;
+      stat->holdtime += elapsed;
+
+      if (elapsed > stat->maxhold)
+        {
+          stat->maxhold = elapsed;
+        }
+    }
+}
+#endif /* CONFIG_SPINLOCK_STATS */
+
 #endif /* CONFIG_SPINLOCK */
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <string.h>
 #include <sched.h>
 #include <errno.h>
 #include <debug.h>
@@ -93,9 +94,12 @@ static int thread_create(FAR const char *name, uint8_t ttype, int priority,
   int errcode;
   int ret;
 
-  /* Allocate a TCB for the new task. */
+  /* Allocate a TCB for the new task.  TCBs are accessed on every context
+   * switch, so place them in fast memory if there is any.
+   */
 
-  tcb = (FAR struct task_tcb_s *)kmm_zalloc(sizeof(struct task_tcb_s));
+  tcb = (FAR struct task_tcb_s *)
+    kmm_malloc_region(sizeof(struct task_tcb_s), MM_REGION_FAST);
   if (!tcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -103,6 +107,8 @@ static int thread_create(FAR const char *name, uint8_t ttype, int priority,
       goto errout;
     }
 
+  memset(tcb, 0, sizeof(struct task_tcb_s));
+
   /* Allocate a new task group with privileges appropriate for the parent
    * thread type.
    */
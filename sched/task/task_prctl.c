@@ -46,6 +46,7 @@
 #include <debug.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/clock.h>
 
 #include "sched/sched.h"
 #include "task/task.h"
@@ -63,8 +64,9 @@
  *   the specific command.
  *
  * Returned Value:
- *   The returned value may depend on the specific commnand.  For PR_SET_NAME
- *   and PR_GET_NAME, the returned value of 0 indicates successful operation.
+ *   The returned value may depend on the specific commnand.  For PR_SET_NAME,
+ *   PR_GET_NAME, PR_SET_TIMERSLACK, and PR_GET_TIMERSLACK, the returned
+ *   value of 0 indicates successful operation.
  *   On any failure, -1 is retruend and the errno value is set appropriately.
  *
  *     EINVAL The value of 'option' is not recognized.
@@ -153,17 +155,87 @@ int prctl(int option, ...)
         goto errout;
 #endif
 
+      case PR_SET_TIMERSLACK:
+      case PR_GET_TIMERSLACK:
+#ifdef CONFIG_WDOG_SLACK
+        {
+          FAR unsigned long *pslack = NULL;
+          unsigned long slack = 0;
+          FAR struct tcb_s *tcb;
+          int pid;
+
+          /* Get the prctl arguments */
+
+          if (option == PR_SET_TIMERSLACK)
+            {
+              slack  = va_arg(ap, unsigned long);
+            }
+          else
+            {
+              pslack = va_arg(ap, FAR unsigned long *);
+            }
+
+          pid = va_arg(ap, int);
+
+          /* Get the TCB associated with the PID (handling the special case of
+           * pid==0 meaning "this thread")
+           */
+
+          if (!pid)
+            {
+              tcb = this_task();
+            }
+          else
+            {
+              tcb = sched_gettcb(pid);
+            }
+
+          if (!tcb)
+            {
+              serr("ERROR: Pid does not correspond to a task: %d\n", pid);
+              errcode = ESRCH;
+              goto errout;
+            }
+
+          /* Now get or set the timer slack.  The slack applies from the next
+           * timed wait of the thread.
+           */
+
+          if (option == PR_SET_TIMERSLACK)
+            {
+              tcb->timerslack = (uint32_t)(slack / NSEC_PER_TICK);
+            }
+          else
+            {
+              if (!pslack)
+                {
+                  serr("ERROR: No location provided\n");
+                  errcode = EFAULT;
+                  goto errout;
+                }
+
+              *pslack = (unsigned long)TICK2NSEC(tcb->timerslack);
+            }
+        }
+        break;
+#else
+        serr("ERROR: Option not enabled: %d\n", option);
+        errcode = ENOSYS;
+        goto errout;
+#endif
+
       default:
         serr("ERROR: Unrecognized option: %d\n", option);
         errcode = EINVAL;
         goto errout;
     }
 
-  /* Not reachable unless CONFIG_TASK_NAME_SIZE is > 0.  NOTE: This might
-   * change if additional commands are supported.
+  /* Not reachable unless CONFIG_TASK_NAME_SIZE is > 0 or CONFIG_WDOG_SLACK
+   * is enabled.  NOTE: This might change if additional commands are
+   * supported.
    */
 
-#if CONFIG_TASK_NAME_SIZE > 0
+#if CONFIG_TASK_NAME_SIZE > 0 || defined(CONFIG_WDOG_SLACK)
   va_end(ap);
   return OK;
 #endif
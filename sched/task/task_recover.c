@@ -100,4 +100,17 @@ void task_recover(FAR struct tcb_s *tcb)
       DEBUGVERIFY(sched_sporadic_stop(tcb));
     }
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE
+  if ((tcb->flags & TCB_FLAG_POLICY_MASK) == TCB_FLAG_SCHED_DEADLINE)
+    {
+      /* Release the deadline reservation.  The thread is no longer
+       * ordered by deadline in whatever list it is still in.
+       */
+
+      DEBUGVERIFY(sched_deadline_stop(tcb));
+      tcb->flags &= ~TCB_FLAG_POLICY_MASK;
+      tcb->flags |= TCB_FLAG_SCHED_FIFO;
+    }
+#endif
 }
@@ -153,7 +153,7 @@ int task_restart(pid_t pid)
   tasklist = TLIST_HEAD(tcb->cmn.task_state);
 #endif
 
-  dq_rem((FAR dq_entry_t *)tcb, tasklist);
+  sched_remprioritized((FAR struct tcb_s *)tcb, tasklist);
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
 
   /* Deallocate anything left in the TCB's queues */
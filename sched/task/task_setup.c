@@ -130,6 +130,9 @@ static int task_assignpid(FAR struct tcb_s *tcb)
           g_pidhash[hash_ndx].pid   = next_pid;
 #ifdef CONFIG_SCHED_CPULOAD
           g_pidhash[hash_ndx].ticks = 0;
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_PRECISE
+          g_pidhash[hash_ndx].runtime = 0;
 #endif
           tcb->pid = next_pid;
 
@@ -173,6 +176,12 @@ static inline void task_inherit_affinity(FAR struct tcb_s *tcb)
 {
   FAR struct tcb_s *rtcb = this_task();
   tcb->affinity = rtcb->affinity;
+
+  /* The new task is considered to have last run on the CPU that created
+   * it.  Its stack and TCB were just initialized there.
+   */
+
+  tcb->cpu      = rtcb->cpu;
 }
 #else
 #  define task_inherit_affinity(tcb)
@@ -401,6 +410,14 @@ static int thread_schedsetup(FAR struct tcb_s *tcb, int priority,
       task_inherit_affinity(tcb);
 #endif
 
+#ifdef CONFIG_WDOG_SLACK
+      /* New tasks and threads inherit the timer slack of the parent
+       * thread.
+       */
+
+      tcb->timerslack     = this_task()->timerslack;
+#endif
+
 #ifndef CONFIG_DISABLE_SIGNALS
       /* exec(), pthread_create(), task_create(), and vfork() all
        * inherit the signal mask of the parent thread.
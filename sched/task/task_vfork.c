@@ -49,6 +49,7 @@
 #include <debug.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
 
 #include "sched/sched.h"
 #include "group/group.h"
@@ -264,9 +265,10 @@ FAR struct task_tcb_s *task_vforksetup(start_t retaddr)
       ttype = TCB_FLAG_TTYPE_TASK;
     }
 
-  /* Allocate a TCB for the child task. */
+  /* Allocate a TCB for the child task, preferably in fast memory. */
 
-  child = (FAR struct task_tcb_s *)kmm_zalloc(sizeof(struct task_tcb_s));
+  child = (FAR struct task_tcb_s *)
+    kmm_malloc_region(sizeof(struct task_tcb_s), MM_REGION_FAST);
   if (!child)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -274,6 +276,8 @@ FAR struct task_tcb_s *task_vforksetup(start_t retaddr)
       return NULL;
     }
 
+  memset(child, 0, sizeof(struct task_tcb_s));
+
   /* Allocate a new task group with the same privileges as the parent */
 
 #ifdef HAVE_TASK_GROUP
@@ -50,10 +50,114 @@
 #include "sched/sched.h"
 #include "wdog/wdog.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_waitrunning
+ *
+ * Description:
+ *   Wait until the function of a watchdog is no longer being executed on
+ *   any other CPU.  This preserves the behavior of the critical section
+ *   based implementation:  When wd_cancel() returns, the watchdog function
+ *   does not run.
+ *
+ *   If the caller holds the critical section then no watchdog function can
+ *   be executing on another CPU and this returns immediately.  A watchdog
+ *   function that cancels its own watchdog is not waited for.
+ *
+ * Parameters:
+ *   wdog - The watchdog of interest
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef WDOG_SPINLOCK
+static void wd_waitrunning(FAR struct wdog_s *wdog)
+{
+  irqstate_t flags;
+  int me;
+  int cpu;
+
+  flags = up_irq_save();
+  me    = this_cpu();
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      while (cpu != me && g_wdrunning[cpu] == wdog)
+        {
+          /* The watchdog function may need to pause this CPU, for example
+           * to make a task ready-to-run.  Handle that request while
+           * spinning with interrupts disabled.
+           */
+
+          if (up_cpu_pausereq(me))
+            {
+              up_cpu_paused(me);
+            }
+
+          SP_DSB();
+        }
+    }
+
+  up_irq_restore(flags);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel and mark it inactive.
+ *
+ * Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the timing wheel lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+void wd_remove(FAR struct wdog_s *wdog)
+{
+  DEBUGASSERT(g_wdnactive > 0 && WDOG_ISACTIVE(wdog));
+
+  /* Remove the watchdog from its slot in the timing wheel.  The slot is
+   * selected by the expiration time so no search is necessary.
+   */
+
+  dq_rem((FAR dq_entry_t *)wdog, WDOG_SLOT(wdog->expire));
+  g_wdnactive--;
+
+#ifdef CONFIG_SCHED_TICKLESS
+  /* If this was the watchdog that the interval timer is waiting for,
+   * then reassess the interval timer that will generate the next
+   * interval event.
+   */
+
+  if (WDOG_LATEST(wdog) == g_wdnext)
+    {
+      sched_timer_reassess();
+    }
+#endif
+
+  /* Mark the watchdog inactive */
+
+  wdog->next = NULL;
+  wdog->prev = NULL;
+  WDOG_CLRACTIVE(wdog);
+}
+
 /****************************************************************************
  * Name: wd_cancel
  *
@@ -72,8 +176,6 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
-  FAR struct wdog_s *curr;
-  FAR struct wdog_s *prev;
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -81,7 +183,7 @@ int wd_cancel(WDOG_ID wdog)
    * cancellation is complete
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
 
   /* Make sure that the watchdog is initialized (non-NULL) and is still
    * active.
@@ -89,66 +191,22 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
-      /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
-       * to do this because there are additional operations that need to be
-       * done.
-       */
-
-      prev = NULL;
-      curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-      while ((curr) && (curr != wdog))
-        {
-          prev = curr;
-          curr = curr->next;
-        }
-
-      /* Check if the watchdog was found in the list.  If not, then an OS
-       * error has occurred because the watchdog is marked active!
-       */
-
-      ASSERT(curr);
-
-      /* If there is a watchdog in the timer queue after the one that
-       * is being cancelled, then it inherits the remaining ticks.
-       */
-
-      if (curr->next)
-        {
-          curr->next->lag += curr->lag;
-        }
-
-      /* Now, remove the watchdog from the timer queue */
-
-      if (prev)
-        {
-          /* Remove the watchdog from mid- or end-of-queue */
-
-          (void)sq_remafter((FAR sq_entry_t *)prev, &g_wdactivelist);
-        }
-      else
-        {
-          /* Remove the watchdog at the head of the queue */
-
-          (void)sq_remfirst(&g_wdactivelist);
-
-          /* Reassess the interval timer that will generate the next
-           * interval event.
-           */
-
-          sched_timer_reassess();
-        }
-
-      /* Mark the watchdog inactive */
+      wd_remove(wdog);
+      ret = OK;
+    }
 
-      wdog->next = NULL;
-      WDOG_CLRACTIVE(wdog);
+  wd_unlock(flags);
 
-      /* Return success */
+#ifdef WDOG_SPINLOCK
+  /* The watchdog may have just expired on another CPU.  Make sure that its
+   * function has returned.
+   */
 
-      ret = OK;
+  if (wdog != NULL)
+    {
+      wd_waitrunning(wdog);
     }
+#endif
 
-  leave_critical_section(flags);
   return ret;
 }
@@ -71,29 +71,17 @@ int wd_gettime(WDOG_ID wdog)
 
   /* Verify the wdog */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
-      /* Traverse the watchdog list accumulating lag times until we find the
-       * wdog that we are looking for
-       */
+      /* The expiration time is absolute so no traversal is needed */
 
-      FAR struct wdog_s *curr;
-      int delay = 0;
+      int delay = WDOG_DELTA(wdog);
 
-      for (curr = (FAR struct wdog_s *)g_wdactivelist.head;
-           curr != NULL;
-           curr = curr->next)
-        {
-          delay += curr->lag;
-          if (curr == wdog)
-            {
-              leave_critical_section(flags);
-              return delay;
-            }
-        }
+      wd_unlock(flags);
+      return delay > 0 ? delay : 0;
     }
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return 0;
 }
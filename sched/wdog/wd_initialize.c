@@ -41,41 +41,77 @@
 
 #include <queue.h>
 
+#include <nuttx/mm/mempool.h>
+
 #include "wdog/wdog.h"
 
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* The g_wdfreelist data structure is a singly linked list of watchdogs
- * available to the system for delayed function use.
+/* g_wdpool is the pool of watchdogs available to the system for delayed
+ * function use.  The last CONFIG_WDOG_INTRESERVE free watchdogs are
+ * reserved for interrupt handlers.
  */
 
-sq_queue_t g_wdfreelist;
+struct mempool_s g_wdpool;
 
-/* The g_wdactivelist data structure is a singly linked list ordered by
- * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+/* g_wdwheel is the timing wheel of active watchdogs.  When the watchdog
+ * time reaches the expiration time of a watchdog in the current slot, the
+ * watchdog is removed from the wheel and its function is called.
  */
 
-sq_queue_t g_wdactivelist;
+dq_queue_t g_wdwheel[WDOG_NSLOTS];
+
+/* g_wdtick is the current watchdog time in clock ticks */
+
+uint32_t g_wdtick;
+
+/* g_wdnactive is the number of watchdogs in the timing wheel */
+
+unsigned int g_wdnactive;
 
-/* This is the number of free, pre-allocated watchdog structures in the
- * g_wdfreelist.  This value is used to enforce a reserve for interrupt
- * handlers.
+#ifdef CONFIG_SCHED_TICKLESS
+/* g_wdnext is the expiration time of the earliest watchdog as determined
+ * by the last call to wd_timer().
  */
 
-uint16_t g_wdnfree;
+uint32_t g_wdnext;
+#endif
+
+#ifdef CONFIG_WDOG_SLACK
+/* g_wdstats holds the watchdog expiration statistics */
+
+struct wdstats_s g_wdstats;
+#endif
+
+#ifdef WDOG_SPINLOCK
+/* g_wdlock protects the timing wheel, g_wdtick and g_wdnactive */
+
+volatile spinlock_t g_wdlock SP_SECTION = SP_UNLOCKED;
+
+/* g_wdrunning holds the watchdog whose function is being executed on each
+ * CPU.
+ */
+
+FAR struct wdog_s *volatile g_wdrunning[CONFIG_SMP_NCPUS];
+#endif
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* g_wdpool is a list of pre-allocated watchdogs. The number of watchdogs
+/* g_wdstorage holds the pre-allocated watchdogs. The number of watchdogs
  * in the pool is a configuration item.
  */
 
-static struct wdog_s g_wdpool[CONFIG_PREALLOC_WDOGS];
+static struct wdog_s g_wdstorage[CONFIG_PREALLOC_WDOGS];
+
+#if defined(WDOG_SPINLOCK) && defined(CONFIG_SPINLOCK_STATS)
+/* Lock statistics of the timing wheel lock */
+
+static struct spinstat_s g_wdstat;
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -102,24 +138,24 @@ static struct wdog_s g_wdpool[CONFIG_PREALLOC_WDOGS];
 
 void wd_initialize(void)
 {
-  FAR struct wdog_s *wdog = g_wdpool;
   int i;
 
-  /* Initialize watchdog lists */
-
-  sq_init(&g_wdfreelist);
-  sq_init(&g_wdactivelist);
+  /* Initialize the timing wheel of active watchdogs */
 
-  /* The g_wdfreelist must be loaded at initialization time to hold the
-   * configured number of watchdogs.
-   */
-
-  for (i = 0; i < CONFIG_PREALLOC_WDOGS; i++)
+  for (i = 0; i < WDOG_NSLOTS; i++)
     {
-      sq_addlast((FAR sq_entry_t *)wdog++, &g_wdfreelist);
+      dq_init(&g_wdwheel[i]);
     }
 
-  /* All watchdogs are free */
+  /* The pool must be loaded at initialization time to hold the configured
+   * number of watchdogs.
+   */
+
+  (void)mempool_initialize(&g_wdpool, "wdog", sizeof(struct wdog_s),
+                           g_wdstorage, CONFIG_PREALLOC_WDOGS,
+                           CONFIG_WDOG_NEXPAND, CONFIG_WDOG_INTRESERVE);
 
-  g_wdnfree = CONFIG_PREALLOC_WDOGS;
+#if defined(WDOG_SPINLOCK) && defined(CONFIG_SPINLOCK_STATS)
+  spin_register(&g_wdstat, &g_wdlock, "wdog");
+#endif
 }
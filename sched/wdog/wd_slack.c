@@ -0,0 +1,133 @@
+/****************************************************************************
+ * sched/wdog/wd_slack.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wdog.h>
+
+#include "sched/sched.h"
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_SLACK
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_setslack
+ *
+ * Description:
+ *   Set the timer slack of a watchdog:  The watchdog function may then be
+ *   called up to 'slack' ticks after the watchdog expires so that its
+ *   expiration can be handled by the same interval timer event as other
+ *   nearby expirations.  The watchdog never expires early.
+ *
+ *   A new watchdog has no slack.  The slack is retained when the watchdog
+ *   is restarted.
+ *
+ * Parameters:
+ *   wdog  - watchdog ID
+ *   slack - The permitted lateness in clock ticks
+ *
+ * Return Value:
+ *   Zero (OK) is returned on success;  A negated errno value is returned to
+ *   indicate the nature of any failure.
+ *
+ ****************************************************************************/
+
+int wd_setslack(WDOG_ID wdog, uint32_t slack)
+{
+  irqstate_t flags;
+
+  if (wdog == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = wd_lock();
+  wdog->slack = slack;
+
+  /* If the watchdog is active, the interval timer may be waiting for a
+   * time that was chosen using the old slack.
+   */
+
+  if (WDOG_ISACTIVE(wdog))
+    {
+      sched_timer_reassess();
+    }
+
+  wd_unlock(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wd_getstats
+ *
+ * Description:
+ *   Return the watchdog expiration statistics.  The ratio of 'ncoalesced'
+ *   to 'nwakeups' shows how many timer interrupts were avoided by timer
+ *   slack.
+ *
+ * Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void wd_getstats(FAR struct wdstats_s *stats)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  flags = wd_lock();
+  memcpy(stats, &g_wdstats, sizeof(struct wdstats_s));
+  wd_unlock(flags);
+}
+
+#endif /* CONFIG_WDOG_SLACK */
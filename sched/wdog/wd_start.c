@@ -62,10 +62,6 @@
 #  define MIN(a,b) (((a) < (b)) ? (a) : (b))
 #endif
 
-#ifndef MAX
-#  define MAX(a,b) (((a) > (b)) ? (a) : (b))
-#endif
-
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -94,92 +90,132 @@ typedef void (*wdentry4_t)(int argc, wdparm_t arg1, wdparm_t arg2,
  * Name: wd_expiration
  *
  * Description:
- *   Check if the timer for the watchdog at the head of list is ready to
- *   run.  If so, remove the watchdog from the list and execute it.
+ *   Check if any watchdog in the timing wheel slot of the current watchdog
+ *   time is ready to run.  If so, remove each such watchdog from the wheel
+ *   and execute it.
  *
  * Parameters:
  *   None
  *
  * Return Value:
- *   None
+ *   The number of watchdog functions that were executed.
  *
  * Assumptions:
+ *   Called with interrupts disabled.
  *
  ****************************************************************************/
 
-static inline void wd_expiration(void)
+static inline int wd_expiration(void)
 {
+  FAR dq_queue_t *slot = WDOG_SLOT(g_wdtick);
   FAR struct wdog_s *wdog;
+  irqstate_t flags;
+  wdentry_t func;
+  wdparm_t parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_PIC
+  FAR void *picbase;
+#endif
+  int nexpired = 0;
+  int argc;
+  int i;
 
-  /* Check if the watchdog at the head of the list is ready to run */
+  /* Process each watchdog in the slot that became ready to run at this
+   * time.  Watchdogs that belong to a later revolution of the wheel remain
+   * in the slot.  The watchdog function may start or cancel other
+   * watchdogs so the slot is searched again from the head after each
+   * watchdog function returns.  Watchdogs that expire at the same time
+   * are executed in the order in which they were started.
+   */
 
-  if (((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0)
+  for (; ; )
     {
-      /* Process the watchdog at the head of the list as well as any
-       * other watchdogs that became ready to run at this time
-       */
+      flags = wd_lock();
+
+      for (wdog = (FAR struct wdog_s *)slot->head;
+           wdog != NULL && WDOG_DELTA(wdog) > 0;
+           wdog = wdog->next);
 
-      while (g_wdactivelist.head &&
-             ((FAR struct wdog_s *)g_wdactivelist.head)->lag <= 0)
+      if (wdog == NULL)
         {
-          /* Remove the watchdog from the head of the list */
+          wd_unlock(flags);
+          break;
+        }
 
-          wdog = (FAR struct wdog_s *)sq_remfirst(&g_wdactivelist);
+      /* Remove the watchdog from the timing wheel */
 
-          /* If there is another watchdog behind this one, update its
-           * its lag (this shouldn't be necessary).
-           */
+      dq_rem((FAR dq_entry_t *)wdog, slot);
+      g_wdnactive--;
 
-          if (g_wdactivelist.head)
-            {
-              ((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
-            }
+      wdog->next = NULL;
+      wdog->prev = NULL;
 
-          /* Indicate that the watchdog is no longer active. */
+      /* Indicate that the watchdog is no longer active. */
 
-          WDOG_CLRACTIVE(wdog);
+      WDOG_CLRACTIVE(wdog);
 
-          /* Execute the watchdog function */
+      /* Take a copy of the watchdog function and its parameters.  The
+       * watchdog may be restarted or deleted as soon as the timing wheel
+       * is unlocked.
+       */
 
-          up_setpicbase(wdog->picbase);
-          switch (wdog->argc)
-            {
-              default:
-                DEBUGPANIC();
-                break;
+      func = wdog->func;
+      argc = wdog->argc;
+#ifdef CONFIG_PIC
+      picbase = wdog->picbase;
+#endif
 
-              case 0:
-                (*((wdentry0_t)(wdog->func)))(0);
-                break;
+      for (i = 0; i < argc && i < CONFIG_MAX_WDOGPARMS; i++)
+        {
+          parm[i] = wdog->parm[i];
+        }
+
+#ifdef WDOG_SPINLOCK
+      g_wdrunning[this_cpu()] = wdog;
+#endif
+      wd_unlock(flags);
+
+      /* Execute the watchdog function */
+
+      up_setpicbase(picbase);
+      switch (argc)
+        {
+          default:
+            DEBUGPANIC();
+            break;
+
+          case 0:
+            (*((wdentry0_t)func))(0);
+            break;
 
 #if CONFIG_MAX_WDOGPARMS > 0
-              case 1:
-                (*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-                break;
+          case 1:
+            (*((wdentry1_t)func))(1, parm[0]);
+            break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 1
-              case 2:
-                (*((wdentry2_t)(wdog->func)))(2,
-                                wdog->parm[0], wdog->parm[1]);
-                break;
+          case 2:
+            (*((wdentry2_t)func))(2, parm[0], parm[1]);
+            break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 2
-              case 3:
-                (*((wdentry3_t)(wdog->func)))(3,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2]);
-                break;
+          case 3:
+            (*((wdentry3_t)func))(3, parm[0], parm[1], parm[2]);
+            break;
 #endif
 #if CONFIG_MAX_WDOGPARMS > 3
-              case 4:
-                (*((wdentry4_t)(wdog->func)))(4,
-                                wdog->parm[0], wdog->parm[1],
-                                wdog->parm[2], wdog->parm[3]);
-                break;
+          case 4:
+            (*((wdentry4_t)func))(4, parm[0], parm[1], parm[2], parm[3]);
+            break;
 #endif
-            }
         }
+
+#ifdef WDOG_SPINLOCK
+      g_wdrunning[this_cpu()] = NULL;
+#endif
+      nexpired++;
     }
+
+  return nexpired;
 }
 
 /****************************************************************************
@@ -222,10 +258,6 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
-  FAR struct wdog_s *curr;
-  FAR struct wdog_s *prev;
-  FAR struct wdog_s *next;
-  int32_t now;
   irqstate_t flags;
   int i;
 
@@ -243,10 +275,10 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
    * the critical section is established.
    */
 
-  flags = enter_critical_section();
+  flags = wd_lock();
   if (WDOG_ISACTIVE(wdog))
     {
-      wd_cancel(wdog);
+      wd_remove(wdog);
     }
 
   /* Save the data in the watchdog structure */
@@ -268,6 +300,17 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 #endif
   va_end(ap);
 
+#ifdef CONFIG_WDOG_SLACK
+  /* The timeout of a timed wait uses the timer slack of the waiting
+   * thread.
+   */
+
+  if (wdog == this_task()->waitdog)
+    {
+      wdog->slack = this_task()->timerslack;
+    }
+#endif
+
   /* Calculate delay+1, forcing the delay into a range that we can handle */
 
   if (delay <= 0)
@@ -281,114 +324,36 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Cancel the interval timer that drives the timing events.  This will cause
-   * wd_timer to be called which update the delay value for the first time
-   * at the head of the timer list (there is a possibility that it could even
-   * remove it).
+   * wd_timer to be called which will bring the watchdog time up to date
+   * (there is a possibility that it could even expire some watchdogs).
    */
 
   (void)sched_timer_cancel();
 #endif
 
-  /* Do the easy case first -- when the watchdog timer queue is empty. */
-
-  if (g_wdactivelist.head == NULL)
-    {
-      /* Add the watchdog to the head == tail of the queue. */
-
-      sq_addlast((FAR sq_entry_t *)wdog, &g_wdactivelist);
-    }
-
-  /* There are other active watchdogs in the timer queue */
-
-  else
-    {
-      now = 0;
-      prev = curr = (FAR struct wdog_s *)g_wdactivelist.head;
-
-      /* Advance to positive time */
-
-      while ((now += curr->lag) < 0 && curr->next)
-        {
-          prev = curr;
-          curr = curr->next;
-        }
-
-      /* Advance past shorter delays */
-
-      while (now <= delay && curr->next)
-        {
-          prev = curr;
-          curr = curr->next;
-          now += curr->lag;
-        }
-
-      /* Check if the new wdog must be inserted before the curr. */
-
-      if (delay < now)
-        {
-          /* The relative delay time is smaller or equal to the current delay
-           * time, so decrement the current delay time by the new relative
-           * delay time.
-           */
-
-          delay -= (now - curr->lag);
-          curr->lag -= delay;
+  /* Compute the absolute expiration time and add the watchdog to the end
+   * of the timing wheel slot selected by that time.  This takes constant
+   * time regardless of the number of active watchdogs.
+   */
 
-          /* Insert the new watchdog in the list */
+  wdog->expire = g_wdtick + (uint32_t)delay;
+  dq_addlast((FAR dq_entry_t *)wdog, WDOG_SLOT(wdog->expire));
+  g_wdnactive++;
 
-          if (curr == (FAR struct wdog_s *)g_wdactivelist.head)
-            {
-              /* Insert the watchdog at the head of the list */
+  /* Mark the watchdog as active. */
 
-              sq_addfirst((FAR sq_entry_t *)wdog, &g_wdactivelist);
-            }
-          else
-            {
-              /* Insert the watchdog in mid- or end-of-queue */
-
-              sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)wdog,
-                          &g_wdactivelist);
-
-            }
-        }
-
-      /* The new watchdog delay time is greater than the curr delay time,
-       * so the new wdog must be inserted after the curr. This only occurs
-       * if the wdog is to be added to the end of the list.
-       */
-
-      else
-        {
-          delay -= now;
-          if (!curr->next)
-            {
-              sq_addlast((FAR sq_entry_t *)wdog, &g_wdactivelist);
-            }
-          else
-            {
-              next = curr->next;
-              next->lag -= delay;
-              sq_addafter((FAR sq_entry_t *)curr, (FAR sq_entry_t *)wdog,
-                          &g_wdactivelist);
-            }
-        }
-    }
-
-  /* Put the lag into the watchdog structure and mark it as active. */
-
-  wdog->lag = delay;
   WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
   /* Resume the interval timer that will generate the next interval event.
-   * If the timer at the head of the list changed, then this will pick that
-   * new delay.
+   * If the new watchdog is now the earliest, then this will pick that new
+   * delay.
    */
 
   sched_timer_resume();
 #endif
 
-  leave_critical_section(flags);
+  wd_unlock(flags);
   return OK;
 }
 
@@ -424,8 +389,12 @@ unsigned int wd_timer(int ticks)
 #ifdef CONFIG_SMP
   irqstate_t flags;
 #endif
-  unsigned int ret;
-  int decr;
+  uint32_t delay;
+  int32_t delta;
+#ifdef CONFIG_WDOG_SLACK
+  int nexpired = 0;
+#endif
+  int i;
 
 #ifdef CONFIG_SMP
   /* We are in an interrupt handler as, as a consequence, interrupts are
@@ -440,40 +409,104 @@ unsigned int wd_timer(int ticks)
   flags = enter_critical_section();
 #endif
 
-  /* Check if there are any active watchdogs to process */
+  /* Advance the watchdog time by the number of ticks that elapsed,
+   * processing the timing wheel slot of each tick.  Only the last
+   * revolution of the wheel needs to be visited:  Any watchdog that
+   * expired earlier than that will be found in its slot anyway.
+   */
 
-  while (g_wdactivelist.head != NULL && ticks > 0)
+  if (ticks > 0)
     {
-      /* Get the watchdog at the head of the list */
+      if (g_wdnactive == 0)
+        {
+          g_wdtick += (uint32_t)ticks;
+        }
+      else
+        {
+          if (ticks > WDOG_NSLOTS)
+            {
+              g_wdtick += (uint32_t)(ticks - WDOG_NSLOTS);
+              ticks     = WDOG_NSLOTS;
+            }
 
-      wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+          for (; ticks > 0; ticks--)
+            {
+              g_wdtick++;
+#ifdef CONFIG_WDOG_SLACK
+              if (wd_expiration() > 0)
+                {
+                  nexpired++;
+                }
+#else
+              wd_expiration();
+#endif
+            }
+        }
+    }
 
-#ifndef CONFIG_SCHED_TICKLESS_ALARM
-      /* There is logic to handle the case where ticks is greater than
-       * the watchdog lag, but if the scheduling is working properly
-       * that should never happen.
-       */
+#ifdef CONFIG_WDOG_SLACK
+  /* Each distinct expiration time handled by this event beyond the first
+   * would have required its own interval timer event without slack.
+   */
 
-      DEBUGASSERT(ticks <= wdog->lag);
+  if (nexpired > 0)
+    {
+      g_wdstats.nwakeups++;
+      g_wdstats.ncoalesced += nexpired - 1;
+    }
 #endif
-      /* Decrement the lag for this watchdog. */
 
-      decr = MIN(wdog->lag, ticks);
+  /* Find the delay for the next watchdog to expire.  The slots are visited
+   * in order of increasing delay so the search can stop as soon as the
+   * shortest delay found so far is not beyond the current slot.
+   *
+   * With timer slack, the delay is instead the latest time that satisfies
+   * the slack of every watchdog.  Every watchdog that expires by then will
+   * be handled by the same event.  No watchdog in a later slot can lower
+   * that time because its slack only adds to its delay.
+   */
+
+  delay = UINT32_MAX;
+  for (i = 1; i <= WDOG_NSLOTS && g_wdnactive > 0; i++)
+    {
+      for (wdog = (FAR struct wdog_s *)WDOG_SLOT(g_wdtick + i)->head;
+           wdog != NULL;
+           wdog = wdog->next)
+        {
+          delta = WDOG_DELTA(wdog);
+          if (delta < 1)
+            {
+              delta = 1;
+            }
 
-      /* There are.  Decrement the lag counter */
+#ifdef CONFIG_WDOG_SLACK
+          if (wdog->slack > 0)
+            {
+              delta += (int32_t)MIN(wdog->slack,
+                                    (uint32_t)(INT32_MAX - delta));
+            }
+#endif
 
-      wdog->lag -= decr;
-      ticks     -= decr;
+          if ((uint32_t)delta < delay)
+            {
+              delay = (uint32_t)delta;
+            }
+        }
 
-      /* Check if the watchdog at the head of the list is ready to run */
+      if (delay <= (uint32_t)i)
+        {
+          break;
+        }
+    }
 
-      wd_expiration();
+  if (delay == UINT32_MAX)
+    {
+      delay = 0;
     }
 
-  /* Return the delay for the next watchdog to expire */
+  /* Remember the time that the interval timer will wait for */
 
-  ret = g_wdactivelist.head ?
-          ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+  g_wdnext = g_wdtick + delay;
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
@@ -481,42 +514,52 @@ unsigned int wd_timer(int ticks)
 
   /* Return the delay for the next watchdog to expire */
 
-  return ret;
+  return (unsigned int)delay;
 }
 
 #else
 void wd_timer(void)
 {
-#ifdef CONFIG_SMP
+#ifdef WDOG_SPINLOCK
   irqstate_t flags;
+  unsigned int nactive;
 
-  /* We are in an interrupt handler as, as a consequence, interrupts are
-   * disabled.  But in the SMP case, interrupst MAY be disabled only on
-   * the local CPU since most architectures do not permit disabling
-   * interrupts on other CPUS.
-   *
-   * Hence, we must follow rules for critical sections even here in the
-   * SMP case.
-   */
+  /* Advance the watchdog time by one tick */
 
-  flags = enter_critical_section();
-#endif
+  flags   = wd_lock();
+  g_wdtick++;
+  nactive = g_wdnactive;
+  wd_unlock(flags);
 
   /* Check if there are any active watchdogs to process */
 
-  if (g_wdactivelist.head)
+  if (nactive > 0)
     {
-      /* There are.  Decrement the lag counter */
+      /* There are.  The watchdog functions operate on the scheduler and
+       * other shared data so they must be called with the critical section
+       * held, but only the timing wheel lock is needed on the ticks when
+       * no watchdog is active.
+       */
 
-      --(((FAR struct wdog_s *)g_wdactivelist.head)->lag);
+      flags = enter_critical_section();
+      wd_expiration();
+      leave_critical_section(flags);
+    }
+#else
+  /* Advance the watchdog time by one tick */
 
-      /* Check if the watchdog at the head of the list is ready to run */
+  g_wdtick++;
+
+  /* Check if there are any active watchdogs to process */
+
+  if (g_wdnactive > 0)
+    {
+      /* There are.  Check if any watchdog in the current slot of the
+       * timing wheel is ready to run.
+       */
 
       wd_expiration();
     }
-
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
 #endif
 }
 #endif /* CONFIG_SCHED_TICKLESS */
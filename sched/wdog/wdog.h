@@ -46,7 +46,57 @@
 #include <stdbool.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 #include <nuttx/wdog.h>
+#include <nuttx/mm/mempool.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Active watchdogs are kept in a hashed timing wheel.  Each slot of the
+ * wheel holds an unordered list of the watchdogs whose absolute expiration
+ * time, modulo the number of slots, selects that slot.
+ */
+
+#define WDOG_NSLOTS        (1 << CONFIG_WDOG_WHEELBITS)
+#define WDOG_SLOTMASK      (WDOG_NSLOTS - 1)
+#define WDOG_SLOT(t)       (&g_wdwheel[(t) & WDOG_SLOTMASK])
+
+/* The signed number of ticks from the current watchdog time until the
+ * expiration of a watchdog.  This is immune to wrap-around of g_wdtick.
+ */
+
+#define WDOG_DELTA(w)      ((int32_t)((w)->expire - g_wdtick))
+
+/* The latest time at which the function of a watchdog may be called */
+
+#ifdef CONFIG_WDOG_SLACK
+#  define WDOG_LATEST(w)   ((w)->expire + (w)->slack)
+#else
+#  define WDOG_LATEST(w)   ((w)->expire)
+#endif
+
+/* In the SMP case, the timing wheel is protected by its own spinlock rather
+ * than by the global critical section so that starting and cancelling
+ * watchdogs does not serialize all CPUs.  The watchdog functions are still
+ * called from within the critical section.
+ *
+ * In the tickless case, starting and cancelling watchdogs also manipulates
+ * the interval timer and the scheduler timing so the global critical
+ * section is still used.
+ */
+
+#if defined(CONFIG_SMP) && !defined(CONFIG_SCHED_TICKLESS)
+#  define WDOG_SPINLOCK    1
+#  define wd_lock()        spin_lock_irqsave(&g_wdlock)
+#  define wd_unlock(f)     spin_unlock_irqrestore(&g_wdlock, f)
+#else
+#  undef  WDOG_SPINLOCK
+#  define wd_lock()        enter_critical_section()
+#  define wd_unlock(f)     leave_critical_section(f)
+#endif
 
 /****************************************************************************
  * Public Data
@@ -60,25 +110,56 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_wdfreelist data structure is a singly linked list of watchdogs
- * available to the system for delayed function use.
+/* g_wdpool is the pool of watchdogs available to the system for delayed
+ * function use.
  */
 
-extern sq_queue_t g_wdfreelist;
+extern struct mempool_s g_wdpool;
 
-/* The g_wdactivelist data structure is a singly linked list ordered by
- * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+/* g_wdwheel is the timing wheel of active watchdogs.  When the watchdog
+ * time reaches the expiration time of a watchdog in the current slot, the
+ * watchdog is removed from the wheel and its function is called.
  */
 
-extern sq_queue_t g_wdactivelist;
+extern dq_queue_t g_wdwheel[WDOG_NSLOTS];
 
-/* This is the number of free, pre-allocated watchdog structures in the
- * g_wdfreelist.  This value is used to enforce a reserve for interrupt
- * handlers.
+/* g_wdtick is the current watchdog time in clock ticks.  It is advanced by
+ * wd_timer() and is the base for the absolute expiration times.
  */
 
-extern uint16_t g_wdnfree;
+extern uint32_t g_wdtick;
+
+/* g_wdnactive is the number of watchdogs in the timing wheel */
+
+extern unsigned int g_wdnactive;
+
+#ifdef CONFIG_SCHED_TICKLESS
+/* g_wdnext is the expiration time of the earliest watchdog as determined
+ * by the last call to wd_timer().  This is the event that the interval
+ * timer is waiting for.  With CONFIG_WDOG_SLACK, this is the latest time
+ * that satisfies the slack of every active watchdog.
+ */
+
+extern uint32_t g_wdnext;
+#endif
+
+#ifdef CONFIG_WDOG_SLACK
+/* g_wdstats holds the watchdog expiration statistics */
+
+extern struct wdstats_s g_wdstats;
+#endif
+
+#ifdef WDOG_SPINLOCK
+/* g_wdlock protects the timing wheel, g_wdtick and g_wdnactive */
+
+extern volatile spinlock_t g_wdlock;
+
+/* g_wdrunning holds the watchdog whose function is being executed on each
+ * CPU.  wd_cancel() uses this to wait until the function has returned.
+ */
+
+extern FAR struct wdog_s *volatile g_wdrunning[CONFIG_SMP_NCPUS];
+#endif
 
 /****************************************************************************
  * Public Function Prototypes
@@ -136,6 +217,25 @@ unsigned int wd_timer(int ticks);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel and mark it inactive.
+ *
+ * Parameters:
+ *   wdog - The active watchdog to remove
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The caller holds the timing wheel lock (see wd_lock()).
+ *
+ ****************************************************************************/
+
+void wd_remove(FAR struct wdog_s *wdog);
+
 /****************************************************************************
  * Name: wd_recover
  *
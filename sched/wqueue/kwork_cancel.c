@@ -55,6 +55,43 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qremove
+ *
+ * Description:
+ *   Remove pending work from a work queue.  The caller holds the lock of
+ *   the work queue.  -ENOENT is returned if the work is not pending.
+ *
+ ****************************************************************************/
+
+static int work_qremove(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct work_s *work)
+{
+  int ret = -ENOENT;
+
+  if (work->worker != NULL)
+    {
+      FAR dq_queue_t *queue = work_queueof(wqueue, work);
+
+      /* A little test of the integrity of the work queue */
+
+      DEBUGASSERT(work->dq.flink != NULL ||
+                  (FAR dq_entry_t *)work == queue->tail);
+      DEBUGASSERT(work->dq.blink != NULL ||
+                  (FAR dq_entry_t *)work == queue->head);
+
+      /* Remove the entry from the work queue and make sure that it is
+       * marked as available (i.e., the worker field is nullified).
+       */
+
+      dq_rem((FAR dq_entry_t *)work, queue);
+      work->worker = NULL;
+      ret = OK;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Name: work_qcancel
  *
@@ -64,7 +101,7 @@
  *   again.
  *
  * Input parameters:
- *   qid    - The work queue ID
+ *   wqueue - The work queue
  *   work   - The previously queue work structure to cancel
  *
  * Returned Value:
@@ -72,7 +109,6 @@
  *   reported:
  *
  *   -ENOENT - There is no such work queued.
- *   -EINVAL - An invalid work queue was specified
  *
  ****************************************************************************/
 
@@ -80,7 +116,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
                         FAR struct work_s *work)
 {
   irqstate_t flags;
-  int ret = -ENOENT;
+  int ret;
 
   DEBUGASSERT(work != NULL);
 
@@ -89,28 +125,55 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
    * new work is typically added to the work queue from interrupt handlers.
    */
 
-  flags = enter_critical_section();
-  if (work->worker != NULL)
-    {
-      /* A little test of the integrity of the work queue */
+  flags = work_lock(wqueue);
+  ret   = work_qremove(wqueue, work);
+  work_unlock(wqueue, flags);
+  return ret;
+}
 
-      DEBUGASSERT(work->dq.flink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.tail);
-      DEBUGASSERT(work->dq.blink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.head);
+/****************************************************************************
+ * Name: work_hpcancel
+ *
+ * Description:
+ *   Cancel high priority work on the per-CPU work queue that holds it.
+ *   work->cpu may be changed by work_queue_oncpu() on another CPU until
+ *   the lock of the work queue that it names is held, so it is re-checked
+ *   once that lock is taken.
+ *
+ ****************************************************************************/
 
-      /* Remove the entry from the work queue and make sure that it is
-       * marked as available (i.e., the worker field is nullified).
-       */
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+static int work_hpcancel(FAR struct work_s *work)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+  int cpu;
+  int ret;
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
-      work->worker = NULL;
-      ret = OK;
+  DEBUGASSERT(work != NULL);
+
+  flags = up_irq_save();
+  for (; ; )
+    {
+      cpu = work->cpu;
+      DEBUGASSERT(cpu < HPWORK_NQUEUES);
+
+      wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork[cpu];
+      spin_lock(&wqueue->lock);
+      if (work->cpu == cpu)
+        {
+          break;
+        }
+
+      spin_unlock(&wqueue->lock);
     }
 
-  leave_critical_section(flags);
+  ret = work_qremove(wqueue, work);
+  spin_unlock(&wqueue->lock);
+  up_irq_restore(flags);
   return ret;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -144,7 +207,11 @@ int work_cancel(int qid, FAR struct work_s *work)
     {
       /* Cancel high priority work */
 
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      return work_hpcancel(work);
+#else
+      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork[0], work);
+#endif
     }
   else
 #endif
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <unistd.h>
+#include <sched.h>
 #include <errno.h>
 #include <queue.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/wqueue.h>
@@ -56,9 +59,19 @@
  * Public Data
  ****************************************************************************/
 
-/* The state of the kernel mode, high priority work queue. */
+/* The state of the kernel mode, high priority work queue(s). */
 
-struct hp_wqueue_s g_hpwork;
+struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_STATS)
+/* Lock statistics of the high priority work queue */
+
+static struct spinstat_s g_hpstat[HPWORK_NQUEUES];
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -92,6 +105,25 @@ struct hp_wqueue_s g_hpwork;
 
 static int work_hpthread(int argc, char *argv[])
 {
+  FAR struct hp_wqueue_s *wqueue = &g_hpwork[0];
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  pid_t me = getpid();
+  int i;
+
+  /* Find the work queue of this thread by searching the work queues */
+
+  for (i = 0; i < HPWORK_NQUEUES; i++)
+    {
+      if (g_hpwork[i].worker[0].pid == me)
+        {
+          wqueue = &g_hpwork[i];
+          break;
+        }
+    }
+
+  DEBUGASSERT(i < HPWORK_NQUEUES);
+#endif
+
   /* Loop forever */
 
   for (; ; )
@@ -105,18 +137,22 @@ static int work_hpthread(int argc, char *argv[])
        * NOTE: If the work thread is disabled, this clean-up is performed by
        * the IDLE thread (at a very, very low priority).  If the low-priority
        * work thread is enabled, then the garbage collection is done on that
-       * thread instead.
+       * thread instead.  With per-CPU work queues, only the worker thread of
+       * CPU0 does the garbage collection.
        */
 
-      sched_garbage_collection();
+      if (wqueue == &g_hpwork[0])
+        {
+          sched_garbage_collection();
+        }
 #endif
 
       /* Then process queued work.  work_process will not return until: (1)
        * there is no further work in the work queue, and (2) the polling
-       * period provided by g_hpwork.delay expires.
+       * period provided by the work queue delay expires.
        */
 
-      work_process((FAR struct kwork_wqueue_s *)&g_hpwork, g_hpwork.delay, 0);
+      work_process((FAR struct kwork_wqueue_s *)wqueue, wqueue->delay, 0);
     }
 
   return OK; /* To keep some compilers happy */
@@ -144,34 +180,66 @@ static int work_hpthread(int argc, char *argv[])
 int work_hpstart(void)
 {
   pid_t pid;
+  int i;
+
+  /* Don't permit any of the threads to run until we have fully initialized
+   * g_hpwork.
+   */
 
-  /* Initialize work queue data structures */
+  sched_lock();
 
-  g_hpwork.delay          = CONFIG_SCHED_HPWORKPERIOD / USEC_PER_TICK;
-  dq_init(&g_hpwork.q);
+  for (i = 0; i < HPWORK_NQUEUES; i++)
+    {
+      /* Initialize work queue data structures */
+
+      g_hpwork[i].delay = CONFIG_SCHED_HPWORKPERIOD / USEC_PER_TICK;
+      dq_init(&g_hpwork[i].q);
+      dq_init(&g_hpwork[i].dq);
+#ifdef CONFIG_SMP
+      spin_initialize(&g_hpwork[i].lock, SP_UNLOCKED);
+#ifdef CONFIG_SPINLOCK_STATS
+      spin_register(&g_hpstat[i], &g_hpwork[i].lock, "hpwork");
+#endif
+#endif
 
-  /* Start the high-priority, kernel mode worker thread */
+      /* Start the high-priority, kernel mode worker thread */
 
-  sinfo("Starting high-priority kernel worker thread\n");
+      sinfo("Starting high-priority kernel worker thread %d\n", i);
 
-  pid = kernel_thread(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
-                      CONFIG_SCHED_HPWORKSTACKSIZE,
-                      (main_t)work_hpthread,
-                      (FAR char * const *)NULL);
+      pid = kernel_thread(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
+                          CONFIG_SCHED_HPWORKSTACKSIZE,
+                          (main_t)work_hpthread,
+                          (FAR char * const *)NULL);
 
-  DEBUGASSERT(pid > 0);
-  if (pid < 0)
-    {
-      int errcode = errno;
-      DEBUGASSERT(errcode > 0);
+      DEBUGASSERT(pid > 0);
+      if (pid < 0)
+        {
+          int errcode = errno;
+          DEBUGASSERT(errcode > 0);
 
-      serr("ERROR: kernel_thread failed: %d\n", errcode);
-      return -errcode;
+          serr("ERROR: kernel_thread %d failed: %d\n", i, errcode);
+          sched_unlock();
+          return -errcode;
+        }
+
+      g_hpwork[i].worker[0].pid  = pid;
+      g_hpwork[i].worker[0].busy = true;
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      /* The worker thread of each work queue runs only on its CPU */
+
+      {
+        cpu_set_t cpuset;
+
+        CPU_ZERO(&cpuset);
+        CPU_SET(i, &cpuset);
+        DEBUGVERIFY(sched_setaffinity(pid, sizeof(cpu_set_t), &cpuset));
+      }
+#endif
     }
 
-  g_hpwork.worker[0].pid  = pid;
-  g_hpwork.worker[0].busy = true;
-  return pid;
+  sched_unlock();
+  return g_hpwork[0].worker[0].pid;
 }
 
 #endif /* CONFIG_SCHED_HPWORK */
@@ -63,6 +63,16 @@
 
 struct lp_wqueue_s g_lpwork;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SPINLOCK_STATS)
+/* Lock statistics of the low priority work queue */
+
+static struct spinstat_s g_lpstat;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -188,6 +198,13 @@ int work_lpstart(void)
 
   g_lpwork.delay = CONFIG_SCHED_LPWORKPERIOD / USEC_PER_TICK;
   dq_init(&g_lpwork.q);
+  dq_init(&g_lpwork.dq);
+#ifdef CONFIG_SMP
+  spin_initialize(&g_lpwork.lock, SP_UNLOCKED);
+#ifdef CONFIG_SPINLOCK_STATS
+  spin_register(&g_lpstat, &g_lpwork.lock, "lpwork");
+#endif
+#endif
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_lpwork.
@@ -219,6 +236,12 @@ int work_lpstart(void)
 
       g_lpwork.worker[wndx].pid  = pid;
       g_lpwork.worker[wndx].busy = true;
+
+#if defined(CONFIG_WDOG_SLACK) && CONFIG_SCHED_LPWORKSLACK > 0
+      /* Let the worker thread delays be coalesced with other timers */
+
+      sched_gettcb(pid)->timerslack = USEC2TICK(CONFIG_SCHED_LPWORKSLACK);
+#endif
     }
 
   sched_unlock();
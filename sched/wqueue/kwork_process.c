@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <unistd.h>
 #include <signal.h>
 #include <assert.h>
@@ -94,7 +95,7 @@
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, systime_t period, int wndx)
 {
-  volatile FAR struct work_s *work;
+  FAR struct work_s *work;
   worker_t  worker;
   irqstate_t flags;
   FAR void *arg;
@@ -103,117 +104,147 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, systime_t period, int wndx)
   systime_t stick;
   systime_t ctick;
   systime_t next;
+  unsigned int gen;
+#if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+  bool expired;
+#endif
 
-  /* Then process queued work.  We need to keep interrupts disabled while
+  /* Then process queued work.  We need to hold the work queue lock while
    * we process items in the work list.
    */
 
   next  = period;
-  flags = enter_critical_section();
+  flags = work_lock(wqueue);
 
   /* Get the time that we started this polling cycle in clock ticks. */
 
   stick = clock_systimer();
 
-  /* And check each entry in the work queue.  Since we have disabled
-   * interrupts we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
-   */
-
-  work = (FAR struct work_s *)wqueue->q.head;
-  while (work)
+  for (; ; )
     {
-      /* Is this work ready?  It is ready if there is no delay or if
-       * the delay has elapsed. qtime is the time that the work was added
-       * to the work queue.  It will always be greater than or equal to
-       * zero.  Therefore a delay of zero will always execute immediately.
+      /* Move the delayed work whose delay has elapsed to the end of the
+       * ready queue.  The delayed queue is ordered by expiration time so
+       * only its head needs to be examined.  qtime is the time that the
+       * work was added to the work queue.
        */
 
-      ctick   = clock_systimer();
-      elapsed = ctick - work->qtime;
-      if (elapsed >= work->delay)
+      ctick = clock_systimer();
+#if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+      expired = false;
+#endif
+
+      while ((work = (FAR struct work_s *)wqueue->dq.head) != NULL)
         {
-          /* Remove the ready-to-execute work from the list */
+          elapsed = ctick - work->qtime;
+          if (elapsed < work->delay)
+            {
+              break;
+            }
 
-          (void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+          (void)dq_rem((FAR dq_entry_t *)work, &wqueue->dq);
+          work->delay = 0;
+          dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+#if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+          expired = true;
+#endif
+        }
 
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
-           */
+      /* Take the work at the head of the ready queue */
 
-          worker = work->worker;
+      work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+      if (work == NULL)
+        {
+          break;
+        }
 
-          /* Check for a race condition where the work may be nullified
-           * before it is removed from the queue.
-           */
+      /* Extract the work description from the entry (in case the work
+       * instance by the re-used after it has been de-queued).
+       */
 
-          if (worker != NULL)
-            {
-              /* Extract the work argument (before re-enabling interrupts) */
+      worker = work->worker;
 
-              arg = work->arg;
+      /* Check for a race condition where the work may be nullified
+       * before it is removed from the queue.
+       */
 
-              /* Mark the work as no longer being queued */
+      if (worker != NULL)
+        {
+          /* Extract the work argument (before re-enabling interrupts) */
 
-              work->worker = NULL;
+          arg = work->arg;
 
-              /* Do the work.  Re-enable interrupts while the work is being
-               * performed... we don't have any idea how long this will take!
-               */
+          /* Mark the work as no longer being queued */
 
-              leave_critical_section(flags);
-              worker(arg);
+          work->worker = NULL;
 
-              /* Now, unfortunately, since we re-enabled interrupts we don't
-               * know the state of the work list and we will have to start
-               * back at the head of the list.
-               */
+          /* Do the work.  Release the lock while the work is being
+           * performed... we don't have any idea how long this will take!
+           */
 
-              flags = enter_critical_section();
-              work  = (FAR struct work_s *)wqueue->q.head;
-            }
-          else
-            {
-              /* Cancelled.. Just move to the next work in the list with
-               * interrupts still disabled.
-               */
+          work_unlock(wqueue, flags);
 
-              work = (FAR struct work_s *)work->dq.flink;
-            }
-        }
-      else /* elapsed < work->delay */
-        {
-          /* This one is not ready.
-           *
-           * NOTE that elapsed is relative to the current time,
-           * not the time of beginning of this queue processing pass.
-           * So it may need an adjustment.
+#if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+          /* If delayed work became ready and more work is waiting, then
+           * let an idle low priority worker thread take it rather than
+           * leaving it until this worker is done.
            */
 
-          elapsed += (ctick - stick);
-          if (elapsed > work->delay)
+          if (expired && wqueue == (FAR struct kwork_wqueue_s *)&g_lpwork &&
+              !dq_empty(&wqueue->q))
             {
-              /* The delay has expired while we are processing */
-
-              elapsed = work->delay;
+              (void)work_signal(LPWORK);
             }
+#endif
 
-          /* Will it be ready before the next scheduled wakeup interval? */
+          worker(arg);
+          flags = work_lock(wqueue);
+        }
+    }
 
-          remaining = work->delay - elapsed;
-          if (remaining < next)
-            {
-              /* Yes.. Then schedule to wake up when the work is ready */
+  /* Will the next delayed work be ready before the next scheduled wakeup
+   * interval?  The work at the head of the delayed queue expires first
+   * and it was not yet ready at time ctick.
+   */
 
-              next = remaining;
-            }
+  work = (FAR struct work_s *)wqueue->dq.head;
+  if (work != NULL)
+    {
+      elapsed   = ctick - work->qtime;
+      remaining = work->delay - elapsed;
 
-          /* Then try the next in the list. */
+      if (remaining < next)
+        {
+          /* Yes.. Then schedule to wake up when the work is ready */
 
-          work = (FAR struct work_s *)work->dq.flink;
+          next = remaining;
         }
     }
 
+  /* Remember the state of the work queue that was examined, then release
+   * the lock before waiting.
+   */
+
+  gen = wqueue->gen;
+  work_unlock(wqueue, flags);
+
+  /* The wait must start within the critical section:  Work queued after
+   * this point is signalled only after this thread has started to wait
+   * because the signal cannot be delivered until the critical section is
+   * released by the wait.  Work queued before this point is detected by
+   * the change of the generation count and is processed without waiting.
+   */
+
+  flags = enter_critical_section();
+  if (wqueue->gen != gen)
+    {
+      /* New work was queued while the lock was released.  Return so that
+       * it is processed without waiting.
+       */
+
+      leave_critical_section(flags);
+      return;
+    }
+
 #if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 0
   /* Value of zero for period means that we should wait indefinitely until
    * signalled.  This option is used only for the case where there are
@@ -49,6 +49,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/wqueue.h>
 
+#include "sched/sched.h"
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
@@ -57,6 +58,107 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_remaining
+ *
+ * Description:
+ *   Return the number of ticks until queued work will be ready, relative to
+ *   the time 'now'.  Zero is returned if the work is already ready.
+ *
+ ****************************************************************************/
+
+static inline systime_t work_remaining(FAR struct work_s *work,
+                                       systime_t now)
+{
+  systime_t elapsed = now - work->qtime;
+  return elapsed < work->delay ? work->delay - elapsed : 0;
+}
+
+/****************************************************************************
+ * Name: work_qdelayed
+ *
+ * Description:
+ *   Add delayed work to the delayed queue, keeping the queue ordered by
+ *   expiration time.  Work that expires at the same time is kept in the
+ *   order in which it was queued.  The queue is searched from the end
+ *   since new work usually expires after the work that is already queued.
+ *
+ ****************************************************************************/
+
+static void work_qdelayed(FAR struct kwork_wqueue_s *wqueue,
+                          FAR struct work_s *work)
+{
+  FAR struct work_s *prev;
+  systime_t remaining = work->delay;
+
+  for (prev = (FAR struct work_s *)wqueue->dq.tail;
+       prev != NULL && work_remaining(prev, work->qtime) > remaining;
+       prev = (FAR struct work_s *)prev->dq.blink);
+
+  if (prev == NULL)
+    {
+      dq_addfirst((FAR dq_entry_t *)work, &wqueue->dq);
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+                  &wqueue->dq);
+    }
+}
+
+/****************************************************************************
+ * Name: work_qinsert
+ *
+ * Description:
+ *   Put work in the ready or delayed queue of a work queue, first removing
+ *   it from that work queue if it is already pending there.  The caller
+ *   holds the lock of the work queue.
+ *
+ ****************************************************************************/
+
+static void work_qinsert(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work, worker_t worker,
+                         FAR void *arg, systime_t delay)
+{
+  /* Is there already pending work? */
+
+  if (work->worker != NULL)
+    {
+      /* Remove the entry from the work queue.  It will re requeued at the
+       * end of the work queue.
+       */
+
+      dq_rem((FAR dq_entry_t *)work, work_queueof(wqueue, work));
+    }
+
+  /* Initialize the work structure. */
+
+  work->worker = worker;           /* Work callback. non-NULL means queued */
+  work->arg    = arg;              /* Callback argument */
+  work->delay  = delay;            /* Delay until work performed */
+
+  /* Now, time-tag that entry and put it in the ready queue or, if there
+   * is a delay, in the delayed queue.
+   */
+
+  work->qtime  = clock_systimer(); /* Time work queued */
+
+  if (delay == 0)
+    {
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+    }
+  else
+    {
+      work_qdelayed(wqueue, work);
+    }
+
+  /* Let a worker thread that is about to wait know that new work was
+   * queued after it examined the queue.
+   */
+
+  wqueue->gen++;
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -95,36 +197,103 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
   DEBUGASSERT(work != NULL && worker != NULL);
 
   /* Interrupts are disabled so that this logic can be called from with task
-   * logic or ifrom nterrupt handling logic.
+   * logic or ifrom nterrupt handling logic.  Only the lock of this work
+   * queue is needed to modify the queue.
    */
 
-  flags = enter_critical_section();
+  flags = work_lock(wqueue);
+  work_qinsert(wqueue, work, worker, arg, delay);
+  work_unlock(wqueue, flags);
+}
 
-  /* Is there already pending work? */
+/****************************************************************************
+ * Name: work_hpqueue
+ *
+ * Description:
+ *   Queue high priority work on the work queue of the selected CPU and
+ *   wake up the worker thread of that work queue.
+ *
+ *   With per-CPU work queues, the work may still be pending on the work
+ *   queue of another CPU.  The locks of both work queues are then held,
+ *   taken in CPU order, while the work is moved so that a concurrent
+ *   work_queue_oncpu() or work_cancel() on another CPU cannot see it
+ *   half-moved.  work->cpu is only changed with the lock of the work queue
+ *   that it names held, so it is re-checked once the locks are taken.
+ *
+ ****************************************************************************/
 
-  if (work->worker != NULL)
+#ifdef CONFIG_SCHED_HPWORK
+static int work_hpqueue(int cpu, FAR struct work_s *work, worker_t worker,
+                        FAR void *arg, systime_t delay)
+{
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  FAR struct kwork_wqueue_s *wqueue =
+    (FAR struct kwork_wqueue_s *)&g_hpwork[cpu];
+  FAR struct kwork_wqueue_s *oldq = wqueue;
+  irqstate_t flags;
+  int oldcpu;
+
+  DEBUGASSERT(work != NULL && worker != NULL);
+
+  flags = up_irq_save();
+  for (; ; )
     {
-      /* Remove the entry from the work queue.  It will re requeued at the
-       * end of the work queue.
-       */
+      oldcpu = work->cpu;
+      DEBUGASSERT(oldcpu < HPWORK_NQUEUES);
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
-    }
+      if (oldcpu == cpu)
+        {
+          spin_lock(&wqueue->lock);
+        }
+      else
+        {
+          oldq = (FAR struct kwork_wqueue_s *)&g_hpwork[oldcpu];
+          spin_lock(oldcpu < cpu ? &oldq->lock : &wqueue->lock);
+          spin_lock(oldcpu < cpu ? &wqueue->lock : &oldq->lock);
+        }
 
-  /* Initialize the work structure. */
+      if (work->cpu == oldcpu)
+        {
+          break;
+        }
 
-  work->worker = worker;           /* Work callback. non-NULL means queued */
-  work->arg    = arg;              /* Callback argument */
-  work->delay  = delay;            /* Delay until work performed */
+      /* The work was moved by another CPU before we got the lock(s) */
 
-  /* Now, time-tag that entry and put it in the work queue */
+      spin_unlock(&wqueue->lock);
+      if (oldcpu != cpu)
+        {
+          spin_unlock(&oldq->lock);
+        }
+    }
 
-  work->qtime  = clock_systimer(); /* Time work queued */
+  /* If the work is still pending on the work queue of another CPU, then it
+   * must be removed from that queue first.
+   */
+
+  if (oldcpu != cpu && work->worker != NULL)
+    {
+      dq_rem((FAR dq_entry_t *)work, work_queueof(oldq, work));
+      work->worker = NULL;
+    }
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  work->cpu = cpu;
+  work_qinsert(wqueue, work, worker, arg, delay);
+
+  spin_unlock(&wqueue->lock);
+  if (oldcpu != cpu)
+    {
+      spin_unlock(&oldq->lock);
+    }
 
-  leave_critical_section(flags);
+  up_irq_restore(flags);
+  return work_hpsignal(cpu);
+#else
+  work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork[0], work, worker,
+              arg, delay);
+  return work_signal(HPWORK);
+#endif
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -169,8 +338,7 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue high priority work */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
-      return work_signal(HPWORK);
+      return work_hpqueue(0, work, worker, arg, delay);
     }
   else
 #endif
@@ -189,4 +357,53 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     }
 }
 
+/****************************************************************************
+ * Name: work_queue_oncpu
+ *
+ * Description:
+ *   Queue kernel-mode work like work_queue(), but on the high priority work
+ *   queue of the selected CPU.  The work is then performed by the worker
+ *   thread that runs on that CPU.  Low priority work is not bound to a CPU
+ *   and is queued just as by work_queue().
+ *
+ * Input parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the workder callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *   cpu    - The CPU that will perform the work or WORK_CPU_CURRENT to
+ *            select the CPU of the caller
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+int work_queue_oncpu(int qid, FAR struct work_s *work, worker_t worker,
+                     FAR void *arg, systime_t delay, int cpu)
+{
+  if (qid != HPWORK)
+    {
+      return work_queue(qid, work, worker, arg, delay);
+    }
+
+  if (cpu == WORK_CPU_CURRENT)
+    {
+      cpu = this_cpu();
+    }
+
+  if (cpu < 0 || cpu >= HPWORK_NQUEUES)
+    {
+      return -EINVAL;
+    }
+
+  return work_hpqueue(cpu, work, worker, arg, delay);
+}
+#endif
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
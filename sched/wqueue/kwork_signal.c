@@ -41,6 +41,7 @@
 
 #include <signal.h>
 #include <errno.h>
+#include <assert.h>
 
 #include <nuttx/wqueue.h>
 
@@ -78,7 +79,7 @@ int work_signal(int qid)
 #ifdef CONFIG_SCHED_HPWORK
   if (qid == HPWORK)
     {
-      pid = g_hpwork.worker[0].pid;
+      pid = g_hpwork[0].worker[0].pid;
     }
   else
 #endif
@@ -130,4 +131,37 @@ int work_signal(int qid)
   return OK;
 }
 
+/****************************************************************************
+ * Name: work_hpsignal
+ *
+ * Description:
+ *   Signal the worker thread of the high priority work queue of a CPU to
+ *   process its work queue now.
+ *
+ * Input parameters:
+ *   cpu    - The CPU whose work queue is signalled
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+int work_hpsignal(int cpu)
+{
+  int ret;
+
+  DEBUGASSERT(cpu >= 0 && cpu < HPWORK_NQUEUES);
+
+  ret = kill(g_hpwork[cpu].worker[0].pid, SIGWORK);
+  if (ret < 0)
+    {
+      int errcode = errno;
+      return -errcode;
+    }
+
+  return OK;
+}
+#endif
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -47,6 +47,8 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -59,6 +61,39 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* Each work queue is protected by its own spinlock rather than by the
+ * global critical section.  The lock only protects the queue of pending
+ * work;  it must not be held while work is performed or while a worker
+ * thread is signalled.  Without SMP, this simply disables interrupts.
+ */
+
+#ifdef CONFIG_SMP
+#  define work_lock(w)        spin_lock_irqsave(&(w)->lock)
+#  define work_unlock(w,f)    spin_unlock_irqrestore(&(w)->lock, f)
+#else
+#  define work_lock(w)        up_irq_save()
+#  define work_unlock(w,f)    up_irq_restore(f)
+#endif
+
+/* Work that is ready to be performed is kept in FIFO order in the ready
+ * queue.  Delayed work is kept in the delayed queue in order of expiration
+ * time until the delay elapses;  it is then moved to the end of the ready
+ * queue and its delay is set to zero.  So the delay of queued work selects
+ * the queue that holds it.
+ */
+
+#define work_queueof(w,k)     ((k)->delay == 0 ? &(w)->q : &(w)->dq)
+
+/* The number of high priority work queues.  With per-CPU work queues, the
+ * work queue of CPU0 is also the one used by work_queue(HPWORK, ...).
+ */
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+#  define HPWORK_NQUEUES      CONFIG_SMP_NCPUS
+#else
+#  define HPWORK_NQUEUES      1
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -75,7 +110,12 @@ struct kworker_s
 struct kwork_wqueue_s
 {
   systime_t         delay;     /* Delay between polling cycles (ticks) */
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work */
+  struct dq_queue_s dq;        /* The queue of delayed work */
+#ifdef CONFIG_SMP
+  volatile spinlock_t lock;    /* Protects the queue of pending work */
+#endif
+  volatile unsigned int gen;   /* Incremented when work is queued */
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -87,7 +127,12 @@ struct kwork_wqueue_s
 struct hp_wqueue_s
 {
   systime_t         delay;     /* Delay between polling cycles (ticks) */
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work */
+  struct dq_queue_s dq;        /* The queue of delayed work */
+#ifdef CONFIG_SMP
+  volatile spinlock_t lock;    /* Protects the queue of pending work */
+#endif
+  volatile unsigned int gen;   /* Incremented when work is queued */
   struct kworker_s  worker[1]; /* Describes the single high priority worker */
 };
 #endif
@@ -100,7 +145,12 @@ struct hp_wqueue_s
 struct lp_wqueue_s
 {
   systime_t         delay;  /* Delay between polling cycles (ticks) */
-  struct dq_queue_s q;      /* The queue of pending work */
+  struct dq_queue_s q;      /* The queue of ready work */
+  struct dq_queue_s dq;     /* The queue of delayed work */
+#ifdef CONFIG_SMP
+  volatile spinlock_t lock; /* Protects the queue of pending work */
+#endif
+  volatile unsigned int gen; /* Incremented when work is queued */
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -113,9 +163,9 @@ struct lp_wqueue_s
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_HPWORK
-/* The state of the kernel mode, high priority work queue. */
+/* The state of the kernel mode, high priority work queue(s). */
 
-extern struct hp_wqueue_s g_hpwork;
+extern struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
 #endif
 
 #ifdef CONFIG_SCHED_LPWORK
@@ -187,5 +237,24 @@ int work_lpstart(void);
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, systime_t period, int wndx);
 
+/****************************************************************************
+ * Name: work_hpsignal
+ *
+ * Description:
+ *   Signal the worker thread of the high priority work queue of a CPU to
+ *   process its work queue now.
+ *
+ * Input parameters:
+ *   cpu    - The CPU whose work queue is signalled
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+int work_hpsignal(int cpu);
+#endif
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
 #endif /* __SCHED_WQUEUE_WQUEUE_H */
@@ -295,9 +295,15 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(pthread_key_delete,       1, STUB_pthread_key_delete)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1, STUB_pthread_mutex_destroy)
   SYSCALL_LOOKUP(pthread_mutex_init,       2, STUB_pthread_mutex_init)
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  SYSCALL_LOOKUP(pthread_mutex_wait,       1, STUB_pthread_mutex_wait)
+  SYSCALL_LOOKUP(pthread_mutex_trywait,    1, STUB_pthread_mutex_trywait)
+  SYSCALL_LOOKUP(pthread_mutex_wake,       1, STUB_pthread_mutex_wake)
+#else
   SYSCALL_LOOKUP(pthread_mutex_lock,       1, STUB_pthread_mutex_lock)
   SYSCALL_LOOKUP(pthread_mutex_trylock,    1, STUB_pthread_mutex_trylock)
   SYSCALL_LOOKUP(pthread_mutex_unlock,     1, STUB_pthread_mutex_unlock)
+#endif
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1, STUB_pthread_mutex_consistent)
 #endif
@@ -332,6 +338,10 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(mq_timedreceive,          5, STUB_mq_timedreceive)
   SYSCALL_LOOKUP(mq_timedsend,             5, STUB_mq_timedsend)
   SYSCALL_LOOKUP(mq_unlink,                1, STUB_mq_unlink)
+#  ifdef CONFIG_MQ_ZEROCOPY
+  SYSCALL_LOOKUP(mq_receivebuf,            3, STUB_mq_receivebuf)
+  SYSCALL_LOOKUP(mq_sendbuf,               4, STUB_mq_sendbuf)
+#  endif
 #endif
 
 /* The following are defined only if environment variables are supported */
@@ -296,6 +296,9 @@ uintptr_t STUB_pthread_mutex_init(int nbr, uintptr_t parm1,
 uintptr_t STUB_pthread_mutex_lock(int nbr, uintptr_t parm1);
 uintptr_t STUB_pthread_mutex_trylock(int nbr, uintptr_t parm1);
 uintptr_t STUB_pthread_mutex_unlock(int nbr, uintptr_t parm1);
+uintptr_t STUB_pthread_mutex_wait(int nbr, uintptr_t parm1);
+uintptr_t STUB_pthread_mutex_trywait(int nbr, uintptr_t parm1);
+uintptr_t STUB_pthread_mutex_wake(int nbr, uintptr_t parm1);
 uintptr_t STUB_pthread_mutex_consistent(int nbr, uintptr_t parm1);
 uintptr_t STUB_pthread_setschedparam(int nbr, uintptr_t parm1,
             uintptr_t parm2, uintptr_t parm3);
@@ -338,6 +341,10 @@ uintptr_t STUB_mq_timedreceive(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_mq_timedsend(int nbr, uintptr_t parm1, uintptr_t parm2,
             uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 uintptr_t STUB_mq_unlink(int nbr, uintptr_t parm1);
+uintptr_t STUB_mq_receivebuf(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3);
+uintptr_t STUB_mq_sendbuf(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4);
 
 /* The following are defined only if environment variables are supported */
 
@@ -0,0 +1,544 @@
+/****************************************************************************
+ * tools/notetrace.c
+ *
+ *   Copyright (C) 2017 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_CPUS     32
+#define MAX_PIDS     65536
+#define MAX_NAME     32
+
+/* Note types.  These must agree with enum note_type_e in
+ * include/nuttx/sched_note.h.
+ */
+
+#define NOTE_START             0
+#define NOTE_STOP              1
+#define NOTE_SUSPEND           2
+#define NOTE_RESUME            3
+#define NOTE_CPU_START         4
+#define NOTE_CPU_STARTED       5
+#define NOTE_CPU_PAUSE         6
+#define NOTE_CPU_PAUSED        7
+#define NOTE_CPU_RESUME        8
+#define NOTE_CPU_RESUMED       9
+#define NOTE_PREEMPT_LOCK      10
+#define NOTE_PREEMPT_UNLOCK    11
+#define NOTE_CSECTION_ENTER    12
+#define NOTE_CSECTION_LEAVE    13
+#define NOTE_SPINLOCK_LOCK     14
+#define NOTE_SPINLOCK_LOCKED   15
+#define NOTE_SPINLOCK_UNLOCK   16
+#define NOTE_SPINLOCK_ABORT    17
+#define NOTE_DEADLINE_RELEASE  18
+#define NOTE_DEADLINE_OVERRUN  19
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The fields of struct note_common_s, independent of the host layout */
+
+struct note_s
+{
+  unsigned int length;
+  unsigned int type;
+  unsigned int priority;
+  unsigned int cpu;
+  unsigned int pid;
+  uint32_t systime;
+  const uint8_t *payload;     /* Type specific data following the header */
+  unsigned int paylen;
+};
+
+/* The state of one CPU */
+
+struct cpu_s
+{
+  bool seen;                  /* A note of this CPU has been seen */
+  bool running;               /* A slice is open for 'pid' */
+  unsigned int pid;           /* The task running on the CPU */
+  uint32_t lastraw;           /* The last timestamp of this CPU */
+  int64_t time;               /* The extended timestamp */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static bool g_smp;            /* Notes include the CPU (CONFIG_SMP) */
+static double g_freq = 100.0; /* Frequency of the timestamps in Hz */
+static FILE *g_out;
+static bool g_first = true;
+static bool g_havebase;       /* g_base has been set */
+static uint32_t g_base;       /* The timestamp of the first note */
+static struct cpu_s g_cpus[MAX_CPUS];
+static char g_names[MAX_PIDS][MAX_NAME];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname, int exitcode)
+{
+  fprintf(stderr, "USAGE: %s [-s] [-f <freq>] [-o <outfile>] [<infile>]\n",
+          progname);
+  fprintf(stderr, "\nConvert the scheduler notes read from /dev/note into "
+                  "the Trace Event JSON\n");
+  fprintf(stderr, "format that can be opened with chrome://tracing or "
+                  "https://ui.perfetto.dev\n\n");
+  fprintf(stderr, "Where:\n");
+  fprintf(stderr, "  -s         The notes were captured with CONFIG_SMP "
+                  "and include the CPU\n");
+  fprintf(stderr, "  -f <freq>  The frequency of the timestamps in Hz.  "
+                  "This is up_perf_getfreq()\n");
+  fprintf(stderr, "             with CONFIG_SCHED_NOTE_HIRES; otherwise "
+                  "the system timer\n");
+  fprintf(stderr, "             frequency.  Default: 100\n");
+  fprintf(stderr, "  -o <file>  Write the output to <file>.  Default: "
+                  "stdout\n");
+  fprintf(stderr, "  <infile>   The binary notes.  Default: stdin\n");
+  exit(exitcode);
+}
+
+static const char *task_name(unsigned int pid)
+{
+  static char name[MAX_NAME];
+
+  if (g_names[pid][0] != '\0')
+    {
+      return g_names[pid];
+    }
+
+  snprintf(name, MAX_NAME, "pid %u", pid);
+  return name;
+}
+
+static void print_string(const char *str)
+{
+  fputc('"', g_out);
+  for (; *str != '\0'; str++)
+    {
+      if (*str == '"' || *str == '\\')
+        {
+          fprintf(g_out, "\\%c", *str);
+        }
+      else if ((unsigned char)*str < 0x20)
+        {
+          fprintf(g_out, "\\u%04x", (unsigned char)*str);
+        }
+      else
+        {
+          fputc(*str, g_out);
+        }
+    }
+
+  fputc('"', g_out);
+}
+
+/* Begin an event object up to (but not including) its arguments */
+
+static void print_event(const char *name, const char *phase,
+                        unsigned int cpu, double ts)
+{
+  fprintf(g_out, "%s\n  {\"name\": ", g_first ? "" : ",");
+  print_string(name);
+  fprintf(g_out, ", \"ph\": \"%s\", \"pid\": 0, \"tid\": %u, "
+                 "\"ts\": %.3f", phase, cpu, ts);
+  if (phase[0] == 'i')
+    {
+      fprintf(g_out, ", \"s\": \"t\"");
+    }
+
+  g_first = false;
+}
+
+static void print_instant(const struct note_s *note, double ts,
+                          const char *name)
+{
+  print_event(name, "i", note->cpu, ts);
+  fprintf(g_out, ", \"args\": {\"task\": ");
+  print_string(task_name(note->pid));
+  fprintf(g_out, ", \"priority\": %u", note->priority);
+}
+
+static void begin_slice(struct cpu_s *cpu, unsigned int ndx,
+                        unsigned int pid, double ts)
+{
+  print_event(task_name(pid), "B", ndx, ts);
+  fprintf(g_out, ", \"args\": {\"pid\": %u}}", pid);
+  cpu->running = true;
+  cpu->pid     = pid;
+}
+
+static void end_slice(struct cpu_s *cpu, unsigned int ndx, double ts)
+{
+  if (cpu->running)
+    {
+      print_event(task_name(cpu->pid), "E", ndx, ts);
+      fputc('}', g_out);
+      cpu->running = false;
+    }
+}
+
+static uint32_t get_le(const uint8_t *data, unsigned int size)
+{
+  uint32_t value = 0;
+
+  while (size-- > 0)
+    {
+      value = (value << 8) | data[size];
+    }
+
+  return value;
+}
+
+static void convert_note(const struct note_s *note)
+{
+  struct cpu_s *cpu = &g_cpus[note->cpu];
+  double ts;
+
+  /* Extend the 32-bit timestamp.  The notes about a CPU are nearly in
+   * order, but a note about it that was generated on another CPU may be
+   * slightly older than the previous one, so the difference is signed.
+   * Times are relative to the first note in the input; the notes of other
+   * CPUs may be somewhat earlier.
+   */
+
+  if (!g_havebase)
+    {
+      g_havebase = true;
+      g_base     = note->systime;
+    }
+
+  if (!cpu->seen)
+    {
+      cpu->seen = true;
+      cpu->time = (int32_t)(note->systime - g_base);
+
+      fprintf(g_out, "%s\n  {\"name\": \"thread_name\", \"ph\": \"M\", "
+                     "\"pid\": 0, \"tid\": %u, "
+                     "\"args\": {\"name\": \"CPU%u\"}}",
+              g_first ? "" : ",", note->cpu, note->cpu);
+      g_first = false;
+    }
+  else
+    {
+      cpu->time += (int32_t)(note->systime - cpu->lastraw);
+    }
+
+  cpu->lastraw = note->systime;
+  ts = (double)cpu->time * 1000000.0 / g_freq;
+
+  switch (note->type)
+    {
+      case NOTE_START:
+        {
+          unsigned int len = note->paylen < MAX_NAME - 1 ?
+                             note->paylen : MAX_NAME - 1;
+
+          memcpy(g_names[note->pid], note->payload, len);
+          g_names[note->pid][len] = '\0';
+          print_instant(note, ts, "start");
+          fputs("}}", g_out);
+        }
+        break;
+
+      case NOTE_STOP:
+        if (cpu->running && cpu->pid == note->pid)
+          {
+            end_slice(cpu, note->cpu, ts);
+          }
+
+        print_instant(note, ts, "stop");
+        fputs("}}", g_out);
+        break;
+
+      case NOTE_SUSPEND:
+        end_slice(cpu, note->cpu, ts);
+        break;
+
+      case NOTE_RESUME:
+        end_slice(cpu, note->cpu, ts);
+        begin_slice(cpu, note->cpu, note->pid, ts);
+        break;
+
+      case NOTE_CPU_START:
+      case NOTE_CPU_PAUSE:
+      case NOTE_CPU_RESUME:
+        {
+          static const char *names[] =
+          {
+            "cpu start", "cpu pause", "cpu resume"
+          };
+
+          print_instant(note, ts, names[(note->type - NOTE_CPU_START) / 2]);
+          if (note->paylen >= 1)
+            {
+              fprintf(g_out, ", \"target\": %u", note->payload[0]);
+            }
+
+          fputs("}}", g_out);
+        }
+        break;
+
+      case NOTE_CPU_STARTED:
+      case NOTE_CPU_PAUSED:
+      case NOTE_CPU_RESUMED:
+        {
+          static const char *names[] =
+          {
+            "cpu started", "cpu paused", "cpu resumed"
+          };
+
+          print_instant(note, ts, names[(note->type - NOTE_CPU_STARTED) / 2]);
+          fputs("}}", g_out);
+        }
+        break;
+
+      case NOTE_PREEMPT_LOCK:
+      case NOTE_PREEMPT_UNLOCK:
+      case NOTE_CSECTION_ENTER:
+      case NOTE_CSECTION_LEAVE:
+        {
+          static const char *names[] =
+          {
+            "preempt lock", "preempt unlock",
+            "csection enter", "csection leave"
+          };
+
+          print_instant(note, ts, names[note->type - NOTE_PREEMPT_LOCK]);
+          if (note->paylen >= 2)
+            {
+              fprintf(g_out, ", \"count\": %u",
+                      (unsigned int)get_le(note->payload, 2));
+            }
+
+          fputs("}}", g_out);
+        }
+        break;
+
+      case NOTE_SPINLOCK_LOCK:
+      case NOTE_SPINLOCK_LOCKED:
+      case NOTE_SPINLOCK_UNLOCK:
+      case NOTE_SPINLOCK_ABORT:
+        {
+          static const char *names[] =
+          {
+            "spinlock lock", "spinlock locked",
+            "spinlock unlock", "spinlock abort"
+          };
+
+          /* The payload is the address of the spinlock (in the byte order
+           * and size of the target) followed by its value.
+           */
+
+          print_instant(note, ts, names[note->type - NOTE_SPINLOCK_LOCK]);
+          if (note->paylen > 1)
+            {
+              fprintf(g_out, ", \"value\": %u",
+                      note->payload[note->paylen - 1]);
+            }
+
+          fputs("}}", g_out);
+        }
+        break;
+
+      case NOTE_DEADLINE_RELEASE:
+      case NOTE_DEADLINE_OVERRUN:
+        print_instant(note, ts, note->type == NOTE_DEADLINE_RELEASE ?
+                      "deadline release" : "deadline overrun");
+        if (note->paylen >= 4)
+          {
+            fprintf(g_out, ", \"deadline\": %u",
+                    (unsigned int)get_le(note->payload, 4));
+          }
+
+        fputs("}}", g_out);
+        break;
+
+      default:
+        print_instant(note, ts, "unknown");
+        fprintf(g_out, ", \"type\": %u}}", note->type);
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char **argv)
+{
+  const char *outfile = NULL;
+  struct note_s note;
+  uint8_t buffer[256];
+  unsigned int hdrlen;
+  unsigned int ndx;
+  size_t nnotes = 0;
+  FILE *in = stdin;
+  int ch;
+
+  while ((ch = getopt(argc, argv, ":sf:o:h")) > 0)
+    {
+      switch (ch)
+        {
+          case 's':
+            g_smp = true;
+            break;
+
+          case 'f':
+            g_freq = strtod(optarg, NULL);
+            if (g_freq <= 0.0)
+              {
+                fprintf(stderr, "ERROR: Invalid frequency: %s\n", optarg);
+                show_usage(argv[0], EXIT_FAILURE);
+              }
+            break;
+
+          case 'o':
+            outfile = optarg;
+            break;
+
+          case 'h':
+            show_usage(argv[0], EXIT_SUCCESS);
+            break;
+
+          case '?':
+            fprintf(stderr, "ERROR: Unrecognized option: %c\n", optopt);
+            show_usage(argv[0], EXIT_FAILURE);
+            break;
+
+          case ':':
+            fprintf(stderr, "ERROR: Missing option argument: %c\n", optopt);
+            show_usage(argv[0], EXIT_FAILURE);
+            break;
+        }
+    }
+
+  if (optind < argc - 1)
+    {
+      fprintf(stderr, "ERROR: Too many arguments\n");
+      show_usage(argv[0], EXIT_FAILURE);
+    }
+
+  if (optind == argc - 1)
+    {
+      in = fopen(argv[optind], "rb");
+      if (in == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s\n", argv[optind]);
+          return EXIT_FAILURE;
+        }
+    }
+
+  g_out = stdout;
+  if (outfile != NULL)
+    {
+      g_out = fopen(outfile, "w");
+      if (g_out == NULL)
+        {
+          fprintf(stderr, "ERROR: Failed to open %s\n", outfile);
+          return EXIT_FAILURE;
+        }
+    }
+
+  /* Length, type, priority, [CPU,] PID[2] and timestamp[4] */
+
+  hdrlen = g_smp ? 10 : 9;
+
+  fprintf(g_out, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+  /* Each note begins with its length */
+
+  while ((ch = fgetc(in)) != EOF)
+    {
+      buffer[0] = (uint8_t)ch;
+      if (buffer[0] < hdrlen ||
+          fread(&buffer[1], 1, buffer[0] - 1, in) != buffer[0] - 1u)
+        {
+          fprintf(stderr, "ERROR: Bad or truncated note at note %zu\n",
+                  nnotes);
+          break;
+        }
+
+      ndx           = 3;
+      note.length   = buffer[0];
+      note.type     = buffer[1];
+      note.priority = buffer[2];
+      note.cpu      = g_smp ? buffer[ndx++] : 0;
+      note.pid      = get_le(&buffer[ndx], 2);
+      note.systime  = get_le(&buffer[ndx + 2], 4);
+      note.payload  = &buffer[hdrlen];
+      note.paylen   = note.length - hdrlen;
+
+      if (note.cpu >= MAX_CPUS)
+        {
+          fprintf(stderr, "ERROR: Bad CPU %u at note %zu\n", note.cpu,
+                  nnotes);
+          break;
+        }
+
+      convert_note(&note);
+      nnotes++;
+    }
+
+  fprintf(g_out, "\n]}\n");
+
+  if (in != stdin)
+    {
+      fclose(in);
+    }
+
+  if (g_out != stdout)
+    {
+      fclose(g_out);
+    }
+
+  fprintf(stderr, "%zu notes converted\n", nnotes);
+  return EXIT_SUCCESS;
+}